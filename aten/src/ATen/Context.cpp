@@ -51,6 +51,14 @@ void Context::setUserEnabledMkldnn(bool e) {
   enabled_mkldnn = e;
 }
 
+bool Context::userEnabledPackedLinear() const {
+  return enabled_packed_linear;
+}
+
+void Context::setUserEnabledPackedLinear(bool e) {
+  enabled_packed_linear = e;
+}
+
 bool Context::deterministicCuDNN() const {
   return deterministic_cudnn;
 }
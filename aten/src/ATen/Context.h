@@ -102,6 +102,10 @@ class CAFFE2_API Context {
   void setUserEnabledCuDNN(bool e);
   bool userEnabledMkldnn() const;
   void setUserEnabledMkldnn(bool e);
+  // Whether eager CPU linear caches its weights in a prepacked form,
+  // see ATen/native/PackedLinear.h
+  bool userEnabledPackedLinear() const;
+  void setUserEnabledPackedLinear(bool e);
   bool benchmarkCuDNN() const;
   void setBenchmarkCuDNN(bool);
   bool deterministicCuDNN() const;
@@ -137,6 +141,7 @@ class CAFFE2_API Context {
   bool _deterministic = false;
   bool benchmark_cudnn = false;
   bool enabled_mkldnn = true;
+  bool enabled_packed_linear = false;
   #ifdef C10_MOBILE
   bool release_original_weights = true;
   #else
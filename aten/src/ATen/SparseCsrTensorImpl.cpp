@@ -0,0 +1,106 @@
+#include <ATen/ATen.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/InitialTensorOptions.h>
+
+namespace at {
+
+namespace {
+  DeviceType sparseCsrTensorSetToDeviceType(DispatchKeySet key_set) {
+    if (key_set.has(DispatchKey::SparseCsrCPU)) {
+      return kCPU;
+    } else {
+      AT_ERROR("Cannot construct SparseCsrTensor with non-CSR tensor type ID ", key_set);
+    }
+  }
+}
+
+// An empty CSR tensor is a 0 x 0 matrix: crow_indices holds the single
+// offset 0, and col_indices and values are empty.
+SparseCsrTensorImpl::SparseCsrTensorImpl(at::DispatchKeySet key_set, const caffe2::TypeMeta& data_type)
+  :   SparseCsrTensorImpl(key_set, data_type
+      , at::zeros({1}, at::initialTensorOptions().device(sparseCsrTensorSetToDeviceType(key_set)).dtype(ScalarType::Long))
+      , at::empty({0}, at::initialTensorOptions().device(sparseCsrTensorSetToDeviceType(key_set)).dtype(ScalarType::Long))
+      , at::empty({0}, at::initialTensorOptions().device(sparseCsrTensorSetToDeviceType(key_set)).dtype(data_type))) {}
+
+SparseCsrTensorImpl::SparseCsrTensorImpl(
+    at::DispatchKeySet key_set,
+    const caffe2::TypeMeta& data_type,
+    at::Tensor crow_indices,
+    at::Tensor col_indices,
+    at::Tensor values)
+    : TensorImpl(key_set, data_type, values.device())
+    , crow_indices_(std::move(crow_indices))
+    , col_indices_(std::move(col_indices))
+    , values_(std::move(values)) {
+  sizes_ = {0, 0};
+  refresh_numel();
+  AT_ASSERT(values_.device() == crow_indices_.device());
+  AT_ASSERT(values_.device() == col_indices_.device());
+  AT_ASSERT(values_.device() == device());
+}
+
+IntArrayRef SparseCsrTensorImpl::strides() const {
+  AT_ERROR("sparse CSR tensors do not have strides");
+}
+bool SparseCsrTensorImpl::is_contiguous(at::MemoryFormat memory_format) const {
+  AT_ERROR("sparse CSR tensors do not have is_contiguous");
+}
+int64_t SparseCsrTensorImpl::stride(int64_t d) const {
+  AT_ERROR("sparse CSR tensors do not have strides");
+}
+void SparseCsrTensorImpl::set_size(int64_t dim, int64_t new_size) {
+  AT_ERROR("sparse CSR tensors do not have set_size");
+}
+void SparseCsrTensorImpl::set_stride(int64_t dim, int64_t new_stride) {
+  AT_ERROR("sparse CSR tensors do not have set_stride");
+}
+void SparseCsrTensorImpl::set_storage_offset(int64_t storage_offset) {
+  AT_ERROR("sparse CSR tensors do not have set_storage_offset");
+}
+
+int64_t SparseCsrTensorImpl::dim() const {
+  return 2;
+}
+bool SparseCsrTensorImpl::has_storage() const {
+  return false;
+}
+const Storage& SparseCsrTensorImpl::storage() const {
+  AT_ERROR("sparse CSR tensors do not have storage");
+}
+int64_t SparseCsrTensorImpl::storage_offset() const {
+  AT_ERROR("sparse CSR tensors do not have storage");
+}
+
+void SparseCsrTensorImpl::set_member_tensors_unsafe(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size) {
+  TORCH_CHECK(allow_tensor_metadata_change(), "set_member_tensors_unsafe ", err_msg_tensor_metadata_change_not_allowed);
+  TORCH_INTERNAL_ASSERT(at::impl::variable_excluded_from_dispatch());
+
+  TORCH_CHECK(size.size() == 2, "sparse CSR tensors must be 2-dimensional, but got size ", size);
+  TORCH_CHECK(crow_indices.layout() == kStrided && col_indices.layout() == kStrided && values.layout() == kStrided,
+      "expected crow_indices, col_indices and values to be dense tensors");
+  TORCH_CHECK(values.device().type() == device().type(), "device type of values (", values.device().type(), ") must match device type of device().type()", device().type(), ")");
+  TORCH_CHECK(values.scalar_type() == typeMetaToScalarType(dtype()), "dtype of values (", values.scalar_type(), ") must match dtype of sparse CSR tensor (", typeMetaToScalarType(dtype()), ")");
+  TORCH_CHECK(crow_indices.scalar_type() == kLong && col_indices.scalar_type() == kLong, "crow_indices and col_indices must be int64 tensors");
+  TORCH_CHECK(crow_indices.device() == values.device() && col_indices.device() == values.device(),
+      "crow_indices, col_indices and values must be on the same device");
+
+  TORCH_CHECK(crow_indices.dim() == 1 && col_indices.dim() == 1 && values.dim() == 1,
+      "crow_indices, col_indices and values must be 1-dimensional, but got dimensions ",
+      crow_indices.dim(), ", ", col_indices.dim(), " and ", values.dim());
+  TORCH_CHECK(crow_indices.size(0) == size[0] + 1,
+      "crow_indices must have size(0) + 1 = ", size[0] + 1, " elements, but got ", crow_indices.size(0));
+  TORCH_CHECK(col_indices.size(0) == values.size(0),
+      "col_indices and values must have same nnz, but got nnz from col_indices: ", col_indices.size(0), ", nnz from values: ", values.size(0));
+
+  crow_indices_ = crow_indices;
+  col_indices_ = col_indices;
+  values_ = values;
+  sizes_ = size.vec();
+  refresh_numel();
+}
+
+} // namespace at
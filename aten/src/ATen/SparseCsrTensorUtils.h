@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/SparseCsrTensorImpl.h>
+
+namespace at { namespace sparse_csr {
+
+// Just for documentary purposes
+using SparseCsrTensor = Tensor;
+
+// This is an internal utility function for getting at the SparseCsrTensorImpl,
+// so that we can write CSR specific accessors for its member tensors. See
+// get_sparse_impl in SparseTensorUtils.h.
+inline SparseCsrTensorImpl* get_sparse_csr_impl(const SparseCsrTensor& self) {
+  TORCH_INTERNAL_ASSERT(at::impl::variable_excluded_from_dispatch());
+  AT_ASSERTM(self.is_sparse_csr(), "_internal_get_SparseCsrTensorImpl: not a sparse CSR tensor");
+  return static_cast<SparseCsrTensorImpl*>(self.unsafeGetTensorImpl());
+}
+
+}} // namespace at::sparse_csr
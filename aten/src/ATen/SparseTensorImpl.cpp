@@ -113,6 +113,7 @@ void SparseTensorImpl::set_indices_and_values_unsafe(const Tensor& indices, cons
   AT_ASSERT(values_.device() == indices_.device());
 
   coalesced_ = false;
+  indices_sorted_ = false;
 }
 
 
@@ -29,6 +29,11 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // The indices are known to be in sorted order, but an index may occur more
+  // than once.  Coalescing such a tensor only has to sum the duplicates, which
+  // are next to each other, so it skips the sort.  Implied by coalesced_.
+  bool indices_sorted_ = false;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::DispatchKeySet, const caffe2::TypeMeta&);
@@ -37,6 +42,7 @@ public:
   int64_t sparse_dim() const { return sparse_dim_; }
   int64_t dense_dim() const { return dense_dim_; }
   bool coalesced() const { return coalesced_; }
+  bool indices_sorted() const { return coalesced_ || indices_sorted_; }
   Tensor indices() const { return indices_; }
   Tensor values() const { return values_; }
 
@@ -162,6 +168,15 @@ public:
   void set_coalesced(bool coalesced) {
     TORCH_CHECK(allow_tensor_metadata_change(), "set_coalesced ", err_msg_tensor_metadata_change_not_allowed);
     coalesced_ = coalesced;
+    // Whoever marks the tensor has just written its indices, and sets
+    // indices_sorted_ afterwards if it knows that they are sorted.
+    indices_sorted_ = false;
+  }
+
+  // NOTE: this function is only used internally and not exposed to Python frontend
+  void set_indices_sorted(bool indices_sorted) {
+    TORCH_CHECK(allow_tensor_metadata_change(), "set_indices_sorted ", err_msg_tensor_metadata_change_not_allowed);
+    indices_sorted_ = indices_sorted;
   }
 
   // NOTE: this function is only used internally and not exposed to Python frontend
@@ -238,6 +253,7 @@ private:
     dest_sparse_impl->indices_ = src_sparse_impl->indices();
     dest_sparse_impl->values_ = src_sparse_impl->values();
     dest_sparse_impl->coalesced_ = src_sparse_impl->coalesced();
+    dest_sparse_impl->indices_sorted_ = src_sparse_impl->indices_sorted();
   }
 };
 
@@ -8,6 +8,7 @@ namespace at {
 
 ThreadLocalState::ThreadLocalState(bool keep_grad_mode)
     : dispatch_key_(c10::impl::tls_local_dispatch_key_set()),
+      inference_mode_enabled_(c10::InferenceMode::is_enabled()),
       debug_info_(c10::ThreadLocalDebugInfo::current()) {
   callbacks_ = _getTLSCallbacks();
 #if !defined(CAFFE2_IS_XPLAT_BUILD) && !defined(C10_MOBILE)
@@ -32,6 +33,8 @@ void ThreadLocalState::setThreadLocalState(
   c10::ThreadLocalDebugInfo::_forceCurrentDebugInfo(state.debug_info_);
 
   c10::impl::_force_tls_local_dispatch_key_set(state.dispatch_key_);
+
+  c10::InferenceMode::_set_enabled(state.inference_mode_enabled_);
 }
 
 } // namespace at
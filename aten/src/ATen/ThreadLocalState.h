@@ -1,5 +1,6 @@
 #pragma once
 
+#include <c10/core/InferenceMode.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/util/Exception.h>
 #include <c10/util/ThreadLocalDebugInfo.h>
@@ -26,6 +27,8 @@ class TORCH_API ThreadLocalState {
  private:
   c10::impl::LocalDispatchKeySet dispatch_key_;
 
+  bool inference_mode_enabled_;
+
   // ThreadLocalDebugInfo does not change after being created
   // with DebugInfoGuard
   std::shared_ptr<c10::ThreadLocalDebugInfo> debug_info_;
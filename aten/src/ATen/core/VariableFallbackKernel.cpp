@@ -32,4 +32,11 @@ TORCH_LIBRARY_IMPL(_, Autograd, m) {
   m.fallback(torch::CppFunction::makeFallthrough());
 }
 
+// Only in-place, out= and view ops have an InplaceOrView kernel (see
+// InplaceOrViewType.cpp); every other op, custom ones included, has nothing
+// to do there.
+TORCH_LIBRARY_IMPL(_, InplaceOrView, m) {
+  m.fallback(torch::CppFunction::makeFallthrough());
+}
+
 }
@@ -10,6 +10,7 @@ void DispatchKeyExtractor::setOperatorHasKernelForBackend(DispatchKey k, bool ha
   } else {
     operatorHasKernelForBackend_ = operatorHasKernelForBackend_.remove(k);
   }
+  updateNonFallthroughKeys_();
 }
 
 void DispatchKeyExtractor::setOperatorHasFallthroughForBackend(DispatchKey k, bool has_fallthrough) {
@@ -18,6 +19,12 @@ void DispatchKeyExtractor::setOperatorHasFallthroughForBackend(DispatchKey k, bo
   } else {
     operatorHasFallthroughForBackend_ = operatorHasFallthroughForBackend_.remove(k);
   }
+  updateNonFallthroughKeys_();
+}
+
+void DispatchKeyExtractor::setBackendsWithoutFallthrough(DispatchKeySet backendsWithoutFallthrough) {
+  backendsWithoutFallthrough_ = backendsWithoutFallthrough;
+  updateNonFallthroughKeys_();
 }
 
 std::string DispatchKeyExtractor::dumpState() const {
@@ -35,6 +42,8 @@ std::string DispatchKeyExtractor::dumpState() const {
 
 void DispatchKeyExtractor::checkInvariants(const FunctionSchema& schema) const {
   TORCH_INTERNAL_ASSERT(makeBitsetForDispatchArgs(schema) == dispatch_arg_indices_reverse_);
+  TORCH_INTERNAL_ASSERT(nonFallthroughKeys_ ==
+    (backendsWithoutFallthrough_ | operatorHasKernelForBackend_) - operatorHasFallthroughForBackend_);
 }
 
 } // namespace c10
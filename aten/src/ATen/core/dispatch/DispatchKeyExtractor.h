@@ -123,7 +123,7 @@ public:
     dispatch_arg_indices_reverse_ = c10::utils::bitset();
   }
 
-  DispatchKey getDispatchKeyBoxed(DispatchKeySet backendsWithoutFallthrough, const torch::jit::Stack* stack) const {
+  DispatchKey getDispatchKeyBoxed(const torch::jit::Stack* stack) const {
     DispatchKeySet ks;
     dispatch_arg_indices_reverse_.for_each_set_bit([&] (size_t reverse_arg_index) {
       const auto& ivalue = torch::jit::peek(*stack, 0, reverse_arg_index + 1);
@@ -137,19 +137,21 @@ public:
         }
       }
     });
-    return dispatchKeySetToDispatchKey_(backendsWithoutFallthrough, DispatchKeySet::FULL, ks);
+    return dispatchKeySetToDispatchKey_(DispatchKeySet::FULL, ks);
   }
 
   template<class... Args>
-  DispatchKey getDispatchKeyUnboxed(DispatchKeySet backendsWithoutFallthrough, DispatchKeySet eligibleKeys, const Args&... args) const {
+  DispatchKey getDispatchKeyUnboxed(DispatchKeySet eligibleKeys, const Args&... args) const {
     auto ks = detail::multi_dispatch_key_set(args...);
-    return dispatchKeySetToDispatchKey_(backendsWithoutFallthrough, eligibleKeys, ks);
+    return dispatchKeySetToDispatchKey_(eligibleKeys, ks);
   }
 
   // Used by DispatchTable to maintain the fallthrough invariant, see
   // docs on operatorHasKernelForBackend_
   void setOperatorHasKernelForBackend(DispatchKey k, bool has_kernel);
   void setOperatorHasFallthroughForBackend(DispatchKey k, bool has_fallthrough);
+  // Used by the Dispatcher when a backend fallback is (de)registered.
+  void setBackendsWithoutFallthrough(DispatchKeySet backendsWithoutFallthrough);
 
   std::string dumpState() const;
   void checkInvariants(const FunctionSchema& schema) const;
@@ -170,32 +172,38 @@ private:
 
   // NB: If there is no valid dispatch key, this will return Undefined
   DispatchKey dispatchKeySetToDispatchKey_(
-      DispatchKeySet backendsWithoutFallthrough,
       // This is often known statically to be all ones; IN OPTIMIZER WE TRUST
       DispatchKeySet eligibleKeys,
       DispatchKeySet ks
   ) const {
     return impl::dispatchTypeId(ks,
-      // We must NOT respect the passed in backendsWithoutFallthrough if an operator has
-      // specifically overridden the backend, since that means we've opted to
-      // not fallthrough and instead apply some specific behavior (which we
-      // must dispatch to).
-      //
-      // This scheme doesn't work if you want to also apply fallthrough on a
-      // per-op basis, but while we could directly fix this by maintaining a
-      // second DispatchKeySet, it doesn't seem that there is any actual use case,
-      // so we are deferring it for #32454.
-        ((backendsWithoutFallthrough | operatorHasKernelForBackend_) - operatorHasFallthroughForBackend_)
       // Regardless of fallthrough behavior, only accept keys which are eligible
       // for dispatch, as requested by the user
       // 不管fallthrough行为如何，只接受用户请求的符合dispatch条件的key
-      & eligibleKeys);
+      nonFallthroughKeys_ & eligibleKeys);
+  }
+
+  // Recomputes nonFallthroughKeys_ from the sets it is derived from.
+  void updateNonFallthroughKeys_() {
+    // We must NOT respect backendsWithoutFallthrough_ if an operator has
+    // specifically overridden the backend, since that means we've opted to
+    // not fallthrough and instead apply some specific behavior (which we
+    // must dispatch to).
+    //
+    // This scheme doesn't work if you want to also apply fallthrough on a
+    // per-op basis, but while we could directly fix this by maintaining a
+    // second DispatchKeySet, it doesn't seem that there is any actual use case,
+    // so we are deferring it for #32454.
+    nonFallthroughKeys_ =
+      (backendsWithoutFallthrough_ | operatorHasKernelForBackend_) - operatorHasFallthroughForBackend_;
   }
 
   explicit DispatchKeyExtractor(c10::utils::bitset dispatch_arg_indices_reverse)
   : dispatch_arg_indices_reverse_(dispatch_arg_indices_reverse)
   , operatorHasKernelForBackend_()
-  , operatorHasFallthroughForBackend_() {}
+  , operatorHasFallthroughForBackend_()
+  , backendsWithoutFallthrough_(DispatchKeySet::FULL)
+  , nonFallthroughKeys_(DispatchKeySet::FULL) {}
 
   // this is a bitset that has ones for each argument index which has to be
   // considered for dispatch. This avoids having to iterate over the stack
@@ -211,6 +219,11 @@ private:
   DispatchKeySet operatorHasKernelForBackend_;
   // Set of backends for which the operator has explicitly registered a fallthrough kernel.
   DispatchKeySet operatorHasFallthroughForBackend_;
+  // The Dispatcher's set of backends that have no fallthrough fallback kernel.
+  DispatchKeySet backendsWithoutFallthrough_;
+  // The keys that do not fall through for this operator, computed from the
+  // three sets above whenever one of them changes rather than on every call.
+  DispatchKeySet nonFallthroughKeys_;
 };
 
 }
@@ -89,7 +89,10 @@ class DispatchTable final {
   : kernels_()
   , catchallKernel_()
   , dispatchKeyExtractor_(DispatchKeyExtractor::make(schema))
-  , operatorName_(schema.operator_name()) {}
+  , operatorName_(schema.operator_name())
+  , backendFallbackKernels_(nullptr) {
+    updateResolvedKernels_();
+  }
 
   // a dispatch table may be default constructed with only an
   // operator name.  Such a dispatch table is not callable until
@@ -98,7 +101,14 @@ class DispatchTable final {
   : kernels_()
   , catchallKernel_()
   , dispatchKeyExtractor_(DispatchKeyExtractor::makeUninitialized())
-  , operatorName_(std::move(op_name)) {}
+  , operatorName_(std::move(op_name))
+  , backendFallbackKernels_(nullptr) {
+    updateResolvedKernels_();
+  }
+
+  // resolvedKernels_ points into this object
+  DispatchTable(const DispatchTable&) = delete;
+  DispatchTable& operator=(const DispatchTable&) = delete;
 
   /**
    * Register a kernel in the table at some dispatch key.
@@ -114,6 +124,7 @@ class DispatchTable final {
     if (kernel.isFallthrough()) {
       dispatchKeyExtractor_.setOperatorHasFallthroughForBackend(dispatchKey, true);
     }
+    updateResolvedKernels_();
   }
 
   /**
@@ -125,6 +136,7 @@ class DispatchTable final {
     kernels_.removeKernelIfExists(dispatchKey);
     dispatchKeyExtractor_.setOperatorHasKernelForBackend(dispatchKey, false);
     dispatchKeyExtractor_.setOperatorHasFallthroughForBackend(dispatchKey, false); // may be no op
+    updateResolvedKernels_();
   }
 
   /**
@@ -138,6 +150,7 @@ class DispatchTable final {
       kernel.setManuallyBoxedKernel_(*manuallyBoxedKernel_);
     }
     catchallKernel_ = std::move(kernel);
+    updateResolvedKernels_();
   }
 
   /**
@@ -145,6 +158,18 @@ class DispatchTable final {
    */
   void removeCatchallKernel() {
     catchallKernel_ = {};
+    updateResolvedKernels_();
+  }
+
+  /**
+   * Make the table aware of the backend fallback kernels of the Dispatcher,
+   * which are used for the dispatch keys this operator has no kernel for.
+   * Must be called again whenever a backend fallback is (de)registered.
+   */
+  void setBackendFallbacks(const impl::KernelFunctionTable& backendFallbackKernels, DispatchKeySet backendsWithoutFallthrough) {
+    backendFallbackKernels_ = &backendFallbackKernels;
+    dispatchKeyExtractor_.setBackendsWithoutFallthrough(backendsWithoutFallthrough);
+    updateResolvedKernels_();
   }
 
   bool isEmpty() const {
@@ -187,6 +212,17 @@ class DispatchTable final {
     }
   }
 
+  /**
+   * The kernel that a call with the given dispatch key runs: the kernel of
+   * this operator for the key if there is one, otherwise the backend fallback
+   * for the key, otherwise the catch-all kernel.  Returns nullptr if there is
+   * none of them.  This is resolved at registration time, so that a call only
+   * does a single lookup.
+   */
+  const KernelFunction* lookupResolved(DispatchKey dispatchKey) const {
+    return resolvedKernels_[static_cast<uint8_t>(dispatchKey)];
+  }
+
   const KernelFunction* lookupCatchallKernel() const {
     // TODO: this condition shouldn't be necessary
     if (!catchallKernel_.isValid()) {
@@ -235,13 +271,41 @@ class DispatchTable final {
     return manuallyBoxedKernel_;
   }
 
+  void checkInvariants() const {
+    for (uint8_t iter = 0; iter != static_cast<uint8_t>(DispatchKey::NumDispatchKeys); ++iter) {
+      auto dispatchKey = static_cast<DispatchKey>(iter);
+      TORCH_INTERNAL_ASSERT(resolvedKernels_[iter] == resolveKernel_(dispatchKey),
+        "The resolved kernel of ", operatorName_, " for ", dispatchKey, " is out of date");
+    }
+  }
+
 private:
+  const KernelFunction* resolveKernel_(DispatchKey dispatchKey) const {
+    if (const KernelFunction* backendKernel = lookup(dispatchKey)) {
+      return backendKernel;
+    }
+    if (backendFallbackKernels_ != nullptr && (*backendFallbackKernels_)[dispatchKey].isValid()) {
+      return &(*backendFallbackKernels_)[dispatchKey];
+    }
+    return lookupCatchallKernel();
+  }
+
+  void updateResolvedKernels_() {
+    for (uint8_t iter = 0; iter != static_cast<uint8_t>(DispatchKey::NumDispatchKeys); ++iter) {
+      resolvedKernels_[iter] = resolveKernel_(static_cast<DispatchKey>(iter));
+    }
+  }
 
   impl::KernelFunctionTable kernels_;
   KernelFunction catchallKernel_;
   DispatchKeyExtractor dispatchKeyExtractor_;
   OperatorName operatorName_;
 
+  // Owned by the Dispatcher; nullptr until setBackendFallbacks is called.
+  const impl::KernelFunctionTable* backendFallbackKernels_;
+  // The kernel each dispatch key resolves to, see lookupResolved().
+  std::array<const KernelFunction*, static_cast<uint8_t>(DispatchKey::NumDispatchKeys)> resolvedKernels_;
+
   // This manuallyBoxedKernel_ member is a temporary hack that allows generated_unboxing_wrappers.cpp to register its codegen'ed
   // unboxing wrapper for aten operators. We still need those for some operators because not all work
   // with the templated unboxing logic yet.
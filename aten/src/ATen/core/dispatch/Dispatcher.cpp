@@ -98,6 +98,7 @@ OperatorHandle Dispatcher::findOrRegisterName_(const OperatorName& op_name) {
 
   operators_.emplace_back(OperatorName(op_name));
   OperatorHandle handle(--operators_.end());
+  handle.operatorIterator_->op.setBackendFallbacks(backendFallbackKernels_, backendsWithoutFallthrough_);
   operatorLookupTable_.write([&] (ska::flat_hash_map<OperatorName, OperatorHandle>& operatorLookupTable) {
     operatorLookupTable.emplace(op_name, handle);
   });
@@ -267,6 +268,7 @@ RegistrationHandleRAII Dispatcher::registerFallback(DispatchKey dispatchKey, Ker
   if (kernel.isFallthrough()) {
     backendsWithoutFallthrough_ = backendsWithoutFallthrough_.remove(dispatchKey);
   }
+  updateBackendFallbacks_();
 
   return RegistrationHandleRAII([this, dispatchKey] {
     deregisterFallback_(dispatchKey);
@@ -278,6 +280,14 @@ void Dispatcher::deregisterFallback_(DispatchKey dispatchKey) {
 
   backendFallbackKernels_.removeKernelIfExists(dispatchKey);
   backendsWithoutFallthrough_ = backendsWithoutFallthrough_.add(dispatchKey);
+  updateBackendFallbacks_();
+}
+
+void Dispatcher::updateBackendFallbacks_() {
+  // precondition: mutex_ is locked
+  for (auto& op : operators_) {
+    op.op.setBackendFallbacks(backendFallbackKernels_, backendsWithoutFallthrough_);
+  }
 }
 
 
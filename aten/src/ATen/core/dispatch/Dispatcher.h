@@ -219,6 +219,7 @@ private:
     std::list<impl::OperatorEntry::KernelEntry>::iterator kernel_handle);
   void deregisterName_(const OperatorHandle& op, const OperatorName& op_name);
   void deregisterFallback_(DispatchKey dispatchKey);
+  void updateBackendFallbacks_();
   void deregisterLibrary_(const std::string& ns);
   void cleanup(const OperatorHandle& op, const OperatorName& op_name);
   void checkSchemaCompatibility(const OperatorHandle& op, const FunctionSchema& schema, const std::string& debug);
@@ -348,7 +349,7 @@ template<class Return, class... Args>
 inline Return Dispatcher::call(const TypedOperatorHandle<Return(Args...)>& op, Args... args) const {
   detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
-  auto dispatchKey = dispatchTable.dispatchKeyExtractor().template getDispatchKeyUnboxed<Args...>(backendsWithoutFallthrough_, DispatchKeySet::FULL, args...);
+  auto dispatchKey = dispatchTable.dispatchKeyExtractor().template getDispatchKeyUnboxed<Args...>(DispatchKeySet::FULL, args...);
   return callWithDispatchKey<Return, Args...>(op, dispatchKey, args...);
 }
 
@@ -357,7 +358,6 @@ inline Return Dispatcher::redispatch(const TypedOperatorHandle<Return (Args...)>
   detail::unused_arg_(args...);  // workaround for a false-positive warning about unused parameters in gcc 5
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
   auto dispatchKey = dispatchTable.dispatchKeyExtractor().template getDispatchKeyUnboxed<Args...>(
-    backendsWithoutFallthrough_,
     DispatchKeySet(DispatchKeySet::FULL_AFTER, currentDispatchKey),
     args...);
   const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
@@ -367,26 +367,18 @@ inline Return Dispatcher::redispatch(const TypedOperatorHandle<Return (Args...)>
 inline void Dispatcher::callBoxed(const OperatorHandle& op, Stack* stack) const {
   // note: this doesn't need the mutex because write operations on the list keep iterators intact.
   const auto& dispatchTable = op.operatorIterator_->op.dispatch_table();
-  auto dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyBoxed(backendsWithoutFallthrough_, stack);
+  auto dispatchKey = dispatchTable.dispatchKeyExtractor().getDispatchKeyBoxed(stack);
   const KernelFunction& kernel = dispatch_(dispatchTable, dispatchKey);
   kernel.callBoxed(op, stack);
 }
 
 inline const KernelFunction& Dispatcher::dispatch_(const DispatchTable& dispatchTable, DispatchKey dispatchKey) const {
-  const KernelFunction* backendKernel = dispatchTable.lookup(dispatchKey);
-
-  if (nullptr != backendKernel) {
-    return *backendKernel;
-  }
-
-  const auto& backendFallbackKernel = backendFallbackKernels_[dispatchKey];
-  if (backendFallbackKernel.isValid()) {
-    return backendFallbackKernel;
-  }
-
-  const KernelFunction* catchallKernel = dispatchTable.lookupCatchallKernel();
-  if (C10_LIKELY(nullptr != catchallKernel)) {
-    return *catchallKernel;
+  // The choice between the kernel of the operator, the backend fallback and
+  // the catch-all kernel is made at registration time, see
+  // DispatchTable::lookupResolved.
+  const KernelFunction* kernel = dispatchTable.lookupResolved(dispatchKey);
+  if (C10_LIKELY(nullptr != kernel)) {
+    return *kernel;
   }
 
   reportError(dispatchTable, dispatchKey);
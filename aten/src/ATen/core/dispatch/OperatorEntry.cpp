@@ -135,6 +135,11 @@ void OperatorEntry::deregisterKernel_(
   updateDispatchTable_(dispatch_key);
 }
 
+void OperatorEntry::setBackendFallbacks(const KernelFunctionTable& backendFallbackKernels, DispatchKeySet backendsWithoutFallthrough) {
+  std::unique_lock<std::mutex> lock(kernelsMutex_);
+  dispatchTable_.setBackendFallbacks(backendFallbackKernels, backendsWithoutFallthrough);
+}
+
 void OperatorEntry::updateDispatchTable_(c10::optional<DispatchKey> dispatch_key) {
   // precondition: kernelsMutex_ is locked
 
@@ -161,6 +166,7 @@ void OperatorEntry::checkInvariants() const {
   }
   TORCH_INTERNAL_ASSERT(schema_.has_value() == debug_.has_value());
   TORCH_INTERNAL_ASSERT(name_ == dispatchTable_.operatorName());
+  dispatchTable_.checkInvariants();
   TORCH_INTERNAL_ASSERT(kernels_.find(DispatchKey::Undefined) == kernels_.end());
   for (const auto& kv : kernels_) {
     auto mb_dispatch_key = kv.first;
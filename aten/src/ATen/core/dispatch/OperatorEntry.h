@@ -86,6 +86,10 @@ public:
   std::list<KernelEntry>::iterator registerKernel(c10::optional<DispatchKey> dispatch_key, KernelFunction kernel, c10::optional<CppSignature> cpp_signature, std::unique_ptr<FunctionSchema> inferred_function_schema, std::string debug);
   void deregisterKernel_(c10::optional<DispatchKey> dispatch_key, std::list<KernelEntry>::iterator kernel);
 
+  // Called by the Dispatcher when the operator is created and whenever a
+  // backend fallback is (de)registered, see DispatchTable::setBackendFallbacks
+  void setBackendFallbacks(const KernelFunctionTable& backendFallbackKernels, DispatchKeySet backendsWithoutFallthrough);
+
   void updateSchemaAliasAnalysis(AliasAnalysisKind a) {
     TORCH_INTERNAL_ASSERT(schema_.has_value());
     schema_->setAliasAnalysis(a);
@@ -794,6 +794,47 @@ TEST(OperatorRegistrationTest, whenRegisteringBackendFallbackKernelAndCatchallKe
   EXPECT_EQ("hello _test::dummy", stack[1].toString()->string());
 }
 
+TEST(OperatorRegistrationTest, givenOpWithCatchallKernel_whenRegisteringBackendFallbackKernelAfterwards_thenCallsFallbackKernel) {
+  auto registrar1 = c10::RegisterOperators().op("_test::dummy(Tensor dummy, str input) -> ()", c10::RegisterOperators::options()
+      .catchAllKernel([] (Tensor, std::string) {
+        called = true;
+      }));
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  {
+    auto registrar = c10::Dispatcher::singleton().registerFallback(c10::DispatchKey::CPU, c10::KernelFunction::makeFromBoxedFunction<&backend_fallback_kernel>(), "");
+
+    called = false;
+    auto stack = callOp(*op, dummyTensor(c10::DispatchKey::CPU), "hello ");
+    EXPECT_FALSE(called);
+    EXPECT_EQ("hello _test::dummy", stack[1].toString()->string());
+    c10::Dispatcher::singleton().checkInvariants();
+  }
+
+  // the fallback is gone, so the call goes back to the catch-all kernel
+  called = false;
+  callOp(*op, dummyTensor(c10::DispatchKey::CPU), "hello ");
+  EXPECT_TRUE(called);
+  c10::Dispatcher::singleton().checkInvariants();
+}
+
+TEST(OperatorRegistrationTest, givenOp_whenRegisteringFallthroughBackendFallbackAfterwards_thenFallsThroughToNextKernel) {
+  auto registrar1 = c10::RegisterOperators().op("_test::dummy(Tensor dummy, str input) -> ()", c10::RegisterOperators::options()
+      .kernel(c10::DispatchKey::CPU, [] (Tensor, std::string) {
+        called = true;
+      }));
+  auto op = Dispatcher::singleton().findSchema({"_test::dummy", ""});
+  ASSERT_TRUE(op.has_value());
+
+  auto registrar = c10::Dispatcher::singleton().registerFallback(c10::DispatchKey::XLA, c10::KernelFunction::makeFallthrough(), "");
+
+  called = false;
+  callOp(*op, dummyTensor(c10::DispatchKeySet({c10::DispatchKey::XLA, c10::DispatchKey::CPU})), "hello ");
+  EXPECT_TRUE(called);
+  c10::Dispatcher::singleton().checkInvariants();
+}
+
 bool called_autograd = false;
 bool called_nonautograd = false;
 
@@ -6,6 +6,11 @@
 #include <ATen/cpu/vec256/intrinsics.h>
 
 #include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#include <ATen/cpu/vec512/vec512_bfloat16.h>
+#include <ATen/cpu/vec512/vec512_double.h>
+#include <ATen/cpu/vec512/vec512_int.h>
+#include <ATen/cpu/vec512/vec512_qint.h>
 #include <ATen/cpu/vec256/vec256_float.h>
 #include <ATen/cpu/vec256/vec256_bfloat16.h>
 #include <ATen/cpu/vec256/vec256_double.h>
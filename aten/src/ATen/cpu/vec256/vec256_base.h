@@ -41,6 +41,16 @@
 #define __at_align32__
 #endif
 
+// Vec256<T> is the vector type of the CPU capability a kernel is compiled
+// for. It is 256 bits wide, except in the AVX512 kernels where the
+// specializations of ATen/cpu/vec512 make it 512 bits wide, so code written
+// against Vec256<T>::size() gets the wider registers for free.
+#ifdef CPU_CAPABILITY_AVX512
+#define VECTOR_WIDTH 64
+#else
+#define VECTOR_WIDTH 32
+#endif
+
 namespace at {
 namespace vec256 {
 // See Note [Acceptable use of anonymous namespace in header]
@@ -74,7 +84,7 @@ using int_same_size_t = typename int_of_size<sizeof(T)>::type;
 template <class T>
 struct Vec256 {
 private:
-  __at_align32__ T values[32 / sizeof(T)];
+  __at_align32__ T values[VECTOR_WIDTH / sizeof(T)];
 public:
   using value_type = T;
   // Note [constexpr static function to avoid odr-usage compiler bug]
@@ -110,7 +120,7 @@ public:
   // identifier is odr-used or not, and in any case it's hard to tell if
   // a variable is odr-used or not.  So best to just cut the problem at the root.
   static constexpr int size() {
-    return 32 / sizeof(T);
+    return VECTOR_WIDTH / sizeof(T);
   }
   Vec256() : values{0} {}
   Vec256(T val) {
@@ -181,7 +191,7 @@ public:
   }
   static Vec256<T> loadu(const void* ptr) {
     Vec256 vec;
-    std::memcpy(vec.values, ptr, 32);
+    std::memcpy(vec.values, ptr, VECTOR_WIDTH);
     return vec;
   }
   static Vec256<T> loadu(const void* ptr, int64_t count) {
@@ -688,7 +698,7 @@ inline Vec256<T> operator^(const Vec256<T>& a, const Vec256<T>& b) {
 
 template<class T, typename Op>
 static inline Vec256<T> bitwise_binary_op(const Vec256<T> &a, const Vec256<T> &b, Op op) {
-  static constexpr uint32_t element_no = 32 / sizeof(intmax_t);
+  static constexpr uint32_t element_no = VECTOR_WIDTH / sizeof(intmax_t);
   __at_align32__ intmax_t buffer[element_no];
   const intmax_t *a_ptr = reinterpret_cast<const intmax_t*>((const T*) a);
   const intmax_t *b_ptr = reinterpret_cast<const intmax_t*>((const T*) b);
@@ -5,16 +5,21 @@
 
 #include <ATen/cpu/vec256/intrinsics.h>
 #include <ATen/cpu/vec256/vec256_base.h>
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#include <ATen/cpu/vec256/vec256_float.h>
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 #include <sleef.h>
 #endif
 
+#include <tuple>
+
 namespace at {
 namespace vec256 {
 // See Note [Acceptable use of anonymous namespace in header]
 namespace {
 
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+// The 256-bit conversions are also available to the AVX512 kernels, for
+// data that only fills half a register.
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
 
 static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
   __m128i lo = _mm256_extractf128_si256(a, 0);
@@ -50,6 +55,10 @@ static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
   return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11        01        10        00
 }
 
+#endif
+
+#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+
 template <> class Vec256<BFloat16> {
 private:
   __m256i values;
@@ -573,6 +582,72 @@ Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a,
   return cvtfp32_bf16(o1, o2);
 }
 
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  __m256 o1, o2;
+  cvtbf16_fp32(__m256i(a), o1, o2);
+  return std::make_tuple(o1, o2);
+}
+
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& a, const Vec256<float>& b) {
+  return cvtfp32_bf16(__m256(a), __m256(b));
+}
+
+template <>
+inline void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    __m256 o1, o2;
+    cvtbf16_fp32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), o1, o2);
+    _mm256_storeu_ps(dst + i, o1);
+    _mm256_storeu_ps(dst + i + Vec256<float>::size(), o2);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    __m256i o = cvtfp32_bf16(_mm256_loadu_ps(src + i), _mm256_loadu_ps(src + i + Vec256<float>::size()));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), o);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<BFloat16>(src[i]);
+  }
+}
+
+#elif !defined(CPU_CAPABILITY_AVX512)
+
+// Without AVX2, Vec256<BFloat16> holds 16 BFloat16 values and Vec256<float>
+// 8 floats, as with it, so the conversions split and join the same way.
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  constexpr int64_t K = Vec256<BFloat16>::size();
+  __at_align32__ BFloat16 arr[K];
+  __at_align32__ float arr2[K];
+  a.store(arr);
+  convert(arr, arr2, K);
+  return std::make_tuple(
+      Vec256<float>::loadu(arr2),
+      Vec256<float>::loadu(arr2 + Vec256<float>::size()));
+}
+
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& a, const Vec256<float>& b) {
+  constexpr int64_t K = Vec256<BFloat16>::size();
+  __at_align32__ float arr[K];
+  __at_align32__ BFloat16 arr2[K];
+  a.store(arr);
+  b.store(arr + Vec256<float>::size());
+  convert(arr, arr2, K);
+  return Vec256<BFloat16>::loadu(arr2);
+}
+
 #endif
 
+// Loads 2 * Vec256<float>::size() BFloat16 values as floats.
+inline void load_fp32_from_bf16(const BFloat16* data, Vec256<float>& out1, Vec256<float>& out2) {
+  std::tie(out1, out2) = convert_bfloat16_float(Vec256<BFloat16>::loadu(data));
+}
+
 }}}
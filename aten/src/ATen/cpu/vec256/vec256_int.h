@@ -29,7 +29,7 @@ public:
   }
 };
 
-#else
+#elif !defined(CPU_CAPABILITY_AVX512)
 
 struct Vec256i {};  // dummy definition to make Vec256i always defined
 
@@ -0,0 +1,507 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#ifdef CPU_CAPABILITY_AVX512
+#include <sleef.h>
+#endif
+
+#include <tuple>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#ifdef CPU_CAPABILITY_AVX512
+
+static inline void cvtbf16_fp32(const __m512i& a, __m512& o1, __m512& o2) {
+  __m256i lo = _mm512_extracti64x4_epi64(a, 0);
+  __m256i hi = _mm512_extracti64x4_epi64(a, 1);
+  o1 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(lo), 16));
+  o2 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(hi), 16));
+}
+
+static inline __m256i cvtfp32_bf16(const __m512& a) {
+  __m512i x = _mm512_castps_si512(a);
+  __m512i ones = _mm512_set1_epi32(0x1);
+  __m512i vec_bias = _mm512_set1_epi32(0x7fff);
+  // uint32_t lsb = (input >> 16) & 1;
+  auto t = _mm512_and_si512(_mm512_srli_epi32(x, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t = _mm512_add_epi32(t, vec_bias);
+  // input += rounding_bias;
+  t = _mm512_add_epi32(t, x);
+  // input = input >> 16;
+  t = _mm512_srli_epi32(t, 16);
+  // Check NaN before converting back to bf16
+  auto ordered = _mm512_cmp_ps_mask(a, a, _CMP_ORD_Q);
+  t = _mm512_mask_blend_epi32(ordered, _mm512_set1_epi32(0x7fc0), t);
+  // Unlike _mm256_packus_epi32, the narrowing keeps the lanes in order.
+  return _mm512_cvtepi32_epi16(t);
+}
+
+static inline __m512i cvtfp32_bf16(const __m512& a, const __m512& b) {
+  return _mm512_inserti64x4(_mm512_castsi256_si512(cvtfp32_bf16(a)), cvtfp32_bf16(b), 1);
+}
+
+template <> class Vec256<BFloat16> {
+private:
+  __m512i values;
+public:
+  using value_type = uint16_t;
+  static constexpr int size() {
+    return 32;
+  }
+  Vec256() {}
+  Vec256(__m512i v) : values(v) {}
+  Vec256(BFloat16 val) {
+    value_type uw = val.x;
+    values = _mm512_set1_epi16(uw);
+  }
+  operator __m512i() const {
+    return values;
+  }
+  BFloat16& operator[](int idx) = delete;
+  const BFloat16& operator[](int idx) const  = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmpeq_epi16_mask(values, _mm512_set1_epi16(0));
+  }
+  static Vec256<BFloat16> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec256<BFloat16> loadu(const void* ptr, int16_t count) {
+    auto mask = static_cast<__mmask32>((1ULL << count) - 1);
+    return _mm512_maskz_loadu_epi16(mask, ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      auto mask = static_cast<__mmask32>((1ULL << count) - 1);
+      _mm512_mask_storeu_epi16(ptr, mask, values);
+    }
+  }
+  template <int64_t mask>
+  static Vec256<BFloat16> blend(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+    return _mm512_mask_blend_epi16(static_cast<__mmask32>(mask), a.values, b.values);
+  }
+  static Vec256<BFloat16> blendv(const Vec256<BFloat16>& a,
+      const Vec256<BFloat16>& b, const Vec256<BFloat16>& mask) {
+    return _mm512_mask_blend_epi16(_mm512_movepi16_mask(mask.values), a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec256<BFloat16> arange(BFloat16 base = 0.f, step_t step = static_cast<step_t>(1)) {
+    __at_align32__ BFloat16 tmp_values[size()];
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec256<BFloat16> set(const Vec256<BFloat16>& a,
+      const Vec256<BFloat16>& b, int64_t count = size()) {
+    auto mask = static_cast<__mmask32>((1ULL << count) - 1);
+    return _mm512_mask_blend_epi16(mask, a.values, b.values);
+  }
+  Vec256<BFloat16> map(const __m512 (*vop)(__m512)) const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = vop(lo);
+    auto o2 = vop(hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> abs() const {
+    // Clearing the sign bit is exact, no need to go through float.
+    return _mm512_and_si512(values, _mm512_set1_epi16(0x7fff));
+  }
+  Vec256<BFloat16> angle() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec256<BFloat16> real() const {
+    return *this;
+  }
+  Vec256<BFloat16> imag() const {
+    return _mm512_set1_epi16(0);
+  }
+  Vec256<BFloat16> conj() const {
+    return *this;
+  }
+  Vec256<BFloat16> acos() const {
+    return map(Sleef_acosf16_u10);
+  }
+  Vec256<BFloat16> asin() const {
+    return map(Sleef_asinf16_u10);
+  }
+  Vec256<BFloat16> atan() const {
+    return map(Sleef_atanf16_u10);
+  }
+  Vec256<BFloat16> atan2(const Vec256<BFloat16> &b) const {
+    __m512 lo, hi;
+    __m512 b1, b2;
+    cvtbf16_fp32(values, lo, hi);
+    cvtbf16_fp32(b.values, b1, b2);
+    auto o1 = Sleef_atan2f16_u10(lo, b1);
+    auto o2 = Sleef_atan2f16_u10(hi, b2);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> erf() const {
+    return map(Sleef_erff16_u10);
+  }
+  Vec256<BFloat16> erfc() const {
+    return map(Sleef_erfcf16_u15);
+  }
+  Vec256<BFloat16> erfinv() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    __at_align32__ float tmp[2 * Vec256<float>::size()];
+    _mm512_storeu_ps(tmp, lo);
+    _mm512_storeu_ps(tmp + Vec256<float>::size(), hi);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = calc_erfinv(tmp[i]);
+    }
+    return cvtfp32_bf16(_mm512_loadu_ps(tmp), _mm512_loadu_ps(tmp + Vec256<float>::size()));
+  }
+  Vec256<BFloat16> exp() const {
+    return map(Sleef_expf16_u10);
+  }
+  Vec256<BFloat16> expm1() const {
+    return map(Sleef_expm1f16_u10);
+  }
+  Vec256<BFloat16> fmod(const Vec256<BFloat16> & q) const {
+    __m512 x_lo, x_hi;
+    cvtbf16_fp32(values, x_lo, x_hi);
+    __m512 q_lo, q_hi;
+    cvtbf16_fp32(q.values, q_lo, q_hi);
+    auto o1 = Sleef_fmodf16(x_lo, q_lo);
+    auto o2 = Sleef_fmodf16(x_hi, q_hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> log() const {
+    return map(Sleef_logf16_u10);
+  }
+  Vec256<BFloat16> log2() const {
+    return map(Sleef_log2f16_u10);
+  }
+  Vec256<BFloat16> log10() const {
+    return map(Sleef_log10f16_u10);
+  }
+  Vec256<BFloat16> log1p() const {
+    return map(Sleef_log1pf16_u10);
+  }
+  Vec256<BFloat16> frac() const;
+  Vec256<BFloat16> sin() const {
+    return map(Sleef_sinf16_u10);
+  }
+  Vec256<BFloat16> sinh() const {
+    return map(Sleef_sinhf16_u10);
+  }
+  Vec256<BFloat16> cos() const {
+    return map(Sleef_cosf16_u10);
+  }
+  Vec256<BFloat16> cosh() const {
+    return map(Sleef_coshf16_u10);
+  }
+  Vec256<BFloat16> ceil() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> floor() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> neg() const {
+    // Flipping the sign bit is exact, no need to go through float.
+    return _mm512_xor_si512(values, _mm512_set1_epi16(static_cast<int16_t>(0x8000)));
+  }
+  Vec256<BFloat16> round() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> tan() const {
+    return map(Sleef_tanf16_u10);
+  }
+  Vec256<BFloat16> tanh() const {
+    return map(Sleef_tanhf16_u10);
+  }
+  Vec256<BFloat16> trunc() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_roundscale_ps(lo, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    auto o2 = _mm512_roundscale_ps(hi, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> lgamma() const {
+    return map(Sleef_lgammaf16_u10);
+  }
+  Vec256<BFloat16> sqrt() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = _mm512_sqrt_ps(lo);
+    auto o2 = _mm512_sqrt_ps(hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> reciprocal() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto ones = _mm512_set1_ps(1);
+    auto o1 = _mm512_div_ps(ones, lo);
+    auto o2 = _mm512_div_ps(ones, hi);
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> rsqrt() const {
+    __m512 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto ones = _mm512_set1_ps(1);
+    auto o1 = _mm512_div_ps(ones, _mm512_sqrt_ps(lo));
+    auto o2 = _mm512_div_ps(ones, _mm512_sqrt_ps(hi));
+    return cvtfp32_bf16(o1, o2);
+  }
+  Vec256<BFloat16> pow(const Vec256<BFloat16> &b) const {
+    __m512 lo, hi;
+    __m512 b1, b2;
+    cvtbf16_fp32(values, lo, hi);
+    cvtbf16_fp32(b.values, b1, b2);
+    auto o1 = Sleef_powf16_u10(lo, b1);
+    auto o2 = Sleef_powf16_u10(hi, b2);
+    return cvtfp32_bf16(o1, o2);
+  }
+
+  Vec256<BFloat16> inline operator>(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> inline operator<(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> inline operator>=(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> inline operator<=(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> inline operator==(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> inline operator!=(const Vec256<BFloat16>& other) const;
+
+  Vec256<BFloat16> eq(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> ne(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> gt(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> ge(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> lt(const Vec256<BFloat16>& other) const;
+  Vec256<BFloat16> le(const Vec256<BFloat16>& other) const;
+};
+
+template<typename Op>
+Vec256<BFloat16> static inline bfloat16_binary_op_as_fp32(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b, Op op) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  auto o1 = op(a_lo, b_lo);
+  auto o2 = op(a_hi, b_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+// Comparisons are made on the float values and produce all-ones 16-bit lanes
+// where true, like the AVX2 version.
+template <int predicate>
+Vec256<BFloat16> static inline bfloat16_compare_as_fp32(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  __mmask32 lo = _mm512_cmp_ps_mask(a_lo, b_lo, predicate);
+  __mmask32 hi = _mm512_cmp_ps_mask(a_hi, b_hi, predicate);
+  return _mm512_movm_epi16(lo | (hi << 16));
+}
+
+Vec256<BFloat16> inline Vec256<BFloat16>::operator>(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_GT_OQ>(*this, other);
+}
+Vec256<BFloat16> inline Vec256<BFloat16>::operator<(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_LT_OQ>(*this, other);
+}
+Vec256<BFloat16> inline Vec256<BFloat16>::operator>=(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_GE_OQ>(*this, other);
+}
+Vec256<BFloat16> inline Vec256<BFloat16>::operator<=(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_LE_OQ>(*this, other);
+}
+Vec256<BFloat16> inline Vec256<BFloat16>::operator==(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_EQ_OQ>(*this, other);
+}
+Vec256<BFloat16> inline Vec256<BFloat16>::operator!=(const Vec256<BFloat16>& other) const {
+  return bfloat16_compare_as_fp32<_CMP_NEQ_OQ>(*this, other);
+}
+
+Vec256<BFloat16> inline operator+(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_add_ps(x, y); });
+}
+Vec256<BFloat16> inline operator-(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_sub_ps(x, y); });
+}
+Vec256<BFloat16> inline operator*(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_mul_ps(x, y); });
+}
+Vec256<BFloat16> inline operator/(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) { return _mm512_div_ps(x, y); });
+}
+
+Vec256<BFloat16> inline operator&(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm512_and_si512(a, b);
+}
+Vec256<BFloat16> inline operator|(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm512_or_si512(a, b);
+}
+Vec256<BFloat16> inline operator^(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm512_xor_si512(a, b);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::eq(const Vec256<BFloat16>& other) const {
+  return (*this == other) & Vec256<BFloat16>(1.0f);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::ne(const Vec256<BFloat16>& other) const {
+  return (*this != other) & Vec256<BFloat16>(1.0f);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::gt(const Vec256<BFloat16>& other) const {
+  return (*this > other) & Vec256<BFloat16>(1.0f);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::ge(const Vec256<BFloat16>& other) const {
+  return (*this >= other) & Vec256<BFloat16>(1.0f);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::lt(const Vec256<BFloat16>& other) const {
+  return (*this < other) & Vec256<BFloat16>(1.0f);
+}
+
+Vec256<BFloat16> Vec256<BFloat16>::le(const Vec256<BFloat16>& other) const {
+  return (*this <= other) & Vec256<BFloat16>(1.0f);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec256<BFloat16> Vec256<BFloat16>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<BFloat16> inline maximum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) {
+    auto max = _mm512_max_ps(x, y);
+    auto isnan = _mm512_cmp_ps_mask(x, y, _CMP_UNORD_Q);
+    return _mm512_mask_blend_ps(isnan, max, _mm512_set1_ps(NAN));
+  });
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec256<BFloat16> inline minimum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return bfloat16_binary_op_as_fp32(a, b, [](const __m512& x, const __m512& y) {
+    auto min = _mm512_min_ps(x, y);
+    auto isnan = _mm512_cmp_ps_mask(x, y, _CMP_UNORD_Q);
+    return _mm512_mask_blend_ps(isnan, min, _mm512_set1_ps(NAN));
+  });
+}
+
+template <>
+Vec256<BFloat16> inline clamp(const Vec256<BFloat16>& a,
+    const Vec256<BFloat16>& min, const Vec256<BFloat16>& max) {
+  __m512 a_lo, a_hi;
+  __m512 min_lo, min_hi;
+  __m512 max_lo, max_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(min), min_lo, min_hi);
+  cvtbf16_fp32(__m512i(max), max_lo, max_hi);
+  auto o1 = _mm512_min_ps(max_lo, _mm512_max_ps(min_lo, a_lo));
+  auto o2 = _mm512_min_ps(max_hi, _mm512_max_ps(min_hi, a_hi));
+  return cvtfp32_bf16(o1, o2);
+}
+
+template <>
+Vec256<BFloat16> inline clamp_max(const Vec256<BFloat16>& a, const Vec256<BFloat16>& max) {
+  return bfloat16_binary_op_as_fp32(a, max, [](const __m512& x, const __m512& y) {
+    return _mm512_min_ps(y, x);
+  });
+}
+
+template <>
+Vec256<BFloat16> inline clamp_min(const Vec256<BFloat16>& a, const Vec256<BFloat16>& min) {
+  return bfloat16_binary_op_as_fp32(a, min, [](const __m512& x, const __m512& y) {
+    return _mm512_max_ps(y, x);
+  });
+}
+
+template <>
+inline void convert(const BFloat16* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<BFloat16>::size()); i += Vec256<BFloat16>::size()) {
+    _mm512_storeu_si512(dst + i, _mm512_loadu_si512(src + i));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a,
+    const Vec256<BFloat16>& b, const Vec256<BFloat16>& c) {
+  __m512 a_lo, a_hi;
+  __m512 b_lo, b_hi;
+  __m512 c_lo, c_hi;
+  cvtbf16_fp32(__m512i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m512i(b), b_lo, b_hi);
+  cvtbf16_fp32(__m512i(c), c_lo, c_hi);
+  auto o1 = _mm512_fmadd_ps(a_lo, b_lo, c_lo);
+  auto o2 = _mm512_fmadd_ps(a_hi, b_hi, c_hi);
+  return cvtfp32_bf16(o1, o2);
+}
+
+inline std::tuple<Vec256<float>, Vec256<float>> convert_bfloat16_float(const Vec256<BFloat16>& a) {
+  __m512 o1, o2;
+  cvtbf16_fp32(__m512i(a), o1, o2);
+  return std::make_tuple(o1, o2);
+}
+
+inline Vec256<BFloat16> convert_float_bfloat16(const Vec256<float>& a, const Vec256<float>& b) {
+  return cvtfp32_bf16(__m512(a), __m512(b));
+}
+
+template <>
+inline void convert(const BFloat16* src, float* dst, int64_t n) {
+  int64_t i;
+  // Half a Vec256<BFloat16> fills a Vec256<float>.
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    auto vsrc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(vsrc), 16)));
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const float* src, BFloat16* dst, int64_t n) {
+  int64_t i;
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    __m256i o = cvtfp32_bf16(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), o);
+  }
+  for (; i < n; i++) {
+    dst[i] = static_cast<BFloat16>(src[i]);
+  }
+}
+
+#endif
+
+}}}
@@ -0,0 +1,484 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#include <ATen/cpu/vec512/vec512_int.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+#include <c10/util/qint32.h>
+#include <c10/util/qint8.h>
+#include <c10/util/quint8.h>
+
+#include <array>
+
+// 512-bit versions of the quantized Vec256 types, see vec256_qint.h for how
+// they are used. With 16 float lanes per Vec256<float> the conversions stay
+// the same as with AVX2:
+//  Vec256<qint8> (64 lanes) -> 4x Vec256<float>
+//  Vec256<quint8> (64 lanes) -> 4x Vec256<float>
+//  Vec256<qint32> (16 lanes) -> 1x Vec256<float>
+
+namespace at {
+namespace vec256 {
+namespace {
+
+#ifdef CPU_CAPABILITY_AVX512
+
+struct Vec256qi {
+ protected:
+  __m512i vals __attribute__((aligned(64)));
+
+ public:
+  Vec256qi() {}
+  Vec256qi(__m512i v) : vals(v) {}
+  operator __m512i() const {
+    return vals;
+  }
+};
+
+// Widens the i-th group of 16 8-bit lanes to int32.
+template <typename T>
+inline __m512i cvt8_epi32(__m512i v, int i);
+
+template <>
+inline __m512i cvt8_epi32<int8_t>(__m512i v, int i) {
+  __m128i chunk;
+  switch (i) {
+    case 0: chunk = _mm512_extracti32x4_epi32(v, 0); break;
+    case 1: chunk = _mm512_extracti32x4_epi32(v, 1); break;
+    case 2: chunk = _mm512_extracti32x4_epi32(v, 2); break;
+    default: chunk = _mm512_extracti32x4_epi32(v, 3); break;
+  }
+  return _mm512_cvtepi8_epi32(chunk);
+}
+
+template <>
+inline __m512i cvt8_epi32<uint8_t>(__m512i v, int i) {
+  __m128i chunk;
+  switch (i) {
+    case 0: chunk = _mm512_extracti32x4_epi32(v, 0); break;
+    case 1: chunk = _mm512_extracti32x4_epi32(v, 1); break;
+    case 2: chunk = _mm512_extracti32x4_epi32(v, 2); break;
+    default: chunk = _mm512_extracti32x4_epi32(v, 3); break;
+  }
+  return _mm512_cvtepu8_epi32(chunk);
+}
+
+// Clamps four vectors of int32 to the range of T and packs them, in order,
+// into one vector of 8-bit lanes.
+template <typename T>
+inline __m512i pack_and_clamp_epi32(
+    __m512i x, __m512i y, __m512i z, __m512i w) {
+  const __m512i min_v = _mm512_set1_epi32(std::numeric_limits<T>::min());
+  const __m512i max_v = _mm512_set1_epi32(std::numeric_limits<T>::max());
+  x = _mm512_max_epi32(min_v, _mm512_min_epi32(max_v, x));
+  y = _mm512_max_epi32(min_v, _mm512_min_epi32(max_v, y));
+  z = _mm512_max_epi32(min_v, _mm512_min_epi32(max_v, z));
+  w = _mm512_max_epi32(min_v, _mm512_min_epi32(max_v, w));
+  // Unlike the AVX2 packs, the truncating conversions keep the lanes in
+  // order, so no permute is needed afterwards.
+  __m512i result = _mm512_castsi128_si512(_mm512_cvtepi32_epi8(x));
+  result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(y), 1);
+  result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(z), 2);
+  result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(w), 3);
+  return result;
+}
+
+template <typename T>
+inline __m512i QuantizeAvx512(
+    const std::array<Vec256<float>, 4>& rhs,
+    float inverse_scale,
+    int32_t zero_point) {
+  // This is the largest int32 value < int32_max exactly representable in float
+  constexpr int32_t int32_float_max_val =
+      std::numeric_limits<int32_t>::max() - 127;
+  const __m512 inverse_scale_v = _mm512_set1_ps(inverse_scale);
+  const __m512 int32_float_max_v = _mm512_set1_ps(int32_float_max_val);
+  const __m512i zero_point_v = _mm512_set1_epi32(zero_point);
+  __m512i rounded[4];
+  for (int i = 0; i < 4; ++i) {
+    __m512 transformed = _mm512_mul_ps(rhs[i], inverse_scale_v);
+    // If the floating point value is greater than int32_max,
+    // _mm512_cvtps_epi32 converts them to -ve. Clip at int32_float_max_val to
+    // avoid this.
+    transformed = _mm512_min_ps(transformed, int32_float_max_v);
+    // Rounds to nearest even, like QuantizeAvx2.
+    rounded[i] = _mm512_add_epi32(_mm512_cvtps_epi32(transformed), zero_point_v);
+  }
+  return pack_and_clamp_epi32<T>(rounded[0], rounded[1], rounded[2], rounded[3]);
+}
+
+// Quantizes len floats from src into dst, like the pointer based
+// QuantizeAvx2 in vec256_qint.h but 64 lanes at a time.
+template <typename T>
+inline void QuantizeAvx512(
+    const float* src,
+    typename T::underlying* dst,
+    int len,
+    float inverse_scale,
+    int64_t zero_point) {
+  constexpr int VLEN = Vec256<float>::size();
+  int i = 0;
+  for (; i + 4 * VLEN <= len; i += 4 * VLEN) {
+    const std::array<Vec256<float>, 4> vals = {
+        Vec256<float>::loadu(src + i),
+        Vec256<float>::loadu(src + i + VLEN),
+        Vec256<float>::loadu(src + i + 2 * VLEN),
+        Vec256<float>::loadu(src + i + 3 * VLEN)};
+    _mm512_storeu_si512(
+        reinterpret_cast<__m512i*>(dst + i),
+        QuantizeAvx512<typename T::underlying>(
+            vals, inverse_scale, zero_point));
+  }
+  at::native::quantize_vec<T>(
+      1.0f / inverse_scale,
+      zero_point,
+      src + i,
+      reinterpret_cast<T*>(dst + i),
+      len - i);
+}
+
+template <typename T>
+inline __m512i RequantizeAvx512(
+    const std::array<Vec256<c10::qint32>, 4>& inp,
+    float multiplier,
+    int32_t zero_point);
+
+template<>
+struct Vec256<c10::qint32> : public Vec256qi {
+    static constexpr int size() {
+        return 16;
+    }
+
+    static constexpr int float_num_vecs() {
+        return 1;
+    }
+
+    static constexpr int int_num_vecs() {
+        return 1;
+    }
+
+    using float_vec_return_type = std::array<Vec256<float>, 1>;
+    using int_vec_return_type = std::array<Vec256<c10::qint32>, 1>;
+    using value_type = c10::qint32::underlying;
+
+ public:
+    using Vec256qi::Vec256qi;
+    Vec256() {}
+
+    Vec256(__m512i vals_) { vals = vals_;}
+
+    // Broadcast constructor
+    Vec256(const c10::qint32& val) {
+        value_type uw = val.val_;
+        vals = _mm512_set1_epi32(uw);
+    }
+
+    void store(void* ptr, int count = size()) const {
+      if (count != size()) {
+        memcpy(ptr, &vals, count * sizeof(value_type));
+      } else {
+        _mm512_storeu_si512(ptr, vals);
+      }
+    }
+
+    static Vec256<c10::qint32> loadu(const void* ptr) {
+        return Vec256<c10::qint32>(ptr);
+    }
+
+    float_vec_return_type dequantize(
+        Vec256<float> scale,
+        Vec256<float> zero_point,
+        Vec256<float> scale_zp_premul) const {
+      __m512 float_vals = _mm512_cvtepi32_ps(vals);
+      return {vec256::fmadd(scale, Vec256<float>(float_vals), scale_zp_premul)};
+    }
+
+    static Vec256<c10::qint32> quantize(
+        const float_vec_return_type& rhs,
+        float scale,
+        int32_t zero_point,
+        float inverse_scale) {
+      Vec256<c10::qint32> retval;
+      auto rhs_data = (__m512)rhs[0];
+      at::native::quantize_vec<c10::qint32, /*precision=*/32>(
+          scale, zero_point, (float*)&rhs_data, (c10::qint32*)&retval.vals, 16);
+      return retval;
+    }
+
+    Vec256<c10::qint32> maximum(Vec256<c10::qint32> b) const {
+      return _mm512_max_epi32(vals, b.vals);
+    }
+
+    Vec256<c10::qint32> minimum(Vec256<c10::qint32> b) const {
+      return _mm512_min_epi32(vals, b.vals);
+    }
+
+    Vec256<c10::qint32> relu(Vec256<c10::qint32> zero_point) const {
+        return maximum(zero_point);
+    }
+
+    Vec256<c10::qint32> relu6(
+        Vec256<c10::qint32> zero_point,
+        Vec256<c10::qint32> q_six) {
+      return _mm512_min_epi32(
+          _mm512_max_epi32(vals, zero_point.vals), q_six.vals);
+    }
+
+    int_vec_return_type widening_subtract(Vec256<c10::qint32> b) const {
+      return {_mm512_sub_epi32(vals, b)};
+    }
+
+    static Vec256<c10::qint32> requantize_from_int(
+        const int_vec_return_type& inp,
+        float multiplier,
+        int32_t zero_point) {
+      __m512 multiplier_v = _mm512_set1_ps(multiplier);
+      __m512i zero_point_v = _mm512_set1_epi32(zero_point);
+
+      __m512 scaled = _mm512_mul_ps(_mm512_cvtepi32_ps(inp[0]), multiplier_v);
+      __m512i rounded = _mm512_cvtps_epi32(scaled);
+      return _mm512_add_epi32(rounded, zero_point_v);
+    }
+
+    void dump() const {
+        for (size_t i = 0; i < size(); ++i) {
+          std::cout << ((int32_t*)&vals)[i] << " ";
+        }
+        std::cout << std::endl;
+    }
+ private:
+    // Load from memory constructor
+    Vec256(const void* ptr) {
+      vals = _mm512_loadu_si512(ptr);
+    }
+};
+
+template <>
+Vec256<c10::qint32> inline maximum(const Vec256<c10::qint32>& a, const Vec256<c10::qint32>& b) {
+  return a.maximum(b);
+}
+
+template <>
+Vec256<c10::qint32> inline operator*(
+    const Vec256<c10::qint32>& a,
+    const Vec256<c10::qint32>& b) {
+  return _mm512_mullo_epi32(a, b);
+}
+
+template <>
+Vec256<c10::qint32> inline operator+(
+    const Vec256<c10::qint32>& a,
+    const Vec256<c10::qint32>& b) {
+  return _mm512_add_epi32(a, b);
+}
+
+/*
+ * Convert values from int32 back to int8/uint8
+ */
+template <typename T>
+inline __m512i RequantizeAvx512(
+    const std::array<Vec256<c10::qint32>, 4>& inp,
+    float multiplier,
+    int32_t zero_point) {
+  static_assert(
+      std::is_same<T, int8_t>::value || std::is_same<T, uint8_t>::value,
+      "Only int8_t/uint8_t are supported");
+  const __m512 multiplier_v = _mm512_set1_ps(multiplier);
+  const __m512i zero_point_v = _mm512_set1_epi32(zero_point);
+  __m512i rounded[4];
+  for (int i = 0; i < 4; ++i) {
+    __m512 scaled = _mm512_mul_ps(_mm512_cvtepi32_ps(inp[i]), multiplier_v);
+    rounded[i] = _mm512_add_epi32(_mm512_cvtps_epi32(scaled), zero_point_v);
+  }
+  return pack_and_clamp_epi32<T>(rounded[0], rounded[1], rounded[2], rounded[3]);
+}
+
+// qint8 and quint8 only differ in the signedness of their 8-bit lanes, which
+// is handled by the T::underlying template arguments of the helpers above.
+template <typename T>
+struct Vec256Qint8Base : public Vec256qi {
+    static constexpr int size() {
+        return 64;
+    }
+
+    static constexpr int float_num_vecs() {
+        return 4;
+    }
+
+    static constexpr int int_num_vecs() {
+        return 4;
+    }
+
+    using float_vec_return_type = std::array<Vec256<float>, 4>;
+    using int_vec_return_type = std::array<Vec256<c10::qint32>, 4>;
+    using value_type = typename T::underlying;
+
+    Vec256Qint8Base() {}
+    Vec256Qint8Base(__m512i vals_) : Vec256qi(vals_) {}
+
+    void store(void* ptr, int count = size()) const {
+        if (count != size()) {
+            memcpy(ptr, &vals, count * sizeof(value_type));
+        } else {
+            _mm512_storeu_si512(ptr, vals);
+        }
+    }
+
+    float_vec_return_type dequantize(
+        Vec256<float> scale,
+        Vec256<float> zero_point,
+        Vec256<float> scale_zp_premul) const {
+      float_vec_return_type rv;
+      for (int i = 0; i < float_num_vecs(); ++i) {
+        __m512 float_vals = _mm512_cvtepi32_ps(cvt8_epi32<value_type>(vals, i));
+        rv[i] = vec256::fmadd(scale, Vec256<float>(float_vals), scale_zp_premul);
+      }
+      return rv;
+    }
+
+    int_vec_return_type widening_subtract(const Vec256Qint8Base<T>& b) const {
+      int_vec_return_type rv;
+      for (int i = 0; i < int_num_vecs(); ++i) {
+        rv[i] = _mm512_sub_epi32(
+            cvt8_epi32<value_type>(vals, i), cvt8_epi32<value_type>(b.vals, i));
+      }
+      return rv;
+    }
+
+    void dump() const {
+        for (size_t i = 0; i < size(); ++i) {
+            std::cout << (int)((value_type*)&vals)[i] << " ";
+        }
+        std::cout << std::endl;
+    }
+};
+
+template<>
+struct Vec256<c10::qint8> : public Vec256Qint8Base<c10::qint8> {
+    Vec256() {}
+    Vec256(__m512i vals_) : Vec256Qint8Base<c10::qint8>(vals_) {}
+
+    // Broadcast constructor
+    Vec256(const c10::qint8& val) {
+        value_type uw = val.val_;
+        vals = _mm512_set1_epi8(uw);
+    }
+
+    static Vec256<c10::qint8> loadu(const void* ptr) {
+        return Vec256<c10::qint8>(ptr);
+    }
+
+    static Vec256<c10::qint8> quantize(
+        const float_vec_return_type& rhs,
+        float scale,
+        int32_t zero_point,
+        float inverse_scale) {
+      return QuantizeAvx512<value_type>(rhs, inverse_scale, zero_point);
+    }
+
+    Vec256<c10::qint8> maximum(Vec256<c10::qint8> b) const {
+      return _mm512_max_epi8(vals, b.vals);
+    }
+
+    Vec256<c10::qint8> minimum(Vec256<c10::qint8> b) const {
+      return _mm512_min_epi8(vals, b.vals);
+    }
+
+    Vec256<c10::qint8> relu(Vec256<c10::qint8> zero_point) const {
+        return maximum(zero_point);
+    }
+
+    Vec256<c10::qint8> relu6(
+        Vec256<c10::qint8> zero_point,
+        Vec256<c10::qint8> q_six) {
+      return _mm512_min_epi8(
+          _mm512_max_epi8(vals, zero_point.vals), q_six.vals);
+    }
+
+    static Vec256<c10::qint8> requantize_from_int(
+        const int_vec_return_type& inp,
+        float multiplier,
+        int32_t zero_point) {
+      return RequantizeAvx512<value_type>(inp, multiplier, zero_point);
+    }
+
+ private:
+    // Load from memory constructor
+    Vec256(const void* ptr) {
+        vals = _mm512_loadu_si512(ptr);
+    }
+};
+
+template <>
+Vec256<c10::qint8> inline maximum(const Vec256<c10::qint8>& a, const Vec256<c10::qint8>& b) {
+  return a.maximum(b);
+}
+
+template<>
+struct Vec256<c10::quint8> : public Vec256Qint8Base<c10::quint8> {
+    Vec256() {}
+    Vec256(__m512i vals_) : Vec256Qint8Base<c10::quint8>(vals_) {}
+
+    // Broadcast constructor
+    Vec256(const c10::quint8& val) {
+        value_type uw = val.val_;
+        vals = _mm512_set1_epi8(uw);
+    }
+
+    static Vec256<c10::quint8> loadu(const void* ptr) {
+        return Vec256<c10::quint8>(ptr);
+    }
+
+    static Vec256<c10::quint8> quantize(
+        const float_vec_return_type& rhs,
+        float scale,
+        int32_t zero_point,
+        float inverse_scale) {
+      return QuantizeAvx512<value_type>(rhs, inverse_scale, zero_point);
+    }
+
+    Vec256<c10::quint8> maximum(Vec256<c10::quint8> b) const {
+      return _mm512_max_epu8(vals, b.vals);
+    }
+
+    Vec256<c10::quint8> minimum(Vec256<c10::quint8> b) const {
+      return _mm512_min_epu8(vals, b.vals);
+    }
+
+    Vec256<c10::quint8> relu(Vec256<c10::quint8> zero_point) const {
+        return maximum(zero_point);
+    }
+
+    Vec256<c10::quint8> relu6(
+        Vec256<c10::quint8> zero_point,
+        Vec256<c10::quint8> q_six) {
+      return _mm512_min_epu8(
+          _mm512_max_epu8(vals, zero_point.vals), q_six.vals);
+    }
+
+    static Vec256<c10::quint8> requantize_from_int(
+        const int_vec_return_type& inp,
+        float multiplier,
+        int32_t zero_point) {
+      return RequantizeAvx512<value_type>(inp, multiplier, zero_point);
+    }
+
+ private:
+    // Load from memory constructor
+    Vec256(const void* ptr) {
+        vals = _mm512_loadu_si512(ptr);
+    }
+};
+
+template <>
+Vec256<c10::quint8> inline maximum(const Vec256<c10::quint8>& a, const Vec256<c10::quint8>& b) {
+  return a.maximum(b);
+}
+
+#endif // CPU_CAPABILITY_AVX512
+
+}}}
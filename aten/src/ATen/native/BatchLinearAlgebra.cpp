@@ -10,6 +10,9 @@
 
 #include <TH/TH.h>  // for USE_LAPACK
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <vector>
 
 // First the required LAPACK implementations are registered here.
@@ -302,6 +305,204 @@ template<> void lapackLuSolve<float>(char trans, int n, int nrhs, float *a, int
 }
 #endif
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ batches ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// LAPACK routines take one matrix at a time, and run small ones on a single
+// thread, so the matrices of a batch are split among threads, each with a
+// workspace of its own. Matrices larger than this are left to run one at a
+// time, since LAPACK may parallelize them itself.
+constexpr int64_t kBatchParallelMaxSize = 128;
+
+// Calls f(begin, end) on ranges of the batch, in parallel for small matrices
+// of size n, with ranges of about GRAIN_SIZE operations (n^3 per matrix).
+template <typename F>
+static void parallel_for_batch(int64_t batch_size, int64_t n, const F& f) {
+  if (n > kBatchParallelMaxSize) {
+    f(0, batch_size);
+    return;
+  }
+  const int64_t matrix_cost = std::max<int64_t>(n * n * n, 1);
+  at::parallel_for(0, batch_size, std::max<int64_t>(internal::GRAIN_SIZE / matrix_cost, 1), f);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ small matrices ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// For tiny matrices the overhead of a LAPACK call (argument checks, blocking,
+// recursion) dominates, so real square matrices of size up to
+// kSmallMatrixMaxSize are factored by the kernels below instead, with the size
+// a compile time constant so that their loops are unrolled. They compute the
+// same factorizations as getrf, getrs and potrf, in the same column major
+// format and with the same pivots and infos.
+constexpr int64_t kSmallMatrixMaxSize = 8;
+
+template <typename scalar_t>
+static bool use_small_matrix_kernels(int64_t n) {
+  return std::is_floating_point<scalar_t>::value && n >= 1 && n <= kSmallMatrixMaxSize;
+}
+
+// Calls f(std::integral_constant<int, n>()) for 1 <= n <= kSmallMatrixMaxSize
+template <typename F>
+static void dispatch_small_matrix_size(int64_t n, const F& f) {
+  switch (n) {
+    case 1: f(std::integral_constant<int, 1>()); break;
+    case 2: f(std::integral_constant<int, 2>()); break;
+    case 3: f(std::integral_constant<int, 3>()); break;
+    case 4: f(std::integral_constant<int, 4>()); break;
+    case 5: f(std::integral_constant<int, 5>()); break;
+    case 6: f(std::integral_constant<int, 6>()); break;
+    case 7: f(std::integral_constant<int, 7>()); break;
+    case 8: f(std::integral_constant<int, 8>()); break;
+    default: TORCH_INTERNAL_ASSERT(false, "unexpected small matrix size ", n);
+  }
+}
+
+// LU factorization with partial pivoting (getf2)
+template <typename scalar_t, int n>
+static int small_lu(scalar_t* a, int* ipiv) {
+  int info = 0;
+  for (int j = 0; j < n; j++) {
+    int p = j;
+    for (int i = j + 1; i < n; i++) {
+      if (std::abs(a[j * n + i]) > std::abs(a[j * n + p])) {
+        p = i;
+      }
+    }
+    ipiv[j] = p + 1;
+    if (a[j * n + p] != scalar_t(0)) {
+      if (p != j) {
+        for (int k = 0; k < n; k++) {
+          std::swap(a[k * n + j], a[k * n + p]);
+        }
+      }
+      for (int i = j + 1; i < n; i++) {
+        a[j * n + i] /= a[j * n + j];
+      }
+    } else if (info == 0) {
+      info = j + 1;
+    }
+    for (int k = j + 1; k < n; k++) {
+      const scalar_t a_jk = a[k * n + j];
+      for (int i = j + 1; i < n; i++) {
+        a[k * n + i] -= a[j * n + i] * a_jk;
+      }
+    }
+  }
+  return info;
+}
+
+// Solves A X = B given the LU factorization of A (getrs), B is n x nrhs
+template <typename scalar_t, int n>
+static void small_lu_solve(const scalar_t* lu, const int* ipiv, scalar_t* b, int64_t nrhs) {
+  for (int64_t c = 0; c < nrhs; c++) {
+    scalar_t* x = b + c * n;
+    for (int i = 0; i < n; i++) {
+      std::swap(x[i], x[ipiv[i] - 1]);
+    }
+    for (int j = 0; j < n; j++) {
+      for (int i = j + 1; i < n; i++) {
+        x[i] -= lu[j * n + i] * x[j];
+      }
+    }
+    for (int j = n - 1; j >= 0; j--) {
+      x[j] /= lu[j * n + j];
+      for (int i = 0; i < j; i++) {
+        x[i] -= lu[j * n + i] * x[j];
+      }
+    }
+  }
+}
+
+// Cholesky factorization (potrf); only the triangle in use is written
+template <typename scalar_t, int n>
+static int small_cholesky(scalar_t* a, bool upper) {
+  // the element of the factor at (i, j) of its lower triangle; for the upper
+  // factor, that of its transpose
+  auto factor = [&](int i, int j) -> scalar_t& {
+    return upper ? a[i * n + j] : a[j * n + i];
+  };
+  for (int j = 0; j < n; j++) {
+    scalar_t diag = factor(j, j);
+    for (int k = 0; k < j; k++) {
+      diag -= factor(j, k) * factor(j, k);
+    }
+    if (!(diag > scalar_t(0))) {
+      factor(j, j) = diag;
+      return j + 1;
+    }
+    diag = std::sqrt(diag);
+    factor(j, j) = diag;
+    for (int i = j + 1; i < n; i++) {
+      scalar_t value = factor(i, j);
+      for (int k = 0; k < j; k++) {
+        value -= factor(i, k) * factor(j, k);
+      }
+      factor(i, j) = value / diag;
+    }
+  }
+  return 0;
+}
+
+// Entry points taking the size at run time; only real types use them.
+template <typename scalar_t, bool is_real = std::is_floating_point<scalar_t>::value>
+struct SmallMatrix {
+  static int lu(int64_t n, scalar_t* a, int* ipiv) {
+    TORCH_INTERNAL_ASSERT(false, "small matrix kernels only support real types");
+    return 0;
+  }
+  static void lu_solve(int64_t n, const scalar_t* lu, const int* ipiv, scalar_t* b, int64_t nrhs) {
+    TORCH_INTERNAL_ASSERT(false, "small matrix kernels only support real types");
+  }
+  static int inverse(int64_t n, scalar_t* a, int* ipiv) {
+    TORCH_INTERNAL_ASSERT(false, "small matrix kernels only support real types");
+    return 0;
+  }
+  static int cholesky(int64_t n, scalar_t* a, bool upper) {
+    TORCH_INTERNAL_ASSERT(false, "small matrix kernels only support real types");
+    return 0;
+  }
+};
+
+template <typename scalar_t>
+struct SmallMatrix<scalar_t, true> {
+  static int lu(int64_t n, scalar_t* a, int* ipiv) {
+    int info = 0;
+    dispatch_small_matrix_size(n, [&](auto size) {
+      info = small_lu<scalar_t, decltype(size)::value>(a, ipiv);
+    });
+    return info;
+  }
+  static void lu_solve(int64_t n, const scalar_t* lu, const int* ipiv, scalar_t* b, int64_t nrhs) {
+    dispatch_small_matrix_size(n, [&](auto size) {
+      small_lu_solve<scalar_t, decltype(size)::value>(lu, ipiv, b, nrhs);
+    });
+  }
+  // getrf + getri: solves A X = I into a, given the LU factorization of A
+  static int inverse(int64_t n, scalar_t* a, int* ipiv) {
+    int info = 0;
+    dispatch_small_matrix_size(n, [&](auto size) {
+      constexpr int m = decltype(size)::value;
+      info = small_lu<scalar_t, m>(a, ipiv);
+      if (info != 0) {
+        return;
+      }
+      scalar_t x[m * m] = {};
+      for (int i = 0; i < m; i++) {
+        x[i * m + i] = scalar_t(1);
+      }
+      small_lu_solve<scalar_t, m>(a, ipiv, x, m);
+      std::copy(x, x + m * m, a);
+    });
+    return info;
+  }
+  static int cholesky(int64_t n, scalar_t* a, bool upper) {
+    int info = 0;
+    dispatch_small_matrix_size(n, [&](auto size) {
+      info = small_cholesky<scalar_t, decltype(size)::value>(a, upper);
+    });
+    return info;
+  }
+};
+
 // Below of the definitions of the functions operating on a batch that are going to be dispatched
 // in the main helper functions for the linear algebra operations
 
@@ -320,19 +521,27 @@ static void apply_solve(Tensor& b, Tensor& A, std::vector<int64_t>& infos) {
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  auto ipiv = at::empty({n}, b.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
-
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv_data, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  const bool small = use_small_matrix_kernels<scalar_t>(n);
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    std::vector<int> ipiv(n);
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      if (small) {
+        info = SmallMatrix<scalar_t>::lu(n, A_working_ptr, ipiv.data());
+        if (info == 0) {
+          SmallMatrix<scalar_t>::lu_solve(n, A_working_ptr, ipiv.data(), b_working_ptr, nrhs);
+        }
+      } else {
+        lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv.data(), b_working_ptr, n, &info);
+      }
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -383,36 +592,50 @@ static void apply_inverse(Tensor& self, std::vector<int64_t>& infos) {
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  auto ipiv = at::empty({n}, self.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
+  if (use_small_matrix_kernels<scalar_t>(n)) {
+    parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+      int ipiv[kSmallMatrixMaxSize];
+      for (int64_t i = begin; i < end; i++) {
+        infos[i] = SmallMatrix<scalar_t>::inverse(n, &self_data[i * self_matrix_stride], ipiv);
+        if (infos[i] != 0) {
+          return;
+        }
+      }
+    });
+    return;
+  }
 
   int info;
   // Run once, first to get the optimum work size
   // Since we deal with batches of matrices with the same dimensions, doing this outside
   // the loop saves (batch_size - 1) workspace queries which would provide the same result
-  // and (batch_size - 1) calls to allocate and deallocate workspace using at::empty()
+  // and (batch_size - 1) calls to allocate and deallocate workspace
   int lwork = -1;
   scalar_t wkopt;
-  lapackGetri<scalar_t>(n, self_data, n, ipiv_data, &wkopt, lwork, &info);
+  std::vector<int> ipiv_query(n);
+  lapackGetri<scalar_t>(n, self_data, n, ipiv_query.data(), &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-  auto work_data = work.data_ptr<scalar_t>();
 
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackLu<scalar_t>(n, n, self_working_ptr, n, ipiv_data, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
-    }
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    std::vector<int> ipiv(n);
+    std::vector<scalar_t> work(lwork);
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      lapackLu<scalar_t>(n, n, self_working_ptr, n, ipiv.data(), &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
 
-    // now compute the actual inverse
-    lapackGetri<scalar_t>(n, self_working_ptr, n, ipiv_data, work_data, lwork, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+      // now compute the actual inverse
+      lapackGetri<scalar_t>(n, self_working_ptr, n, ipiv.data(), work.data(), lwork, &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -463,16 +686,18 @@ static void apply_cholesky_solve(Tensor& b, Tensor& A, bool upper, std::vector<i
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackCholeskySolve<scalar_t>(uplo, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -523,15 +748,22 @@ static void apply_cholesky(Tensor& self, bool upper, std::vector<int64_t>& infos
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  const bool small = use_small_matrix_kernels<scalar_t>(n);
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      if (small) {
+        info = SmallMatrix<scalar_t>::cholesky(n, self_working_ptr, upper);
+      } else {
+        lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
+      }
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -587,12 +819,19 @@ static void apply_lu(Tensor& self, Tensor& pivots, Tensor& infos) {
   auto m = self.size(-2);
   auto n = self.size(-1);
 
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
-    int* infos_working_ptr = &infos_data[i];
-    lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
-  }
+  const bool small = m == n && use_small_matrix_kernels<scalar_t>(n);
+  parallel_for_batch(batch_size, std::max(m, n), [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
+      int* infos_working_ptr = &infos_data[i];
+      if (small) {
+        *infos_working_ptr = SmallMatrix<scalar_t>::lu(n, self_working_ptr, pivots_working_ptr);
+      } else {
+        lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
+      }
+    }
+  });
 #endif
 }
 
@@ -648,12 +887,14 @@ static void apply_triangular_solve(Tensor& b, Tensor& A, bool upper, bool transp
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-  }
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+    }
+  });
 #endif
 }
 
@@ -712,19 +953,22 @@ static void apply_geqrf(Tensor& self, Tensor& tau, int64_t m, int64_t n,
   scalar_t wkopt;
   lapackGeqrf<scalar_t>(m, n, self_data, m, tau_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
 
-    // now compute the actual R and TAU
-    lapackGeqrf<scalar_t>(m, n, self_working_ptr, m, tau_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  parallel_for_batch(batch_size, std::max(m, n), [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> work(lwork);
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
+
+      // now compute the actual R and TAU
+      lapackGeqrf<scalar_t>(m, n, self_working_ptr, m, tau_working_ptr, work.data(), lwork, &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -750,19 +994,22 @@ static void apply_orgqr(Tensor& self, const Tensor& tau, int64_t m, int64_t n_co
   scalar_t wkopt;
   lapackOrgqr<scalar_t>(m, n_columns, k, self_data, m, tau_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
 
-    // now compute the actual Q
-    lapackOrgqr<scalar_t>(m, n_columns, k, self_working_ptr, m, tau_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  parallel_for_batch(batch_size, std::max(m, n_columns), [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> work(lwork);
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      scalar_t* tau_working_ptr = &tau_data[i * tau_stride];
+
+      // now compute the actual Q
+      lapackOrgqr<scalar_t>(m, n_columns, k, self_working_ptr, m, tau_working_ptr, work.data(), lwork, &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -870,19 +1117,22 @@ static void apply_symeig(Tensor& self, Tensor& eigvals, bool eigenvectors, bool
   scalar_t wkopt;
   lapackSymeig<scalar_t>(jobz, uplo, n, self_data, n, eigvals_data, &wkopt, lwork, &info);
   lwork = static_cast<int>(real_impl<scalar_t, value_t>(wkopt));
-  Tensor work = at::empty({lwork}, self.options());
-
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    scalar_t* eigvals_working_ptr = &eigvals_data[i * eigvals_stride];
 
-    // now compute the eigenvalues and the eigenvectors (optionally)
-    lapackSymeig<scalar_t>(jobz, uplo, n, self_working_ptr, n, eigvals_working_ptr, work.data_ptr<scalar_t>(), lwork, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> work(lwork);
+    int info;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      scalar_t* eigvals_working_ptr = &eigvals_data[i * eigvals_stride];
+
+      // now compute the eigenvalues and the eigenvectors (optionally)
+      lapackSymeig<scalar_t>(jobz, uplo, n, self_working_ptr, n, eigvals_working_ptr, work.data(), lwork, &info);
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
@@ -1071,18 +1321,25 @@ static void apply_lu_solve(Tensor& b, const Tensor& lu, const Tensor& pivots, st
   auto n = lu.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* b_working_ptr = &b_data[i * b_stride];
-    scalar_t* lu_working_ptr = &lu_data[i * lu_stride];
-    int* pivots_working_ptr = &pivots_data[i * pivots_stride];
-    lapackLuSolve<scalar_t>('N', n, nrhs, lu_working_ptr, n, pivots_working_ptr,
-                            b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  const bool small = use_small_matrix_kernels<scalar_t>(n);
+  parallel_for_batch(batch_size, n, [&](int64_t begin, int64_t end) {
+    int info = 0;
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* b_working_ptr = &b_data[i * b_stride];
+      scalar_t* lu_working_ptr = &lu_data[i * lu_stride];
+      int* pivots_working_ptr = &pivots_data[i * pivots_stride];
+      if (small) {
+        SmallMatrix<scalar_t>::lu_solve(n, lu_working_ptr, pivots_working_ptr, b_working_ptr, nrhs);
+      } else {
+        lapackLuSolve<scalar_t>('N', n, nrhs, lu_working_ptr, n, pivots_working_ptr,
+                                b_working_ptr, n, &info);
+      }
+      infos[i] = info;
+      if (info != 0) {
+        return;
+      }
     }
-  }
+  });
 #endif
 }
 
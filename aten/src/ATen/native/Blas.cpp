@@ -12,6 +12,14 @@ constexpr inline bool lda_cond(int64_t m, int64_t n, int64_t lda) {
 }
 
 Tensor &addmv_impl_cpu(Tensor& result, const Tensor &self, const Tensor &mat, const Tensor &vec, Scalar beta_, Scalar alpha_) {
+  if (mat.scalar_type() == kBFloat16) {
+    // The generic gemv would round every partial sum to BFloat16; compute in
+    // float instead, as addmm does.
+    Tensor result_float = result.to(kFloat);
+    at::_addmv_impl_(result_float, result_float, mat.to(kFloat), vec.to(kFloat), beta_, alpha_);
+    result.copy_(result_float);
+    return result;
+  }
   auto r_stride = result.stride(0);
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kBFloat16, mat.scalar_type(), "addmv_impl_cpu", [&] {
     auto beta = beta_.to<scalar_t>();
@@ -2,11 +2,13 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
+#include <ATen/native/cpu/DirectConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/ConvUtils.h>
 #include <ATen/native/xnnpack/Engine.h>
 
 #include <ATen/Config.h>
+#include <ATen/core/grad_mode.h>
 #include <c10/macros/Macros.h>
 
 #if AT_NNPACK_ENABLED()
@@ -22,6 +24,7 @@ constexpr int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(convolution_direct_stub);
 
 struct ConvParams {
   std::vector<int64_t> stride;
@@ -43,6 +46,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_direct(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -163,6 +167,29 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+// The direct convolution replaces the unfold + GEMM fallbacks on CPU, where
+// MKL-DNN and NNPACK don't apply. It has no backward, so it is only used when
+// no gradient is needed.
+auto ConvParams::use_cpu_direct(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias) const -> bool {
+  const bool requires_grad = input.requires_grad() || weight.requires_grad() ||
+      (bias.defined() && bias.requires_grad());
+  return !transposed &&
+         (input.ndimension() == 4 || input.ndimension() == 5) &&
+         input.device().is_cpu() &&
+         input.layout() == at::kStrided &&
+         weight.layout() == at::kStrided &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble) &&
+         weight.scalar_type() == input.scalar_type() &&
+         weight.device().is_cpu() &&
+         (!bias.defined() ||
+            (bias.device().is_cpu() && bias.scalar_type() == input.scalar_type())) &&
+         !(groups == 1 && use_nnpack(input)) &&
+         !(at::GradMode::is_enabled() && requires_grad);
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -776,6 +803,16 @@ at::Tensor _convolution(
         params.stride,
         params.padding,
         params.groups);
+  } else if (params.use_cpu_direct(input, weight, bias)) {
+    output = convolution_direct_stub(
+        input.device().type(),
+        input.contiguous(),
+        weight,
+        bias,
+        params.stride,
+        params.padding,
+        params.dilation,
+        params.groups);
   } else if (
         !params.transposed && (input.ndimension() == 5) &&
         (input.device().type() == c10::DeviceType::CPU) &&
@@ -1,5 +1,6 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/PackedLinear.h>
 #include <ATen/native/xnnpack/Engine.h>
 #include <ATen/WrapDimUtilsMulti.h>
 #include <c10/macros/Macros.h>
@@ -22,6 +23,9 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
     return xnnpack::linear(input, weight, bias);
   }
 #endif
+  if (use_packed_linear(input, weight, bias)) {
+    return packed_linear(input, weight, bias);
+  }
   if (input.dim() == 2 && bias.defined()) {
     // Fused op is marginally faster.
     return at::addmm(bias, input, weight.t());
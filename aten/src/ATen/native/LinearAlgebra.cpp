@@ -183,15 +183,32 @@ Tensor& addbmm_cpu_out(Tensor& result, const Tensor& self, const Tensor& batch1,
   return legacy::cpu::_th_addbmm_out(result, b_self, batch1, batch2, beta, alpha);
 }
 
+// The TH GEMM multiplies BFloat16 matrices with scalar loops that round every
+// partial sum to BFloat16. Instead, BFloat16 products are computed by the
+// float GEMM (BLAS when available) on float copies of the operands, so that
+// they accumulate in float, and rounded once.
+static bool use_float_gemm(const Tensor& self, const Tensor& mat1, const Tensor& mat2) {
+  return self.scalar_type() == kBFloat16 && mat1.scalar_type() == kBFloat16 &&
+      mat2.scalar_type() == kBFloat16;
+}
+
 Tensor addmm_cpu(const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
   Tensor b_self;
   std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm");
+  if (use_float_gemm(self, mat1, mat2)) {
+    return at::addmm(b_self.to(kFloat), mat1.to(kFloat), mat2.to(kFloat), beta, alpha).to(kBFloat16);
+  }
   return legacy::cpu::_th_addmm(b_self, mat1, mat2, beta, alpha);
 }
 
 Tensor& addmm_cpu_out(Tensor &result, const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
   Tensor b_self;
   std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm_out");
+  if (use_float_gemm(self, mat1, mat2) && result.scalar_type() == kBFloat16) {
+    Tensor result_float = at::addmm(b_self.to(kFloat), mat1.to(kFloat), mat2.to(kFloat), beta, alpha);
+    result.resize_as_(result_float);
+    return result.copy_(result_float);
+  }
   return legacy::cpu::_th_addmm_out(result, b_self, mat1, mat2, beta, alpha);
 }
 
@@ -201,6 +218,11 @@ Tensor mm_cpu(const Tensor & self, const Tensor & mat2) {
 }
 
 Tensor& mm_cpu_out(Tensor & result, const Tensor & self, const Tensor & mat2) {
+  if (use_float_gemm(result, self, mat2)) {
+    Tensor result_float = at::mm(self.to(kFloat), mat2.to(kFloat));
+    result.resize_as_(result_float);
+    return result.copy_(result_float);
+  }
   result.resize_({ self.size(0), mat2.size(1) });
   return legacy::cpu::_th_addmm_out(result, result, self, mat2, 0, 1);
 }
@@ -293,6 +315,14 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
     }
   }
 
+  // See use_float_gemm
+  if (use_float_gemm(self_or_result, batch1, batch2)) {
+    Tensor result_float = is_bmm_out
+        ? at::bmm(batch1.to(kFloat), batch2.to(kFloat))
+        : at::baddbmm(self_or_result.to(kFloat), batch1.to(kFloat), batch2.to(kFloat), beta, alpha);
+    return self_or_result.copy_(result_float);
+  }
+
   auto batch_items_contiguous_or_transposed = [&](const Tensor& t) {
     return (t.stride(2) == 1 && t.stride(1) >= t.size(2))
             || (t.stride(1) == 1 && t.stride(2) >= t.size(1));
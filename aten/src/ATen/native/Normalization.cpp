@@ -17,6 +17,7 @@ static const int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(batch_norm_cpu_inference_contiguous_stub);
+DEFINE_DISPATCH(batch_norm_cpu_collect_stats_stub);
 
 namespace {
   void check_dims_match_num_input_features(const char* arg_name, int64_t expected, int64_t actual){
@@ -224,47 +225,30 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
 
   Tensor save_mean = at::empty({n_input}, input.options());
   Tensor save_var_transform = at::empty({n_input}, input.options());
+  Tensor var_sum = at::empty({n_input}, input.options());
+  batch_norm_cpu_collect_stats_stub(kCPU, input, save_mean, var_sum);
+
   auto save_mean_a = save_mean.accessor<scalar_t, 1>();
   auto save_var_transform_a = save_var_transform.accessor<scalar_t, 1>();
+  auto var_sum_a = var_sum.accessor<scalar_t, 1>();
 
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
-  parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
-    for (int64_t f = b_begin; f < b_end; ++f) {
-      Tensor in = input.select(1, f);
-
-      // compute mean per input
-      auto iter = TensorIteratorConfig()
-        .add_input(in)
-        .build();
-      accscalar_t sum = 0;
-      cpu_serial_kernel(iter, [&](const scalar_t i) -> void {
-        sum += i;
-      });
-      scalar_t mean = sum / n;
-      save_mean_a[f] = mean;
-
-      // compute variance per input
-      accscalar_t var_sum = 0;
-      iter = TensorIteratorConfig()
-        .add_input(in)
-        .build();
-      cpu_serial_kernel(iter, [&](const scalar_t i) -> void {
-        var_sum += (i - mean) * (i - mean);
-      });
-      save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum / n, eps);
+  for (int64_t f = 0; f < n_input; ++f) {
+    scalar_t mean = save_mean_a[f];
+    accscalar_t var_sum_f = var_sum_a[f];
+    save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum_f / n, eps);
 
-      // update running averages
-      if (running_mean.defined()) {
-        running_mean_a[f] = momentum * mean + (1 - momentum) * running_mean_a[f];
-      }
-      if (running_var.defined()) {
-        accscalar_t unbiased_var = var_sum / (n - 1);
-        running_var_a[f] = momentum * unbiased_var + (1 - momentum) * running_var_a[f];
-      }
+    // update running averages
+    if (running_mean.defined()) {
+      running_mean_a[f] = momentum * mean + (1 - momentum) * running_mean_a[f];
     }
-  });
+    if (running_var.defined()) {
+      accscalar_t unbiased_var = var_sum_f / (n - 1);
+      running_var_a[f] = momentum * unbiased_var + (1 - momentum) * running_var_a[f];
+    }
+  }
   return std::make_tuple(save_mean, save_var_transform);
 }
 
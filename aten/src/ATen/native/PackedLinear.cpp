@@ -0,0 +1,164 @@
+#include <ATen/native/PackedLinear.h>
+
+#include <ATen/ATen.h>
+#include <ATen/core/grad_mode.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(packed_linear_pack_stub);
+DEFINE_DISPATCH(packed_linear_stub);
+
+namespace {
+
+// A packed weight, valid as long as the tensor it was packed from is still
+// alive (its storage is) and has not been written to since (same version).
+struct PackedWeight {
+  c10::weak_intrusive_ptr<StorageImpl> storage;
+  int64_t storage_offset;
+  std::vector<int64_t> sizes;
+  std::vector<int64_t> strides;
+  ScalarType dtype;
+  uint32_t version;
+  Tensor packed;
+
+  bool matches(const Tensor& weight) const {
+    return storage_offset == weight.storage_offset() &&
+        weight.sizes().equals(sizes) &&
+        weight.strides().equals(strides) &&
+        dtype == weight.scalar_type();
+  }
+};
+
+class PackedWeightCache {
+ public:
+  Tensor get(const Tensor& weight) {
+    StorageImpl* storage = weight.storage().unsafeGetStorageImpl();
+    const uint32_t version = weight.unsafeGetTensorImpl()->version_counter().current_version();
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      // Weights are freed without telling the cache, so also look for expired
+      // entries every so often when all lookups hit.
+      if (++lookups_ % kPruneInterval == 0) {
+        remove_expired();
+      }
+      auto it = entries_.find(storage);
+      if (it != entries_.end()) {
+        for (const auto& entry : it->second) {
+          if (entry.matches(weight) && entry.version == version) {
+            return entry.packed;
+          }
+        }
+      }
+    }
+
+    // Pack outside of the lock; if two threads race on the same weight, both
+    // results are valid and the last one is kept.
+    Tensor packed = packed_linear_pack_stub(kCPU, weight);
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    remove_expired();
+    auto& entries = entries_[storage];
+    for (auto& entry : entries) {
+      if (entry.matches(weight)) {
+        entry.version = version;
+        entry.packed = packed;
+        return packed;
+      }
+    }
+    entries.push_back(PackedWeight{
+        c10::weak_intrusive_ptr<StorageImpl>(
+            c10::intrusive_ptr<StorageImpl>::unsafe_reclaim_from_nonowning(storage)),
+        weight.storage_offset(),
+        weight.sizes().vec(),
+        weight.strides().vec(),
+        weight.scalar_type(),
+        version,
+        packed});
+    return packed;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    entries_.clear();
+  }
+
+ private:
+  // Drops the packed weights of freed tensors. The weak references keep the
+  // StorageImpl objects (not their data) alive, so a key is never reused by
+  // a new storage while its entries are in the cache.
+  void remove_expired() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.empty() || it->second.front().storage.expired()) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  static constexpr uint64_t kPruneInterval = 1024;
+
+  std::mutex mutex_;
+  uint64_t lookups_ = 0;
+  std::unordered_map<StorageImpl*, std::vector<PackedWeight>> entries_;
+};
+
+PackedWeightCache& packed_weight_cache() {
+  static PackedWeightCache cache;
+  return cache;
+}
+
+bool is_cpu_dense(const Tensor& t, ScalarType dtype) {
+  return t.device().is_cpu() && t.layout() == kStrided && t.scalar_type() == dtype;
+}
+
+} // anonymous namespace
+
+bool use_packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  if (!at::globalContext().userEnabledPackedLinear()) {
+    return false;
+  }
+  const ScalarType dtype = input.scalar_type();
+  const bool requires_grad = input.requires_grad() || weight.requires_grad() ||
+      (bias.defined() && bias.requires_grad());
+  return (dtype == kFloat || dtype == kBFloat16) &&
+      input.dim() >= 1 &&
+      is_cpu_dense(input, dtype) &&
+      is_cpu_dense(weight, dtype) &&
+      weight.dim() == 2 &&
+      // reshape({-1, 0}) can't infer the number of rows
+      weight.size(1) > 0 &&
+      input.size(-1) == weight.size(1) &&
+      (!bias.defined() ||
+       (is_cpu_dense(bias, dtype) && bias.dim() == 1 && bias.size(0) == weight.size(0))) &&
+      !(at::GradMode::is_enabled() && requires_grad);
+}
+
+Tensor packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  const int64_t in_features = weight.size(1);
+  const int64_t out_features = weight.size(0);
+  // The cache relies on the version counter to notice in-place updates, which
+  // inference tensors don't have, so pack those on every call instead.
+  Tensor packed_weight = weight.is_inference()
+      ? packed_linear_pack_stub(kCPU, weight)
+      : packed_weight_cache().get(weight);
+
+  Tensor input_2d = input.reshape({-1, in_features}).to(kFloat).contiguous();
+  Tensor bias_float = bias.defined() ? bias.to(kFloat).contiguous() : Tensor();
+  Tensor output = at::empty({input_2d.size(0), out_features}, input.options().dtype(kFloat));
+  packed_linear_stub(kCPU, input_2d, packed_weight, bias_float, out_features, output);
+
+  std::vector<int64_t> output_size = input.sizes().vec();
+  output_size.back() = out_features;
+  return output.view(output_size).to(input.scalar_type());
+}
+
+void packed_linear_clear_cache() {
+  packed_weight_cache().clear();
+}
+
+}} // namespace at::native
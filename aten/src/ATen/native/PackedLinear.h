@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+// Prepacked weights for eager CPU linear (opt-in).
+//
+// BLAS repacks the weight of a GEMM into its own panel format on every call,
+// which for small batches with static weights costs as much as the product
+// itself. When enabled (torch.backends.packed_linear.enabled), linear packs the
+// weight once into column panels and caches the packed form, so that later
+// calls only stream the panels through a register-tiled kernel. The cache is
+// keyed on the storage of the weight and validated against its version
+// counter, so an in-place update of the weight repacks it on its next use.
+//
+// Only inference is covered: float and bfloat16 inputs (bfloat16 weights are
+// packed to float, and products accumulate in float) with no gradient
+// required.
+
+namespace at { namespace native {
+
+// Packs a [out_features, in_features] weight into float panels of the width
+// expected by packed_linear_stub.
+using packed_linear_pack_fn = Tensor(*)(const Tensor& weight);
+// output[m][n] = bias[n] + sum_k input[m][k] * weight[n][k], for a contiguous
+// float input matrix, a packed weight with out_features rows, an optional
+// contiguous float bias, and a contiguous float output.
+using packed_linear_fn = void(*)(const Tensor& input, const Tensor& packed_weight, const Tensor& bias, int64_t out_features, Tensor& output);
+
+DECLARE_DISPATCH(packed_linear_pack_fn, packed_linear_pack_stub);
+DECLARE_DISPATCH(packed_linear_fn, packed_linear_stub);
+
+bool use_packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias);
+Tensor packed_linear(const Tensor& input, const Tensor& weight, const Tensor& bias);
+
+// Drops every cached packed weight.
+CAFFE2_API void packed_linear_clear_cache();
+
+}} // namespace at::native
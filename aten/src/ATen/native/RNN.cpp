@@ -3,12 +3,15 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/core/op_registration/op_registration.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <torch/custom_class.h>
 
+#include <numeric>
+
 torch::jit::class_<LinearPackedParamsBase> register_linear_params();
 
 namespace at { namespace native {
@@ -1118,6 +1121,223 @@ std::tuple<io_type, Tensor, Tensor> _lstm_impl(
   return std::make_tuple(std::move(result.outputs), at::stack(hy, 0), at::stack(cy, 0));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// FUSED CPU IMPLEMENTATION
+//
+// The layers above run a cell per time step, and the cell issues a matmul and
+// several pointwise ops, each allocating its result. When no gradient is
+// needed, LSTM and GRU on CPU instead run each layer as:
+//
+//   1. one GEMM computing the input part of the gates for all time steps,
+//   2. per step, one GEMM adding the hidden part of the gates, and a single
+//      vectorized pass over the gates (lstm_gates_stub, gru_gates_stub) that
+//      updates the hidden state buffers in place and writes the output.
+//
+// The quantized LSTM and GRU run the same way, with the linear layers of their
+// quantized weights as the GEMMs. With dynamic quantization, the input of all
+// time steps is then quantized once per layer, and only the hidden state is
+// quantized at every step.
+//
+// All buffers are allocated once per layer. A padded sequence is handled as a
+// packed sequence whose batch sizes are all equal: since batch sizes only
+// decrease, the states of the sequences active at a step are the first rows
+// of the state buffers, and the rows past them keep the final states of the
+// sequences that ended (or, going backwards, the initial states of those that
+// haven't started yet).
+
+enum class FusedCell { None, LSTM, GRU };
+
+template <typename CellType>
+struct fused_cell { static constexpr FusedCell value = FusedCell::None; };
+template <>
+struct fused_cell<LSTMCell<CellParams>> { static constexpr FusedCell value = FusedCell::LSTM; };
+template <>
+struct fused_cell<GRUCell<CellParams>> { static constexpr FusedCell value = FusedCell::GRU; };
+template <>
+struct fused_cell<LSTMCell<QRNNCellParamsWrapper>> { static constexpr FusedCell value = FusedCell::LSTM; };
+template <>
+struct fused_cell<GRUCell<QRNNCellParamsWrapper>> { static constexpr FusedCell value = FusedCell::GRU; };
+
+bool use_fused_rnn_cpu(const Tensor& input, TensorList params, TensorList hx) {
+  if (!input.device().is_cpu() || input.layout() != kStrided || input.numel() == 0) {
+    return false;
+  }
+  const auto dtype = input.scalar_type();
+  if (dtype != kFloat && dtype != kDouble) {
+    return false;
+  }
+  bool requires_grad = input.requires_grad();
+  for (TensorList tensors : {params, hx}) {
+    for (const Tensor& t : tensors) {
+      if (!t.device().is_cpu() || t.layout() != kStrided || t.scalar_type() != dtype) {
+        return false;
+      }
+      requires_grad = requires_grad || t.requires_grad();
+    }
+  }
+  return !(at::GradMode::is_enabled() && requires_grad);
+}
+
+// The GEMMs of a fused layer. With float weights, the hidden part of the LSTM
+// gates is added in place to the input part, and the hidden part of the GRU
+// gates goes to a preallocated buffer, since the reset gate only scales the
+// hidden part of the new gate; with quantized weights, the linear_ih and
+// linear_hh of the cell params are used, which include the biases.
+Tensor fused_input_gates(FusedCell cell, const Tensor& data, const CellParams& params) {
+  if (cell == FusedCell::GRU) {
+    return at::linear(data, params.w_ih, params.b_ih());
+  }
+  // both biases go into the input part of the gates
+  if (params.b_ih().defined()) {
+    return at::addmm(params.b_ih() + params.b_hh(), data, params.w_ih.t());
+  }
+  return at::mm(data, params.w_ih.t());
+}
+
+Tensor fused_input_gates(FusedCell cell, const Tensor& data, const QRNNCellParamsWrapper& params) {
+  return params.linear_ih(data);
+}
+
+// Returns the hidden part of the gates of a step, or an undefined tensor if it
+// was added to the input part.
+Tensor fused_hidden_gates(
+    FusedCell cell, const Tensor& step_h, const CellParams& params, Tensor& step_igates, Tensor& hgates) {
+  if (cell == FusedCell::LSTM) {
+    step_igates.addmm_(step_h, params.w_hh.t());
+    return Tensor();
+  }
+  Tensor step_hgates = hgates.narrow(0, 0, step_h.size(0));
+  at::mm_out(step_hgates, step_h, params.w_hh.t());
+  return step_hgates;
+}
+
+Tensor fused_hidden_gates(
+    FusedCell cell, const Tensor& step_h, const QRNNCellParamsWrapper& params, Tensor& step_igates, Tensor& hgates) {
+  return params.linear_hh(step_h);
+}
+
+// The bias that the GRU gate math adds to the hidden part of the gates
+Tensor fused_hidden_bias(const CellParams& params) {
+  return params.b_hh().defined() ? params.b_hh().contiguous() : Tensor();
+}
+
+Tensor fused_hidden_bias(const QRNNCellParamsWrapper& params) {
+  return Tensor();
+}
+
+// Runs one direction of a layer over `data` (the inputs of all time steps,
+// stacked as in a packed sequence), starting from the states in h and c,
+// which are updated in place. Returns the outputs of all time steps.
+template <typename cell_params>
+Tensor fused_layer_cpu(
+    FusedCell cell,
+    const Tensor& data,
+    const std::vector<int64_t>& batch_sizes,
+    const cell_params& params,
+    Tensor& h,
+    Tensor& c,
+    bool reverse) {
+  const int64_t num_steps = batch_sizes.size();
+  const int64_t hidden_size = h.size(1);
+
+  Tensor igates = fused_input_gates(cell, data, params);
+  Tensor hgates;
+  Tensor b_hh;
+  if (cell == FusedCell::GRU) {
+    hgates = at::empty({batch_sizes[0], 3 * hidden_size}, data.options());
+    b_hh = fused_hidden_bias(params);
+  }
+  Tensor output = at::empty({data.size(0), hidden_size}, data.options());
+
+  std::vector<int64_t> offsets(num_steps + 1, 0);
+  std::partial_sum(batch_sizes.begin(), batch_sizes.end(), offsets.begin() + 1);
+
+  for (int64_t i = 0; i < num_steps; i++) {
+    const int64_t step = reverse ? num_steps - 1 - i : i;
+    const int64_t batch_size = batch_sizes[step];
+    Tensor step_h = h.narrow(0, 0, batch_size);
+    Tensor step_igates = igates.narrow(0, offsets[step], batch_size);
+    Tensor step_output = output.narrow(0, offsets[step], batch_size);
+    Tensor step_hgates = fused_hidden_gates(cell, step_h, params, step_igates, hgates);
+    if (cell == FusedCell::LSTM) {
+      Tensor step_c = c.narrow(0, 0, batch_size);
+      lstm_gates_stub(kCPU, step_igates, step_hgates, step_h, step_c, step_output);
+    } else {
+      gru_gates_stub(kCPU, step_igates, step_hgates, b_hh, step_h, step_output);
+    }
+  }
+  return output;
+}
+
+// Returns the outputs of the last layer, the final hidden states, and for
+// LSTM the final cell states.
+template <typename cell_params>
+std::tuple<Tensor, Tensor, Tensor> fused_rnn_cpu(
+    FusedCell cell,
+    const Tensor& data,
+    const std::vector<int64_t>& batch_sizes,
+    const Tensor& hx,
+    const Tensor& cx,
+    const std::vector<cell_params>& params,
+    int64_t num_layers,
+    double dropout_p,
+    bool train,
+    bool bidirectional) {
+  const int64_t num_directions = bidirectional ? 2 : 1;
+  TORCH_CHECK(static_cast<int64_t>(params.size()) == num_layers * num_directions,
+      "Expected more weights in stacked_rnn");
+  TORCH_CHECK(hx.size(0) == num_layers * num_directions, "Expected more hidden states in stacked_rnn");
+
+  Tensor layer_input = data.contiguous();
+  std::vector<Tensor> hy, cy;
+  for (int64_t layer = 0; layer < num_layers; layer++) {
+    std::vector<Tensor> outputs;
+    for (int64_t direction = 0; direction < num_directions; direction++) {
+      const int64_t index = layer * num_directions + direction;
+      Tensor h = hx[index].clone(at::MemoryFormat::Contiguous);
+      Tensor c = cell == FusedCell::LSTM ? cx[index].clone(at::MemoryFormat::Contiguous) : Tensor();
+      outputs.push_back(fused_layer_cpu(cell, layer_input, batch_sizes, params[index], h, c, direction == 1));
+      hy.push_back(std::move(h));
+      cy.push_back(std::move(c));
+    }
+    layer_input = bidirectional ? at::cat(outputs, 1) : outputs[0];
+    if (dropout_p != 0 && train && layer < num_layers - 1) {
+      layer_input = dropout(layer_input, dropout_p);
+    }
+  }
+  return std::make_tuple(
+      std::move(layer_input),
+      at::stack(hy, 0),
+      cell == FusedCell::LSTM ? at::stack(cy, 0) : Tensor());
+}
+
+// The same for a padded input of shape (seq_len, batch, input_size).
+template <typename cell_params>
+std::tuple<Tensor, Tensor, Tensor> fused_rnn_cpu(
+    FusedCell cell,
+    const Tensor& input,
+    const Tensor& hx,
+    const Tensor& cx,
+    const std::vector<cell_params>& params,
+    int64_t num_layers,
+    double dropout_p,
+    bool train,
+    bool bidirectional) {
+  const int64_t seq_length = input.size(0);
+  const int64_t batch = input.size(1);
+  Tensor output, hy, cy;
+  std::tie(output, hy, cy) = fused_rnn_cpu(
+      cell, input.reshape({seq_length * batch, input.size(2)}), std::vector<int64_t>(seq_length, batch),
+      hx, cx, params, num_layers, dropout_p, train, bidirectional);
+  return std::make_tuple(output.view({seq_length, batch, output.size(1)}), std::move(hy), std::move(cy));
+}
+
+std::vector<int64_t> batch_sizes_vec(const Tensor& batch_sizes) {
+  Tensor contiguous_batch_sizes = batch_sizes.contiguous();
+  const int64_t* ptr = contiguous_batch_sizes.data_ptr<int64_t>();
+  return std::vector<int64_t>(ptr, ptr + contiguous_batch_sizes.numel());
+}
+
 } // anonymous namespace
 
 bool _use_cudnn_rnn_flatten_weight() {
@@ -1185,6 +1405,16 @@ bool _use_cudnn_rnn_flatten_weight() {
     check_device(_input, _params, hx);                                      \
     auto input = batch_first ? _input.transpose(0, 1) : _input;             \
     auto params = gather_params(_params, has_biases);                       \
+    if (fused_cell<CELL>::value != FusedCell::None &&                       \
+        use_fused_rnn_cpu(input, _params, hx)) {                            \
+      auto results = fused_rnn_cpu(                                         \
+          fused_cell<CELL>::value, input, hx, Tensor(), params,             \
+          num_layers, dropout_p, train, bidirectional);                     \
+      auto output = std::get<0>(results);                                   \
+      return std::make_tuple(                                               \
+          batch_first ? output.transpose(0, 1) : output,                    \
+          std::move(std::get<1>(results)));                                 \
+    }                                                                       \
     auto results =                                                          \
         _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>(     \
             input,                                                          \
@@ -1244,8 +1474,17 @@ bool _use_cudnn_rnn_flatten_weight() {
           bidirectional);                                                   \
       return std::make_tuple(std::move(output), std::move(hy));             \
     }                                                                       \
-    PackedSequence input{data, batch_sizes};                                \
     auto params = gather_params(_params, has_biases);                       \
+    if (fused_cell<CELL>::value != FusedCell::None &&                       \
+        use_fused_rnn_cpu(data, _params, hx)) {                             \
+      auto results = fused_rnn_cpu(                                         \
+          fused_cell<CELL>::value, data, batch_sizes_vec(batch_sizes), hx,  \
+          Tensor(), params, num_layers, dropout_p, train, bidirectional);   \
+      return std::make_tuple(                                               \
+          std::move(std::get<0>(results)),                                  \
+          std::move(std::get<1>(results)));                                 \
+    }                                                                       \
+    PackedSequence input{data, batch_sizes};                                \
     auto result =                                                           \
         _rnn_impl_with_concat<CELL, PackedLayer, PackedBidirectionalLayer>( \
             input,                                                          \
@@ -1275,6 +1514,16 @@ bool _use_cudnn_rnn_flatten_weight() {
       params.emplace_back(std::move(x));                                    \
     }                                                                       \
     auto input = batch_first ? _input.transpose(0, 1) : _input;             \
+    if (fused_cell<CELL>::value != FusedCell::None &&                       \
+        use_fused_rnn_cpu(input, TensorList(), hx)) {                       \
+      auto results = fused_rnn_cpu(                                         \
+          fused_cell<CELL>::value, input, hx, Tensor(), params,             \
+          num_layers, dropout_p, train, bidirectional);                     \
+      auto output = std::get<0>(results);                                   \
+      return std::make_tuple(                                               \
+          batch_first ? output.transpose(0, 1) : output,                    \
+          std::move(std::get<1>(results)));                                 \
+    }                                                                       \
     auto results =                                                          \
         _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>(     \
             input,                                                          \
@@ -1304,6 +1553,15 @@ bool _use_cudnn_rnn_flatten_weight() {
     for (c10::intrusive_ptr<CellParamsBase> x : _params) {                  \
       params.emplace_back(std::move(x));                                    \
     }                                                                       \
+    if (fused_cell<CELL>::value != FusedCell::None &&                       \
+        use_fused_rnn_cpu(data, TensorList(), hx)) {                        \
+      auto results = fused_rnn_cpu(                                         \
+          fused_cell<CELL>::value, data, batch_sizes_vec(batch_sizes), hx,  \
+          Tensor(), params, num_layers, dropout_p, train, bidirectional);   \
+      return std::make_tuple(                                               \
+          std::move(std::get<0>(results)),                                  \
+          std::move(std::get<1>(results)));                                 \
+    }                                                                       \
     PackedSequence input{data, batch_sizes};                                \
     auto result =                                                           \
         _rnn_impl_with_concat<CELL, PackedLayer, PackedBidirectionalLayer>( \
@@ -1383,6 +1641,9 @@ ONE_HIDDEN_RNN(rnn_tanh, tanf_cell_type)
 using relu_cell_type = SimpleCell<relu_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_relu, relu_cell_type);
 
+DEFINE_DISPATCH(lstm_gates_stub);
+DEFINE_DISPATCH(gru_gates_stub);
+
 DEFINE_DISPATCH(lstm_cudnn_stub);
 DEFINE_DISPATCH(lstm_packed_cudnn_stub);
 DEFINE_DISPATCH(lstm_miopen_stub);
@@ -1413,8 +1674,11 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
   check_device(_input, _params, hx);
   auto input = batch_first ? _input.transpose(0, 1) : _input;
   auto params = gather_params(_params, has_biases);
-  auto results = _lstm_impl<FullLayer, FullBidirectionalLayer>(
-      input, params, hx[0], hx[1], num_layers, dropout_p, train, bidirectional);
+  auto results = use_fused_rnn_cpu(input, _params, hx)
+      ? fused_rnn_cpu(FusedCell::LSTM, input, hx[0], hx[1], params,
+                      num_layers, dropout_p, train, bidirectional)
+      : _lstm_impl<FullLayer, FullBidirectionalLayer>(
+            input, params, hx[0], hx[1], num_layers, dropout_p, train, bidirectional);
   if (batch_first) {
     std::get<0>(results) = std::get<0>(results).transpose(0, 1);
   }
@@ -1440,8 +1704,13 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
     return std::make_tuple(std::move(output), std::move(hy), std::move(cy));
   }
 
-  PackedSequence input { data, batch_sizes };
   auto params = gather_params(_params, has_biases);
+  if (use_fused_rnn_cpu(data, _params, hx)) {
+    return fused_rnn_cpu(FusedCell::LSTM, data, batch_sizes_vec(batch_sizes), hx[0], hx[1],
+                         params, num_layers, dropout_p, train, bidirectional);
+  }
+
+  PackedSequence input { data, batch_sizes };
   auto result = _lstm_impl<PackedLayer, PackedBidirectionalLayer>(
       input, params, hx[0], hx[1], num_layers, dropout_p, train, bidirectional);
   auto & packed_output = std::get<0>(result);
@@ -1600,7 +1869,10 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm_input(
       "dtype is not supported");
 
   std::tuple<Tensor, Tensor, Tensor> results;
-  if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
+  if (use_fused_rnn_cpu(input, TensorList(), hx)) {
+    results = fused_rnn_cpu(FusedCell::LSTM, input, hx[0], hx[1], params,
+                            num_layers, dropout_p, train, bidirectional);
+  } else if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
     if (use_dynamic) {
       results = _lstm_impl<FullLayer, FullBidirectionalLayer>(
           input, params, hx[0], hx[1], num_layers,
@@ -1687,6 +1959,11 @@ std::tuple<Tensor, Tensor, Tensor> quantized_lstm_data(
 
   auto result_dtype = dtype.has_value() ? dtype.value() : at::kChar;
 
+  if (use_fused_rnn_cpu(data, TensorList(), hx)) {
+    return fused_rnn_cpu(FusedCell::LSTM, data, batch_sizes_vec(batch_sizes), hx[0], hx[1],
+                         params, num_layers, dropout_p, train, bidirectional);
+  }
+
   PackedSequence input { data, batch_sizes };
   std::tuple<PackedSequence, Tensor, Tensor> results;
   if (result_dtype == at::kChar || result_dtype == at::kQInt8) {
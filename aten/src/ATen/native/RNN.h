@@ -27,6 +27,18 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
 
+// Gate math of one time step of the fused CPU LSTM and GRU, for a batch of
+// sequences. The pre-activation gates are `igates` + `hgates` (+ `b_hh` for
+// GRU), where `hgates` may be undefined for LSTM if it was already added to
+// `igates`, and `b_hh` may be undefined; `h` and `c` are the hidden and cell
+// states, updated in place; the new hidden state is also written to `output`.
+// All tensors are contiguous matrices with a row per sequence.
+using lstm_gates_fn = void(*)(const Tensor& igates, const Tensor& hgates, Tensor& h, Tensor& c, Tensor& output);
+using gru_gates_fn = void(*)(const Tensor& igates, const Tensor& hgates, const Tensor& b_hh, Tensor& h, Tensor& output);
+
+DECLARE_DISPATCH(lstm_gates_fn, lstm_gates_stub);
+DECLARE_DISPATCH(gru_gates_fn, gru_gates_stub);
+
 inline void check_device(const Tensor& input, const TensorList& params, const TensorList& hiddens) {
   auto input_device = input.device();
 
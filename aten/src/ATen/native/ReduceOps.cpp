@@ -8,7 +8,6 @@
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/NamedTensorUtils.h>
-#include <ATen/native/TensorDimApply.h>
 #include <ATen/native/SharedReduceOps.h>
 
 #include <algorithm>
@@ -35,9 +34,12 @@ DEFINE_DISPATCH(min_values_stub);
 DEFINE_DISPATCH(max_values_stub);
 DEFINE_DISPATCH(argmax_stub);
 DEFINE_DISPATCH(argmin_stub);
+DEFINE_DISPATCH(aminmax_stub);
 DEFINE_DISPATCH(cumsum_stub);
 DEFINE_DISPATCH(cumprod_stub);
 DEFINE_DISPATCH(logcumsumexp_stub);
+DEFINE_DISPATCH(cummax_stub);
+DEFINE_DISPATCH(cummin_stub);
 
 Tensor _logcumsumexp_cpu(const Tensor& self, int64_t dim) {
   Tensor result = at::empty_like(self, MemoryFormat::Contiguous);
@@ -142,48 +144,8 @@ Tensor& cumprod_out(Tensor& result, const Tensor& self, int64_t dim, c10::option
   return result;
 }
 
-// Implement std::is_nan<IntegralType> for MSVC.
-namespace {
-#ifdef _MSC_VER
-template<typename T>
-inline typename std::enable_if<std::is_integral<T>::value, bool>::type isnan_(T x) {
-  return false;
-}
-template<typename T>
-inline typename std::enable_if<!std::is_integral<T>::value, bool>::type isnan_(T x) {
-  return std::isnan(x);
-}
-#else
-template<typename T>
-inline bool isnan_(T x) {
-  return std::isnan(x);
-}
-#endif
-}
-
-template<typename T1, typename T2, typename Operation>
-void cummax_cummin_helper(const T1* self_data, T1* values_data, T2* indices_data,
-          int self_dim_size, int self_stride, int values_stride, int indices_stride) {
-      Operation op;
-      T1 out = self_data[0];
-      int idx = 0;
-      for(int i = 0; i < self_dim_size; i++) {
-        T1 curr_elem = self_data[i*self_stride];
-        if(isnan_(curr_elem) || (!isnan_(out) && op(curr_elem, out))) {
-            out = self_data[i*self_stride];
-            idx = i;
-        }
-        values_data[i*values_stride] = out;
-        indices_data[i*indices_stride] = idx;
-      }
-}
-
 void cummax_helper_cpu(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
-  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool,
-    self.scalar_type(), "cummax_cpu",
-    [&] {
-      at::native::tensor_dim_apply3<scalar_t, int64_t>(self, values, indices, dim, cummax_cummin_helper<scalar_t, int64_t, std::greater_equal<scalar_t>>);
-    });
+  cummax_stub(self.device().type(), self, values, indices, dim);
 }
 
 std::tuple<Tensor&, Tensor&> cummax_out(Tensor& values, Tensor& indices, const Tensor& self, int64_t dim) {
@@ -214,11 +176,7 @@ std::tuple<Tensor, Tensor> cummax(const Tensor& self, int64_t dim) {
 }
 
 void cummin_helper_cpu(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
-  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool,
-    self.scalar_type(), "cummin_cpu",
-    [&] {
-      at::native::tensor_dim_apply3<scalar_t, int64_t>(self, values, indices, dim, cummax_cummin_helper<scalar_t, int64_t, std::less_equal<scalar_t>>);
-    });
+  cummin_stub(self.device().type(), self, values, indices, dim);
 }
 
 std::tuple<Tensor&, Tensor&> cummin_out(Tensor& values, Tensor& indices, const Tensor& self, int64_t dim) {
@@ -619,6 +577,30 @@ Tensor max_values(const Tensor& self, IntArrayRef dims, bool keepdim) {
   }
 }
 
+// The minimum and maximum of self, or of its slices along dim, in a single
+// pass over self.
+std::tuple<Tensor, Tensor> _aminmax(const Tensor& self, int64_t dim, bool keepdim) {
+  TORCH_CHECK(!at::isComplexType(self.scalar_type()),
+              "_aminmax does not support complex inputs.");
+  Tensor min = at::empty({0}, self.options());
+  Tensor max = at::empty({0}, self.options());
+  auto iter = make_reduction("_aminmax", min, max, self, dim, keepdim, self.scalar_type());
+  TORCH_CHECK(iter.numel() > 0, "_aminmax on a tensor with no elements is not defined.");
+  aminmax_stub(iter.device_type(), iter);
+  return std::tuple<Tensor, Tensor>(min, max);
+}
+
+std::tuple<Tensor, Tensor> _aminmax_all(const Tensor& self) {
+  TORCH_CHECK(!at::isComplexType(self.scalar_type()),
+              "_aminmax does not support complex inputs.");
+  Tensor min = at::empty({0}, self.options());
+  Tensor max = at::empty({0}, self.options());
+  auto iter = make_reduction("_aminmax", min, max, self, {}, false, self.scalar_type());
+  TORCH_CHECK(iter.numel() > 0, "_aminmax on a tensor with no elements is not defined.");
+  aminmax_stub(iter.device_type(), iter);
+  return std::tuple<Tensor, Tensor>(min, max);
+}
+
 Tensor min_values(const Tensor& self, DimnameList dims, bool keepdim) {
   TORCH_CHECK(false, "NYI: min_values with names");
   return at::min_values(self, dimnames_to_positions(self, dims), keepdim);
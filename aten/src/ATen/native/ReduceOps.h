@@ -21,6 +21,7 @@ DECLARE_DISPATCH(reduce_fn, min_values_stub);
 DECLARE_DISPATCH(reduce_fn, max_values_stub);
 DECLARE_DISPATCH(reduce_fn, argmax_stub);
 DECLARE_DISPATCH(reduce_fn, argmin_stub);
+DECLARE_DISPATCH(reduce_fn, aminmax_stub);
 
 using reduce_std_var_function =
   void (*)(TensorIterator&, bool unbiased, bool take_sqrt);
@@ -38,4 +39,8 @@ DECLARE_DISPATCH(cum_fn, cumsum_stub);
 DECLARE_DISPATCH(cum_fn, cumprod_stub);
 DECLARE_DISPATCH(cum_fn, logcumsumexp_stub);
 
+using cummax_cummin_fn = void (*)(const Tensor&, Tensor&, Tensor&, int64_t);
+DECLARE_DISPATCH(cummax_cummin_fn, cummax_stub);
+DECLARE_DISPATCH(cummax_cummin_fn, cummin_stub);
+
 }} // namespace at::native
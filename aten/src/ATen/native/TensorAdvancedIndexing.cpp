@@ -76,6 +76,7 @@ DEFINE_DISPATCH(gather_stub);
 DEFINE_DISPATCH(scatter_stub);
 DEFINE_DISPATCH(scatter_fill_stub);
 DEFINE_DISPATCH(scatter_add_stub);
+DEFINE_DISPATCH(scatter_reduce_stub);
 
 static bool all_strides_match(TensorList tensors) {
   TORCH_CHECK(tensors.size() >= 1);
@@ -269,6 +270,49 @@ Tensor& index_out(Tensor& result, const Tensor & self, TensorList indices) {
   return result;
 }
 
+std::vector<int64_t> group_positions_by_bucket(
+    const std::vector<int32_t>& bucket_of, int64_t num_buckets, std::vector<int64_t>& bucket_offsets) {
+  int64_t n = bucket_of.size();
+  // A counting sort: every chunk counts its elements per bucket, and then
+  // writes them out after those of the preceding chunks in the same bucket,
+  // which keeps the positions of a bucket in increasing order.
+  int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), divup(n, at::internal::GRAIN_SIZE)));
+  int64_t chunk_size = divup(n, num_chunks);
+  std::vector<int64_t> counts(num_chunks * num_buckets, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* chunk_counts = counts.data() + c * num_buckets;
+      for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+        chunk_counts[bucket_of[i]]++;
+      }
+    }
+  });
+
+  bucket_offsets.assign(num_buckets + 1, 0);
+  int64_t offset = 0;
+  for (int64_t b = 0; b < num_buckets; b++) {
+    bucket_offsets[b] = offset;
+    for (int64_t c = 0; c < num_chunks; c++) {
+      int64_t count = counts[c * num_buckets + b];
+      counts[c * num_buckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucket_offsets[num_buckets] = offset;
+
+  std::vector<int64_t> positions(n);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* chunk_offsets = counts.data() + c * num_buckets;
+      for (int64_t i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++) {
+        positions[chunk_offsets[bucket_of[i]]++] = i;
+      }
+    }
+  });
+  return positions;
+}
+
 Tensor index_put(const Tensor & self, TensorList indices, const Tensor & value, bool accumulate) {
   return self.clone(at::MemoryFormat::Preserve).index_put_(indices, value, accumulate);
 }
@@ -336,6 +380,29 @@ Tensor index_copy(const Tensor & self, int64_t dim, const Tensor & index, const
 }
 
 
+static bool use_index_add_buckets(int64_t work) {
+  return work >= at::internal::GRAIN_SIZE && at::get_num_threads() > 1 && !at::in_parallel_region();
+}
+
+// Groups the positions of `index` by the range of rows of self they add to,
+// so that index_add_ can add to every range from a single thread, in order.
+// The indices that are out of range are put in the first bucket, and are
+// reported when they are reached.
+static std::vector<int64_t> index_add_buckets(const int64_t* index_data, int64_t numel,
+                                              int64_t self_dim_size, std::vector<int64_t>& bucket_offsets) {
+  // A few buckets per thread to balance uneven index distributions.
+  int64_t num_buckets = std::max<int64_t>(1, std::min<int64_t>(4 * at::get_num_threads(), self_dim_size));
+  std::vector<int32_t> bucket_of(numel);
+  at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      auto self_i = index_data[i];
+      bool in_range = (self_i >= 0) && (self_i < self_dim_size);
+      bucket_of[i] = in_range ? self_i * num_buckets / self_dim_size : 0;
+    }
+  });
+  return group_positions_by_bucket(bucket_of, num_buckets, bucket_offsets);
+}
+
 Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
   dim = maybe_wrap_dim(dim, self.dim());
 
@@ -368,17 +435,35 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     auto self_stride_bytes = self.stride(dim) * elementSize(self.scalar_type());
     auto source_stride_bytes = source.stride(dim) * elementSize(source.scalar_type());
     auto self_dim_size = self.size(dim);
+    auto slice_size = selfSlice.numel();
     auto iter = TensorIterator::binary_op(selfSlice, selfSlice, sourceSlice);
 
-    for (auto i = 0; i < numel; i++) {
+    auto add_slices = [&](TensorIterator& sub_iter, int64_t i) {
       auto self_i = index_data[i];
       TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
       auto self_data = static_cast<char*>(selfSlice.data_ptr()) + self_i * self_stride_bytes;
       auto source_data = static_cast<char*>(sourceSlice.data_ptr()) + i * source_stride_bytes;
-      iter.unsafe_replace_operand(0, self_data);
-      iter.unsafe_replace_operand(1, self_data);
-      iter.unsafe_replace_operand(2, source_data);
-      add_stub(iter.device_type(), iter, 1);
+      sub_iter.unsafe_replace_operand(0, self_data);
+      sub_iter.unsafe_replace_operand(1, self_data);
+      sub_iter.unsafe_replace_operand(2, source_data);
+      add_stub(sub_iter.device_type(), sub_iter, 1);
+    };
+
+    // add_ is parallel within a slice when the slice is large enough;
+    // otherwise parallel over the rows of self
+    if (slice_size >= at::internal::GRAIN_SIZE || !use_index_add_buckets(numel * slice_size)) {
+      for (auto i = 0; i < numel; i++) {
+        add_slices(iter, i);
+      }
+    } else {
+      std::vector<int64_t> bucket_offsets;
+      auto positions = index_add_buckets(index_data, numel, self_dim_size, bucket_offsets);
+      at::parallel_for(0, bucket_offsets.size() - 1, 1, [&](int64_t begin, int64_t end) {
+        auto sub_iter = TensorIterator(iter);
+        for (int64_t j = bucket_offsets[begin]; j < bucket_offsets[end]; j++) {
+          add_slices(sub_iter, positions[j]);
+        }
+      });
     }
   }
   else {
@@ -387,11 +472,27 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     AT_DISPATCH_ALL_TYPES(self.scalar_type(), "index_add_", [&] {
       auto self_stride = self.dim() == 0 ? 1 : self.stride(dim);
       auto source_stride = source.dim() == 0 ? 1 : source.stride(dim);
-      for (auto i = 0; i < numel; i++) {
+      auto self_data_ptr = self.data_ptr<scalar_t>();
+      auto source_data_ptr = source.data_ptr<scalar_t>();
+      auto self_numel = self.numel();
+      auto add_element = [&](int64_t i) {
         auto self_i = index_data[i];
-        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self.numel()), "index out of range in self");
-        scalar_t *self_ip = self.data<scalar_t>() + self_i * self_stride;
-        *self_ip += *(source.data<scalar_t>() + i * source_stride);
+        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_numel), "index out of range in self");
+        scalar_t *self_ip = self_data_ptr + self_i * self_stride;
+        *self_ip += *(source_data_ptr + i * source_stride);
+      };
+      if (!use_index_add_buckets(numel)) {
+        for (auto i = 0; i < numel; i++) {
+          add_element(i);
+        }
+      } else {
+        std::vector<int64_t> bucket_offsets;
+        auto positions = index_add_buckets(index_data, numel, self_numel, bucket_offsets);
+        at::parallel_for(0, bucket_offsets.size() - 1, 1, [&](int64_t begin, int64_t end) {
+          for (int64_t j = bucket_offsets[begin]; j < bucket_offsets[end]; j++) {
+            add_element(positions[j]);
+          }
+        });
       }
     });
   }
@@ -557,6 +658,43 @@ Tensor scatter_add(const Tensor & self, int64_t dim, const Tensor & index, const
   return self.clone(at::MemoryFormat::Preserve).scatter_add_(dim, index, source);
 }
 
+Tensor & scatter_reduce_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & src, std::string reduce) {
+  SCATTER_GATHER_OP op;
+  if (reduce == "sum" || reduce == "mean") {
+    op = SCATTER_GATHER_OP::REDUCE_ADD;
+  } else if (reduce == "prod") {
+    op = SCATTER_GATHER_OP::REDUCE_MULTIPLY;
+  } else if (reduce == "max") {
+    op = SCATTER_GATHER_OP::REDUCE_MAXIMUM;
+  } else if (reduce == "min") {
+    op = SCATTER_GATHER_OP::REDUCE_MINIMUM;
+  } else {
+    TORCH_CHECK(false, "scatter_reduce_(): reduce argument must be one of sum, prod, mean, max or min, got ", reduce);
+  }
+  TORCH_CHECK(!self.is_complex() || op == SCATTER_GATHER_OP::REDUCE_ADD || op == SCATTER_GATHER_OP::REDUCE_MULTIPLY,
+              "scatter_reduce_(): reduce=", reduce, " is not supported for complex tensors");
+  TORCH_CHECK(reduce != "mean" || self.scalar_type() != ScalarType::Bool,
+              "scatter_reduce_(): reduce=mean is not supported for bool tensors");
+
+  scatter_reduce_stub(self.device().type(), self, dim, index, src, op);
+
+  if (reduce == "mean" && index.numel() > 0) {
+    // Every element of self is averaged with the values scattered to it.
+    auto counts = at::ones_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+    counts.scatter_add_(dim, index, at::ones(index.sizes(), self.options()));
+    if (isIntegralType(self.scalar_type(), /*includeBool=*/false)) {
+      self.floor_divide_(counts);
+    } else {
+      self.div_(counts);
+    }
+  }
+  return self;
+}
+
+Tensor scatter_reduce(const Tensor & self, int64_t dim, const Tensor & index, const Tensor & src, std::string reduce) {
+  return self.clone(at::MemoryFormat::Preserve).scatter_reduce_(dim, index, src, reduce);
+}
+
 Tensor masked_scatter(const Tensor & self, const Tensor & mask, const Tensor & source) {
   Tensor _mask, _self;
   std::tie(_mask, _self) = expand_outplace(mask, self);
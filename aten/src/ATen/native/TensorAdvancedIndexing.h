@@ -21,6 +21,18 @@ using scatter_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const
 using scatter_fill_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, Scalar src);
 using scatter_add_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src);
 
+// The reductions of scatter_reduce_ that have a kernel. "mean" is computed
+// from REDUCE_ADD.
+enum class SCATTER_GATHER_OP : uint8_t {
+  REDUCE_ADD,
+  REDUCE_MULTIPLY,
+  REDUCE_MAXIMUM,
+  REDUCE_MINIMUM
+};
+
+using scatter_reduce_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src,
+                                  SCATTER_GATHER_OP reduce);
+
 DECLARE_DISPATCH(index_fn, index_stub);
 DECLARE_DISPATCH(index_put_fn, index_put_stub);
 DECLARE_DISPATCH(index_put_accum_fn, index_put_accum_stub);
@@ -30,7 +42,17 @@ DECLARE_DISPATCH(gather_fn, gather_stub);
 DECLARE_DISPATCH(scatter_fn, scatter_stub);
 DECLARE_DISPATCH(scatter_fill_fn, scatter_fill_stub);
 DECLARE_DISPATCH(scatter_add_fn, scatter_add_stub);
+DECLARE_DISPATCH(scatter_reduce_fn, scatter_reduce_stub);
 
 TORCH_API Tensor& index_out(Tensor& result, const Tensor & self, TensorList indices);
 
+// Used to accumulate into a tensor in parallel with deterministic results:
+// the elements are put into buckets by their destination, and every bucket is
+// then reduced by a single thread. Given the bucket of every element, returns
+// the positions 0, ..., bucket_of.size() - 1 grouped by bucket, in increasing
+// order within each bucket, and sets `bucket_offsets` so that bucket b spans
+// [bucket_offsets[b], bucket_offsets[b + 1]).
+TORCH_API std::vector<int64_t> group_positions_by_bucket(
+    const std::vector<int32_t>& bucket_of, int64_t num_buckets, std::vector<int64_t>& bucket_offsets);
+
 }} // namespace at::native
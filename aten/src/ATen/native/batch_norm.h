@@ -12,6 +12,10 @@ using batch_norm_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
 
 DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_contiguous_stub);
 
+using batch_norm_stats_fn = void (*)(const Tensor&, Tensor&, Tensor&);
+
+DECLARE_DISPATCH(batch_norm_stats_fn, batch_norm_cpu_collect_stats_stub);
+
 } // namespace native
 
 } // namespace at
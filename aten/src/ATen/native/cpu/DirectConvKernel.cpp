@@ -0,0 +1,249 @@
+#include <ATen/native/cpu/DirectConvKernel.h>
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/ConvUtils.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+namespace {
+
+// The convolution is computed without unfolding the input:
+//
+//  - the weight is repacked into blocks of Vec256::size() output channels,
+//    [groups][out channel blocks][in channels per group][kd][kh][kw][block],
+//    so that the weights of a block for one input element are one vector;
+//  - every task computes a row of the output for a block of output channels,
+//    in tiles of kTileWidth output elements kept in registers: an input
+//    element is broadcast and multiplied with the weight vector of every
+//    kernel position it meets;
+//  - the input is padded once, so that the kernel loops have no bounds checks.
+//
+// Tasks are (image, group, output channel block, depth, row), so small
+// batches are split among threads as well as large ones.
+
+constexpr int64_t kTileWidth = 8;
+
+struct Arguments final {
+  int64_t batch;
+  int64_t groups;
+  // Per group
+  int64_t in_channels;
+  int64_t out_channels;
+  int64_t out_channel_blocks;
+
+  // Padded input
+  int64_t in_depth;
+  int64_t in_rows;
+  int64_t in_cols;
+
+  int64_t out_depth;
+  int64_t out_rows;
+  int64_t out_cols;
+
+  int64_t kernel_depth;
+  int64_t kernel_rows;
+  int64_t kernel_cols;
+  int64_t stride[3];
+  int64_t dilation[3];
+};
+
+// Computes `tile` output elements of a row, starting at column
+// `out_col`, for a block of output channels. The result of element p and
+// channel o of the block goes to out[p * Vec::size() + o].
+template <typename scalar_t, int64_t tile>
+void conv_tile(
+    const Arguments& args,
+    const scalar_t* input,
+    const scalar_t* weight,
+    const vec256::Vec256<scalar_t>& bias,
+    int64_t out_depth_index,
+    int64_t out_row,
+    int64_t out_col,
+    scalar_t* out) {
+  using Vec = vec256::Vec256<scalar_t>;
+  Vec acc[tile];
+  for (int64_t p = 0; p < tile; p++) {
+    acc[p] = bias;
+  }
+  const int64_t in_plane = args.in_rows * args.in_cols;
+  const int64_t col_stride = args.stride[2];
+  const scalar_t* w = weight;
+  for (int64_t ic = 0; ic < args.in_channels; ic++) {
+    const scalar_t* in_channel = input + ic * args.in_depth * in_plane;
+    for (int64_t kd = 0; kd < args.kernel_depth; kd++) {
+      const scalar_t* in_depth =
+          in_channel + (out_depth_index * args.stride[0] + kd * args.dilation[0]) * in_plane;
+      for (int64_t kh = 0; kh < args.kernel_rows; kh++) {
+        const scalar_t* in_row =
+            in_depth + (out_row * args.stride[1] + kh * args.dilation[1]) * args.in_cols + out_col * col_stride;
+        for (int64_t kw = 0; kw < args.kernel_cols; kw++) {
+          const Vec w_vec = Vec::loadu(w);
+          w += Vec::size();
+          const scalar_t* x = in_row + kw * args.dilation[2];
+          for (int64_t p = 0; p < tile; p++) {
+            acc[p] = vec256::fmadd(Vec(x[p * col_stride]), w_vec, acc[p]);
+          }
+        }
+      }
+    }
+  }
+  for (int64_t p = 0; p < tile; p++) {
+    acc[p].store(out + p * Vec::size());
+  }
+}
+
+template <typename scalar_t>
+void conv_kernel(
+    const Arguments& args,
+    const Tensor& input,
+    const Tensor& packed_weight,
+    const Tensor& packed_bias,
+    Tensor& output) {
+  using Vec = vec256::Vec256<scalar_t>;
+  constexpr int64_t block = Vec::size();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const scalar_t* weight_data = packed_weight.data_ptr<scalar_t>();
+  const scalar_t* bias_data = packed_bias.data_ptr<scalar_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+
+  const int64_t in_image = args.in_channels * args.in_depth * args.in_rows * args.in_cols;
+  const int64_t weight_block = args.in_channels * args.kernel_depth * args.kernel_rows * args.kernel_cols * block;
+  const int64_t out_plane = args.out_depth * args.out_rows * args.out_cols;
+  const int64_t num_tasks =
+      args.batch * args.groups * args.out_channel_blocks * args.out_depth * args.out_rows;
+  const int64_t task_cost = args.out_cols * weight_block;
+
+  at::parallel_for(0, num_tasks, divup(internal::GRAIN_SIZE, task_cost), [&](int64_t begin, int64_t end) {
+    scalar_t tile_out[kTileWidth * block];
+    for (int64_t task = begin; task < end; task++) {
+      int64_t rest = task;
+      const int64_t out_row = rest % args.out_rows;
+      rest /= args.out_rows;
+      const int64_t out_depth_index = rest % args.out_depth;
+      rest /= args.out_depth;
+      const int64_t oc_block = rest % args.out_channel_blocks;
+      rest /= args.out_channel_blocks;
+      const int64_t g = rest % args.groups;
+      const int64_t n = rest / args.groups;
+
+      const scalar_t* in = input_data + (n * args.groups + g) * in_image;
+      const int64_t weight_index = g * args.out_channel_blocks + oc_block;
+      const scalar_t* w = weight_data + weight_index * weight_block;
+      const Vec bias = Vec::loadu(bias_data + weight_index * block);
+      const int64_t oc_begin = oc_block * block;
+      const int64_t oc_count = std::min(block, args.out_channels - oc_begin);
+      scalar_t* out = output_data +
+          ((n * args.groups + g) * args.out_channels + oc_begin) * out_plane +
+          (out_depth_index * args.out_rows + out_row) * args.out_cols;
+
+      int64_t col = 0;
+      while (col < args.out_cols) {
+        int64_t width = kTileWidth;
+        if (col + kTileWidth <= args.out_cols) {
+          conv_tile<scalar_t, kTileWidth>(args, in, w, bias, out_depth_index, out_row, col, tile_out);
+        } else {
+          width = 1;
+          conv_tile<scalar_t, 1>(args, in, w, bias, out_depth_index, out_row, col, tile_out);
+        }
+        for (int64_t o = 0; o < oc_count; o++) {
+          for (int64_t p = 0; p < width; p++) {
+            out[o * out_plane + col + p] = tile_out[p * block + o];
+          }
+        }
+        col += width;
+      }
+    }
+  });
+}
+
+// [out_channels, in_channels per group, kd, kh, kw] ->
+// [groups][out channel blocks][in channels per group][kd][kh][kw][block]
+template <typename scalar_t>
+Tensor pack_weight(const Tensor& weight, int64_t groups, int64_t out_channel_blocks) {
+  constexpr int64_t block = vec256::Vec256<scalar_t>::size();
+  const int64_t out_channels = weight.size(0) / groups;
+  // pad the output channels of every group to a multiple of the block
+  Tensor padded = at::zeros(
+      {groups, out_channel_blocks * block, weight.size(1), weight.size(2), weight.size(3), weight.size(4)},
+      weight.options());
+  padded.narrow(1, 0, out_channels).copy_(
+      weight.view({groups, out_channels, weight.size(1), weight.size(2), weight.size(3), weight.size(4)}));
+  return padded
+      .view({groups, out_channel_blocks, block, weight.size(1), weight.size(2), weight.size(3), weight.size(4)})
+      .permute({0, 1, 3, 4, 5, 6, 2})
+      .contiguous();
+}
+
+Tensor _convolution_direct(
+    const Tensor& input_,
+    const Tensor& weight_,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  const bool is_2d = input_.dim() == 4;
+  // a 2D convolution is a 3D one of depth 1
+  Tensor input = is_2d ? input_.unsqueeze(2) : input_;
+  Tensor weight = is_2d ? weight_.unsqueeze(2) : weight_;
+  std::vector<int64_t> stride3d = stride.vec();
+  std::vector<int64_t> padding3d = padding.vec();
+  std::vector<int64_t> dilation3d = dilation.vec();
+  if (is_2d) {
+    stride3d.insert(stride3d.begin(), 1);
+    padding3d.insert(padding3d.begin(), 0);
+    dilation3d.insert(dilation3d.begin(), 1);
+  }
+
+  const auto output_size = conv_output_size(input.sizes(), weight.sizes(), padding3d, stride3d, dilation3d);
+  Tensor output = at::empty(output_size, input.options());
+
+  if (padding3d[0] != 0 || padding3d[1] != 0 || padding3d[2] != 0) {
+    input = at::constant_pad_nd(
+        input, {padding3d[2], padding3d[2], padding3d[1], padding3d[1], padding3d[0], padding3d[0]}, 0);
+  }
+  input = input.contiguous();
+
+  Arguments args;
+  args.batch = input.size(0);
+  args.groups = groups;
+  args.in_channels = input.size(1) / groups;
+  args.out_channels = weight.size(0) / groups;
+  args.in_depth = input.size(2);
+  args.in_rows = input.size(3);
+  args.in_cols = input.size(4);
+  args.out_depth = output_size[2];
+  args.out_rows = output_size[3];
+  args.out_cols = output_size[4];
+  args.kernel_depth = weight.size(2);
+  args.kernel_rows = weight.size(3);
+  args.kernel_cols = weight.size(4);
+  for (int i = 0; i < 3; i++) {
+    args.stride[i] = stride3d[i];
+    args.dilation[i] = dilation3d[i];
+  }
+
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "convolution_direct", [&] {
+    constexpr int64_t block = vec256::Vec256<scalar_t>::size();
+    args.out_channel_blocks = divup(args.out_channels, block);
+    Tensor packed_weight = pack_weight<scalar_t>(weight.contiguous(), groups, args.out_channel_blocks);
+    Tensor packed_bias = at::zeros({groups, args.out_channel_blocks * block}, input.options());
+    if (bias.defined()) {
+      packed_bias.narrow(1, 0, args.out_channels).copy_(bias.reshape({groups, args.out_channels}));
+    }
+    conv_kernel<scalar_t>(args, input, packed_weight, packed_bias, output);
+  });
+
+  return is_2d ? output.squeeze(2) : output;
+}
+
+}  // namespace
+
+REGISTER_DISPATCH(convolution_direct_stub, &_convolution_direct);
+
+}  // namespace native
+}  // namespace at
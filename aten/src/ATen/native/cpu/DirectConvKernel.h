@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Direct (im2col-free) 2D and 3D convolution operator, for float and double
+  inputs on CPU. Takes 4D or 5D contiguous inputs and supports strides,
+  padding, dilation and groups.
+*/
+
+namespace at {
+namespace native {
+
+using convolution_direct_fn = Tensor (*)(
+    const Tensor&, const Tensor&, const Tensor&, IntArrayRef, IntArrayRef, IntArrayRef, int64_t);
+
+DECLARE_DISPATCH(convolution_direct_fn, convolution_direct_stub);
+
+}  // namespace native
+}  // namespace at
@@ -2,11 +2,12 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
-#include <ATen/native/cpu/AtomicAddFloat.h>
 
 namespace at { namespace native {
 namespace {
@@ -106,19 +107,78 @@ void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef inde
   });
 }
 
+// index_put_ with accumulate=True, in parallel. The elements are put into
+// buckets by their destination, each bucket covering a range of addresses, and
+// every bucket is then accumulated by a single thread in the order of the
+// elements. Duplicate indices are thus summed in the same order as by the
+// serial loop, and the result does not depend on the number of threads.
+template <typename scalar_t>
+void cpu_index_put_accumulate_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride) {
+  int ntensor = iter.ntensors();
+  int64_t numel = iter.numel();
+  const int index_parallel_grain_size = 3000;
+
+  // The destination and source of every element, in iteration order.
+  std::vector<char*> dst_ptrs(numel);
+  std::vector<char*> src_ptrs(numel);
+  at::parallel_for(0, numel, index_parallel_grain_size, [&](int64_t begin, int64_t end) {
+    int64_t i = begin;
+    iter.serial_for_each([&](char** data, const int64_t* strides, int64_t n) {
+      auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
+      for (int64_t k = 0; k < n; k++, i++) {
+        dst_ptrs[i] = data[0] + strides[0] * k + indexer.get(k);
+        src_ptrs[i] = data[1] + strides[1] * k;
+      }
+    }, {begin, end});
+  });
+
+  using range_t = std::pair<uintptr_t, uintptr_t>;
+  auto range = at::parallel_reduce(0, numel, internal::GRAIN_SIZE,
+    range_t(std::numeric_limits<uintptr_t>::max(), 0),
+    [&](int64_t begin, int64_t end, range_t r) {
+      for (int64_t i = begin; i < end; i++) {
+        auto addr = reinterpret_cast<uintptr_t>(dst_ptrs[i]);
+        r.first = std::min(r.first, addr);
+        r.second = std::max(r.second, addr);
+      }
+      return r;
+    },
+    [](range_t a, range_t b) {
+      return range_t(std::min(a.first, b.first), std::max(a.second, b.second));
+    });
+  int64_t span = (range.second - range.first) / sizeof(scalar_t) + 1;
+
+  // A few buckets per thread to balance uneven index distributions.
+  int64_t num_buckets = std::min<int64_t>(4 * at::get_num_threads(), span);
+  std::vector<int32_t> bucket_of(numel);
+  at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      int64_t elem = (reinterpret_cast<uintptr_t>(dst_ptrs[i]) - range.first) / sizeof(scalar_t);
+      bucket_of[i] = elem * num_buckets / span;
+    }
+  });
+  std::vector<int64_t> bucket_offsets;
+  auto positions = group_positions_by_bucket(bucket_of, num_buckets, bucket_offsets);
+
+  at::parallel_for(0, num_buckets, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      for (int64_t j = bucket_offsets[b]; j < bucket_offsets[b + 1]; j++) {
+        int64_t i = positions[j];
+        *(scalar_t*)dst_ptrs[i] += *(scalar_t*)src_ptrs[i];
+      }
+    }
+  });
+}
+
 void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride, bool accumulate) {
   // NOTE: duplicate indices are only supported if accumulate is true.
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_put", [&] {
     if (accumulate) {
       bool use_parallel_for = ((iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1));
-      if (iter.dtype() == at::ScalarType::Float && use_parallel_for) {
-        cpu_index_kernel<float>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-          cpu_atomic_add_float((float*)(dst + offset), *(float*)src);
-        });
+      if (use_parallel_for) {
+        cpu_index_put_accumulate_kernel<scalar_t>(iter, index_size, index_stride);
       } else {
-        // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-        // this needs to be thread-safe.
         cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
           *(scalar_t*)(dst + offset) += *(scalar_t*)src;
         }, /*serial_execution=*/true);
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/ReduceOpsUtils.h>
+#include <ATen/native/SharedReduceOps.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/Reduce.h>
+#include <ATen/native/cpu/zmath.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+
+// Reductions computing several statistics of their input in a single pass.
+//
+// An ops_t of multi_kernel_reduce provides:
+//
+//   scalar_t: the type of the input.
+//   opmath_t: the type the statistics are computed in.
+//   acc_t: the statistics of any number of elements. acc_t {} is an identity
+//     for combine.
+//   vec_acc_t: the statistics of kMultiReduceVecs independent Vec256<opmath_t>
+//     accumulators. vec_acc_t {} holds the statistics of zero elements.
+//
+//   reduce: (acc_t, opmath_t) -> acc_t adds one element.
+//   combine: (acc_t, acc_t) -> acc_t merges the statistics of two sets of
+//     elements. It must be associative and commutative: the elements are
+//     reduced in lanes and blocks, in a different order than they are stored.
+//   vec_reduce: (vec_acc_t&, const opmath_t*) adds kMultiReduceVecs *
+//     Vec256<opmath_t>::size() contiguous elements, one per lane, in place:
+//     copying the accumulators at every step keeps them out of registers.
+//   vec_store: (const vec_acc_t&, acc_t*) writes the statistics of each lane.
+//   project: acc_t -> std::tuple<...> finishes the reduction, one tuple
+//     element per output.
+
+// Number of independent vector accumulators, enough to hide the latency of
+// the arithmetic without spilling the accumulators of two statistics.
+constexpr int64_t kMultiReduceVecs = 4;
+
+// Long reductions are split into blocks of kMultiReduceBlockSize elements,
+// reduced in parallel and merged with a fixed tree of combine calls. The block
+// size does not depend on the number of threads, nor does the result.
+constexpr int64_t kMultiReduceBlockSize = at::internal::GRAIN_SIZE;
+
+// Combines accs[0, n) pairwise and returns the result, overwriting accs.
+template <typename ops_t, typename acc_t>
+acc_t multi_reduce_tree(acc_t* accs, int64_t n, const ops_t& ops) {
+  for (int64_t stride = 1; stride < n; stride *= 2) {
+    for (int64_t i = 0; i + stride < n; i += 2 * stride) {
+      accs[i] = ops.combine(accs[i], accs[i + stride]);
+    }
+  }
+  return accs[0];
+}
+
+// Returns n contiguous elements as opmath_t, converting them into buf unless
+// they already have that type.
+template <typename opmath_t, typename scalar_t>
+inline const opmath_t* multi_reduce_load(const scalar_t* data, opmath_t* buf, int64_t n) {
+  convert(data, buf, n);
+  return buf;
+}
+
+template <typename opmath_t>
+inline const opmath_t* multi_reduce_load(const opmath_t* data, opmath_t* /*buf*/, int64_t /*n*/) {
+  return data;
+}
+
+// Adds n elements, stride elements apart, to acc. Contiguous elements are
+// reduced with Vec256 and the lanes merged with multi_reduce_tree.
+template <typename ops_t>
+typename ops_t::acc_t multi_reduce_range(
+    typename ops_t::acc_t acc,
+    const typename ops_t::scalar_t* data,
+    int64_t stride,
+    int64_t n,
+    const ops_t& ops) {
+  using opmath_t = typename ops_t::opmath_t;
+  using acc_t = typename ops_t::acc_t;
+  constexpr int64_t kChunkSize = kMultiReduceVecs * Vec256<opmath_t>::size();
+  int64_t i = 0;
+  if (stride == 1 && n >= kChunkSize) {
+    __at_align32__ opmath_t buf[kChunkSize];
+    typename ops_t::vec_acc_t vacc;
+    for (; i + kChunkSize <= n; i += kChunkSize) {
+      ops.vec_reduce(vacc, multi_reduce_load(data + i, buf, kChunkSize));
+    }
+    std::array<acc_t, kChunkSize> lanes;
+    ops.vec_store(vacc, lanes.data());
+    acc = ops.combine(acc, multi_reduce_tree(lanes.data(), kChunkSize, ops));
+  }
+  for (; i < n; ++i) {
+    acc = ops.reduce(acc, static_cast<opmath_t>(data[i * stride]));
+  }
+  return acc;
+}
+
+// Like binary_kernel_reduce, but the input of every output element is read
+// once, with Vec256 where it is contiguous, to produce all the outputs of the
+// iterator. The reduction of a single output element is split into
+// kMultiReduceBlockSize blocks, reduced in parallel.
+template <typename ops_t>
+void multi_kernel_reduce(TensorIterator& iter, const ops_t& ops) {
+  using scalar_t = typename ops_t::scalar_t;
+  using acc_t = typename ops_t::acc_t;
+  using r_traits = binary_function_traits<decltype(&ops_t::reduce)>;
+  static_assert(
+    !std::is_same<acc_t, bool>::value,
+    "Concurrently modifying different references into std::vector<bool> is UB.");
+
+  const int num_outputs = iter.noutputs();
+  iter.foreach_reduced_elt([&ops, num_outputs](TensorIterator& sub_iter) {
+    AT_ASSERT(sub_iter.ntensors() - num_outputs == 1);
+    auto reduce_block = [&](int64_t begin, int64_t end) {
+      acc_t acc {};
+      sub_iter.serial_for_each([&](char** data, const int64_t* strides, int64_t size) {
+        acc = multi_reduce_range(
+          acc,
+          reinterpret_cast<const scalar_t*>(data[num_outputs]),
+          strides[num_outputs] / static_cast<int64_t>(sizeof(scalar_t)),
+          size,
+          ops);
+      }, {begin, end});
+      return acc;
+    };
+
+    const int64_t numel = sub_iter.numel();
+    acc_t total;
+    if (numel <= kMultiReduceBlockSize) {
+      total = reduce_block(0, numel);
+    } else {
+      const int64_t num_blocks = divup(numel, kMultiReduceBlockSize);
+      std::vector<acc_t> partials(num_blocks);
+      at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t k = begin; k < end; ++k) {
+          const int64_t start = k * kMultiReduceBlockSize;
+          partials[k] = reduce_block(start, std::min(start + kMultiReduceBlockSize, numel));
+        }
+      });
+      total = multi_reduce_tree(partials.data(), num_blocks, ops);
+    }
+    set_results<r_traits>(ops.project(total), sub_iter, num_outputs);
+  });
+}
+
+// Mean and variance, or standard deviation, with Welford's algorithm. The
+// outputs are (var or std, mean) like WelfordOps, which combines and projects.
+// The vector accumulators all hold the same number of elements, so the update
+// divides by a scalar.
+template <typename scalar_t_, typename opmath_t_>
+struct WelfordVecOps
+    : WelfordOps<opmath_t_, opmath_t_, int64_t, opmath_t_, std::tuple<scalar_t_, scalar_t_>> {
+  using scalar_t = scalar_t_;
+  using opmath_t = opmath_t_;
+  using Vec = Vec256<opmath_t>;
+  using acc_t = WelfordData<opmath_t, int64_t, opmath_t>;
+  using welford_ops_t = WelfordOps<opmath_t, opmath_t, int64_t, opmath_t, std::tuple<scalar_t, scalar_t>>;
+
+  struct vec_acc_t {
+    Vec mean[kMultiReduceVecs];
+    Vec m2[kMultiReduceVecs];
+    opmath_t nf;
+    vec_acc_t() : nf(0) {
+      for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+        mean[v] = Vec(opmath_t(0));
+        m2[v] = Vec(opmath_t(0));
+      }
+    }
+  };
+
+  WelfordVecOps(bool unbiased, bool take_sqrt)
+    : welford_ops_t(unbiased, take_sqrt) {}
+
+  // Unlike WelfordOps::reduce, counts with nf: acc may come from combine,
+  // which does not keep n.
+  inline acc_t reduce(acc_t acc, opmath_t data) const {
+    const opmath_t nf = acc.nf + 1;
+    const opmath_t delta = data - acc.mean;
+    const opmath_t mean = acc.mean + delta / nf;
+    return {mean, acc.m2 + delta * (data - mean), static_cast<int64_t>(nf), nf};
+  }
+
+  inline void vec_reduce(vec_acc_t& acc, const opmath_t* data) const {
+    acc.nf += 1;
+    const Vec inv_n(opmath_t(1) / acc.nf);
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      const Vec x = Vec::loadu(data + v * Vec::size());
+      const Vec delta = x - acc.mean[v];
+      acc.mean[v] = fmadd(delta, inv_n, acc.mean[v]);
+      acc.m2[v] = fmadd(delta, x - acc.mean[v], acc.m2[v]);
+    }
+  }
+
+  inline void vec_store(const vec_acc_t& acc, acc_t* lanes) const {
+    __at_align32__ opmath_t mean[Vec::size()];
+    __at_align32__ opmath_t m2[Vec::size()];
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      acc.mean[v].store(mean);
+      acc.m2[v].store(m2);
+      for (int64_t l = 0; l < Vec::size(); ++l) {
+        lanes[v * Vec::size() + l] = acc_t(mean[l], m2[l], static_cast<int64_t>(acc.nf), acc.nf);
+      }
+    }
+  }
+};
+
+template <typename T>
+struct MinMaxData {
+  T min = upper_bound<T>();
+  T max = lower_bound<T>();
+};
+
+// Minimum and maximum, propagating NaN. The outputs are (min, max).
+template <typename scalar_t_, typename opmath_t_>
+struct MinMaxVecOps {
+  using scalar_t = scalar_t_;
+  using opmath_t = opmath_t_;
+  using Vec = Vec256<opmath_t>;
+  using acc_t = MinMaxData<opmath_t>;
+
+  struct vec_acc_t {
+    Vec min[kMultiReduceVecs];
+    Vec max[kMultiReduceVecs];
+    vec_acc_t() {
+      for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+        min[v] = Vec(upper_bound<opmath_t>());
+        max[v] = Vec(lower_bound<opmath_t>());
+      }
+    }
+  };
+
+  inline acc_t reduce(acc_t acc, opmath_t data) const {
+    return {min_impl(acc.min, data), max_impl(acc.max, data)};
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return {min_impl(a.min, b.min), max_impl(a.max, b.max)};
+  }
+
+  inline void vec_reduce(vec_acc_t& acc, const opmath_t* data) const {
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      const Vec x = Vec::loadu(data + v * Vec::size());
+      acc.min[v] = minimum(acc.min[v], x);
+      acc.max[v] = maximum(acc.max[v], x);
+    }
+  }
+
+  inline void vec_store(const vec_acc_t& acc, acc_t* lanes) const {
+    __at_align32__ opmath_t min[Vec::size()];
+    __at_align32__ opmath_t max[Vec::size()];
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      acc.min[v].store(min);
+      acc.max[v].store(max);
+      for (int64_t l = 0; l < Vec::size(); ++l) {
+        lanes[v * Vec::size() + l] = {min[l], max[l]};
+      }
+    }
+  }
+
+  inline std::tuple<scalar_t, scalar_t> project(acc_t acc) const {
+    return std::tuple<scalar_t, scalar_t>(
+      static_cast<scalar_t>(acc.min), static_cast<scalar_t>(acc.max));
+  }
+};
+
+// Sum accumulated in opmath_t, e.g. float for BFloat16, whose partial sums
+// would otherwise be rounded to BFloat16. The output is the sum.
+template <typename scalar_t_, typename opmath_t_>
+struct SumVecOps {
+  using scalar_t = scalar_t_;
+  using opmath_t = opmath_t_;
+  using Vec = Vec256<opmath_t>;
+  using acc_t = opmath_t;
+
+  struct vec_acc_t {
+    Vec sum[kMultiReduceVecs];
+    vec_acc_t() {
+      for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+        sum[v] = Vec(opmath_t(0));
+      }
+    }
+  };
+
+  inline acc_t reduce(acc_t acc, opmath_t data) const {
+    return acc + data;
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return a + b;
+  }
+
+  inline void vec_reduce(vec_acc_t& acc, const opmath_t* data) const {
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      acc.sum[v] = acc.sum[v] + Vec::loadu(data + v * Vec::size());
+    }
+  }
+
+  inline void vec_store(const vec_acc_t& acc, acc_t* lanes) const {
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      acc.sum[v].store(lanes + v * Vec::size());
+    }
+  }
+
+  inline scalar_t project(acc_t acc) const {
+    return static_cast<scalar_t>(acc);
+  }
+};
+
+template <typename T>
+struct SumSqData {
+  T sum = 0;
+  T sumsq = 0;
+};
+
+// Sum and sum of squares. The outputs are (sum, sum of squares).
+template <typename scalar_t_, typename opmath_t_>
+struct SumSqVecOps {
+  using scalar_t = scalar_t_;
+  using opmath_t = opmath_t_;
+  using Vec = Vec256<opmath_t>;
+  using acc_t = SumSqData<opmath_t>;
+
+  struct vec_acc_t {
+    Vec sum[kMultiReduceVecs];
+    Vec sumsq[kMultiReduceVecs];
+    vec_acc_t() {
+      for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+        sum[v] = Vec(opmath_t(0));
+        sumsq[v] = Vec(opmath_t(0));
+      }
+    }
+  };
+
+  inline acc_t reduce(acc_t acc, opmath_t data) const {
+    return {acc.sum + data, acc.sumsq + data * data};
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return {a.sum + b.sum, a.sumsq + b.sumsq};
+  }
+
+  inline void vec_reduce(vec_acc_t& acc, const opmath_t* data) const {
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      const Vec x = Vec::loadu(data + v * Vec::size());
+      acc.sum[v] = acc.sum[v] + x;
+      acc.sumsq[v] = fmadd(x, x, acc.sumsq[v]);
+    }
+  }
+
+  inline void vec_store(const vec_acc_t& acc, acc_t* lanes) const {
+    __at_align32__ opmath_t sum[Vec::size()];
+    __at_align32__ opmath_t sumsq[Vec::size()];
+    for (int64_t v = 0; v < kMultiReduceVecs; ++v) {
+      acc.sum[v].store(sum);
+      acc.sumsq[v].store(sumsq);
+      for (int64_t l = 0; l < Vec::size(); ++l) {
+        lanes[v * Vec::size() + l] = {sum[l], sumsq[l]};
+      }
+    }
+  }
+
+  inline std::tuple<scalar_t, scalar_t> project(acc_t acc) const {
+    return std::tuple<scalar_t, scalar_t>(
+      static_cast<scalar_t>(acc.sum), static_cast<scalar_t>(acc.sumsq));
+  }
+};
+
+}}}  // namespace at::native::<anonymous>
@@ -0,0 +1,104 @@
+#include <ATen/native/PackedLinear.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+using Vec = vec256::Vec256<float>;
+
+// The weight is packed into panels of kBlock output features,
+// [out_features / kBlock][in_features][kBlock], so that the weights of a
+// panel for one input feature are two vectors. A task computes a tile of
+// kTileRows input rows against one panel, keeping its 2 * kTileRows sums in
+// registers.
+constexpr int64_t kBlock = 2 * Vec::size();
+constexpr int64_t kTileRows = 4;
+
+Tensor pack_weight(const Tensor& weight) {
+  const int64_t out_features = weight.size(0);
+  const int64_t in_features = weight.size(1);
+  const int64_t blocks = divup(out_features, kBlock);
+  Tensor padded = at::zeros({blocks * kBlock, in_features}, weight.options().dtype(kFloat));
+  padded.narrow(0, 0, out_features).copy_(weight);
+  return padded.view({blocks, kBlock, in_features}).permute({0, 2, 1}).contiguous();
+}
+
+// out[r * kBlock + j] = bias[j] + sum_k a[r * lda + k] * panel[k * kBlock + j]
+template <int64_t rows>
+void gemm_tile(const float* a, int64_t lda, const float* panel, int64_t in_features, const float* bias, float* out) {
+  Vec acc0[rows];
+  Vec acc1[rows];
+  const Vec bias0 = Vec::loadu(bias);
+  const Vec bias1 = Vec::loadu(bias + Vec::size());
+  for (int64_t r = 0; r < rows; r++) {
+    acc0[r] = bias0;
+    acc1[r] = bias1;
+  }
+  for (int64_t k = 0; k < in_features; k++) {
+    const Vec b0 = Vec::loadu(panel + k * kBlock);
+    const Vec b1 = Vec::loadu(panel + k * kBlock + Vec::size());
+    for (int64_t r = 0; r < rows; r++) {
+      const Vec a_rk(a[r * lda + k]);
+      acc0[r] = vec256::fmadd(a_rk, b0, acc0[r]);
+      acc1[r] = vec256::fmadd(a_rk, b1, acc1[r]);
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    acc0[r].store(out + r * kBlock);
+    acc1[r].store(out + r * kBlock + Vec::size());
+  }
+}
+
+void packed_linear_kernel(const Tensor& input, const Tensor& packed_weight, const Tensor& bias, int64_t out_features, Tensor& output) {
+  const int64_t rows = input.size(0);
+  const int64_t in_features = input.size(1);
+  const int64_t blocks = packed_weight.size(0);
+  const float* input_data = input.data_ptr<float>();
+  const float* weight_data = packed_weight.data_ptr<float>();
+  float* output_data = output.data_ptr<float>();
+
+  std::vector<float> padded_bias(blocks * kBlock, 0.f);
+  if (bias.defined()) {
+    std::copy(bias.data_ptr<float>(), bias.data_ptr<float>() + out_features, padded_bias.begin());
+  }
+
+  // Tasks of a panel are consecutive, so that a thread reuses it from cache.
+  const int64_t row_tiles = divup(rows, kTileRows);
+  const int64_t task_cost = kTileRows * kBlock * std::max<int64_t>(in_features, 1);
+  at::parallel_for(0, blocks * row_tiles, divup(internal::GRAIN_SIZE, task_cost), [&](int64_t begin, int64_t end) {
+    float tile_out[kTileRows * kBlock];
+    for (int64_t task = begin; task < end; task++) {
+      const int64_t block = task / row_tiles;
+      const int64_t row_begin = (task % row_tiles) * kTileRows;
+      const int64_t tile_rows = std::min(kTileRows, rows - row_begin);
+      const float* a = input_data + row_begin * in_features;
+      const float* panel = weight_data + block * in_features * kBlock;
+      const float* tile_bias = padded_bias.data() + block * kBlock;
+      switch (tile_rows) {
+        case 4: gemm_tile<4>(a, in_features, panel, in_features, tile_bias, tile_out); break;
+        case 3: gemm_tile<3>(a, in_features, panel, in_features, tile_bias, tile_out); break;
+        case 2: gemm_tile<2>(a, in_features, panel, in_features, tile_bias, tile_out); break;
+        default: gemm_tile<1>(a, in_features, panel, in_features, tile_bias, tile_out); break;
+      }
+      const int64_t col_begin = block * kBlock;
+      const int64_t cols = std::min(kBlock, out_features - col_begin);
+      for (int64_t r = 0; r < tile_rows; r++) {
+        std::copy(
+            tile_out + r * kBlock,
+            tile_out + r * kBlock + cols,
+            output_data + (row_begin + r) * out_features + col_begin);
+      }
+    }
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(packed_linear_pack_stub, &pack_weight);
+REGISTER_DISPATCH(packed_linear_stub, &packed_linear_kernel);
+
+}} // namespace at::native
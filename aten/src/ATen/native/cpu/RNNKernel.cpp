@@ -0,0 +1,159 @@
+#include <ATen/native/RNN.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+template <typename scalar_t>
+inline scalar_t sigmoid(scalar_t x) {
+  return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+}
+
+template <typename scalar_t>
+inline vec256::Vec256<scalar_t> sigmoid(const vec256::Vec256<scalar_t>& x) {
+  const vec256::Vec256<scalar_t> one(scalar_t(1));
+  return one / (one + x.neg().exp());
+}
+
+// The rows are independent sequences, so they are split among threads.
+int64_t rows_grain_size(int64_t row_size) {
+  return std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(row_size, 1), 1);
+}
+
+// i, f, g, o = igates + hgates
+// c' = sigmoid(f) * c + sigmoid(i) * tanh(g)
+// h' = sigmoid(o) * tanh(c')
+template <typename scalar_t, bool has_hgates>
+void lstm_gates_kernel(const Tensor& igates, const Tensor& hgates, Tensor& h, Tensor& c, Tensor& output) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch = h.size(0);
+  const int64_t hidden = h.size(1);
+  const scalar_t* igates_ptr = igates.data_ptr<scalar_t>();
+  const scalar_t* hgates_ptr = has_hgates ? hgates.data_ptr<scalar_t>() : nullptr;
+  scalar_t* h_ptr = h.data_ptr<scalar_t>();
+  scalar_t* c_ptr = c.data_ptr<scalar_t>();
+  scalar_t* output_ptr = output.data_ptr<scalar_t>();
+
+  // a gate is the sum of its input and hidden parts
+  auto load = [](const scalar_t* input_part, const scalar_t* hidden_part, int64_t j) {
+    return has_hgates ? Vec::loadu(input_part + j) + Vec::loadu(hidden_part + j) : Vec::loadu(input_part + j);
+  };
+  auto get = [](const scalar_t* input_part, const scalar_t* hidden_part, int64_t j) {
+    return has_hgates ? input_part[j] + hidden_part[j] : input_part[j];
+  };
+
+  at::parallel_for(0, batch, rows_grain_size(4 * hidden), [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* i_in = igates_ptr + b * 4 * hidden;
+      const scalar_t* i_forget = i_in + hidden;
+      const scalar_t* i_cell = i_in + 2 * hidden;
+      const scalar_t* i_out = i_in + 3 * hidden;
+      const scalar_t* h_in = has_hgates ? hgates_ptr + b * 4 * hidden : nullptr;
+      const scalar_t* h_forget = has_hgates ? h_in + hidden : nullptr;
+      const scalar_t* h_cell = has_hgates ? h_in + 2 * hidden : nullptr;
+      const scalar_t* h_out = has_hgates ? h_in + 3 * hidden : nullptr;
+      scalar_t* h_row = h_ptr + b * hidden;
+      scalar_t* c_row = c_ptr + b * hidden;
+      scalar_t* output_row = output_ptr + b * hidden;
+      int64_t j = 0;
+      for (; j + Vec::size() <= hidden; j += Vec::size()) {
+        Vec cy = sigmoid(load(i_forget, h_forget, j)) * Vec::loadu(c_row + j) +
+            sigmoid(load(i_in, h_in, j)) * load(i_cell, h_cell, j).tanh();
+        Vec hy = sigmoid(load(i_out, h_out, j)) * cy.tanh();
+        cy.store(c_row + j);
+        hy.store(h_row + j);
+        hy.store(output_row + j);
+      }
+      for (; j < hidden; j++) {
+        scalar_t cy = sigmoid(get(i_forget, h_forget, j)) * c_row[j] +
+            sigmoid(get(i_in, h_in, j)) * std::tanh(get(i_cell, h_cell, j));
+        scalar_t hy = sigmoid(get(i_out, h_out, j)) * std::tanh(cy);
+        c_row[j] = cy;
+        h_row[j] = hy;
+        output_row[j] = hy;
+      }
+    }
+  });
+}
+
+void lstm_gates_kernel_impl(const Tensor& igates, const Tensor& hgates, Tensor& h, Tensor& c, Tensor& output) {
+  AT_DISPATCH_FLOATING_TYPES(h.scalar_type(), "lstm_gates", [&] {
+    if (hgates.defined()) {
+      lstm_gates_kernel<scalar_t, true>(igates, hgates, h, c, output);
+    } else {
+      lstm_gates_kernel<scalar_t, false>(igates, hgates, h, c, output);
+    }
+  });
+}
+
+// r, z, n = igates + hgates + b_hh, except that the hidden part of n is
+// scaled by the reset gate:
+// n' = tanh(n_i + sigmoid(r) * (n_h + b_hn))
+// h' = n' + sigmoid(z) * (h - n')
+template <typename scalar_t>
+void gru_gates_kernel(const Tensor& igates, const Tensor& hgates, const Tensor& b_hh, Tensor& h, Tensor& output) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch = h.size(0);
+  const int64_t hidden = h.size(1);
+  const scalar_t* igates_ptr = igates.data_ptr<scalar_t>();
+  const scalar_t* hgates_ptr = hgates.data_ptr<scalar_t>();
+  // without a bias, add zeros
+  std::vector<scalar_t> zeros;
+  if (!b_hh.defined()) {
+    zeros.resize(3 * hidden, scalar_t(0));
+  }
+  const scalar_t* bias = b_hh.defined() ? b_hh.data_ptr<scalar_t>() : zeros.data();
+  scalar_t* h_ptr = h.data_ptr<scalar_t>();
+  scalar_t* output_ptr = output.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch, rows_grain_size(6 * hidden), [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* ir = igates_ptr + b * 3 * hidden;
+      const scalar_t* iz = ir + hidden;
+      const scalar_t* in = ir + 2 * hidden;
+      const scalar_t* hr = hgates_ptr + b * 3 * hidden;
+      const scalar_t* hz = hr + hidden;
+      const scalar_t* hn = hr + 2 * hidden;
+      const scalar_t* br = bias;
+      const scalar_t* bz = bias + hidden;
+      const scalar_t* bn = bias + 2 * hidden;
+      scalar_t* h_row = h_ptr + b * hidden;
+      scalar_t* output_row = output_ptr + b * hidden;
+      int64_t j = 0;
+      for (; j + Vec::size() <= hidden; j += Vec::size()) {
+        Vec reset_gate = sigmoid(Vec::loadu(ir + j) + Vec::loadu(hr + j) + Vec::loadu(br + j));
+        Vec input_gate = sigmoid(Vec::loadu(iz + j) + Vec::loadu(hz + j) + Vec::loadu(bz + j));
+        Vec new_gate = vec256::fmadd(reset_gate, Vec::loadu(hn + j) + Vec::loadu(bn + j), Vec::loadu(in + j)).tanh();
+        Vec hy = vec256::fmadd(input_gate, Vec::loadu(h_row + j) - new_gate, new_gate);
+        hy.store(h_row + j);
+        hy.store(output_row + j);
+      }
+      for (; j < hidden; j++) {
+        scalar_t reset_gate = sigmoid(ir[j] + hr[j] + br[j]);
+        scalar_t input_gate = sigmoid(iz[j] + hz[j] + bz[j]);
+        scalar_t new_gate = std::tanh(in[j] + reset_gate * (hn[j] + bn[j]));
+        scalar_t hy = new_gate + input_gate * (h_row[j] - new_gate);
+        h_row[j] = hy;
+        output_row[j] = hy;
+      }
+    }
+  });
+}
+
+void gru_gates_kernel_impl(const Tensor& igates, const Tensor& hgates, const Tensor& b_hh, Tensor& h, Tensor& output) {
+  AT_DISPATCH_FLOATING_TYPES(h.scalar_type(), "gru_gates", [&] {
+    gru_gates_kernel<scalar_t>(igates, hgates, b_hh, h, output);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(lstm_gates_stub, &lstm_gates_kernel_impl);
+REGISTER_DISPATCH(gru_gates_stub, &gru_gates_kernel_impl);
+
+}} // namespace at::native
@@ -9,122 +9,201 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/SharedReduceOps.h>
 #include <ATen/native/ReduceOpsUtils.h>
+#include <ATen/native/cpu/MultiReduce.h>
 #include <ATen/native/cpu/Reduce.h>
+#include <ATen/native/cpu/Scan.h>
 
 #include <c10/util/Optional.h>
 #include <ATen/AccumulateType.h>
+#include <ATen/NumericUtils.h>
 
 namespace at { namespace native { namespace {
 
 using namespace vec256;
 
-template <typename scalar_t, typename func_t>
-static inline void cpu_cum_base_kernel(Tensor& result,
-    const Tensor& self,
-    int64_t dim,
-    const func_t& f,
-    scalar_t init_val) {
-  if (result.sizes() != self.sizes()) {
-    result.resize_as_(self);
-  }
-  if (self.numel() == 0) {
-    return;
-  }
-  const auto input_ndim = self.dim();
-  if (input_ndim == 0) {
-    result.fill_(self);
-    return;
+struct CumSumOps {
+  template <typename T>
+  inline T combine(const T& a, const T& b) const {
+    return a + b;
   }
+};
 
-  auto iter = TensorIteratorConfig()
-    .check_all_same_dtype(false)
-    .resize_outputs(false)
-    .declare_static_shape(self.sizes(), /*squash_dim=*/dim)
-    .add_output(result)
-    .add_input(self)
-    .build();
-
-  auto result_dim_stride = ensure_nonempty_stride(result, dim);
-  auto self_dim_stride = ensure_nonempty_stride(self, dim);
-
-  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
-    auto* result_data_bytes = data[0];
-    const auto* self_data_bytes = data[1];
-
-    for (int64_t i = 0; i < n; ++i) {
-      f(
-        (scalar_t*)result_data_bytes, result_dim_stride,
-        (scalar_t*)self_data_bytes, self_dim_stride, init_val
-      );
-      result_data_bytes += strides[0];
-      self_data_bytes += strides[1];
+struct CumProdOps {
+  template <typename T>
+  inline T combine(const T& a, const T& b) const {
+    return a * b;
+  }
+};
+
+// Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
+template <typename scalar_t>
+struct LogCumSumExpOps {
+  inline scalar_t combine(scalar_t a, scalar_t b) const {
+    const scalar_t min = std::isnan(b) ? b : std::min(a, b);
+    const scalar_t max = std::isnan(b) ? b : std::max(a, b);
+    // min - max is NaN when both are the same infinity.
+    if (min != max || std::isfinite(min)) {
+      return std::log1p(std::exp(min - max)) + max;
     }
-  };
+    return a;
+  }
 
-  iter.for_each(loop);
-}
+  inline Vec256<scalar_t> combine(const Vec256<scalar_t>& a, const Vec256<scalar_t>& b) const {
+    using Vec = Vec256<scalar_t>;
+    const Vec min = minimum(a, b);
+    const Vec max = maximum(a, b);
+    const Vec result = (min - max).exp().log1p() + max;
+    const Vec infinite = min.abs() == Vec(std::numeric_limits<scalar_t>::infinity());
+    return Vec::blendv(result, Vec::blendv(result, a, min == max), infinite);
+  }
+};
 
 static void cumsum_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(self.scalar_type(), "cumsum_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number += self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
-        }
-      }, /*init_val=*/ 0
-    );
+    cpu_scan_kernel<scalar_t, at::acc_type<scalar_t, false>>(
+      result, self, wrap_dim, CumSumOps());
   });
 }
 
 static void cumprod_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(self.scalar_type(), "cumprod_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number *= self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
-        }
-      }, /*init_val=*/ 1
-    );
+    cpu_scan_kernel<scalar_t, at::acc_type<scalar_t, false>>(
+      result, self, wrap_dim, CumProdOps());
   });
 }
 
 static void logcumsumexp_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "logcumsumexp_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        scalar_t cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          scalar_t x = self_data[i * self_dim_stride];
-
-          // Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
-          auto log_add_exp = [](scalar_t x, scalar_t y) -> scalar_t {
-            return std::log1p(std::exp(std::min(x, y) - std::max(x, y))) + std::max(x, y);
-          };
-          cum_number = log_add_exp(x, cum_number);
-          result_data[i * result_dim_stride] = static_cast<scalar_t>(cum_number);
+    cpu_scan_kernel<scalar_t, scalar_t>(
+      result, self, wrap_dim, LogCumSumExpOps<scalar_t>());
+  });
+}
+
+// cummax and cummin keep the running extremum and its index. A NaN replaces
+// anything and is only replaced by a later NaN; ties go to the later element.
+// The values and the indices have lanes of different widths, so adjacent rows
+// are scanned together with a scalar loop rather than with Vec256.
+template <typename scalar_t, typename op_t>
+static void cummax_cummin_kernel(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  using acc_t = std::pair<scalar_t, int64_t>;
+  auto replaces = [](scalar_t x, scalar_t current) {
+    return _isnan(x) || (!_isnan(current) && op_t()(x, current));
+  };
+
+  auto iter = TensorIteratorConfig()
+    .check_all_same_dtype(false)
+    .resize_outputs(false)
+    .declare_static_shape(self.sizes(), /*squash_dim=*/dim)
+    .add_output(values)
+    .add_output(indices)
+    .add_input(self)
+    .build();
+
+  const int64_t dim_size = ensure_nonempty_size(self, dim);
+  const int64_t values_dim_stride = ensure_nonempty_stride(values, dim);
+  const int64_t indices_dim_stride = ensure_nonempty_stride(indices, dim);
+  const int64_t self_dim_stride = ensure_nonempty_stride(self, dim);
+
+  // Scans the elements [begin, end) of a row from carry, or from its first
+  // element if carry is null, and writes the result if write is set.
+  auto scan_row = [&](char* const* row, int64_t begin, int64_t end, const acc_t* carry, bool write) {
+    auto* values_data = reinterpret_cast<scalar_t*>(row[0]);
+    auto* indices_data = reinterpret_cast<int64_t*>(row[1]);
+    const auto* self_data = reinterpret_cast<const scalar_t*>(row[2]);
+    acc_t acc = carry != nullptr ? *carry : acc_t(self_data[begin * self_dim_stride], begin);
+    for (int64_t i = begin; i < end; ++i) {
+      const scalar_t x = self_data[i * self_dim_stride];
+      if (replaces(x, acc.first)) {
+        acc = acc_t(x, i);
+      }
+      if (write) {
+        values_data[i * values_dim_stride] = acc.first;
+        indices_data[i * indices_dim_stride] = acc.second;
+      }
+    }
+    return acc;
+  };
+
+  if (use_parallel_scan(dim_size)) {
+    const auto rows = scan_row_pointers<3>(iter);
+    parallel_scan<acc_t>(
+      rows.size(), dim_size,
+      [&](int64_t row, int64_t begin, int64_t end) {
+        return scan_row(rows[row].data(), begin, end, nullptr, /*write=*/false);
+      },
+      [&](int64_t row, int64_t begin, int64_t end, const acc_t* carry) {
+        return scan_row(rows[row].data(), begin, end, carry, /*write=*/true);
+      },
+      [&](const acc_t& a, const acc_t& b) {
+        return replaces(b.first, a.first) ? b : a;
+      });
+    return;
+  }
+
+  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+    if (n > 1 && strides[0] == sizeof(scalar_t) && strides[1] == sizeof(int64_t) &&
+        strides[2] == sizeof(scalar_t)) {
+      auto* values_data = reinterpret_cast<scalar_t*>(data[0]);
+      auto* indices_data = reinterpret_cast<int64_t*>(data[1]);
+      const auto* self_data = reinterpret_cast<const scalar_t*>(data[2]);
+      scalar_t acc[kScanChunkSize];
+      int64_t idx[kScanChunkSize];
+      for (int64_t j = 0; j < n; j += kScanChunkSize) {
+        const int64_t m = std::min(kScanChunkSize, n - j);
+        for (int64_t k = 0; k < m; ++k) {
+          acc[k] = self_data[j + k];
+          idx[k] = 0;
         }
-      }, /*init_val=*/ -std::numeric_limits<scalar_t>::infinity()
-    );
+        for (int64_t i = 0; i < dim_size; ++i) {
+          const scalar_t* x = self_data + i * self_dim_stride + j;
+          for (int64_t k = 0; k < m; ++k) {
+            if (replaces(x[k], acc[k])) {
+              acc[k] = x[k];
+              idx[k] = i;
+            }
+          }
+          std::copy(acc, acc + m, values_data + i * values_dim_stride + j);
+          std::copy(idx, idx + m, indices_data + i * indices_dim_stride + j);
+        }
+      }
+      return;
+    }
+    char* row[3] = {data[0], data[1], data[2]};
+    for (int64_t i = 0; i < n; ++i) {
+      scan_row(row, 0, dim_size, nullptr, /*write=*/true);
+      for (int arg = 0; arg < 3; ++arg) {
+        row[arg] += strides[arg];
+      }
+    }
+  };
+  iter.for_each(loop, std::max<int64_t>(1, at::internal::GRAIN_SIZE / dim_size));
+}
+
+static void cummax_cpu_kernel(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "cummax_cpu", [&] {
+    cummax_cummin_kernel<scalar_t, std::greater_equal<scalar_t>>(self, values, indices, dim);
+  });
+}
+
+static void cummin_cpu_kernel(const Tensor& self, Tensor& values, Tensor& indices, int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "cummin_cpu", [&] {
+    cummax_cummin_kernel<scalar_t, std::less_equal<scalar_t>>(self, values, indices, dim);
   });
 }
 
 static void sum_kernel_impl(TensorIterator& iter) {
+  if (iter.dtype() == ScalarType::BFloat16 && iter.input_dtype() == ScalarType::BFloat16) {
+    // Contiguous BFloat16 inputs are loaded with Vec256 and converted to
+    // float, so that the partial sums accumulate in float.
+    multi_kernel_reduce(iter, SumVecOps<BFloat16, float>{});
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
       ScalarType::BFloat16, ScalarType::Half, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
         binary_kernel_reduce_vec(
@@ -146,11 +225,7 @@ static void mean_kernel_impl(TensorIterator& iter) {
 
 static void std_var_kernel_impl(TensorIterator &iter, bool unbiased, bool take_sqrt) {
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "std_cpu", [&] {
-    binary_kernel_reduce(
-      iter,
-      WelfordOps<scalar_t, double, int64_t, double, std::tuple<scalar_t, scalar_t>> { unbiased, take_sqrt },
-      WelfordData<double, int64_t, double>()
-    );
+    multi_kernel_reduce(iter, WelfordVecOps<scalar_t, double> { unbiased, take_sqrt });
   });
 }
 
@@ -284,6 +359,12 @@ static void max_values_kernel_impl(TensorIterator& iter) {
   });
 }
 
+static void aminmax_kernel_impl(TensorIterator& iter) {
+  AT_DISPATCH_ALL_TYPES(iter.dtype(), "_aminmax_cpu", [&iter] {
+    multi_kernel_reduce(iter, MinMaxVecOps<scalar_t, scalar_t>{});
+  });
+}
+
 static void argmax_kernel_impl(TensorIterator &iter) {
   AT_DISPATCH_ALL_TYPES_AND(kHalf, iter.dtype(1), "argmax_cpu", [&] {
     binary_kernel_reduce(
@@ -315,8 +396,11 @@ REGISTER_DISPATCH(min_values_stub, &min_values_kernel_impl);
 REGISTER_DISPATCH(max_values_stub, &max_values_kernel_impl);
 REGISTER_DISPATCH(argmax_stub, &argmax_kernel_impl);
 REGISTER_DISPATCH(argmin_stub, &argmin_kernel_impl);
+REGISTER_DISPATCH(aminmax_stub, &aminmax_kernel_impl);
 REGISTER_DISPATCH(cumprod_stub, &cumprod_cpu_kernel);
 REGISTER_DISPATCH(cumsum_stub, &cumsum_cpu_kernel);
 REGISTER_DISPATCH(logcumsumexp_stub, &logcumsumexp_cpu_kernel);
+REGISTER_DISPATCH(cummax_stub, &cummax_cpu_kernel);
+REGISTER_DISPATCH(cummin_stub, &cummin_cpu_kernel);
 
 }}  // namespace at::native
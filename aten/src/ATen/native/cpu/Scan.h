@@ -0,0 +1,283 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/ReduceOpsUtils.h>
+#include <ATen/native/TensorIterator.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+
+// parallel_scan splits rows into blocks of kScanBlockSize elements. The block
+// size is fixed so that the result of a blocked scan does not depend on the
+// number of threads.
+constexpr int64_t kScanBlockSize = at::internal::GRAIN_SIZE;
+
+// Number of elements the vectorized loops convert to the accumulate type at
+// once. A multiple of Vec256<acc_t>::size() for every accumulate type.
+constexpr int64_t kScanChunkSize = 64;
+
+// Blocked prefix scan of num_rows rows of n elements:
+//
+//   reduce(row, begin, end) -> acc_t
+//     combines the elements [begin, end) of the row, in the same order as
+//     scan does.
+//   scan(row, begin, end, const acc_t* carry) -> acc_t
+//     writes the inclusive scan of the elements [begin, end) of the row,
+//     each combined with *carry if carry is not null, and returns the last
+//     value it wrote.
+//   combine(a, b) -> acc_t
+//     combines the results of two consecutive ranges of a row.
+//
+// The first pass reduces every block of every row but the last, in parallel.
+// The block totals of each row are then turned into the carry of the next
+// blocks serially, and the second pass scans all the blocks in parallel.
+// Without threads to spare, the blocks of a row are scanned one after the
+// other instead, each returning the carry of the next, which reads the input
+// once and gives the same result. Rows of a single block are scanned in one
+// go, one row per task.
+template <typename acc_t, typename reduce_t, typename scan_t, typename combine_t>
+void parallel_scan(
+    int64_t num_rows,
+    int64_t n,
+    const reduce_t& reduce,
+    const scan_t& scan,
+    const combine_t& combine) {
+  if (num_rows == 0 || n == 0) {
+    return;
+  }
+  const int64_t num_blocks = divup(n, kScanBlockSize);
+  if (num_blocks == 1) {
+    at::parallel_for(0, num_rows, divup(kScanBlockSize, n), [&](int64_t begin, int64_t end) {
+      for (int64_t row = begin; row < end; ++row) {
+        scan(row, 0, n, nullptr);
+      }
+    });
+    return;
+  }
+
+  if (at::get_num_threads() == 1 || at::in_parallel_region()) {
+    for (int64_t row = 0; row < num_rows; ++row) {
+      acc_t carry = scan(row, 0, kScanBlockSize, nullptr);
+      for (int64_t start = kScanBlockSize; start < n; start += kScanBlockSize) {
+        carry = scan(row, start, std::min(start + kScanBlockSize, n), &carry);
+      }
+    }
+    return;
+  }
+
+  std::vector<acc_t> carries(num_rows * num_blocks);
+  at::parallel_for(0, num_rows * num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; ++k) {
+      const int64_t block = k % num_blocks;
+      if (block + 1 < num_blocks) {
+        const int64_t start = block * kScanBlockSize;
+        carries[k] = reduce(k / num_blocks, start, start + kScanBlockSize);
+      }
+    }
+  });
+
+  // carries[row * num_blocks + block] becomes the total of the blocks before
+  // that block, the first block of a row has none.
+  for (int64_t row = 0; row < num_rows; ++row) {
+    acc_t* row_carries = carries.data() + row * num_blocks;
+    acc_t total = row_carries[0];
+    for (int64_t block = 1; block < num_blocks; ++block) {
+      const acc_t block_total = row_carries[block];
+      row_carries[block] = total;
+      if (block + 1 < num_blocks) {
+        total = combine(total, block_total);
+      }
+    }
+  }
+
+  at::parallel_for(0, num_rows * num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t k = begin; k < end; ++k) {
+      const int64_t block = k % num_blocks;
+      const int64_t start = block * kScanBlockSize;
+      scan(
+          k / num_blocks,
+          start,
+          std::min(start + kScanBlockSize, n),
+          block == 0 ? nullptr : &carries[k]);
+    }
+  });
+}
+
+// Whether rows of n elements are scanned with parallel_scan. This depends on
+// n alone, so that the thread count does not change how results are rounded.
+inline bool use_parallel_scan(int64_t n) {
+  return n >= 2 * kScanBlockSize;
+}
+
+// Base pointers of the rows of a TensorIterator built with
+// declare_static_shape(sizes, /*squash_dim=*/dim), one per operand.
+template <int ntensors>
+std::vector<std::array<char*, ntensors>> scan_row_pointers(const TensorIterator& iter) {
+  std::vector<std::array<char*, ntensors>> rows;
+  rows.reserve(iter.numel());
+  iter.serial_for_each([&](char** data, const int64_t* strides, int64_t n) {
+    std::array<char*, ntensors> ptrs;
+    std::copy(data, data + ntensors, ptrs.begin());
+    for (int64_t i = 0; i < n; ++i) {
+      rows.push_back(ptrs);
+      for (int arg = 0; arg < ntensors; ++arg) {
+        ptrs[arg] += strides[arg];
+      }
+    }
+  }, {0, iter.numel()});
+  return rows;
+}
+
+// Combines the elements [begin, end) of a row with ops.combine, one after
+// the other like scan_range, so that the carries of parallel_scan match a
+// scan of the whole block.
+template <typename acc_t, typename scalar_t, typename ops_t>
+acc_t scan_reduce_range(
+    const scalar_t* data, int64_t stride, int64_t begin, int64_t end, const ops_t& ops) {
+  acc_t acc = static_cast<acc_t>(data[begin * stride]);
+  for (int64_t i = begin + 1; i < end; ++i) {
+    acc = ops.combine(acc, static_cast<acc_t>(data[i * stride]));
+  }
+  return acc;
+}
+
+// Writes the inclusive scan of the elements [begin, end) of a row and returns
+// its last value. This is a scalar loop: Vec256 has no lane shifts to scan
+// within a vector, and scanning transposed runs of a row side by side was
+// slower than this loop, so only scans of adjacent rows (scan_columns) are
+// vectorized. With a carry, the scan of the range is computed from its
+// first element and each prefix is combined with *carry, so that the last
+// value is exactly combine(*carry, scan_reduce_range(...)) and the results
+// stay monotone across the blocks of parallel_scan.
+template <typename acc_t, typename scalar_t, typename ops_t>
+acc_t scan_range(
+    scalar_t* result_data, int64_t result_stride,
+    const scalar_t* self_data, int64_t self_stride,
+    int64_t begin, int64_t end, const acc_t* carry, const ops_t& ops) {
+  acc_t acc = static_cast<acc_t>(self_data[begin * self_stride]);
+  if (carry == nullptr) {
+    result_data[begin * result_stride] = static_cast<scalar_t>(acc);
+    for (int64_t i = begin + 1; i < end; ++i) {
+      acc = ops.combine(acc, static_cast<acc_t>(self_data[i * self_stride]));
+      result_data[i * result_stride] = static_cast<scalar_t>(acc);
+    }
+    return acc;
+  }
+  acc_t out = ops.combine(*carry, acc);
+  result_data[begin * result_stride] = static_cast<scalar_t>(out);
+  for (int64_t i = begin + 1; i < end; ++i) {
+    acc = ops.combine(acc, static_cast<acc_t>(self_data[i * self_stride]));
+    out = ops.combine(*carry, acc);
+    result_data[i * result_stride] = static_cast<scalar_t>(out);
+  }
+  return out;
+}
+
+// Scans n adjacent rows, contiguous in memory, at once: every step along the
+// scan dimension combines a contiguous chunk of each row with Vec256.
+template <typename acc_t, typename scalar_t, typename ops_t>
+void scan_columns(
+    scalar_t* result_data, int64_t result_stride,
+    const scalar_t* self_data, int64_t self_stride,
+    int64_t dim_size, int64_t n, const ops_t& ops) {
+  using Vec = Vec256<acc_t>;
+  __at_align32__ acc_t acc[kScanChunkSize];
+  __at_align32__ acc_t buf[kScanChunkSize];
+  for (int64_t j = 0; j < n; j += kScanChunkSize) {
+    const int64_t m = std::min(kScanChunkSize, n - j);
+    convert(self_data + j, acc, m);
+    convert(acc, result_data + j, m);
+    for (int64_t i = 1; i < dim_size; ++i) {
+      convert(self_data + i * self_stride + j, buf, m);
+      int64_t k = 0;
+      for (; k + Vec::size() <= m; k += Vec::size()) {
+        ops.combine(Vec::loadu(acc + k), Vec::loadu(buf + k)).store(acc + k);
+      }
+      for (; k < m; ++k) {
+        acc[k] = ops.combine(acc[k], buf[k]);
+      }
+      convert(acc, result_data + i * result_stride + j, m);
+    }
+  }
+}
+
+// Inclusive scan of self along dim into result, accumulating in acc_t.
+// ops.combine must be associative and commutative, and be callable on both
+// acc_t and Vec256<acc_t>.
+//
+// Long rows are scanned with parallel_scan. Otherwise the scan is parallelized
+// over the rows, and rows that are adjacent in memory, i.e. scans along a
+// dimension other than the innermost one, are scanned together with Vec256.
+template <typename scalar_t, typename acc_t, typename ops_t>
+void cpu_scan_kernel(Tensor& result, const Tensor& self, int64_t dim, const ops_t& ops) {
+  if (result.sizes() != self.sizes()) {
+    result.resize_as_(self);
+  }
+  if (self.numel() == 0) {
+    return;
+  }
+  if (self.dim() == 0) {
+    result.fill_(self);
+    return;
+  }
+
+  auto iter = TensorIteratorConfig()
+    .check_all_same_dtype(false)
+    .resize_outputs(false)
+    .declare_static_shape(self.sizes(), /*squash_dim=*/dim)
+    .add_output(result)
+    .add_input(self)
+    .build();
+
+  const int64_t dim_size = ensure_nonempty_size(self, dim);
+  const int64_t result_dim_stride = ensure_nonempty_stride(result, dim);
+  const int64_t self_dim_stride = ensure_nonempty_stride(self, dim);
+
+  if (use_parallel_scan(dim_size)) {
+    const auto rows = scan_row_pointers<2>(iter);
+    parallel_scan<acc_t>(
+      rows.size(), dim_size,
+      [&](int64_t row, int64_t begin, int64_t end) {
+        return scan_reduce_range<acc_t>(
+          reinterpret_cast<const scalar_t*>(rows[row][1]), self_dim_stride, begin, end, ops);
+      },
+      [&](int64_t row, int64_t begin, int64_t end, const acc_t* carry) {
+        return scan_range<acc_t>(
+          reinterpret_cast<scalar_t*>(rows[row][0]), result_dim_stride,
+          reinterpret_cast<const scalar_t*>(rows[row][1]), self_dim_stride,
+          begin, end, carry, ops);
+      },
+      [&](const acc_t& a, const acc_t& b) {
+        return ops.combine(a, b);
+      });
+    return;
+  }
+
+  auto loop = [&](char** data, const int64_t* strides, int64_t n) {
+    auto* result_data = reinterpret_cast<scalar_t*>(data[0]);
+    const auto* self_data = reinterpret_cast<const scalar_t*>(data[1]);
+    if (n > 1 && strides[0] == sizeof(scalar_t) && strides[1] == sizeof(scalar_t)) {
+      scan_columns<acc_t>(
+        result_data, result_dim_stride, self_data, self_dim_stride, dim_size, n, ops);
+      return;
+    }
+    for (int64_t i = 0; i < n; ++i) {
+      scan_range<acc_t>(
+        result_data, result_dim_stride, self_data, self_dim_stride,
+        0, dim_size, static_cast<const acc_t*>(nullptr), ops);
+      result_data = reinterpret_cast<scalar_t*>(
+        reinterpret_cast<char*>(result_data) + strides[0]);
+      self_data = reinterpret_cast<const scalar_t*>(
+        reinterpret_cast<const char*>(self_data) + strides[1]);
+    }
+  };
+  iter.for_each(loop, std::max<int64_t>(1, at::internal::GRAIN_SIZE / dim_size));
+}
+
+}}}  // namespace at::native::<anonymous>
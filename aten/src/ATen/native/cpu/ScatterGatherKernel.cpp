@@ -1,12 +1,18 @@
 #include <ATen/native/ScatterGatherChecks.h>
 #include <ATen/native/DispatchStub.h>
+#include <ATen/native/TensorAdvancedIndexing.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 namespace at { namespace native {
 
 namespace {
 
+using namespace vec256;
+
 template <bool is_scatter_like = true>
 struct _cpu_scatter_gather_dim_loop {
   template <typename scalar_t, typename func_t>
@@ -177,13 +183,217 @@ void scatter_fill_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, Sca
   );
 }
 
-void scatter_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
-  cpu_scatter_gather_base_kernel<>()(
-    self, dim, index, src,
-    "scatter_add_", [] (auto* lhs, const auto* rhs) {
-      *lhs += *rhs;
+// Propagates NaN like vec256::maximum and vec256::minimum. Complex numbers
+// are not ordered, which scatter_reduce_ checks before calling the kernel.
+template <typename scalar_t,
+          typename std::enable_if<!c10::is_complex_t<scalar_t>::value, int>::type = 0>
+inline scalar_t scatter_maximum(scalar_t a, scalar_t b) {
+  return (b > a || _isnan(b)) ? b : a;
+}
+
+template <typename scalar_t,
+          typename std::enable_if<c10::is_complex_t<scalar_t>::value, int>::type = 0>
+inline scalar_t scatter_maximum(scalar_t a, scalar_t b) {
+  TORCH_INTERNAL_ASSERT(false, "scatter_reduce_(): max is not supported for complex tensors");
+  return a;
+}
+
+template <typename scalar_t,
+          typename std::enable_if<!c10::is_complex_t<scalar_t>::value, int>::type = 0>
+inline scalar_t scatter_minimum(scalar_t a, scalar_t b) {
+  return (b < a || _isnan(b)) ? b : a;
+}
+
+template <typename scalar_t,
+          typename std::enable_if<c10::is_complex_t<scalar_t>::value, int>::type = 0>
+inline scalar_t scatter_minimum(scalar_t a, scalar_t b) {
+  TORCH_INTERNAL_ASSERT(false, "scatter_reduce_(): min is not supported for complex tensors");
+  return a;
+}
+
+// The reductions reduce a single element, for cpu_scatter_gather_base_kernel,
+// or a vector of them, for cpu_scatter_slices.
+struct ReduceAdd {
+  template <typename scalar_t>
+  void operator()(scalar_t* self_data, const scalar_t* src_data) const {
+    *self_data += *src_data;
+  }
+  template <typename scalar_t>
+  Vec256<scalar_t> operator()(const Vec256<scalar_t>& a, const Vec256<scalar_t>& b) const {
+    return a + b;
+  }
+};
+
+struct ReduceMultiply {
+  template <typename scalar_t>
+  void operator()(scalar_t* self_data, const scalar_t* src_data) const {
+    *self_data = *self_data * *src_data;
+  }
+  template <typename scalar_t>
+  Vec256<scalar_t> operator()(const Vec256<scalar_t>& a, const Vec256<scalar_t>& b) const {
+    return a * b;
+  }
+};
+
+struct ReduceMaximum {
+  template <typename scalar_t>
+  void operator()(scalar_t* self_data, const scalar_t* src_data) const {
+    *self_data = scatter_maximum(*self_data, *src_data);
+  }
+  template <typename scalar_t>
+  Vec256<scalar_t> operator()(const Vec256<scalar_t>& a, const Vec256<scalar_t>& b) const {
+    return vec256::maximum(a, b);
+  }
+};
+
+struct ReduceMinimum {
+  template <typename scalar_t>
+  void operator()(scalar_t* self_data, const scalar_t* src_data) const {
+    *self_data = scatter_minimum(*self_data, *src_data);
+  }
+  template <typename scalar_t>
+  Vec256<scalar_t> operator()(const Vec256<scalar_t>& a, const Vec256<scalar_t>& b) const {
+    return vec256::minimum(a, b);
+  }
+};
+
+// Whether src[..., i, ...] is reduced into self[..., index[i], ...] as a whole:
+// self and src are contiguous, nothing precedes dim, and index holds the same
+// value across all the dims following it. This is e.g. the message passing of
+// graph networks, where the index of the edges is expanded over the features.
+// A slice is then a contiguous row that can be reduced with Vec256.
+static bool can_scatter_slices(const Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  auto dtype = self.scalar_type();
+  if (!(isIntegralType(dtype, /*includeBool=*/false) || dtype == ScalarType::Float || dtype == ScalarType::Double)) {
+    return false;
+  }
+  if (index.dim() == 0 || index.dim() != self.dim() || index.dim() != src.dim() ||
+      index.scalar_type() != ScalarType::Long || src.scalar_type() != dtype) {
+    return false;
+  }
+  if (!self.is_contiguous() || !src.is_contiguous()) {
+    return false;
+  }
+  for (int64_t d = 0; d < index.dim(); d++) {
+    if (d == dim) {
+      continue;
     }
-  );
+    if (index.size(d) != self.size(d) || index.size(d) != src.size(d)) {
+      return false;
+    }
+    if (d < dim ? index.size(d) != 1 : (index.size(d) != 1 && index.stride(d) != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename scalar_t, typename op_t>
+void cpu_scatter_slices(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src, const op_t& op) {
+  using Vec = Vec256<scalar_t>;
+  auto self_dim_size = self.size(dim);
+  auto index_dim_size = index.size(dim);
+  auto index_dim_stride = index.stride(dim);
+  int64_t slice_size = 1;
+  for (int64_t d = dim + 1; d < self.dim(); d++) {
+    slice_size *= self.size(d);
+  }
+
+  auto* self_data = self.data_ptr<scalar_t>();
+  auto* src_data = src.data_ptr<scalar_t>();
+  auto* index_data = index.data_ptr<int64_t>();
+
+  std::vector<int64_t> rows(index_dim_size);
+  at::parallel_for(0, index_dim_size, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      int64_t idx_dim = index_data[i * index_dim_stride];
+      TORCH_CHECK(idx_dim >= 0 && idx_dim < self_dim_size,
+        "index ", idx_dim,
+        " is out of bounds for dimension ", dim,
+        " with size ", self_dim_size
+      );
+      rows[i] = idx_dim;
+    }
+  });
+
+  auto reduce_slice = [&](int64_t i) {
+    scalar_t* self_row = self_data + rows[i] * slice_size;
+    scalar_t* src_row = src_data + i * slice_size;
+    if (slice_size == 1) {
+      op(self_row, src_row);
+    } else {
+      vec256::map2<scalar_t>(
+        [&op](const Vec& a, const Vec& b) { return op(a, b); },
+        self_row, self_row, src_row, slice_size);
+    }
+  };
+
+  if (index_dim_size * slice_size < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
+      at::in_parallel_region()) {
+    for (int64_t i = 0; i < index_dim_size; i++) {
+      reduce_slice(i);
+    }
+    return;
+  }
+
+  // Each thread reduces into its own range of rows of self, in the order of
+  // the index, so that the result does not depend on the number of threads.
+  // A few buckets per thread balance uneven index distributions.
+  int64_t num_buckets = std::max<int64_t>(1, std::min<int64_t>(4 * at::get_num_threads(), self_dim_size));
+  std::vector<int32_t> bucket_of(index_dim_size);
+  at::parallel_for(0, index_dim_size, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      bucket_of[i] = rows[i] * num_buckets / self_dim_size;
+    }
+  });
+  std::vector<int64_t> bucket_offsets;
+  auto positions = group_positions_by_bucket(bucket_of, num_buckets, bucket_offsets);
+  at::parallel_for(0, num_buckets, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t j = bucket_offsets[begin]; j < bucket_offsets[end]; j++) {
+      reduce_slice(positions[j]);
+    }
+  });
+}
+
+template <typename op_t>
+void cpu_scatter_reduce(
+    Tensor& self, int64_t dim, const Tensor& index, const Tensor& src,
+    const std::string& method_name, const op_t& op) {
+  if (index.numel() == 0) {
+    return;
+  }
+  dim = maybe_wrap_dim(dim, self.dim());
+  if (!can_scatter_slices(self, dim, index, src)) {
+    cpu_scatter_gather_base_kernel<>()(self, dim, index, src, method_name, op);
+    return;
+  }
+  scatter_gather_dtype_check(method_name, self, index, src);
+  scatter_shape_check(self, dim, index, src);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), method_name, [&] {
+    cpu_scatter_slices<scalar_t>(self, dim, index, src, op);
+  });
+}
+
+void scatter_add_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  cpu_scatter_reduce(self, dim, index, src, "scatter_add_", ReduceAdd());
+}
+
+void scatter_reduce_cpu_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src,
+                               SCATTER_GATHER_OP reduce) {
+  switch (reduce) {
+    case SCATTER_GATHER_OP::REDUCE_ADD:
+      cpu_scatter_reduce(self, dim, index, src, "scatter_reduce_", ReduceAdd());
+      break;
+    case SCATTER_GATHER_OP::REDUCE_MULTIPLY:
+      cpu_scatter_reduce(self, dim, index, src, "scatter_reduce_", ReduceMultiply());
+      break;
+    case SCATTER_GATHER_OP::REDUCE_MAXIMUM:
+      cpu_scatter_reduce(self, dim, index, src, "scatter_reduce_", ReduceMaximum());
+      break;
+    case SCATTER_GATHER_OP::REDUCE_MINIMUM:
+      cpu_scatter_reduce(self, dim, index, src, "scatter_reduce_", ReduceMinimum());
+      break;
+  }
 }
 
 } // anonymous namespace
@@ -192,5 +402,6 @@ REGISTER_DISPATCH(gather_stub, &gather_cpu_kernel);
 REGISTER_DISPATCH(scatter_stub, &scatter_cpu_kernel);
 REGISTER_DISPATCH(scatter_fill_stub, &scatter_fill_cpu_kernel);
 REGISTER_DISPATCH(scatter_add_stub, &scatter_add_cpu_kernel);
+REGISTER_DISPATCH(scatter_reduce_stub, &scatter_reduce_cpu_kernel);
 
 }} // namespace at::native
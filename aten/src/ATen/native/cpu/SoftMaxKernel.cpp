@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <vector>
 
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
@@ -223,10 +224,131 @@ struct vec_host_softmax_backward_lastdim {
   }
 };
 
+// BFloat16 rows are converted to float, computed on in float, so that the
+// sums accumulate in float, and converted back.
+template <bool LogSoftMax>
+struct vec_host_softmax_lastdim<BFloat16, LogSoftMax> {
+  static void apply(Tensor& output, const Tensor& input) {
+    using Vec = vec256::Vec256<float>;
+    int64_t outer_size = 1;
+    int64_t dim_size = input.size(input.ndimension() - 1);
+    for (int64_t i = 0; i < input.ndimension() - 1; ++i)
+      outer_size *= input.size(i);
+    BFloat16* input_data_base = input.data_ptr<BFloat16>();
+    BFloat16* output_data_base = output.data_ptr<BFloat16>();
+    int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+    if (grain_size < 1)
+      grain_size = 1;
+
+    parallel_for(
+        0,
+        outer_size,
+        grain_size,
+        [&](int64_t begin, int64_t end) {
+          std::vector<float> buffer(dim_size);
+          float* data = buffer.data();
+          for (int64_t i = begin; i < end; i++) {
+            vec256::convert(input_data_base + i * dim_size, data, dim_size);
+            float max_input = vec256::reduce_all<float>(
+                [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+                data,
+                dim_size);
+            if (LogSoftMax) {
+              float tmp_sum = vec256::map_reduce_all<float>(
+                  [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+                  [](Vec x, Vec y) { return x + y; },
+                  data,
+                  dim_size);
+              // See [Note AVX-SSE transitions]
+              vec256::map([](Vec x) { return x.log(); }, &tmp_sum, &tmp_sum, 1);
+              vec256::map(
+                  [tmp_sum, max_input](Vec x) { return x - Vec(max_input) - Vec(tmp_sum); },
+                  data,
+                  data,
+                  dim_size);
+            } else {
+              vec256::map(
+                  [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
+                  data,
+                  data,
+                  dim_size);
+              float tmp_sum = vec256::reduce_all<float>(
+                  [](Vec x, Vec y) { return x + y; }, data, dim_size);
+              tmp_sum = 1 / tmp_sum;
+              vec256::map(
+                  [tmp_sum](Vec x) { return x * Vec(tmp_sum); },
+                  data,
+                  data,
+                  dim_size);
+            }
+            vec256::convert(data, output_data_base + i * dim_size, dim_size);
+          }
+        });
+  }
+};
+
+template <bool LogSoftMax>
+struct vec_host_softmax_backward_lastdim<BFloat16, LogSoftMax> {
+  static void
+  apply(Tensor& grad_input, const Tensor& grad, const Tensor& output) {
+    using Vec = vec256::Vec256<float>;
+    int64_t outer_size = 1;
+    int64_t dim_size = grad.size(grad.ndimension() - 1);
+    for (int64_t i = 0; i < grad.ndimension() - 1; ++i)
+      outer_size *= grad.size(i);
+    BFloat16* grad_input_data_base = grad_input.data_ptr<BFloat16>();
+    BFloat16* grad_data_base = grad.data_ptr<BFloat16>();
+    BFloat16* output_data_base = output.data_ptr<BFloat16>();
+    int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+    if (grain_size < 1)
+      grain_size = 1;
+
+    parallel_for(
+        0,
+        outer_size,
+        grain_size,
+        [&](int64_t begin, int64_t end) {
+          std::vector<float> buffer(2 * dim_size);
+          float* grad_data = buffer.data();
+          float* output_data = buffer.data() + dim_size;
+          for (int64_t i = begin; i < end; i++) {
+            vec256::convert(grad_data_base + i * dim_size, grad_data, dim_size);
+            vec256::convert(output_data_base + i * dim_size, output_data, dim_size);
+            float sum;
+            if (LogSoftMax) {
+              sum = vec256::reduce_all<float>(
+                  [](Vec& x, Vec& y) { return x + y; }, grad_data, dim_size);
+              vec256::map2(
+                  [sum](Vec x, Vec y) { return x - ((y.exp()) * Vec(sum)); },
+                  grad_data,
+                  grad_data,
+                  output_data,
+                  dim_size);
+            } else {
+              sum = vec256::map2_reduce_all<float>(
+                  [](Vec x, Vec y) { return x * y; },
+                  [](Vec x, Vec y) { return x + y; },
+                  grad_data,
+                  output_data,
+                  dim_size);
+              vec256::map2(
+                  [sum](Vec x, Vec y) { return (x - Vec(sum)) * y; },
+                  grad_data,
+                  grad_data,
+                  output_data,
+                  dim_size);
+            }
+            vec256::convert(grad_data, grad_input_data_base + i * dim_size, dim_size);
+          }
+        });
+  }
+};
+
 static void softmax_lastdim_kernel_impl(Tensor& result, const Tensor& self) {
-  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_lastdim_kernel_impl", [&] {
-    vec_host_softmax_lastdim<scalar_t, false>::apply(result, self);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, self.scalar_type(),
+      "softmax_lastdim_kernel_impl",
+      [&] { vec_host_softmax_lastdim<scalar_t, false>::apply(result, self); });
 }
 
 static void log_softmax_lastdim_kernel_impl(
@@ -242,8 +364,9 @@ static void softmax_backward_lastdim_kernel_impl(
     Tensor& grad_input,
     const Tensor& grad,
     const Tensor& output) {
-  AT_DISPATCH_FLOATING_TYPES(
-      grad.scalar_type(), "softmax_backward_lastdim_kernel_impl", [&] {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "softmax_backward_lastdim_kernel_impl", [&] {
         vec_host_softmax_backward_lastdim<scalar_t, false>::apply(
             grad_input, grad, output);
       });
@@ -0,0 +1,120 @@
+#include <ATen/native/sparse/SparseCsrTensorMath.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native { namespace {
+
+// Rows are independent in CSR, so both kernels split the rows among threads,
+// and every thread writes only to its own rows of the result. The grain size
+// is a number of rows chosen so that a task touches about GRAIN_SIZE elements.
+int64_t rows_grain_size(int64_t rows, int64_t nnz, int64_t work_per_nnz) {
+  int64_t work_per_row = std::max<int64_t>(nnz / std::max<int64_t>(rows, 1), 1) * work_per_nnz;
+  return std::max<int64_t>(internal::GRAIN_SIZE / work_per_row, 1);
+}
+
+template <typename scalar_t>
+void addmm_sparse_csr_kernel(
+    Tensor& result,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const Tensor& dense,
+    Scalar alpha) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t dim_i = result.size(0);
+  const int64_t dim_k = dense.size(1);
+  const int64_t* crow = crow_indices.data_ptr<int64_t>();
+  const int64_t* col = col_indices.data_ptr<int64_t>();
+  const scalar_t* vals = values.data_ptr<scalar_t>();
+  const scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+  scalar_t* result_ptr = result.data_ptr<scalar_t>();
+  const scalar_t cast_alpha = alpha.to<scalar_t>();
+
+  at::parallel_for(0, dim_i, rows_grain_size(dim_i, values.size(0), dim_k), [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t* out_row = result_ptr + i * dim_k;
+      for (int64_t p = crow[i]; p < crow[i + 1]; p++) {
+        const int64_t j = col[p];
+        // out_row += alpha * value * dense[j]
+        const scalar_t scale = cast_alpha * vals[p];
+        const Vec scale_vec(scale);
+        const scalar_t* dense_row = dense_ptr + j * dim_k;
+        int64_t k = 0;
+        for (; k + Vec::size() <= dim_k; k += Vec::size()) {
+          Vec out = vec256::fmadd(scale_vec, Vec::loadu(dense_row + k), Vec::loadu(out_row + k));
+          out.store(out_row + k);
+        }
+        for (; k < dim_k; k++) {
+          out_row[k] += scale * dense_row[k];
+        }
+      }
+    }
+  });
+}
+
+void addmm_sparse_csr_kernel_impl(
+    Tensor& result,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const Tensor& dense,
+    Scalar alpha) {
+  AT_DISPATCH_ALL_TYPES(values.scalar_type(), "addmm_sparse_csr", [&] {
+    addmm_sparse_csr_kernel<scalar_t>(result, crow_indices, col_indices, values, dense, alpha);
+  });
+}
+
+// Vec256 has no gather, so each row is a scalar dot product over its
+// elements; the four accumulators break the dependency on a single sum.
+template <typename scalar_t>
+void mv_sparse_csr_kernel(
+    Tensor& result,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const Tensor& vec) {
+  const int64_t dim_i = result.size(0);
+  const int64_t* crow = crow_indices.data_ptr<int64_t>();
+  const int64_t* col = col_indices.data_ptr<int64_t>();
+  const scalar_t* vals = values.data_ptr<scalar_t>();
+  const scalar_t* vec_ptr = vec.data_ptr<scalar_t>();
+  scalar_t* result_ptr = result.data_ptr<scalar_t>();
+
+  at::parallel_for(0, dim_i, rows_grain_size(dim_i, values.size(0), 1), [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      scalar_t acc[4] = {0, 0, 0, 0};
+      int64_t p = crow[i];
+      const int64_t row_end = crow[i + 1];
+      for (; p + 4 <= row_end; p += 4) {
+        acc[0] += vals[p] * vec_ptr[col[p]];
+        acc[1] += vals[p + 1] * vec_ptr[col[p + 1]];
+        acc[2] += vals[p + 2] * vec_ptr[col[p + 2]];
+        acc[3] += vals[p + 3] * vec_ptr[col[p + 3]];
+      }
+      for (; p < row_end; p++) {
+        acc[0] += vals[p] * vec_ptr[col[p]];
+      }
+      result_ptr[i] = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+  });
+}
+
+void mv_sparse_csr_kernel_impl(
+    Tensor& result,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const Tensor& vec) {
+  AT_DISPATCH_ALL_TYPES(values.scalar_type(), "mv_sparse_csr", [&] {
+    mv_sparse_csr_kernel<scalar_t>(result, crow_indices, col_indices, values, vec);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(addmm_sparse_csr_stub, &addmm_sparse_csr_kernel_impl);
+REGISTER_DISPATCH(mv_sparse_csr_stub, &mv_sparse_csr_kernel_impl);
+
+}} // namespace at::native
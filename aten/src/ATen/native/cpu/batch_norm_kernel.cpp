@@ -1,10 +1,13 @@
 #include <ATen/native/batch_norm.h>
 
 #include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/native/cpu/MultiReduce.h>
 
 namespace at { namespace native {
 namespace {
@@ -107,8 +110,51 @@ void batch_norm_cpu_inference_contiguous_kernel(Tensor& output, const Tensor& in
   });
 }
 
+/// Computes the mean of every channel of the input and the sum of the squared
+/// deviations from it, in a single pass over the input with Welford's
+/// algorithm. The input of a channel is reduced with Vec256 where it is
+/// contiguous, i.e. over the images of channels first inputs.
+template<typename scalar_t>
+void batch_norm_cpu_collect_stats_impl(
+    const Tensor& input, Tensor& mean, Tensor& var_sum) {
+
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  using ops_t = WelfordVecOps<scalar_t, accscalar_t>;
+  const ops_t ops(/*unbiased=*/false, /*take_sqrt=*/false);
+  int64_t n_channel = input.size(1);
+  auto mean_a = mean.accessor<scalar_t, 1>();
+  auto var_sum_a = var_sum.accessor<scalar_t, 1>();
+
+  at::parallel_for(0, n_channel, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      auto iter = TensorIteratorConfig()
+        .add_input(input.select(1, c))
+        .build();
+      typename ops_t::acc_t acc;
+      iter.serial_for_each([&](char** data, const int64_t* strides, int64_t size) {
+        acc = multi_reduce_range(
+          acc,
+          reinterpret_cast<const scalar_t*>(data[0]),
+          strides[0] / static_cast<int64_t>(sizeof(scalar_t)),
+          size,
+          ops);
+      }, {0, iter.numel()});
+      mean_a[c] = acc.mean;
+      var_sum_a[c] = acc.m2;
+    }
+  });
+}
+
+void batch_norm_cpu_collect_stats_kernel(
+    const Tensor& input, Tensor& mean, Tensor& var_sum) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_collect_stats", [&] {
+    batch_norm_cpu_collect_stats_impl<scalar_t>(input, mean, var_sum);
+  });
+}
+
 }// anonymous namespace
 
 REGISTER_DISPATCH(batch_norm_cpu_inference_contiguous_stub, &batch_norm_cpu_inference_contiguous_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_collect_stats_stub, &batch_norm_cpu_collect_stats_kernel);
 
 }} // namespace at::native
@@ -8,6 +8,7 @@
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/cpu/MultiReduce.h>
 
 namespace at {
 namespace native {
@@ -43,29 +44,12 @@ void GroupNormKernelImplInternal(
   const bool beta_null = beta_data == nullptr;
 
   at::parallel_for(0, N * G, 1, [&](int64_t start, int64_t end) {
-    constexpr int64_t K = vec256::Vec256<T>::size();
-    const int64_t inner_size = D * HxW / K * K;
-    std::array<T, K> mean_arr;
-    std::array<T, K> rstd_arr;
     for (int64_t i = start; i < end; ++i) {
       const T* X_ptr = X_data + i * D * HxW;
-      vec256::Vec256<T> mean_vec(0);
-      vec256::Vec256<T> rstd_vec(0);
-      for (int64_t j = 0; j < inner_size; j += K) {
-        const vec256::Vec256<T> x_vec = vec256::Vec256<T>::loadu(X_ptr + j);
-        mean_vec = mean_vec + x_vec;
-        rstd_vec = rstd_vec + x_vec * x_vec;
-      }
-      mean_vec.store(mean_arr.data());
-      rstd_vec.store(rstd_arr.data());
-      T mean_val = std::accumulate(mean_arr.cbegin(), mean_arr.cend(), T(0));
-      T rstd_val = std::accumulate(rstd_arr.cbegin(), rstd_arr.cend(), T(0));
-      for (int64_t j = inner_size; j < D * HxW; ++j) {
-        mean_val += X_ptr[j];
-        rstd_val += X_ptr[j] * X_ptr[j];
-      }
-      mean_val *= s;
-      rstd_val = std::max(rstd_val * s - mean_val * mean_val, T(0));
+      const SumSqData<T> moments = multi_reduce_range(
+          SumSqData<T>(), X_ptr, 1, D * HxW, SumSqVecOps<T, T>());
+      T mean_val = moments.sum * s;
+      T rstd_val = std::max(moments.sumsq * s - mean_val * mean_val, T(0));
       rstd_val = T(1) / std::sqrt(rstd_val + eps);
 
       const int64_t g = i % G;
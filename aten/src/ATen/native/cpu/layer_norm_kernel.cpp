@@ -1,12 +1,14 @@
 #include <ATen/native/layer_norm.h>
 
 #include <cmath>
+#include <vector>
 
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/cpu/MultiReduce.h>
 
 namespace at {
 namespace native {
@@ -20,11 +22,10 @@ void LayerNormKernelImplInternal(
     const Tensor& beta,
     int64_t M,
     int64_t N,
-    T eps,
+    double eps,
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  using Vec = vec256::Vec256<T>;
   DCHECK_EQ(X.numel(), M * N);
   DCHECK(!gamma.defined() || gamma.numel() == N);
   DCHECK(!beta.defined() || beta.numel() == N);
@@ -41,18 +42,11 @@ void LayerNormKernelImplInternal(
     for (int64_t i = start; i < end; ++i) {
       T* X_ptr = X_data + i * N;
       T* Y_ptr = Y_data + i * N;
-      T mean_val = vec256::reduce_all<T>(
-          [](Vec& x, Vec& y) { return x + y; },
-          X_ptr,
-          N);
-      T rstd_val = vec256::map_reduce_all<T>(
-          [](Vec x) { return x * x; },
-          [](Vec x, Vec y) { return x + y; },
-          X_ptr,
-          N);
-      mean_val *= c;
-      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
-      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      const SumSqData<T> moments =
+          multi_reduce_range(SumSqData<T>(), X_ptr, 1, N, SumSqVecOps<T, T>());
+      T mean_val = moments.sum * c;
+      T rstd_val = std::max(moments.sumsq * c - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + static_cast<T>(eps));
       const T scale = rstd_val;
       const T bias = -rstd_val * mean_val;
       for (int64_t j = 0; j < N; ++j) {
@@ -66,7 +60,12 @@ void LayerNormKernelImplInternal(
   });
 }
 
-void LayerNormKernelImpl(
+// BFloat16 rows are normalized in float: they are converted to float, the
+// moments accumulate in float, and gamma and beta are converted to float once.
+// mean and rstd are float tensors (see layer_norm_cpu), so that the backward
+// pass uses the statistics the forward pass normalized with.
+template <>
+void LayerNormKernelImplInternal<BFloat16>(
     const Tensor& X,
     const Tensor& gamma,
     const Tensor& beta,
@@ -76,12 +75,71 @@ void LayerNormKernelImpl(
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "LayerNormKernelImpl", [&]() {
-    LayerNormKernelImplInternal<scalar_t>(
-        X, gamma, beta, M, N, static_cast<scalar_t>(eps), Y, mean, rstd);
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  using Vec = vec256::Vec256<float>;
+  const BFloat16* X_data = X.data_ptr<BFloat16>();
+  BFloat16* Y_data = Y->data_ptr<BFloat16>();
+  float* mean_data = mean->data_ptr<float>();
+  float* rstd_data = rstd->data_ptr<float>();
+  std::vector<float> gamma_f(N, 1.0f);
+  std::vector<float> beta_f(N, 0.0f);
+  if (gamma.defined()) {
+    vec256::convert(gamma.data_ptr<BFloat16>(), gamma_f.data(), N);
+  }
+  if (beta.defined()) {
+    vec256::convert(beta.data_ptr<BFloat16>(), beta_f.data(), N);
+  }
+  const float c = 1.0f / static_cast<float>(N);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    std::vector<float> buffer(N);
+    float* X_ptr = buffer.data();
+    for (int64_t i = start; i < end; ++i) {
+      vec256::convert(X_data + i * N, X_ptr, N);
+      const SumSqData<float> moments = multi_reduce_range(
+          SumSqData<float>(), X_ptr, 1, N, SumSqVecOps<float, float>());
+      float mean_val = moments.sum * c;
+      float rstd_val =
+          std::max(moments.sumsq * c - mean_val * mean_val, 0.0f);
+      rstd_val = 1.0f / std::sqrt(rstd_val + static_cast<float>(eps));
+      const float scale = rstd_val;
+      const float bias = -rstd_val * mean_val;
+      const Vec scale_vec(scale);
+      const Vec bias_vec(bias);
+      int64_t j = 0;
+      for (; j + Vec::size() <= N; j += Vec::size()) {
+        const Vec x = vec256::fmadd(Vec::loadu(X_ptr + j), scale_vec, bias_vec);
+        vec256::fmadd(x, Vec::loadu(gamma_f.data() + j), Vec::loadu(beta_f.data() + j))
+            .store(X_ptr + j);
+      }
+      for (; j < N; ++j) {
+        X_ptr[j] = (X_ptr[j] * scale + bias) * gamma_f[j] + beta_f[j];
+      }
+      vec256::convert(X_ptr, Y_data + i * N, N);
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
   });
 }
 
+void LayerNormKernelImpl(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormKernelImpl", [&]() {
+        LayerNormKernelImplInternal<scalar_t>(
+            X, gamma, beta, M, N, eps, Y, mean, rstd);
+      });
+}
+
 template <typename T>
 void LayerNormBackwardKernelImplInternal(
     const Tensor& dY,
@@ -151,6 +209,130 @@ void LayerNormBackwardKernelImplInternal(
   }
 }
 
+// As the forward pass, in float. The rows are split into a chunk per thread,
+// and dX of every row is computed by the thread of its chunk. Every chunk
+// accumulates dgamma and dbeta of its rows in float. The chunks are then summed
+// in order and converted once.
+template <>
+void LayerNormBackwardKernelImplInternal<BFloat16>(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    Tensor* dX,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  using Vec = vec256::Vec256<float>;
+  DCHECK_EQ(dY.numel(), M * N);
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(mean.numel(), M);
+  DCHECK_EQ(rstd.numel(), M);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  // The forward pass returns float statistics; BFloat16 ones passed in by a
+  // caller are widened.
+  const Tensor mean_f = mean.to(ScalarType::Float).contiguous();
+  const Tensor rstd_f = rstd.to(ScalarType::Float).contiguous();
+  const BFloat16* dY_data = dY.data_ptr<BFloat16>();
+  const BFloat16* X_data = X.data_ptr<BFloat16>();
+  const float* mean_data = mean_f.data_ptr<float>();
+  const float* rstd_data = rstd_f.data_ptr<float>();
+  BFloat16* dX_data = dX->defined() ? dX->data_ptr<BFloat16>() : nullptr;
+  BFloat16* dgamma_data = dgamma->defined() ? dgamma->data_ptr<BFloat16>() : nullptr;
+  BFloat16* dbeta_data = dbeta->defined() ? dbeta->data_ptr<BFloat16>() : nullptr;
+  std::vector<float> gamma_f(N, 1.0f);
+  if (gamma.defined()) {
+    vec256::convert(gamma.data_ptr<BFloat16>(), gamma_f.data(), N);
+  }
+  const int64_t num_chunks = std::min<int64_t>(at::get_num_threads(), M);
+  std::vector<float> dgamma_acc(dgamma_data != nullptr ? num_chunks * N : 0, 0.0f);
+  std::vector<float> dbeta_acc(dbeta_data != nullptr ? num_chunks * N : 0, 0.0f);
+  const float scale = 1.0f / static_cast<float>(N);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<float> buffer(2 * N);
+    float* dY_ptr = buffer.data();
+    float* X_ptr = buffer.data() + N;
+    for (int64_t k = begin; k < end; ++k) {
+      float* dgamma_ptr = dgamma_data != nullptr ? dgamma_acc.data() + k * N : nullptr;
+      float* dbeta_ptr = dbeta_data != nullptr ? dbeta_acc.data() + k * N : nullptr;
+      for (int64_t i = k * M / num_chunks; i < (k + 1) * M / num_chunks; ++i) {
+        vec256::convert(dY_data + i * N, dY_ptr, N);
+        vec256::convert(X_data + i * N, X_ptr, N);
+        const float a = rstd_data[i];
+        const float mean_val = mean_data[i];
+        if (dgamma_ptr != nullptr) {
+          const float b = -a * mean_val;
+          const Vec a_vec(a);
+          const Vec b_vec(b);
+          int64_t j = 0;
+          for (; j + Vec::size() <= N; j += Vec::size()) {
+            const Vec x_hat = vec256::fmadd(a_vec, Vec::loadu(X_ptr + j), b_vec);
+            vec256::fmadd(Vec::loadu(dY_ptr + j), x_hat, Vec::loadu(dgamma_ptr + j))
+                .store(dgamma_ptr + j);
+          }
+          for (; j < N; ++j) {
+            dgamma_ptr[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+          }
+        }
+        if (dbeta_ptr != nullptr) {
+          vec256::map2(
+              [](Vec x, Vec y) { return x + y; }, dbeta_ptr, dbeta_ptr, dY_ptr, N);
+        }
+        if (dX_data != nullptr) {
+          Vec ds_vec(0.0f);
+          Vec db_vec(0.0f);
+          int64_t j = 0;
+          for (; j + Vec::size() <= N; j += Vec::size()) {
+            const Vec dy_gamma = Vec::loadu(dY_ptr + j) * Vec::loadu(gamma_f.data() + j);
+            ds_vec = vec256::fmadd(dy_gamma, Vec::loadu(X_ptr + j), ds_vec);
+            db_vec = db_vec + dy_gamma;
+          }
+          auto add = [](Vec x, Vec y) { return x + y; };
+          float ds = vec256::vec_reduce_all<float>(add, ds_vec, Vec::size());
+          float db = vec256::vec_reduce_all<float>(add, db_vec, Vec::size());
+          for (; j < N; ++j) {
+            ds += dY_ptr[j] * X_ptr[j] * gamma_f[j];
+            db += dY_ptr[j] * gamma_f[j];
+          }
+          const float b = (db * mean_val - ds) * a * a * a * scale;
+          const float c = -b * mean_val - db * a * scale;
+          // dY is no longer needed for this row, so dX is computed in its place
+          const Vec a_vec(a);
+          const Vec b_vec(b);
+          const Vec c_vec(c);
+          for (j = 0; j + Vec::size() <= N; j += Vec::size()) {
+            const Vec dy_gamma = a_vec * Vec::loadu(dY_ptr + j) * Vec::loadu(gamma_f.data() + j);
+            (dy_gamma + vec256::fmadd(b_vec, Vec::loadu(X_ptr + j), c_vec)).store(dY_ptr + j);
+          }
+          for (; j < N; ++j) {
+            dY_ptr[j] = a * dY_ptr[j] * gamma_f[j] + b * X_ptr[j] + c;
+          }
+          vec256::convert(dY_ptr, dX_data + i * N, N);
+        }
+      }
+    }
+  });
+  auto sum_chunks = [&](std::vector<float>& acc, BFloat16* out) {
+    for (int64_t k = 1; k < num_chunks; ++k) {
+      vec256::map2(
+          [](Vec x, Vec y) { return x + y; },
+          acc.data(),
+          acc.data(),
+          acc.data() + k * N,
+          N);
+    }
+    vec256::convert(acc.data(), out, N);
+  };
+  if (dgamma_data != nullptr) {
+    sum_chunks(dgamma_acc, dgamma_data);
+  }
+  if (dbeta_data != nullptr) {
+    sum_chunks(dbeta_acc, dbeta_data);
+  }
+}
+
 void LayerNormBackwardKernelImpl(
     const Tensor& dY,
     const Tensor& X,
@@ -162,8 +344,8 @@ void LayerNormBackwardKernelImpl(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
-  AT_DISPATCH_FLOATING_TYPES(
-      X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
         LayerNormBackwardKernelImplInternal<scalar_t>(
             dY, X, mean, rstd, gamma, M, N, dX, dgamma, dbeta);
       });
@@ -25,8 +25,13 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_cpu(
     int64_t N,
     double eps) {
   Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
-  Tensor mean = at::empty({M}, X.options());
-  Tensor rstd = at::empty({M}, X.options());
+  // BFloat16 inputs are normalized in float, and their statistics are kept
+  // in float for the backward pass.
+  const auto stats_options = X.scalar_type() == kBFloat16
+      ? X.options().dtype(kFloat)
+      : X.options();
+  Tensor mean = at::empty({M}, stats_options);
+  Tensor rstd = at::empty({M}, stats_options);
   if (M > 0) {
     LayerNormKernel(kCPU, X, gamma, beta, M, N, eps, &Y, &mean, &rstd);
   }
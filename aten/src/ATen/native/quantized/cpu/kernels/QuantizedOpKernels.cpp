@@ -163,7 +163,7 @@ int64_t hsum(const uint8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v = _mm256_setzero_si256();
   __m256i one_epi16_v = _mm256_set1_epi16(1);
   __m256i one_epi8_v = _mm256_set1_epi8(1);
@@ -184,7 +184,7 @@ int64_t hsum(const uint8_t* A, int len) {
   for (int k = 0; k < 8; ++k) {
     row_sum += temp[k];
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -199,7 +199,7 @@ int64_t hsum(const int8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v = _mm256_setzero_si256();
   __m256i one_epi16_v = _mm256_set1_epi16(1);
   __m256i one_epi8_v = _mm256_set1_epi8(1);
@@ -220,7 +220,7 @@ int64_t hsum(const int8_t* A, int len) {
   for (int k = 0; k < 8; ++k) {
     row_sum += temp[k];
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -235,7 +235,7 @@ int64_t hsum(const int32_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_epi64 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 8 * 8; i += 8) {
@@ -255,7 +255,7 @@ int64_t hsum(const int32_t* A, int len) {
   for (int k = 0; k < 4; ++k) {
     row_sum += temp[k];
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -270,7 +270,7 @@ int64_t hsum_sq(const uint8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v_epu32 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 16 * 16; i += 16) {
@@ -296,7 +296,7 @@ int64_t hsum_sq(const uint8_t* A, int len) {
   for (int k = 0; k < 8; ++k) {
     row_sum += temp[k];
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -311,7 +311,7 @@ int64_t hsum_sq(const int8_t* A, int len) {
   int64_t row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256i sum_v_epi32 = _mm256_setzero_si256();
   // vectorized
   for (; i < len / 16 * 16; i += 16) {
@@ -337,7 +337,7 @@ int64_t hsum_sq(const int8_t* A, int len) {
   for (int k = 0; k < 8; ++k) {
     row_sum += temp[k];
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -353,7 +353,7 @@ float hsum_sq(const int32_t* A, int len) {
   float row_sum = 0;
   int i = 0;
 
-#ifdef CPU_CAPABILITY_AVX2
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
   __m256 sum_ps = _mm256_setzero_ps();
   // vectorized
   for (; i < len / 8 * 8; i += 8) {
@@ -367,7 +367,7 @@ float hsum_sq(const int32_t* A, int len) {
   for (int k = 0; k < 8; ++k) {
     row_sum += static_cast<float>(temp[k]);
   }
-#endif // CPU_CAPABILITY_AVX2
+#endif // CPU_CAPABILITY_AVX2 || CPU_CAPABILITY_AVX512
 
   // scalar
   for (; i < len; ++i) {
@@ -1148,7 +1148,7 @@ void do_avg_pool_nhwc_on_AVX2(
     int hsize,
     int wsize,
     int csize) {
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   // buffer for channel accumulator, used to interchange channel-loop
   // to inner-most, so that memory access of the input tensor data is
   // continuous.
@@ -1158,7 +1158,7 @@ void do_avg_pool_nhwc_on_AVX2(
   Vec256<int32_t> acc_buffer[cb_size];
   Vec256<float> acc_buffer_fp[cb_size];
 
-  if (vec_width == 8) {
+  if (vec_width == Vec256<int32_t>::size()) {
     for (int c = c_start; c < csize; c += cb_step) {
       int cend = std::min(cb_size, (csize - c) / vec_width);
       // initialize loop
@@ -1184,9 +1184,13 @@ void do_avg_pool_nhwc_on_AVX2(
       // convert int32 accumulative to fp32
       vec256::convert((int*)acc_buffer, (float*)acc_buffer_fp, cend * vec_width);
 
-      // first quantize using AVX using 32 lanes, then 8, finally falls
-      // back to single
+      // first quantize using AVX using 32 lanes (64 with AVX512), then 8,
+      // finally falls back to single
+#ifdef CPU_CAPABILITY_AVX512
+      QuantizeAvx512<T>(
+#else
       QuantizeAvx2<T>(
+#endif
           (float*)acc_buffer_fp,
           o_p + c,
           cend * vec_width,
@@ -1218,9 +1222,9 @@ void do_avg_pool_on_AVX2(
     int64_t stride_D,
     int64_t stride_H,
     int64_t stride_W) {
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   constexpr auto vec_width = Vec256<T>::size() / 4;
-  if (vec_width == 8) {
+  if (vec_width == Vec256<int32_t>::size()) {
     for (; c + vec_width <= channel_size; c += vec_width) {
       int64_t tcntr = 0;
 
@@ -1573,9 +1577,9 @@ int64_t do_quantized_bilinear_on_AVX2(
     const int64_t h1p,
     const int64_t w1p) {
   int64_t c = 0;
-#if defined(CPU_CAPABILITY_AVX2) && !defined(_MSC_VER)
+#if (defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)) && !defined(_MSC_VER)
   constexpr auto vec_width = Vec256<T>::size() / 4;
-  if (vec_width == 8) {
+  if (vec_width == Vec256<int32_t>::size()) {
     for (; c + vec_width <= channels; c += vec_width) {
       Vec256<float> pos1_fp_v[4];
       Vec256<int32_t> pos1_int_v[4];
@@ -1591,7 +1595,7 @@ int64_t do_quantized_bilinear_on_AVX2(
         float pos1_fp[vec_width];
         pos1_int_v[i].store(pos1_int);
         vec256::convert(pos1_int, pos1_fp, vec_width);
-        pos1_fp_v[i] = Vec256<float>::loadu(pos1_fp, 8);
+        pos1_fp_v[i] = Vec256<float>::loadu(pos1_fp, vec_width);
       }
       Vec256<float> h0lambda_v(h0lambda);
       Vec256<float> h1lambda_v(h1lambda);
@@ -2137,6 +2141,109 @@ void quantized_normalize_kernel(
   });
 }
 
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
+template <typename T>
+__m256i cvt_8bit_epi16(__m128i src);
+
+template <>
+__m256i cvt_8bit_epi16<uint8_t>(__m128i src) {
+  return _mm256_cvtepu8_epi16(src);
+}
+
+template <>
+__m256i cvt_8bit_epi16<int8_t>(__m128i src) {
+  return _mm256_cvtepi8_epi16(src);
+}
+#endif
+
+// Dot product of two rows of 8-bit values with their zero points subtracted.
+// The result is accumulated in int64, so it does not overflow for any len.
+template <typename T>
+int64_t dot_zero_point_adjusted(
+    const T* a,
+    const T* b,
+    int64_t len,
+    int32_t a_zero_point,
+    int32_t b_zero_point) {
+  int64_t acc = 0;
+  int64_t i = 0;
+#if defined(CPU_CAPABILITY_AVX2) || defined(CPU_CAPABILITY_AVX512)
+  // The adjusted values lie in [-255, 255], so each int32 lane of
+  // _mm256_madd_epi16 gains at most 2 * 255 * 255 per step. Lanes are
+  // flushed to the int64 accumulator every kBlock values, long before they
+  // can overflow.
+  constexpr int64_t kBlock = 1 << 14;
+  const __m256i a_zero_point_v = _mm256_set1_epi16(a_zero_point);
+  const __m256i b_zero_point_v = _mm256_set1_epi16(b_zero_point);
+  const int64_t vec_len = len / 16 * 16;
+  while (i < vec_len) {
+    const int64_t block_end = std::min(vec_len, i + kBlock);
+    __m256i sum_v = _mm256_setzero_si256();
+    for (; i < block_end; i += 16) {
+      __m256i a_v = _mm256_sub_epi16(
+          cvt_8bit_epi16<T>(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))),
+          a_zero_point_v);
+      __m256i b_v = _mm256_sub_epi16(
+          cvt_8bit_epi16<T>(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))),
+          b_zero_point_v);
+      sum_v = _mm256_add_epi32(sum_v, _mm256_madd_epi16(a_v, b_v));
+    }
+    int32_t sums[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum_v);
+    for (int j = 0; j < 8; ++j) {
+      acc += sums[j];
+    }
+  }
+#endif
+  for (; i < len; ++i) {
+    acc += (static_cast<int64_t>(a[i]) - a_zero_point) *
+        (static_cast<int64_t>(b[i]) - b_zero_point);
+  }
+  return acc;
+}
+
+// qa is [batch, M, K] and qbt is [batch, N, K], both contiguous, so that
+// every output element is the dot product of two contiguous rows.
+void qmatmul_kernel(
+    const Tensor& qa,
+    const Tensor& qbt,
+    Tensor& qc,
+    double multiplier,
+    int64_t output_zero_point) {
+  const int64_t batch = qa.size(0);
+  const int64_t M = qa.size(1);
+  const int64_t K = qa.size(2);
+  const int64_t N = qbt.size(1);
+  const int32_t a_zero_point = qa.q_zero_point();
+  const int32_t b_zero_point = qbt.q_zero_point();
+
+  AT_DISPATCH_QINT_TYPES(qa.scalar_type(), "qmatmul", [&]() {
+    const underlying_t* a_data =
+        reinterpret_cast<const underlying_t*>(qa.data_ptr<scalar_t>());
+    const underlying_t* bt_data =
+        reinterpret_cast<const underlying_t*>(qbt.data_ptr<scalar_t>());
+    scalar_t* c_data = qc.data_ptr<scalar_t>();
+    const int64_t grain_size =
+        std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(N * K, 1), 1);
+    // One task is a row of the output of one batch entry.
+    at::parallel_for(0, batch * M, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t row = begin; row < end; row++) {
+        const int64_t b = row / M;
+        const underlying_t* a = a_data + row * K;
+        for (int64_t n = 0; n < N; n++) {
+          const underlying_t* bt = bt_data + (b * N + n) * K;
+          const int64_t acc =
+              dot_zero_point_adjusted(a, bt, K, a_zero_point, b_zero_point);
+          c_data[row * N + n] =
+              requantize_from_int<scalar_t>(multiplier, output_zero_point, acc);
+        }
+      }
+    });
+  });
+}
+
 #ifdef USE_FBGEMM
 void quantize_tensor_per_tensor_affine_cpu(
     Tensor rtensor,
@@ -2444,6 +2551,7 @@ REGISTER_DISPATCH(
     dequantize_tensor_per_channel_affine_stub,
     &dequantize_tensor_per_channel_affine_cpu);
 REGISTER_DISPATCH(quantized_normalize_stub, &quantized_normalize_kernel);
+REGISTER_DISPATCH(qmatmul_stub, &qmatmul_kernel);
 
 } // namespace native
 } // namespace at
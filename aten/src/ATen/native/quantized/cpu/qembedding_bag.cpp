@@ -0,0 +1,163 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <torch/library.h>
+#include <ATen/quantized/Quantizer.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+enum EmbeddingBagMode { kSum = 0, kMean = 1, kMax = 2 };
+
+// Per row quantization parameters of the weight, which is quantized either
+// per tensor or per channel along the rows.
+void weight_row_qparams(
+    const Tensor& weight,
+    std::vector<float>& scales,
+    std::vector<int32_t>& zero_points) {
+  const int64_t rows = weight.size(0);
+  if (weight.qscheme() == kPerTensorAffine) {
+    scales.assign(rows, weight.q_scale());
+    zero_points.assign(rows, weight.q_zero_point());
+    return;
+  }
+  TORCH_CHECK(
+      weight.qscheme() == kPerChannelAffine && weight.q_per_channel_axis() == 0,
+      "quantized::embedding_bag expects a weight quantized per tensor or per row");
+  Tensor row_scales = weight.q_per_channel_scales().to(kFloat).contiguous();
+  Tensor row_zero_points = weight.q_per_channel_zero_points().to(kInt).contiguous();
+  scales.assign(row_scales.data_ptr<float>(), row_scales.data_ptr<float>() + rows);
+  zero_points.assign(
+      row_zero_points.data_ptr<int32_t>(), row_zero_points.data_ptr<int32_t>() + rows);
+}
+
+} // namespace
+
+// Bags of rows of a quantized embedding table, reduced in float and
+// requantized to the output parameters. Indices are 1-D, with bag b made of
+// indices[offsets[b]:offsets[b + 1]]; empty bags are zero.
+Tensor quantized_embedding_bag(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    double output_scale,
+    int64_t output_zero_point,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights,
+    bool include_last_offset) {
+  TORCH_CHECK(
+      weight.dim() == 2,
+      "quantized::embedding_bag expects a 2-D weight, got ", weight.dim(), " dimensions");
+  TORCH_CHECK(
+      indices.dim() == 1 && offsets.dim() == 1,
+      "quantized::embedding_bag expects 1-D indices and offsets");
+  TORCH_CHECK(
+      indices.scalar_type() == kLong && offsets.scalar_type() == kLong,
+      "quantized::embedding_bag expects int64 indices and offsets");
+  TORCH_CHECK(
+      mode == kSum || mode == kMean || mode == kMax,
+      "quantized::embedding_bag: unknown mode ", mode);
+  const bool weighted = per_sample_weights.has_value() && per_sample_weights->defined();
+  Tensor sample_weights;
+  if (weighted) {
+    TORCH_CHECK(
+        mode == kSum,
+        "quantized::embedding_bag: per_sample_weights are only supported for mode='sum'");
+    TORCH_CHECK(
+        per_sample_weights->sizes() == indices.sizes(),
+        "quantized::embedding_bag: per_sample_weights must have the shape of indices");
+    sample_weights = per_sample_weights->to(kFloat).contiguous();
+  }
+
+  const int64_t num_rows = weight.size(0);
+  const int64_t embedding_dim = weight.size(1);
+  const int64_t num_indices = indices.numel();
+  int64_t num_bags = offsets.numel();
+  if (include_last_offset) {
+    TORCH_CHECK(num_bags >= 1, "quantized::embedding_bag: include_last_offset needs an offset");
+    num_bags -= 1;
+  }
+
+  std::vector<float> scales;
+  std::vector<int32_t> zero_points;
+  weight_row_qparams(weight, scales, zero_points);
+
+  Tensor weight_contig = weight.contiguous();
+  Tensor indices_contig = indices.contiguous();
+  Tensor offsets_contig = offsets.contiguous();
+  const int64_t* indices_data = indices_contig.data_ptr<int64_t>();
+  const int64_t* offsets_data = offsets_contig.data_ptr<int64_t>();
+  const float* sample_weights_data = weighted ? sample_weights.data_ptr<float>() : nullptr;
+  for (int64_t i = 0; i < num_indices; i++) {
+    TORCH_CHECK(
+        indices_data[i] >= 0 && indices_data[i] < num_rows,
+        "quantized::embedding_bag: index ", indices_data[i], " out of range for ",
+        num_rows, " rows");
+  }
+  for (int64_t b = 0; b < offsets.numel(); b++) {
+    TORCH_CHECK(
+        offsets_data[b] >= 0 && offsets_data[b] <= num_indices &&
+            (b == 0 || offsets_data[b] >= offsets_data[b - 1]),
+        "quantized::embedding_bag: offsets must be non-decreasing and within indices");
+  }
+
+  Tensor output = at::_empty_affine_quantized(
+      {num_bags, embedding_dim},
+      weight.options().memory_format(MemoryFormat::Contiguous),
+      output_scale,
+      output_zero_point);
+
+  AT_DISPATCH_QINT_TYPES(weight.scalar_type(), "quantized_embedding_bag", [&]() {
+    const underlying_t* weight_data =
+        reinterpret_cast<const underlying_t*>(weight_contig.data_ptr<scalar_t>());
+    scalar_t* output_data = output.data_ptr<scalar_t>();
+    const int64_t grain_size =
+        std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(embedding_dim, 1), 1);
+    at::parallel_for(0, num_bags, grain_size, [&](int64_t begin, int64_t end) {
+      std::vector<float> acc(embedding_dim);
+      for (int64_t b = begin; b < end; b++) {
+        const int64_t start = offsets_data[b];
+        const int64_t stop = b + 1 < offsets.numel() ? offsets_data[b + 1] : num_indices;
+        std::fill(
+            acc.begin(),
+            acc.end(),
+            (mode == kMax && stop > start) ? -std::numeric_limits<float>::infinity() : 0.f);
+        for (int64_t i = start; i < stop; i++) {
+          const int64_t row = indices_data[i];
+          const underlying_t* w = weight_data + row * embedding_dim;
+          const float scale = scales[row];
+          const int32_t zero_point = zero_points[row];
+          if (mode == kMax) {
+            for (int64_t d = 0; d < embedding_dim; d++) {
+              acc[d] = std::max(acc[d], scale * (static_cast<int32_t>(w[d]) - zero_point));
+            }
+          } else {
+            const float row_scale = weighted ? scale * sample_weights_data[i] : scale;
+            for (int64_t d = 0; d < embedding_dim; d++) {
+              acc[d] += row_scale * (static_cast<int32_t>(w[d]) - zero_point);
+            }
+          }
+        }
+        const float inv_count = (mode == kMean && stop > start) ? 1.f / (stop - start) : 1.f;
+        scalar_t* out = output_data + b * embedding_dim;
+        for (int64_t d = 0; d < embedding_dim; d++) {
+          out[d] = quantize_val<scalar_t>(output_scale, output_zero_point, acc[d] * inv_count);
+        }
+      }
+    });
+  });
+  return output;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("embedding_bag", TORCH_FN(quantized_embedding_bag));
+}
+
+}}  // namespace at::native
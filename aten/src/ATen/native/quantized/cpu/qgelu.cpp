@@ -0,0 +1,66 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <torch/library.h>
+#include <ATen/quantized/Quantizer.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+
+#include <array>
+#include <cmath>
+
+namespace at {
+namespace native {
+
+namespace {
+
+float gelu(float x) {
+  return x * 0.5f * (1.0f + std::erf(x * static_cast<float>(M_SQRT1_2)));
+}
+
+} // namespace
+
+// An 8-bit input only takes 256 values, so GELU together with the
+// requantization to the output parameters is a table lookup per element.
+Tensor quantized_gelu(const Tensor& qx, double output_scale, int64_t output_zero_point) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      "quantized::gelu only supports per tensor quantized input");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      "quantized::gelu only supports quint8 and qint8 inputs, got ",
+      toString(qx.scalar_type()));
+  Tensor qx_contig = qx.contiguous(qx.suggest_memory_format());
+  Tensor qy = at::_empty_affine_quantized(
+      qx_contig.sizes(),
+      qx.options(),
+      output_scale,
+      output_zero_point,
+      qx.suggest_memory_format());
+  const double i_scale = qx.q_scale();
+  const int64_t i_zero_point = qx.q_zero_point();
+
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), "quantized_gelu", [&]() {
+    constexpr int64_t qmin = std::numeric_limits<underlying_t>::min();
+    std::array<underlying_t, 256> table;
+    for (int64_t i = 0; i < 256; i++) {
+      const float x = dequantize_val<scalar_t>(
+          i_scale, i_zero_point, scalar_t(static_cast<underlying_t>(i + qmin)));
+      table[i] = quantize_val<scalar_t>(output_scale, output_zero_point, gelu(x)).val_;
+    }
+    const underlying_t* x_data =
+        reinterpret_cast<const underlying_t*>(qx_contig.data_ptr<scalar_t>());
+    underlying_t* y_data = reinterpret_cast<underlying_t*>(qy.data_ptr<scalar_t>());
+    at::parallel_for(0, qx_contig.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        y_data[i] = table[static_cast<int64_t>(x_data[i]) - qmin];
+      }
+    });
+  });
+  return qy;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("gelu", TORCH_FN(quantized_gelu));
+}
+
+}}  // namespace at::native
@@ -0,0 +1,75 @@
+#include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/NativeFunctions.h>
+#include <torch/library.h>
+#include <ATen/quantized/Quantizer.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qmatmul_stub);
+
+// Product of two quantized activations, [..., M, K] x [..., K, N] with
+// broadcast batch dimensions. Products of the zero point adjusted 8-bit
+// values are accumulated in int64 and requantized once per output element.
+Tensor quantized_matmul(
+    const Tensor& qa,
+    const Tensor& qb,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qa.qscheme() == kPerTensorAffine && qb.qscheme() == kPerTensorAffine,
+      "quantized::matmul only supports per tensor quantized inputs");
+  TORCH_CHECK(
+      qa.scalar_type() == qb.scalar_type(),
+      "quantized::matmul expects both inputs to have the same dtype, got ",
+      toString(qa.scalar_type()), " and ", toString(qb.scalar_type()));
+  TORCH_CHECK(
+      qa.scalar_type() == kQUInt8 || qa.scalar_type() == kQInt8,
+      "quantized::matmul only supports quint8 and qint8 inputs, got ",
+      toString(qa.scalar_type()));
+  TORCH_CHECK(
+      qa.dim() >= 2 && qb.dim() >= 2,
+      "quantized::matmul expects inputs with at least 2 dimensions, got ",
+      qa.dim(), " and ", qb.dim());
+  const int64_t M = qa.size(-2);
+  const int64_t K = qa.size(-1);
+  const int64_t N = qb.size(-1);
+  TORCH_CHECK(
+      qb.size(-2) == K,
+      "quantized::matmul: size mismatch, got ", qa.sizes(), " and ", qb.sizes());
+
+  std::vector<int64_t> batch_sizes = infer_size(
+      qa.sizes().slice(0, qa.dim() - 2), qb.sizes().slice(0, qb.dim() - 2));
+  std::vector<int64_t> a_sizes(batch_sizes);
+  a_sizes.insert(a_sizes.end(), {M, K});
+  std::vector<int64_t> b_sizes(batch_sizes);
+  b_sizes.insert(b_sizes.end(), {K, N});
+  std::vector<int64_t> output_sizes(batch_sizes);
+  output_sizes.insert(output_sizes.end(), {M, N});
+  const int64_t batch = std::accumulate(
+      batch_sizes.begin(), batch_sizes.end(), int64_t{1}, std::multiplies<int64_t>());
+
+  // b is transposed so that both operands of a dot product are contiguous.
+  Tensor a_contig = qa.expand(a_sizes).contiguous().view({batch, M, K});
+  Tensor bt_contig = qb.expand(b_sizes).contiguous().view({batch, K, N}).transpose(1, 2).contiguous();
+  Tensor qc = at::_empty_affine_quantized(
+      output_sizes, qa.options(), output_scale, output_zero_point);
+
+  const double multiplier = qa.q_scale() * qb.q_scale() / output_scale;
+  qmatmul_stub(kCPU, a_contig, bt_contig, qc, multiplier, output_zero_point);
+  return qc;
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("matmul", TORCH_FN(quantized_matmul));
+}
+
+}}  // namespace at::native
@@ -0,0 +1,79 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
+#include <torch/library.h>
+#include <ATen/quantized/Quantizer.h>
+#include <ATen/native/quantized/affine_quantizer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace at {
+namespace native {
+
+// Softmax of an 8-bit input along a dimension, requantized to the output
+// parameters. Within a slice, x - max(x) is scale * (q - max(q)) with
+// max(q) - q in [0, 255], so the exponentials come from a 256 entry table
+// and only the sum and the final scaling are computed per element.
+Tensor quantized_softmax(
+    const Tensor& qx,
+    int64_t dim,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      "quantized::softmax only supports per tensor quantized input");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      "quantized::softmax only supports quint8 and qint8 inputs, got ",
+      toString(qx.scalar_type()));
+  dim = maybe_wrap_dim(dim, qx.dim());
+  if (qx.dim() == 0) {
+    return quantized_softmax(qx.view({1}), 0, output_scale, output_zero_point).view({});
+  }
+
+  // Slices are made contiguous by moving dim last.
+  const int64_t last = qx.dim() - 1;
+  Tensor qx_contig = qx.transpose(dim, last).contiguous();
+  Tensor qy = at::_empty_affine_quantized(
+      qx_contig.sizes(), qx.options(), output_scale, output_zero_point);
+  const int64_t dim_size = qx_contig.size(last);
+  const int64_t outer_size = dim_size == 0 ? 0 : qx_contig.numel() / dim_size;
+  const double i_scale = qx.q_scale();
+
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), "quantized_softmax", [&]() {
+    std::array<float, 256> exp_table;
+    for (int64_t d = 0; d < 256; d++) {
+      exp_table[d] = std::exp(static_cast<float>(-i_scale * d));
+    }
+    const underlying_t* x_data =
+        reinterpret_cast<const underlying_t*>(qx_contig.data_ptr<scalar_t>());
+    underlying_t* y_data = reinterpret_cast<underlying_t*>(qy.data_ptr<scalar_t>());
+    const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / std::max<int64_t>(dim_size, 1), 1);
+    at::parallel_for(0, outer_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const underlying_t* x = x_data + i * dim_size;
+        underlying_t* y = y_data + i * dim_size;
+        const int64_t x_max = *std::max_element(x, x + dim_size);
+        float sum = 0;
+        for (int64_t j = 0; j < dim_size; j++) {
+          sum += exp_table[x_max - x[j]];
+        }
+        const float inv_sum = 1.0f / sum;
+        for (int64_t j = 0; j < dim_size; j++) {
+          y[j] = quantize_val<scalar_t>(
+              output_scale, output_zero_point, exp_table[x_max - x[j]] * inv_sum).val_;
+        }
+      }
+    });
+  });
+  return qy.transpose(dim, last).contiguous();
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("softmax", TORCH_FN(quantized_softmax));
+}
+
+}}  // namespace at::native
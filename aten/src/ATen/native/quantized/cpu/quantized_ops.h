@@ -135,6 +135,13 @@ using qnormalize_fn = void (*)(
     double /* eps */,
     Tensor* /* Y */);
 
+using qmatmul_fn = void (*)(
+    const Tensor& /* qa */,
+    const Tensor& /* qbt */,
+    Tensor& /* qc */,
+    double /* multiplier */,
+    int64_t /* output_zero_point */);
+
 // using qavg_pool2d_fn
 DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
 DECLARE_DISPATCH(qrelu_fn, qrelu6_stub);
@@ -163,6 +170,7 @@ DECLARE_DISPATCH(qtopk_fn, qtopk_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_stub);
 DECLARE_DISPATCH(qbatch_norm_fn, qbatch_norm_relu_stub);
 DECLARE_DISPATCH(qnormalize_fn, quantized_normalize_stub);
+DECLARE_DISPATCH(qmatmul_fn, qmatmul_stub);
 
 } // namespace native
 } // namespace at
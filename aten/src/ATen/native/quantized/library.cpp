@@ -77,6 +77,8 @@ TORCH_LIBRARY(quantized, m) {
   m.def("conv3d_dilation(__torch__.torch.classes.quantized.Conv3dPackedParamsBase packed_weights) -> int[]");
   m.def("conv3d_groups(__torch__.torch.classes.quantized.Conv3dPackedParamsBase packed_weights) -> int");
   m.def("elu(Tensor self, float output_scale, int output_zero_point, Scalar alpha=1, Scalar scale=1, Scalar input_scale=1) -> Tensor");
+  m.def("embedding_bag(Tensor weight, Tensor indices, Tensor offsets, float output_scale, int output_zero_point, int mode=0, Tensor? per_sample_weights=None, bool include_last_offset=False) -> Tensor");
+  m.def("gelu(Tensor qx, float output_scale, int output_zero_point) -> Tensor");
   m.def("hardswish(Tensor input, float output_scale, int output_zero_point) -> Tensor");
   m.def("group_norm(Tensor input, int num_groups, Tensor? weight, Tensor? bias, float eps, float output_scale, int output_zero_point) -> Tensor");
   m.def("instance_norm(Tensor input, Tensor? weight, Tensor? bias, float eps, float output_scale, int output_zero_point) -> Tensor");
@@ -106,6 +108,7 @@ TORCH_LIBRARY(quantized, m) {
       "linear_unpack.legacy(Tensor W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
   m.def(
       "linear_unpack_fp16.legacy(Tensor W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
+  m.def("matmul(Tensor qa, Tensor qb, float scale, int zero_point) -> Tensor qc");
   m.def("mul(Tensor qa, Tensor qb, float scale, int zero_point)-> Tensor qc");
   m.def("mul_relu(Tensor qa, Tensor qb, float scale, int zero_point)-> Tensor qc");
   m.def("mul_out(Tensor qa, Tensor qb, Tensor(a!) out)-> Tensor(a!) out");
@@ -122,6 +125,7 @@ TORCH_LIBRARY(quantized, m) {
   // NB: missing a space after comma here...
   m.def("max_pool2d(Tensor qx, int[] kernel_size, int[] stride, int[] padding, int[] dilation,bool ceil_mode) -> Tensor");
   m.def("relu6(Tensor qx, bool inplace=False) -> Tensor");
+  m.def("softmax(Tensor qx, int dim, float output_scale, int output_zero_point) -> Tensor");
 }
 
 // According to #33294: The "_" prefix registration will be
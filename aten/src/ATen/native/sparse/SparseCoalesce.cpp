@@ -0,0 +1,285 @@
+#include <ATen/native/sparse/SparseCoalesce.h>
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// Below this many entries, a parallel sort doesn't pay for its setup.
+constexpr int64_t kParallelCoalesceMinNnz = internal::GRAIN_SIZE;
+
+constexpr int kRadixBits = 8;
+constexpr int64_t kRadixBuckets = 1 << kRadixBits;
+// A radix sort moves every entry once per pass. Past this many passes,
+// aggregating the entries in hash tables is cheaper.
+constexpr int kMaxRadixPasses = 3;
+
+// The number of key ranges per thread in hash aggregation. More ranges than
+// threads balance the load when the keys are skewed.
+constexpr int64_t kHashRangesPerThread = 4;
+
+int significant_bits(int64_t x) {
+  int bits = 0;
+  while (x > 0) {
+    bits++;
+    x >>= 1;
+  }
+  return bits;
+}
+
+// [0, n) split into contiguous chunks of at least GRAIN_SIZE elements, at most
+// one per thread.
+struct Chunks {
+  Chunks(int64_t n)
+      : n_(n),
+        num(std::max<int64_t>(1, std::min<int64_t>(at::get_num_threads(), divup(n, internal::GRAIN_SIZE)))),
+        size_(divup(n, num)) {}
+
+  int64_t begin(int64_t c) const {
+    return std::min(n_, c * size_);
+  }
+  int64_t end(int64_t c) const {
+    return std::min(n_, (c + 1) * size_);
+  }
+
+  int64_t n_;
+  int64_t num;
+  int64_t size_;
+};
+
+bool keys_are_sorted(const int64_t* keys, int64_t n) {
+  // not a bool, as the partial results of parallel_reduce live in a vector
+  return at::parallel_reduce(1, n, internal::GRAIN_SIZE, int64_t(1),
+      [&](int64_t begin, int64_t end, int64_t ident) -> int64_t {
+        for (int64_t i = begin; i < end; i++) {
+          if (keys[i] < keys[i - 1]) {
+            return 0;
+          }
+        }
+        return ident;
+      },
+      [](int64_t a, int64_t b) { return a & b; });
+}
+
+// Stably moves the entries (src_keys[i], src_positions[i]) into dst_keys and
+// dst_positions, grouped by bucket_of(key) in increasing order of buckets. A
+// null src_positions stands for 0, 1, ..., n - 1. Returns the offset of every
+// bucket in the destination, followed by n.
+template <typename BucketOf>
+std::vector<int64_t> partition_by_bucket(
+    const int64_t* src_keys,
+    const int64_t* src_positions,
+    int64_t* dst_keys,
+    int64_t* dst_positions,
+    int64_t n,
+    int64_t num_buckets,
+    const Chunks& chunks,
+    const BucketOf& bucket_of) {
+  // every chunk counts its entries in every bucket...
+  std::vector<int64_t> offsets(chunks.num * num_buckets, 0);
+  at::parallel_for(0, chunks.num, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* counts = offsets.data() + c * num_buckets;
+      for (int64_t i = chunks.begin(c); i < chunks.end(c); i++) {
+        counts[bucket_of(src_keys[i])]++;
+      }
+    }
+  });
+  // ...which tells where it writes them: after the entries of the previous
+  // buckets, and of the previous chunks in the same bucket
+  std::vector<int64_t> bucket_offsets(num_buckets + 1);
+  int64_t offset = 0;
+  for (int64_t b = 0; b < num_buckets; b++) {
+    bucket_offsets[b] = offset;
+    for (int64_t c = 0; c < chunks.num; c++) {
+      int64_t count = offsets[c * num_buckets + b];
+      offsets[c * num_buckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucket_offsets[num_buckets] = n;
+  at::parallel_for(0, chunks.num, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* next = offsets.data() + c * num_buckets;
+      for (int64_t i = chunks.begin(c); i < chunks.end(c); i++) {
+        int64_t j = next[bucket_of(src_keys[i])]++;
+        dst_keys[j] = src_keys[i];
+        dst_positions[j] = src_positions ? src_positions[i] : i;
+      }
+    }
+  });
+  return bucket_offsets;
+}
+
+// LSD radix sort of the keys, which are in [0, 2^bits).
+void radix_sort_keys(
+    const int64_t* keys,
+    int64_t n,
+    int bits,
+    int64_t* sorted_keys,
+    int64_t* positions) {
+  Chunks chunks(n);
+  int passes = divup(bits, kRadixBits);
+  std::vector<int64_t> tmp_keys(n);
+  std::vector<int64_t> tmp_positions(n);
+  const int64_t* src_keys = keys;
+  const int64_t* src_positions = nullptr;
+  for (int pass = 0; pass < passes; pass++) {
+    // alternate between the buffers so that the last pass writes the output
+    bool to_output = (passes - pass) % 2 == 1;
+    int64_t* dst_keys = to_output ? sorted_keys : tmp_keys.data();
+    int64_t* dst_positions = to_output ? positions : tmp_positions.data();
+    int shift = pass * kRadixBits;
+    partition_by_bucket(
+        src_keys, src_positions, dst_keys, dst_positions, n, kRadixBuckets, chunks,
+        [shift](int64_t key) { return (key >> shift) & (kRadixBuckets - 1); });
+    src_keys = dst_keys;
+    src_positions = dst_positions;
+  }
+}
+
+// Groups the entries by key, in increasing order of keys, with hash tables.
+// The keys are in [0, max_key].
+void hash_aggregate_keys(
+    const int64_t* keys,
+    int64_t n,
+    int64_t max_key,
+    int64_t* sorted_keys,
+    int64_t* positions) {
+  Chunks chunks(n);
+  // Partition the entries into ranges of keys, so that every range can be
+  // aggregated on its own and the ranges come out in order.
+  int64_t num_ranges = chunks.num * kHashRangesPerThread;
+  int64_t range_width = max_key / num_ranges + 1;
+  std::vector<int64_t> range_keys(n);
+  std::vector<int64_t> range_positions(n);
+  std::vector<int64_t> range_offsets = partition_by_bucket(
+      keys, nullptr, range_keys.data(), range_positions.data(), n, num_ranges, chunks,
+      [range_width](int64_t key) { return key / range_width; });
+
+  at::parallel_for(0, num_ranges, 1, [&](int64_t begin, int64_t end) {
+    std::unordered_map<int64_t, int64_t> slot_of_key;
+    std::vector<int64_t> distinct_keys;
+    std::vector<int64_t> slots;
+    std::vector<int64_t> order;
+    std::vector<int64_t> rank;
+    std::vector<int64_t> offsets;
+    for (int64_t r = begin; r < end; r++) {
+      const int64_t lo = range_offsets[r];
+      const int64_t m = range_offsets[r + 1] - lo;
+      if (m == 0) {
+        continue;
+      }
+      // aggregate: give every distinct key a slot
+      slot_of_key.clear();
+      slot_of_key.reserve(m);
+      distinct_keys.clear();
+      slots.resize(m);
+      for (int64_t i = 0; i < m; i++) {
+        auto inserted = slot_of_key.emplace(range_keys[lo + i], distinct_keys.size());
+        if (inserted.second) {
+          distinct_keys.push_back(range_keys[lo + i]);
+        }
+        slots[i] = inserted.first->second;
+      }
+      // only the distinct keys are sorted
+      const int64_t u = distinct_keys.size();
+      order.resize(u);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+        return distinct_keys[a] < distinct_keys[b];
+      });
+      rank.resize(u);
+      for (int64_t k = 0; k < u; k++) {
+        rank[order[k]] = k;
+      }
+      // counting sort of the entries by the rank of their key
+      offsets.assign(u + 1, 0);
+      for (int64_t i = 0; i < m; i++) {
+        offsets[rank[slots[i]] + 1]++;
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (int64_t i = 0; i < m; i++) {
+        int64_t j = lo + offsets[rank[slots[i]]]++;
+        sorted_keys[j] = range_keys[lo + i];
+        positions[j] = range_positions[lo + i];
+      }
+    }
+  });
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor> sort_coalesce_keys(const Tensor& keys_, bool keys_sorted) {
+  TORCH_INTERNAL_ASSERT(keys_.dim() == 1 && keys_.scalar_type() == kLong && !keys_.is_cuda());
+  Tensor keys = keys_.contiguous();
+  int64_t n = keys.numel();
+  const int64_t* keys_ptr = keys.data_ptr<int64_t>();
+
+  if (keys_sorted || keys_are_sorted(keys_ptr, n)) {
+    return std::make_tuple(keys, at::arange(n, keys.options()));
+  }
+  if (n < kParallelCoalesceMinNnz) {
+    return keys.sort(0);
+  }
+  int64_t min_key = keys.min().item<int64_t>();
+  if (min_key < 0) {
+    // out-of-bounds indices, which Tensor::sort handles like any other
+    return keys.sort(0);
+  }
+  int64_t max_key = keys.max().item<int64_t>();
+
+  Tensor sorted_keys = at::empty({n}, keys.options());
+  Tensor positions = at::empty({n}, keys.options());
+  int bits = significant_bits(max_key);
+  if (bits <= kMaxRadixPasses * kRadixBits) {
+    radix_sort_keys(keys_ptr, n, bits, sorted_keys.data_ptr<int64_t>(), positions.data_ptr<int64_t>());
+  } else {
+    hash_aggregate_keys(keys_ptr, n, max_key, sorted_keys.data_ptr<int64_t>(), positions.data_ptr<int64_t>());
+  }
+  return std::make_tuple(sorted_keys, positions);
+}
+
+Tensor coalesce_run_starts(const Tensor& sorted_keys_) {
+  TORCH_INTERNAL_ASSERT(sorted_keys_.dim() == 1 && sorted_keys_.scalar_type() == kLong);
+  Tensor sorted_keys = sorted_keys_.contiguous();
+  int64_t n = sorted_keys.numel();
+  const int64_t* keys = sorted_keys.data_ptr<int64_t>();
+
+  // Count the runs starting in every chunk, then write the starts of each
+  // chunk after those of the previous chunks.
+  Chunks chunks(n);
+  std::vector<int64_t> run_offsets(chunks.num + 1, 0);
+  at::parallel_for(0, chunks.num, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t runs = 0;
+      for (int64_t i = chunks.begin(c); i < chunks.end(c); i++) {
+        runs += i == 0 || keys[i] != keys[i - 1];
+      }
+      run_offsets[c + 1] = runs;
+    }
+  });
+  std::partial_sum(run_offsets.begin(), run_offsets.end(), run_offsets.begin());
+
+  Tensor starts = at::empty({run_offsets[chunks.num]}, sorted_keys.options());
+  int64_t* starts_ptr = starts.data_ptr<int64_t>();
+  at::parallel_for(0, chunks.num, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t next = run_offsets[c];
+      for (int64_t i = chunks.begin(c); i < chunks.end(c); i++) {
+        if (i == 0 || keys[i] != keys[i - 1]) {
+          starts_ptr[next++] = i;
+        }
+      }
+    }
+  });
+  return starts;
+}
+
+}} // namespace at::native
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+#include <tuple>
+
+namespace at { namespace native {
+
+// Helpers for coalescing sparse CPU tensors in parallel.
+//
+// `keys` holds the linearized index of every entry of a sparse tensor (see
+// flatten_indices). sort_coalesce_keys returns the keys in sorted order, and
+// for each of them the position of its entry in `keys`. Entries with equal
+// keys end up next to each other, in no particular order.
+//
+// Small inputs are sorted with Tensor::sort. Larger ones are sorted by a
+// parallel LSD radix sort when the keys span few enough bits for it to take
+// at most a few passes, and by hash-based aggregation otherwise: the entries
+// are partitioned into ranges of keys, and every range is aggregated in a hash
+// table, so only its distinct keys need to be sorted. If `keys_sorted` is true
+// or the keys turn out to be sorted already, nothing is moved.
+TORCH_API std::tuple<Tensor, Tensor> sort_coalesce_keys(const Tensor& keys, bool keys_sorted);
+
+// The position of the first element of every run of equal elements in
+// `sorted_keys`.
+TORCH_API Tensor coalesce_run_starts(const Tensor& sorted_keys);
+
+}} // namespace at::native
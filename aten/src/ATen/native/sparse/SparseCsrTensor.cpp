@@ -0,0 +1,203 @@
+// Basic functions on sparse CSR tensors
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/InitialTensorOptions.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/SparseTensorUtils.h>
+
+namespace at { namespace native {
+
+using namespace at::sparse_csr;
+
+namespace {
+
+// The row offsets of a matrix with `rows` rows whose elements are in row-major
+// order and lie in the given rows.
+Tensor crow_indices_from_rows(const Tensor& row_indices, int64_t rows) {
+  Tensor crow_indices = at::zeros({rows + 1}, row_indices.options());
+  if (row_indices.numel() > 0) {
+    Tensor counts = at::bincount(row_indices, {}, rows);
+    Tensor offsets = crow_indices.narrow(0, 1, rows);
+    at::cumsum_out(offsets, counts, 0);
+  }
+  return crow_indices;
+}
+
+// The row of each element of a CSR matrix, i.e. the row indices of the
+// equivalent COO matrix.
+Tensor rows_from_crow_indices(const Tensor& crow_indices) {
+  int64_t rows = crow_indices.size(0) - 1;
+  Tensor counts = crow_indices.narrow(0, 1, rows) - crow_indices.narrow(0, 0, rows);
+  return at::repeat_interleave(counts);
+}
+
+} // namespace
+
+/******************************************************************************
+ * access methods
+ ******************************************************************************/
+
+int64_t _nnz_sparse_csr(const SparseCsrTensor& self) {
+  return get_sparse_csr_impl(self)->nnz();
+}
+
+Tensor crow_indices_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->crow_indices().alias();
+}
+
+Tensor col_indices_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->col_indices().alias();
+}
+
+Tensor values_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->values().alias();
+}
+
+/******************************************************************************
+ * creation methods
+ ******************************************************************************/
+
+SparseCsrTensor new_csr_tensor_with_tensors(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    ArrayRef<int64_t> size,
+    const TensorOptions& options) {
+  AT_ASSERT(options.layout() == kSparseCsr);
+  TORCH_CHECK(options.device().type() == kCPU, "sparse CSR tensors are only supported on CPU, but got device ", options.device());
+  SparseCsrTensor self = detail::make_tensor<SparseCsrTensorImpl>(
+      DispatchKeySet(DispatchKey::SparseCsrCPU), options.dtype());
+  // NOTE: As for COO tensors, the member tensors of a CSR tensor must not
+  // contain AutogradMeta, so we shallow-copy them here.
+  auto shallow_copy = [](const Tensor& t) {
+    return Tensor(t.unsafeGetTensorImpl()->shallow_copy_and_detach(
+      /*version_counter=*/t.unsafeGetTensorImpl()->version_counter(),
+      /*allow_tensor_metadata_change=*/true));
+  };
+  get_sparse_csr_impl(self)->set_member_tensors_unsafe(
+      shallow_copy(crow_indices), shallow_copy(col_indices), shallow_copy(values), size);
+  return self;
+}
+
+// NOTE: _sparse_csr_tensor_unsafe() differs from sparse_csr_tensor() in that
+// it doesn't check that the indices are consistent with each other and with
+// `size`. It should ONLY be used where the indices are known to be valid.
+Tensor _sparse_csr_tensor_unsafe(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    ArrayRef<int64_t> size,
+    const TensorOptions& options) {
+  TORCH_CHECK(!options.has_layout() || options.layout() == kSparseCsr, "expected sparse CSR layout, but got layout ", options.layout());
+  Tensor values_ = options.has_dtype() ? values.to(typeMetaToScalarType(options.dtype())) : values;
+  return at::_sparse_csr_tensor_with_tensors(
+      crow_indices, col_indices, values_, size, values_.options().layout(kSparseCsr));
+}
+
+Tensor sparse_csr_tensor(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    ArrayRef<int64_t> size,
+    const TensorOptions& options) {
+  TORCH_CHECK(!options.has_layout() || options.layout() == kSparseCsr, "expected sparse CSR layout, but got layout ", options.layout());
+  TORCH_CHECK(size.size() == 2, "sparse CSR tensors must be 2-dimensional, but got size ", size);
+  TORCH_CHECK(crow_indices.dim() == 1 && col_indices.dim() == 1 && values.dim() == 1,
+      "crow_indices, col_indices and values must be 1-dimensional, but got dimensions ",
+      crow_indices.dim(), ", ", col_indices.dim(), " and ", values.dim());
+  TORCH_CHECK(crow_indices.scalar_type() == kLong && col_indices.scalar_type() == kLong,
+      "crow_indices and col_indices must be int64 tensors");
+  TORCH_CHECK(crow_indices.size(0) == size[0] + 1,
+      "crow_indices must have size(0) + 1 = ", size[0] + 1, " elements, but got ", crow_indices.size(0));
+  TORCH_CHECK(col_indices.size(0) == values.size(0),
+      "col_indices and values must have same nnz, but got nnz from col_indices: ", col_indices.size(0),
+      ", nnz from values: ", values.size(0));
+
+  // Check the indices on CPU, like sparse_coo_tensor does.
+  Tensor cpu_crow_indices = crow_indices.to(kCPU).contiguous();
+  auto crow = cpu_crow_indices.data_ptr<int64_t>();
+  int64_t nnz = col_indices.size(0);
+  TORCH_CHECK(crow[0] == 0, "crow_indices must start with 0, but got ", crow[0]);
+  TORCH_CHECK(crow[size[0]] == nnz,
+      "the last element of crow_indices must be nnz (", nnz, "), but got ", crow[size[0]]);
+  for (int64_t i = 0; i < size[0]; i++) {
+    TORCH_CHECK(crow[i] <= crow[i + 1],
+        "crow_indices must be non-decreasing, but crow_indices[", i, "] = ", crow[i],
+        " > crow_indices[", i + 1, "] = ", crow[i + 1]);
+  }
+  if (nnz > 0) {
+    int64_t min_col = col_indices.min().item<int64_t>();
+    int64_t max_col = col_indices.max().item<int64_t>();
+    TORCH_CHECK(min_col >= 0, "found negative column index ", min_col);
+    TORCH_CHECK(max_col < size[1],
+        "size is inconsistent with col_indices: size(1) is ", size[1], " but found column index ", max_col);
+  }
+
+  return at::_sparse_csr_tensor_unsafe(crow_indices, col_indices, values, size, options);
+}
+
+Tensor sparse_csr_tensor(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const TensorOptions& options) {
+  TORCH_CHECK(crow_indices.dim() == 1 && crow_indices.size(0) > 0,
+      "crow_indices must be a 1-dimensional tensor with at least one element, but got size ", crow_indices.sizes());
+  // The number of columns is the smallest one that holds every column index.
+  int64_t cols = col_indices.numel() > 0 ? col_indices.max().item<int64_t>() + 1 : 0;
+  return at::sparse_csr_tensor(crow_indices, col_indices, values, {crow_indices.size(0) - 1, cols}, options);
+}
+
+/******************************************************************************
+ * conversions
+ ******************************************************************************/
+
+SparseCsrTensor dense_to_sparse_csr(const Tensor& self) {
+  TORCH_CHECK(self.dim() == 2, "to_sparse_csr: expected a 2-dimensional tensor, but got ", self.dim(), "D tensor");
+  // nonzero() lists the elements in row-major order, which is the CSR order.
+  Tensor nz = self.nonzero();
+  Tensor row_indices = nz.select(1, 0);
+  Tensor col_indices = nz.select(1, 1).contiguous();
+  Tensor values = self.index({row_indices, col_indices});
+  return at::_sparse_csr_tensor_unsafe(
+      crow_indices_from_rows(row_indices, self.size(0)), col_indices, values, self.sizes(),
+      values.options().layout(kSparseCsr));
+}
+
+SparseCsrTensor sparse_to_sparse_csr(const sparse::SparseTensor& self) {
+  TORCH_CHECK(self.sparse_dim() == 2 && self.dense_dim() == 0,
+      "to_sparse_csr: expected a sparse matrix with scalar values, but got sparse_dim ", self.sparse_dim(),
+      " and dense_dim ", self.dense_dim());
+  // A coalesced COO matrix has sorted, unique indices, which is the CSR order.
+  sparse::SparseTensor coalesced = self.coalesce();
+  Tensor indices = coalesced._indices();
+  Tensor values = coalesced._values();
+  return at::_sparse_csr_tensor_unsafe(
+      crow_indices_from_rows(indices.select(0, 0), self.size(0)), indices.select(0, 1).contiguous(), values,
+      self.sizes(), values.options().layout(kSparseCsr));
+}
+
+SparseCsrTensor sparse_csr_to_sparse_csr(const SparseCsrTensor& self) {
+  return self;
+}
+
+sparse::SparseTensor sparse_csr_to_sparse(const SparseCsrTensor& self) {
+  Tensor crow_indices = self.crow_indices();
+  Tensor col_indices = self.col_indices();
+  Tensor indices = at::stack({rows_from_crow_indices(crow_indices), col_indices});
+  return at::_sparse_coo_tensor_unsafe(indices, self.values(), self.sizes());
+}
+
+Tensor sparse_csr_to_dense(const SparseCsrTensor& self) {
+  Tensor dst = at::zeros(self.sizes(), self.options().layout(kStrided));
+  if (self._nnz() == 0) {
+    return dst;
+  }
+  Tensor row_indices = rows_from_crow_indices(self.crow_indices());
+  // Accumulate, as a CSR matrix may specify an element more than once.
+  return dst.index_put_({row_indices, self.col_indices()}, self.values(), /*accumulate=*/true);
+}
+
+}} // namespace at::native
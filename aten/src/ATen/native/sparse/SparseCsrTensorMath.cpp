@@ -0,0 +1,167 @@
+#include <ATen/native/sparse/SparseCsrTensorMath.h>
+
+#include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/native/sparse/SparseMatMul.h>
+
+namespace at { namespace native {
+
+using namespace at::sparse_csr;
+
+DEFINE_DISPATCH(addmm_sparse_csr_stub);
+DEFINE_DISPATCH(mv_sparse_csr_stub);
+
+namespace {
+
+// _sparse_csr_tensor_unsafe skips the index checks, so the column indices are
+// checked once here rather than per nonzero in the inner loops of the kernels.
+void check_col_indices(const Tensor& col_indices, int64_t cols, const char* op) {
+  if (col_indices.numel() == 0) {
+    return;
+  }
+  int64_t min_col = col_indices.min().item<int64_t>();
+  int64_t max_col = col_indices.max().item<int64_t>();
+  TORCH_CHECK(min_col >= 0 && max_col < cols,
+      op, ": index out of column bound: ", min_col < 0 ? min_col : max_col, " not between 0 and ", cols - 1);
+}
+
+} // namespace
+
+// --------------------------------------------------------------------
+// addmm(D1, S, D2, beta, alpha) -> D  [broadcasts]
+//
+// D = beta * D1 + alpha * mm(S, D2), where S is a CSR matrix
+// --------------------------------------------------------------------
+
+Tensor& s_addmm_out_sparse_csr_dense_cpu(
+    Tensor& r,
+    const Tensor& t,
+    const SparseCsrTensor& sparse,
+    const Tensor& dense,
+    Scalar beta,
+    Scalar alpha
+) {
+  TORCH_CHECK(!r.is_cuda(), "addmm: expected 'out' to be CPU tensor, but got CUDA tensor");
+  TORCH_CHECK(!dense.is_cuda(), "addmm: expected 'mat2' to be a CPU tensor, but got a CUDA tensor");
+  TORCH_CHECK(dense.dim() == 2, "addmm: matrices expected, got ", dense.dim(), "D tensor");
+  TORCH_CHECK(sparse.scalar_type() == dense.scalar_type(),
+      "addmm: expected 'mat1' and 'mat2' to have the same dtype, but got ", sparse.scalar_type(), " and ", dense.scalar_type());
+
+  // ixj * jxk = ixk
+  int64_t dim_i = sparse.size(0);
+  int64_t dim_j = sparse.size(1);
+  int64_t dim_k = dense.size(1);
+
+  TORCH_CHECK(dense.size(0) == dim_j,
+      "addmm: Argument #3 (dense): Expected dim 0 size ", dim_j, ", got ", dense.size(0));
+  TORCH_CHECK(t.size(0) == dim_i,
+      "addmm: Argument #1 (t): Expected dim 0 size ", dim_i, ", got ", t.size(0));
+  TORCH_CHECK(t.size(1) == dim_k,
+      "addmm: Argument #1 (t): Expected dim 1 size ", dim_k, ", got ", t.size(1));
+
+  r.resize_({dim_i, dim_k});
+
+  // The kernel accumulates into a contiguous result, so start from beta * t
+  // there and copy back if `r` isn't contiguous.
+  Tensor r_contig = r.is_contiguous() ? r : at::empty({dim_i, dim_k}, r.options());
+  if (beta.toComplexDouble() == 0.) {
+    r_contig.zero_();
+  } else if (beta.toComplexDouble() == 1.) {
+    if (!r_contig.is_same(t)) {
+      r_contig.copy_(t);
+    }
+  } else {
+    at::mul_out(r_contig, t, scalar_to_tensor(beta));
+  }
+
+  if (sparse._nnz() > 0 && dim_k > 0) {
+    Tensor col_indices = sparse.col_indices().contiguous();
+    check_col_indices(col_indices, dim_j, "addmm");
+    addmm_sparse_csr_stub(
+        kCPU, r_contig, sparse.crow_indices().contiguous(), col_indices,
+        sparse.values().contiguous(), dense.contiguous(), alpha);
+  }
+
+  if (!r_contig.is_same(r)) {
+    r.copy_(r_contig);
+  }
+  return r;
+}
+
+Tensor& addmm_out_sparse_csr_dense_cpu(
+    Tensor& result,
+    const Tensor& self,
+    const SparseCsrTensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha
+) {
+  Tensor b_self;
+  std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm_out");
+  return s_addmm_out_sparse_csr_dense_cpu(result, b_self, mat1, mat2, beta, alpha);
+}
+
+Tensor addmm_sparse_csr_dense_cpu(
+    const Tensor& self,
+    const SparseCsrTensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha
+) {
+  Tensor b_self;
+  std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm");
+  Tensor r = at::empty({0}, b_self.options());
+  s_addmm_out_sparse_csr_dense_cpu(r, b_self, mat1, mat2, beta, alpha);
+  return r;
+}
+
+Tensor mm_sparse_csr(const SparseCsrTensor& sparse, const Tensor& dense) {
+  if (dense.is_sparse_csr()) {
+    return sparse_csr_matmul_cpu(sparse, dense);
+  }
+  Tensor t = at::zeros({}, dense.options());
+  return at::addmm(t, sparse, dense, 0, 1);  // redispatch!
+}
+
+Tensor& mm_out_sparse_csr(Tensor& result, const SparseCsrTensor& sparse, const Tensor& dense) {
+  if (dense.is_sparse_csr()) {
+    TORCH_CHECK(result.is_sparse_csr(), "mm: expected 'out' to be a sparse CSR tensor, but got layout ", result.layout());
+    TORCH_CHECK(result.scalar_type() == sparse.scalar_type(),
+        "mm: expected 'out' to have dtype ", sparse.scalar_type(), ", but got ", result.scalar_type());
+    Tensor r = sparse_csr_matmul_cpu(sparse, dense);
+    get_sparse_csr_impl(result)->set_member_tensors_unsafe(
+        get_sparse_csr_impl(r)->crow_indices(), get_sparse_csr_impl(r)->col_indices(),
+        get_sparse_csr_impl(r)->values(), r.sizes());
+    return result;
+  }
+  Tensor t = at::zeros({}, dense.options());
+  return at::addmm_out(result, t, sparse, dense, 0, 1);  // redispatch!
+}
+
+// --------------------------------------------------------------------
+// mv(SparseCsrTensor, Tensor)
+// --------------------------------------------------------------------
+
+Tensor mv_sparse_csr(const SparseCsrTensor& self, const Tensor& vec) {
+  TORCH_CHECK(vec.dim() == 1,
+      "mv: two tensor dim should be 2 and 1, but got SparseCsrTensor Dim: 2 Tensor Dim: ", vec.dim());
+  TORCH_CHECK(!vec.is_cuda(), "mv: expected 'vec' to be a CPU tensor, but got a CUDA tensor");
+  TORCH_CHECK(vec.size(0) == self.size(1),
+      "mv: expected self.size(-1) == vec.size(-1)");
+  TORCH_CHECK(self.scalar_type() == vec.scalar_type(),
+      "mv: expected 'self' and 'vec' to have the same dtype, but got ", self.scalar_type(), " and ", vec.scalar_type());
+
+  Tensor result = at::zeros({self.size(0)}, vec.options());
+  if (self._nnz() > 0) {
+    Tensor col_indices = self.col_indices().contiguous();
+    check_col_indices(col_indices, vec.size(0), "mv");
+    mv_sparse_csr_stub(
+        kCPU, result, self.crow_indices().contiguous(), col_indices,
+        self.values().contiguous(), vec.contiguous());
+  }
+  return result;
+}
+
+}} // namespace at::native
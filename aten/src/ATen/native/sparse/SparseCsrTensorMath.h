@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// result += alpha * csr @ dense, where the CSR matrix is given by its member
+// tensors, and result and dense are contiguous matrices. The kernels do not
+// bounds check the column indices; callers check them once beforehand with
+// check_col_indices.
+using addmm_sparse_csr_fn = void(*)(Tensor& result, const Tensor& crow_indices, const Tensor& col_indices, const Tensor& values, const Tensor& dense, Scalar alpha);
+// result = csr @ vec, where result and vec are contiguous vectors.
+using mv_sparse_csr_fn = void(*)(Tensor& result, const Tensor& crow_indices, const Tensor& col_indices, const Tensor& values, const Tensor& vec);
+
+DECLARE_DISPATCH(addmm_sparse_csr_fn, addmm_sparse_csr_stub);
+DECLARE_DISPATCH(mv_sparse_csr_fn, mv_sparse_csr_stub);
+
+}} // namespace at::native
@@ -0,0 +1,223 @@
+// Products of two sparse matrices on CPU
+
+#include <ATen/native/sparse/SparseMatMul.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/SparseTensorUtils.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace at { namespace native {
+
+using namespace at::sparse;
+using namespace at::sparse_csr;
+
+namespace {
+
+// A row of the result is accumulated either in an array with an element per
+// column, or in a hash map. The array is faster, but costs as much as its size
+// to set up, so it is used for at most this many columns, or when a thread
+// does more multiply-adds than there are columns.
+constexpr int64_t kDenseAccumulatorMaxCols = 1 << 16;
+
+// Gustavson's algorithm: row i of a @ b is the sum of the rows of b selected
+// by the elements of row i of a, scaled by them. The rows of the result are
+// independent, so they are split among threads into ranges that take about
+// the same number of multiply-adds.
+template <typename scalar_t>
+void csr_matmul_kernel(
+    int64_t dim_i,
+    int64_t dim_k,
+    const int64_t* a_crow,
+    const int64_t* a_col,
+    const scalar_t* a_values,
+    const int64_t* b_crow,
+    const int64_t* b_col,
+    const scalar_t* b_values,
+    Tensor& crow_indices,
+    Tensor& col_indices,
+    Tensor& values) {
+  // work[i] is the number of multiply-adds of the rows before row i
+  std::vector<int64_t> work(dim_i + 1, 0);
+  at::parallel_for(0, dim_i, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      int64_t row_work = 0;
+      for (int64_t p = a_crow[i]; p < a_crow[i + 1]; p++) {
+        const int64_t j = a_col[p];
+        row_work += b_crow[j + 1] - b_crow[j];
+      }
+      work[i + 1] = row_work;
+    }
+  });
+  std::partial_sum(work.begin(), work.end(), work.begin());
+
+  const int64_t total_work = work[dim_i];
+  const int64_t num_chunks = std::max<int64_t>(
+      1, std::min<int64_t>(at::get_num_threads(), divup(total_work, internal::GRAIN_SIZE)));
+  std::vector<int64_t> chunk_rows(num_chunks + 1, dim_i);
+  for (int64_t c = 0; c < num_chunks; c++) {
+    chunk_rows[c] = std::lower_bound(work.begin(), work.end() - 1, total_work * c / num_chunks) - work.begin();
+  }
+
+  // Every chunk of rows is computed into buffers of its own, which are then
+  // copied to their place in the result.
+  std::vector<int64_t> row_nnz(dim_i);
+  std::vector<std::vector<int64_t>> chunk_cols(num_chunks);
+  std::vector<std::vector<scalar_t>> chunk_values(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    // row_of_col[k] is the last row that has an element in column k, and
+    // acc[k] its value so far
+    std::vector<int64_t> row_of_col;
+    std::vector<scalar_t> acc;
+    std::unordered_map<int64_t, scalar_t> acc_map;
+    std::vector<int64_t> row_cols;
+    for (int64_t c = begin; c < end; c++) {
+      const int64_t row_begin = chunk_rows[c];
+      const int64_t row_end = chunk_rows[c + 1];
+      const bool dense_acc = dim_k <= std::max(kDenseAccumulatorMaxCols, work[row_end] - work[row_begin]);
+      if (dense_acc && static_cast<int64_t>(acc.size()) != dim_k) {
+        row_of_col.assign(dim_k, -1);
+        acc.resize(dim_k);
+      }
+      std::vector<int64_t>& cols = chunk_cols[c];
+      std::vector<scalar_t>& vals = chunk_values[c];
+      cols.reserve(work[row_end] - work[row_begin]);
+      vals.reserve(work[row_end] - work[row_begin]);
+
+      for (int64_t i = row_begin; i < row_end; i++) {
+        row_cols.clear();
+        if (dense_acc) {
+          for (int64_t p = a_crow[i]; p < a_crow[i + 1]; p++) {
+            const int64_t j = a_col[p];
+            const scalar_t a_val = a_values[p];
+            for (int64_t q = b_crow[j]; q < b_crow[j + 1]; q++) {
+              const int64_t k = b_col[q];
+              if (row_of_col[k] != i) {
+                row_of_col[k] = i;
+                acc[k] = a_val * b_values[q];
+                row_cols.push_back(k);
+              } else {
+                acc[k] += a_val * b_values[q];
+              }
+            }
+          }
+          std::sort(row_cols.begin(), row_cols.end());
+          for (int64_t k : row_cols) {
+            cols.push_back(k);
+            vals.push_back(acc[k]);
+          }
+        } else {
+          acc_map.clear();
+          for (int64_t p = a_crow[i]; p < a_crow[i + 1]; p++) {
+            const int64_t j = a_col[p];
+            const scalar_t a_val = a_values[p];
+            for (int64_t q = b_crow[j]; q < b_crow[j + 1]; q++) {
+              acc_map[b_col[q]] += a_val * b_values[q];
+            }
+          }
+          for (const auto& entry : acc_map) {
+            row_cols.push_back(entry.first);
+          }
+          std::sort(row_cols.begin(), row_cols.end());
+          for (int64_t k : row_cols) {
+            cols.push_back(k);
+            vals.push_back(acc_map[k]);
+          }
+        }
+        row_nnz[i] = row_cols.size();
+      }
+    }
+  });
+
+  int64_t* crow = crow_indices.data_ptr<int64_t>();
+  crow[0] = 0;
+  for (int64_t i = 0; i < dim_i; i++) {
+    crow[i + 1] = crow[i] + row_nnz[i];
+  }
+  col_indices.resize_({crow[dim_i]});
+  values.resize_({crow[dim_i]});
+  int64_t* col_ptr = col_indices.data_ptr<int64_t>();
+  scalar_t* values_ptr = values.data_ptr<scalar_t>();
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      const int64_t offset = crow[chunk_rows[c]];
+      std::copy(chunk_cols[c].begin(), chunk_cols[c].end(), col_ptr + offset);
+      std::copy(chunk_values[c].begin(), chunk_values[c].end(), values_ptr + offset);
+    }
+  });
+}
+
+} // namespace
+
+Tensor sparse_csr_matmul_cpu(const Tensor& mat1, const Tensor& mat2) {
+  TORCH_CHECK(mat1.is_sparse_csr() && mat2.is_sparse_csr(),
+      "mm: expected two sparse CSR matrices, but got layouts ", mat1.layout(), " and ", mat2.layout());
+  TORCH_CHECK(mat1.size(1) == mat2.size(0),
+      "mm: Argument #2 (mat2): Expected dim 0 size ", mat1.size(1), ", got ", mat2.size(0));
+  TORCH_CHECK(mat1.scalar_type() == mat2.scalar_type(),
+      "mm: expected 'mat1' and 'mat2' to have the same dtype, but got ", mat1.scalar_type(), " and ", mat2.scalar_type());
+
+  const int64_t dim_i = mat1.size(0);
+  const int64_t dim_j = mat1.size(1);
+  const int64_t dim_k = mat2.size(1);
+  Tensor a_crow = mat1.crow_indices().contiguous();
+  Tensor a_col = mat1.col_indices().contiguous();
+  Tensor a_values = mat1.values().contiguous();
+  Tensor b_crow = mat2.crow_indices().contiguous();
+  Tensor b_col = mat2.col_indices().contiguous();
+  Tensor b_values = mat2.values().contiguous();
+  if (a_col.numel() > 0) {
+    // the rows of mat2 are indexed by the columns of mat1
+    int64_t min_col = a_col.min().item<int64_t>();
+    int64_t max_col = a_col.max().item<int64_t>();
+    TORCH_CHECK(min_col >= 0 && max_col < dim_j,
+        "mm: index out of column bound: mat1 has ", dim_j, " columns, but found column index ",
+        min_col < 0 ? min_col : max_col);
+  }
+  if (b_col.numel() > 0) {
+    // the accumulators are indexed by the columns of mat2
+    int64_t min_col = b_col.min().item<int64_t>();
+    int64_t max_col = b_col.max().item<int64_t>();
+    TORCH_CHECK(min_col >= 0 && max_col < dim_k,
+        "mm: index out of column bound: mat2 has ", dim_k, " columns, but found column index ",
+        min_col < 0 ? min_col : max_col);
+  }
+
+  Tensor crow_indices = at::empty({dim_i + 1}, a_crow.options());
+  Tensor col_indices = at::empty({0}, a_col.options());
+  Tensor values = at::empty({0}, a_values.options());
+  AT_DISPATCH_ALL_TYPES(values.scalar_type(), "sparse_csr_matmul", [&] {
+    csr_matmul_kernel<scalar_t>(
+        dim_i, dim_k,
+        a_crow.data_ptr<int64_t>(), a_col.data_ptr<int64_t>(), a_values.data_ptr<scalar_t>(),
+        b_crow.data_ptr<int64_t>(), b_col.data_ptr<int64_t>(), b_values.data_ptr<scalar_t>(),
+        crow_indices, col_indices, values);
+  });
+  return at::_sparse_csr_tensor_unsafe(
+      crow_indices, col_indices, values, {dim_i, dim_k}, values.options().layout(kSparseCsr));
+}
+
+// --------------------------------------------------------------------
+// _sparse_sparse_matmul(SparseTensor, SparseTensor) -> SparseTensor
+// --------------------------------------------------------------------
+
+SparseTensor sparse_sparse_matmul_cpu(const SparseTensor& mat1, const SparseTensor& mat2) {
+  TORCH_CHECK(mat1.is_sparse() && mat2.is_sparse(),
+      "mm: expected two sparse COO matrices, but got layouts ", mat1.layout(), " and ", mat2.layout());
+  TORCH_CHECK(mat1.sparse_dim() == 2 && mat1.dense_dim() == 0 && mat2.sparse_dim() == 2 && mat2.dense_dim() == 0,
+      "mm: expected sparse matrices with scalar values, but got sparse_dim ", mat1.sparse_dim(), " and ",
+      mat2.sparse_dim(), ", dense_dim ", mat1.dense_dim(), " and ", mat2.dense_dim());
+  // The rows of a coalesced COO matrix are in order, so it converts to CSR
+  // without a sort, and so does the result back to COO.
+  SparseTensor result = sparse_csr_matmul_cpu(mat1.to_sparse_csr(), mat2.to_sparse_csr()).to_sparse();
+  return result._coalesced_(true);
+}
+
+}} // namespace at::native
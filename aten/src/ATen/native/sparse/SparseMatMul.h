@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// The product of two CSR matrices, as a CSR matrix whose column indices are
+// sorted and unique in every row.
+TORCH_API Tensor sparse_csr_matmul_cpu(const Tensor& mat1, const Tensor& mat2);
+
+}} // namespace at::native
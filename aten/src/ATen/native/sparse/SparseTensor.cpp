@@ -7,6 +7,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/InitialTensorOptions.h>
 #include <ATen/SparseTensorUtils.h>
+#include <ATen/native/sparse/SparseCoalesce.h>
 
 #include <TH/THBlasUtils.h>
 
@@ -262,7 +263,9 @@ SparseTensor clone_sparse(const SparseTensor& self, c10::optional<c10::MemoryFor
       optional_memory_format.value());
   SparseTensor other = new_with_dims_sparse(self.sparse_dim(), self.dense_dim(), self.sizes(), self.options());
   copy_into_sparse(other, self._indices(), self._values(), true);
-  return other._coalesced_(self.is_coalesced());
+  other._coalesced_(self.is_coalesced());
+  get_sparse_impl(other)->set_indices_sorted(get_sparse_impl(self)->indices_sorted());
+  return other;
 }
 
 /******************************************************************************
@@ -349,7 +352,9 @@ SparseTensor& copy_sparse_(SparseTensor& self, const SparseTensor& src, bool non
   if (is_same_tensor(self, src)) return self;
   get_sparse_impl(self)->resize_(src.sparse_dim(), src.dense_dim(), src.sizes());
   copy_into_sparse(self, src._indices(), src._values(), non_blocking);
-  return self._coalesced_(src.is_coalesced());
+  self._coalesced_(src.is_coalesced());
+  get_sparse_impl(self)->set_indices_sorted(get_sparse_impl(src)->indices_sorted());
+  return self;
 }
 
 SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
@@ -376,51 +381,52 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
 
   LongTensor indices_scalar = flatten_indices(indices, self.sizes());
 
+  // Group the entries by index, then sum every group in parallel.
+  LongTensor indicesBuffer;
+  LongTensor indicesPermutation;
+  std::tie(indicesBuffer, indicesPermutation) =
+      sort_coalesce_keys(indices_scalar, get_sparse_impl(self)->indices_sorted());
+  LongTensor runStarts = coalesce_run_starts(indicesBuffer);
+  int64_t newNnz = runStarts.size(0);
+
   SparseTensor dst = new_sparse(self.options());
   get_sparse_impl(dst)->resize_(sparse_dim, dense_dim, self.sizes());
-  // TODO: is there a more idiomatic way to do this?
-  LongTensor newIndices = at::empty(indices.sizes(), indices.options());
-  Tensor newValues = at::empty(values.sizes(), values.options());
+  LongTensor newIndices = at::empty({sparse_dim, newNnz}, indices.options());
+  Tensor newValues = new_values_with_size_of(values, newNnz);
   alias_into_sparse(dst, newIndices, newValues);
 
-  LongTensor indicesBuffer;
-  LongTensor indicesPermutation;
-  std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
   // NB: The accessor accesses here rely on self._nnz() > 0 (tested earlier in this function)
   auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
   auto indicesAccessor = indices.accessor<int64_t, 2>();
   auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
-  auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
+  auto runStartsAccessor = runStarts.accessor<int64_t, 1>();
 
-  int64_t i = -1;
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "coalesce", [&] {
-        int64_t prev = -1;
         int64_t blockSize = values.stride(0);
         scalar_t* values_ptr = values.data_ptr<scalar_t>();
         scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
-        for (int64_t j = 0; j < nnz; j++) {
-          int64_t pos = indicesPermutationAccessor[j];
-          int64_t curr = indicesBufferAccessor[j];
-          if (curr == prev) {
-            if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
-              THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
-            }
-          } else {
-            ++i;
+        int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(1, blockSize));
+        at::parallel_for(0, newNnz, grain_size, [&](int64_t start, int64_t end) {
+          for (int64_t i = start; i < end; i++) {
+            int64_t run_begin = runStartsAccessor[i];
+            int64_t run_end = i + 1 < newNnz ? runStartsAccessor[i + 1] : nnz;
+            int64_t pos = indicesPermutationAccessor[run_begin];
             for (int64_t d = 0; d < sparse_dim; d++) {
               newIndicesAccessor[d][i] = indicesAccessor[d][pos];
             }
             if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
               THBlas_copy<scalar_t>(blockSize, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+              for (int64_t j = run_begin + 1; j < run_end; j++) {
+                pos = indicesPermutationAccessor[j];
+                THBlas_axpy<scalar_t>(blockSize, 1, values_ptr + pos * blockSize, 1, newValues_ptr + i * blockSize, 1);
+              }
             }
           }
-          prev = curr;
-        }
+        });
     });
 
   dst._coalesced_(true);
-  get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
 
   return dst;
 }
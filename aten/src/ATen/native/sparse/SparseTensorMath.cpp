@@ -12,6 +12,7 @@
 #include <TH/THBlasUtils.h>
 
 #include <algorithm>
+#include <numeric>
 
 namespace at { namespace native {
 
@@ -42,6 +43,78 @@ namespace {
     return csr;
   }
 
+  // Binary operations with a sparse result walk the indices of both operands
+  // in order, like a merge of two sorted lists. Given the flattened indices
+  // (keys) of both operands, this splits the merge into parts, at most one per
+  // thread, such that part c covers t_keys[t_bounds[c] : t_bounds[c + 1]] and
+  // s_keys[s_bounds[c] : s_bounds[c + 1]]. The longer list is split evenly,
+  // and the other one before the first key that is not less than the key at
+  // the split, so equal keys end up in the same part. Unless both lists are
+  // sorted, there is a single part.
+  void split_merge(
+      const int64_t* t_keys, int64_t t_nnz,
+      const int64_t* s_keys, int64_t s_nnz,
+      bool sorted,
+      std::vector<int64_t>& t_bounds,
+      std::vector<int64_t>& s_bounds) {
+    int64_t num_parts = sorted
+        ? std::max<int64_t>(1, std::min<int64_t>(at::get_num_threads(), divup(t_nnz + s_nnz, internal::GRAIN_SIZE)))
+        : 1;
+    bool split_t = t_nnz >= s_nnz;
+    const int64_t* long_keys = split_t ? t_keys : s_keys;
+    const int64_t* short_keys = split_t ? s_keys : t_keys;
+    int64_t long_nnz = split_t ? t_nnz : s_nnz;
+    int64_t short_nnz = split_t ? s_nnz : t_nnz;
+    std::vector<int64_t>& long_bounds = split_t ? t_bounds : s_bounds;
+    std::vector<int64_t>& short_bounds = split_t ? s_bounds : t_bounds;
+
+    long_bounds.resize(num_parts + 1);
+    short_bounds.resize(num_parts + 1);
+    long_bounds[0] = short_bounds[0] = 0;
+    for (int64_t c = 1; c < num_parts; c++) {
+      long_bounds[c] = long_nnz * c / num_parts;
+      short_bounds[c] = std::lower_bound(short_keys, short_keys + short_nnz, long_keys[long_bounds[c]]) - short_keys;
+    }
+    long_bounds[num_parts] = long_nnz;
+    short_bounds[num_parts] = short_nnz;
+  }
+
+  // Calls f(t_i, s_i) for every element of the union of the two lists of keys,
+  // with -1 for the list that doesn't have it.
+  template <typename F>
+  void merge_union(
+      const int64_t* t_keys, int64_t t_i, int64_t t_end,
+      const int64_t* s_keys, int64_t s_i, int64_t s_end,
+      const F& f) {
+    while (t_i < t_end || s_i < s_end) {
+      if (s_i >= s_end || (t_i < t_end && t_keys[t_i] < s_keys[s_i])) {
+        f(t_i++, -1);
+      } else if (t_i >= t_end || s_keys[s_i] < t_keys[t_i]) {
+        f(-1, s_i++);
+      } else {
+        f(t_i++, s_i++);
+      }
+    }
+  }
+
+  // Calls f(t_i, s_i) for every element of the intersection of the two lists
+  // of keys.
+  template <typename F>
+  void merge_intersection(
+      const int64_t* t_keys, int64_t t_i, int64_t t_end,
+      const int64_t* s_keys, int64_t s_i, int64_t s_end,
+      const F& f) {
+    while (t_i < t_end && s_i < s_end) {
+      if (t_keys[t_i] < s_keys[s_i]) {
+        t_i++;
+      } else if (s_keys[s_i] < t_keys[t_i]) {
+        s_i++;
+      } else {
+        f(t_i++, s_i++);
+      }
+    }
+  }
+
 }
 
 // --------------------------------------------------------------------
@@ -83,6 +156,7 @@ SparseTensor& mul_out_sparse_zerodim(SparseTensor& r, const SparseTensor& t, con
     at::mul_out(r_values, t._values(), value);
     get_sparse_impl(r)->set_nnz_and_narrow(t._nnz());
     r._coalesced_(t.is_coalesced());
+    get_sparse_impl(r)->set_indices_sorted(get_sparse_impl(t)->indices_sorted());
   }
   return r;
 }
@@ -409,22 +483,43 @@ Tensor& sub_out_sparse(Tensor& r, const Tensor& self, const Tensor& other, Scala
 
 SparseTensor& add_out_sparse_contiguous(SparseTensor& r, const SparseTensor& t, const SparseTensor& src, Scalar value, ScalarType commonDtype) {
     // saving those because they can be overwritten when doing in-place operations
-    int64_t t_nnz = t._nnz(), s_nnz = src._nnz(), max_nnz = t_nnz + s_nnz;
+    int64_t t_nnz = t._nnz(), s_nnz = src._nnz();
     bool coalesced = t.is_coalesced() && src.is_coalesced();
+    // merging two sorted lists of indices gives a sorted list
+    bool indices_sorted = get_sparse_impl(t)->indices_sorted() && get_sparse_impl(src)->indices_sorted();
     int64_t sparse_dim = src.sparse_dim();
 
-    LongTensor r_indices = at::empty({src.sparse_dim(), max_nnz}, t._indices().options());
-
     Tensor t_values = t._values().to(commonDtype);
     Tensor s_values = src._values().to(commonDtype);
 
-    Tensor r_values = new_values_with_size_of(s_values, max_nnz).zero_();
-
-    int64_t blockSize = r_values.stride(0);
-    int64_t cmp, d;
-    int64_t r_i = 0, t_i = 0, s_i = 0;
     auto t_indices = t._indices();
     auto src_indices = src._indices();
+    LongTensor t_keys = flatten_indices(t_indices, t.sizes()).contiguous();
+    LongTensor s_keys = flatten_indices(src_indices, src.sizes()).contiguous();
+    const int64_t* t_keys_ptr = t_keys.data_ptr<int64_t>();
+    const int64_t* s_keys_ptr = s_keys.data_ptr<int64_t>();
+
+    // Merge the indices in parallel when they are sorted: count the entries
+    // of every part of the result, then fill the parts in.
+    std::vector<int64_t> t_bounds, s_bounds;
+    split_merge(t_keys_ptr, t_nnz, s_keys_ptr, s_nnz, indices_sorted, t_bounds, s_bounds);
+    int64_t num_parts = t_bounds.size() - 1;
+    std::vector<int64_t> r_offsets(num_parts + 1, 0);
+    at::parallel_for(0, num_parts, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        int64_t count = 0;
+        merge_union(t_keys_ptr, t_bounds[c], t_bounds[c + 1], s_keys_ptr, s_bounds[c], s_bounds[c + 1],
+                    [&](int64_t, int64_t) { count++; });
+        r_offsets[c + 1] = count;
+      }
+    });
+    std::partial_sum(r_offsets.begin(), r_offsets.end(), r_offsets.begin());
+    int64_t r_nnz = r_offsets[num_parts];
+
+    LongTensor r_indices = at::empty({sparse_dim, r_nnz}, t_indices.options());
+    Tensor r_values = new_values_with_size_of(s_values, r_nnz).zero_();
+
+    int64_t blockSize = r_values.stride(0);
 
     // NB: relies on nnz tests above
     auto t_indices_accessor = t_indices.accessor<int64_t, 2>();
@@ -437,48 +532,35 @@ SparseTensor& add_out_sparse_contiguous(SparseTensor& r, const SparseTensor& t,
           scalar_t* s_values_ptr = s_values.data_ptr<scalar_t>();
           scalar_t* r_values_ptr = r_values.data_ptr<scalar_t>();
           scalar_t cast_value = value.to<scalar_t>();
-          while (t_i < t_nnz || s_i < s_nnz) {
-            if (t_i >= t_nnz) {
-              cmp = -1;
-            } else if (s_i >= s_nnz) {
-              cmp = 1;
-            } else {
-              cmp = 0;
-              for (d = 0; d < sparse_dim; d++) {
-                if (t_indices_accessor[d][t_i] < src_indices_accessor[d][s_i]) {
-                  cmp = 1;
-                  break;
+          at::parallel_for(0, num_parts, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t c = begin; c < end; c++) {
+              int64_t r_i = r_offsets[c];
+              merge_union(t_keys_ptr, t_bounds[c], t_bounds[c + 1], s_keys_ptr, s_bounds[c], s_bounds[c + 1],
+                          [&](int64_t t_i, int64_t s_i) {
+                if (t_i >= 0) {
+                  for (int64_t d = 0; d < sparse_dim; d++) {
+                    r_indices_accessor[d][r_i] = t_indices_accessor[d][t_i];
+                  }
+                  if (t_values.numel() > 0) {  // We add all elements from t_values to r_values only if t_values is not an empty tensor
+                    THBlas_axpy<scalar_t>(blockSize, 1,
+                      t_values_ptr + t_i * blockSize, 1,
+                      r_values_ptr + r_i * blockSize, 1);
+                  }
                 }
-                if (t_indices_accessor[d][t_i] > src_indices_accessor[d][s_i]) {
-                  cmp = -1;
-                  break;
+                if (s_i >= 0) {
+                  for (int64_t d = 0; d < sparse_dim; d++) {
+                    r_indices_accessor[d][r_i] = src_indices_accessor[d][s_i];
+                  }
+                  if (s_values.numel() > 0) {  // We add all elements from s_values to r_values only if s_values is not an empty tensor
+                    THBlas_axpy<scalar_t>(blockSize, cast_value,
+                      s_values_ptr + s_i * blockSize, 1,
+                      r_values_ptr + r_i * blockSize, 1);
+                  }
                 }
-              }
-            }
-            if (cmp >= 0) {
-              for (d = 0; d < sparse_dim; d++) {
-                r_indices_accessor[d][r_i] = t_indices_accessor[d][t_i];
-              }
-              if (t_values.numel() > 0) {  // We add all elements from t_values to r_values only if t_values is not an empty tensor
-                THBlas_axpy<scalar_t>(blockSize, 1,
-                  t_values_ptr + t_i * blockSize, 1,
-                  r_values_ptr + r_i * blockSize, 1);
-              }
-              t_i++;
+                r_i++;
+              });
             }
-            if (cmp <= 0) {
-              for (d = 0; d < sparse_dim; d++) {
-                r_indices_accessor[d][r_i] = src_indices_accessor[d][s_i];
-              }
-              if (s_values.numel() > 0) {  // We add all elements from s_values to r_values only if s_values is not an empty tensor
-                THBlas_axpy<scalar_t>(blockSize, cast_value,
-                  s_values_ptr + s_i * blockSize, 1,
-                  r_values_ptr + r_i * blockSize, 1);
-              }
-              s_i++;
-            }
-            r_i++;
-          }
+          });
         }
     );
 
@@ -486,13 +568,14 @@ SparseTensor& add_out_sparse_contiguous(SparseTensor& r, const SparseTensor& t,
       r_values = r_values.to(r.scalar_type());
     }
     get_sparse_impl(r)->set_indices_and_values_unsafe(r_indices, r_values);
-    get_sparse_impl(r)->set_nnz_and_narrow(r_i);
 
     // TODO: I think it may be possible to track inside the loop and
     // detect when we are uncoalesced (e.g., by observing that an
     // index goes backwards) which may be more precise than using the
     // coalesced flag here.  But this is easy.
-    return r._coalesced_(coalesced);
+    r._coalesced_(coalesced);
+    get_sparse_impl(r)->set_indices_sorted(indices_sorted);
+    return r;
 }
 
 SparseTensor& add_out_sparse_non_contiguous(SparseTensor& r, const SparseTensor& t, const SparseTensor& src, Scalar value, ScalarType commonDtype) {
@@ -674,19 +757,14 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
     return r.zero_();
   }
 
+  // coalesce() returns its argument as it is if it's coalesced already
   SparseTensor t = t_.coalesce();
   SparseTensor src = src_.coalesce();
 
   // saving those because they can be overwritten when doing in-place operations
   int64_t t_nnz = t._nnz(), s_nnz = src._nnz();
-  int64_t max_nnz = std::min(t_nnz, s_nnz);  // multiply by zero is zero, and can be dropped
-  int64_t sparse_dim = src.sparse_dim();
   LongTensor t_indices = t._indices();
   LongTensor src_indices = src._indices();
-  LongTensor r_indices = at::empty({sparse_dim, max_nnz}, t_indices.options());
-
-  int64_t match, d;
-  int64_t r_i = 0, t_i = 0, s_i = 0;
 
   auto commonDtype = promoteTypes(t_.scalar_type(), src_.scalar_type());
   TORCH_CHECK(canCast(commonDtype, r.scalar_type()), "Can't convert result type ", commonDtype, " to output ", r.scalar_type(), " in mul operation");
@@ -694,67 +772,50 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
   Tensor t_values = t._values().to(commonDtype);
   Tensor s_values = src._values().to(commonDtype);
 
-  Tensor r_buffer = new_values_with_size_of(t_values, max_nnz).zero_();
-
-  // NB: relies on nnz test above
-  auto t_indices_accessor = t_indices.accessor<int64_t, 2>();
-  auto r_indices_accessor = r_indices.accessor<int64_t, 2>();
-  auto src_indices_accessor = src_indices.accessor<int64_t, 2>();
-
-  // Check if we can find matching indices, and if so, write an
-  // entry to the result indices vector.  Returns true if matching
-  // indices were found.
-  auto index_preamble = [&]() {
-    match = 1;
-    for (d = 0; d < sparse_dim; d++) {
-      if (t_indices_accessor[d][t_i] < src_indices_accessor[d][s_i]) {
-        t_i++;
-        match = 0;
-        break;
-      }
-      if (t_indices_accessor[d][t_i] > src_indices_accessor[d][s_i]) {
-        s_i++;
-        match = 0;
-        break;
-      }
-    }
-    if (!match) return false;
-    for (d = 0; d < sparse_dim; d++) {
-      r_indices_accessor[d][r_i] = t_indices_accessor[d][t_i];
+  // Find the entries with matching indices in parallel, counting them in
+  // every part of the merge before writing their positions.
+  LongTensor t_keys = flatten_indices(t_indices, t.sizes()).contiguous();
+  LongTensor s_keys = flatten_indices(src_indices, src.sizes()).contiguous();
+  const int64_t* t_keys_ptr = t_keys.data_ptr<int64_t>();
+  const int64_t* s_keys_ptr = s_keys.data_ptr<int64_t>();
+  std::vector<int64_t> t_bounds, s_bounds;
+  split_merge(t_keys_ptr, t_nnz, s_keys_ptr, s_nnz, /*sorted=*/true, t_bounds, s_bounds);
+  int64_t num_parts = t_bounds.size() - 1;
+  std::vector<int64_t> r_offsets(num_parts + 1, 0);
+  at::parallel_for(0, num_parts, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t count = 0;
+      merge_intersection(t_keys_ptr, t_bounds[c], t_bounds[c + 1], s_keys_ptr, s_bounds[c], s_bounds[c + 1],
+                         [&](int64_t, int64_t) { count++; });
+      r_offsets[c + 1] = count;
     }
-    return true;
-  };
-
-  if (t_values.dim() > 1) {
-    while (t_i < t_nnz && s_i < s_nnz) {
-      if (!index_preamble()) continue;
-      r_buffer.select(0, r_i).addcmul_(t_values.select(0, t_i), s_values.select(0, s_i));
-      r_i++;
-      t_i++;
-      s_i++;
+  });
+  std::partial_sum(r_offsets.begin(), r_offsets.end(), r_offsets.begin());
+  int64_t r_nnz = r_offsets[num_parts];
+
+  LongTensor t_matches = at::empty({r_nnz}, t_indices.options());
+  LongTensor s_matches = at::empty({r_nnz}, t_indices.options());
+  int64_t* t_matches_ptr = t_matches.data_ptr<int64_t>();
+  int64_t* s_matches_ptr = s_matches.data_ptr<int64_t>();
+  at::parallel_for(0, num_parts, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t r_i = r_offsets[c];
+      merge_intersection(t_keys_ptr, t_bounds[c], t_bounds[c + 1], s_keys_ptr, s_bounds[c], s_bounds[c + 1],
+                         [&](int64_t t_i, int64_t s_i) {
+        t_matches_ptr[r_i] = t_i;
+        s_matches_ptr[r_i] = s_i;
+        r_i++;
+      });
     }
-  } else {
-    AT_DISPATCH_ALL_TYPES(
-        commonDtype, "mul_out_sparse", [&] {
-          auto r_accessor = r_buffer.accessor<scalar_t, 1>();
-          auto t_accessor = t_values.accessor<scalar_t, 1>();
-          auto s_accessor = s_values.accessor<scalar_t, 1>();
-
-          while (t_i < t_nnz && s_i < s_nnz) {
-            if (!index_preamble()) continue;
-            r_accessor[r_i] = t_accessor[t_i] * s_accessor[s_i];
-            r_i++;
-            t_i++;
-            s_i++;
-          }
-        }
-    );
-  }
+  });
+
+  // multiply by zero is zero, so only the matching entries are kept
+  LongTensor r_indices = t_indices.index_select(1, t_matches);
+  Tensor r_buffer = t_values.index_select(0, t_matches).mul_(s_values.index_select(0, s_matches));
 
   r.resize_as_(src);
   Tensor r_values = r_buffer.to(r.scalar_type());
   get_sparse_impl(r)->set_indices_and_values_unsafe(r_indices, r_values);
-  get_sparse_impl(r)->set_nnz_and_narrow(r_i);
   return r._coalesced_(true);
 }
 
@@ -928,6 +989,9 @@ Tensor _sparse_mm(
   const SparseTensor& sparse,
   const Tensor& dense
 ) {
+  if (dense.is_sparse()) {
+    return at::_sparse_sparse_matmul(sparse, dense);
+  }
   Tensor t = at::zeros({}, dense.options());
   return at::_sparse_addmm(t, sparse, dense, 0, 1);  // redispatch!
 }
@@ -940,6 +1004,9 @@ SparseTensor& _sparse_mm_out(
   const SparseTensor& sparse,
   const Tensor& dense
 ) {
+  if (dense.is_sparse()) {
+    return at::copy_sparse_to_sparse_(result, at::_sparse_sparse_matmul(sparse, dense));
+  }
   Tensor t = at::zeros({}, dense.options());
   return at::addmm_out(result, t, sparse, dense, 0, 1);  // redispatch!
 }
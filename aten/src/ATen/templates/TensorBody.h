@@ -215,11 +215,16 @@ class CAFFE2_API Tensor {
     return impl_->is_non_overlapping_and_dense();
   }
 
+  /// Returns if a `Tensor` was created in `c10::InferenceMode`.
+  bool is_inference() const {
+    return impl_->is_inference();
+  }
+
   at::MemoryFormat suggest_memory_format(
       bool channels_last_strides_exact_match = false) const {
     // Setting channels_last_strides_exact_match to true forces function to
     // check 0,1 - sized dimension strides.
-    if (!is_mkldnn() && !is_sparse()) {
+    if (!is_mkldnn() && !is_sparse() && !is_sparse_csr()) {
       if (impl_->is_strides_like_channels_last()) {
         if (!channels_last_strides_exact_match ||
             get_channels_last_strides_2d(sizes()) == strides()) {
@@ -314,6 +319,9 @@ class CAFFE2_API Tensor {
   /// Returns if a `Tensor` has sparse backend.
   bool is_sparse() const;
 
+  /// Returns if a `Tensor` has the compressed sparse row layout.
+  bool is_sparse_csr() const;
+
   /// Returns if a `Tensor` is mkldnn tensor.
   bool is_mkldnn() const;
 
@@ -126,6 +126,15 @@ bool is_sparse(Tensor self) {
   return self.is_sparse();
 }
 
+bool Tensor::is_sparse_csr() const {
+  // NB: this is not a native function to avoid dispatching overhead.
+  return impl_->is_sparse_csr();
+}
+
+bool is_sparse_csr(Tensor self) {
+  return self.is_sparse_csr();
+}
+
 bool Tensor::is_mkldnn() const {
   // NB: this is not a native function to avoid dispatching overhead.
   return impl_->is_mkldnn();
@@ -8,6 +8,13 @@ def add_tensors_loop(x, y):
         z = torch.add(z, x)
     return z
 
+def add_scalar_mul_loop(x, y):
+    z = torch.add(x, y)
+    for i in range(NUM_LOOP_ITERS):
+        z = torch.add(z, 1)
+        z = torch.mul(z, y)
+    return z
+
 class SimpleAddModule(torch.nn.Module):
     def __init__(self, add_op):
         super(SimpleAddModule, self).__init__()
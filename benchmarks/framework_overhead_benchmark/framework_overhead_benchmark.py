@@ -1,14 +1,15 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 from utils import ms_to_us, benchmark_module, BenchmarkConfig, ModuleConfig
 import argparse
+import torch
 from C2Module import C2SimpleNet
 
-from SimpleAddModule import SimpleAddModule, add_tensors_loop
+from SimpleAddModule import SimpleAddModule, add_tensors_loop, add_scalar_mul_loop
 from pt_wrapper_module import WrapperModule
 
 """ Framework overhead benchmark script.
 Benchmark framework overhead.
-Currently supported ops: add.
+Currently supported ops: add, add_scalar (add/mul chain with a constant operand).
 As of now runs only forward pass.
 Supports both graph mode and eager mode. In graph mode the module is traced via JIT tracing.
 Debug option prints the traced graph is graph_mode is enabled.
@@ -22,9 +23,14 @@ buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_ben
 To run C2 benchmark:
 buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_benchmark --
  --add_op --benchmark_c2_net
+To measure the JIT interpreter superinstructions, compare:
+buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_benchmark --
+ --op add_scalar_op
+buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_benchmark --
+ --op add_scalar_op --enable_superinstructions
 """
 
-SUPPORTED_OPS = {"add_op"}
+SUPPORTED_OPS = {"add_op", "add_scalar_op"}
 
 def parse_op_args(op):
     op_list = ops.split(",")
@@ -70,6 +76,8 @@ def main():
     parser.add_argument("--debug", default=False, dest="debug", action="store_true")
     parser.add_argument("--save", default=False, dest="save", action="store_true")
     parser.add_argument("--eager_mode", default=False, dest="eager_mode", action="store_true")
+    parser.add_argument("--enable_superinstructions", default=False, dest="enable_superinstructions",
+                        action="store_true")
     parser.add_argument("--num_warmup_iters", type=int, default=100)
     parser.add_argument("--num_iters", type=int, default=1000)
     args = parser.parse_args()
@@ -80,6 +88,9 @@ def main():
     assert not (args.benchmark_c2_net and args.use_throughput_benchmark), \
         "Benchmarking of C2 net via throughput benchmarking is not yet supported"
 
+    if args.enable_superinstructions:
+        torch._C._jit_set_interpreter_superinstructions(True)
+
     num_warmup_iters = args.num_warmup_iters
     num_iters = args.num_iters
     config = BenchmarkConfig(num_warmup_iters, num_iters)
@@ -94,6 +105,11 @@ def main():
         else:
             module_config = ModuleConfig(add_tensors_loop, None, num_params, graph_mode)
         benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
+    elif args.op == "add_scalar_op":
+        assert not args.benchmark_c2_net, "add_scalar_op has no C2 equivalent"
+        num_params = 2
+        module_config = ModuleConfig(add_scalar_mul_loop, None, num_params, graph_mode)
+        benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
     print_results(result)
 
 if __name__ == "__main__":
@@ -189,6 +189,8 @@ class BenchmarkRunner(object):
               "# PyTorch/Caffe2 Operator Micro-benchmarks\n"
               "# {}\n"
               "# Tag : {}\n".format(DASH_LINE, DASH_LINE, self.args.tag_filter))
+        if self.args.cpu_capability:
+            print("# CPU capability : {}\n".format(self.args.cpu_capability))
         if self.args.list_tests:
             print("# List of tests:")
         elif self.args.list_ops:
@@ -4,6 +4,7 @@ from __future__ import print_function
 from __future__ import unicode_literals
 
 import argparse
+import os
 
 import torch
 
@@ -132,8 +133,19 @@ def main():
         help='Run tests on the provided architecture (cpu, cuda)',
         default='None')
 
+    parser.add_argument(
+        '--cpu_capability',
+        help='Run the CPU kernels compiled for this capability (default, avx, avx2, avx512) '
+             'instead of the best one the machine supports. Run once per capability to compare them.',
+        default=None)
+
     args, _ = parser.parse_known_args()
 
+    if args.cpu_capability:
+        # The capability is read from ATEN_CPU_CAPABILITY the first time a CPU
+        # kernel is dispatched, so it has to be set before any operator runs.
+        os.environ['ATEN_CPU_CAPABILITY'] = args.cpu_capability
+
     if args.omp_num_threads:
         # benchmark_utils.set_omp_threads sets the env variable OMP_NUM_THREADS
         # which doesn't have any impact as C2 init logic has already been called
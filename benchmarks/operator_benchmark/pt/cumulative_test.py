@@ -0,0 +1,67 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for cumsum, cumprod, logcumsumexp, cummax and cummin."""
+
+cumulative_ops_list = op_bench.op_list(
+    attr_names=["op_name", "op_func"],
+    attrs=[
+        ["cumsum", torch.cumsum],
+        ["cumprod", torch.cumprod],
+        ["logcumsumexp", torch.logcumsumexp],
+        ["cummax", torch.cummax],
+        ["cummin", torch.cummin],
+    ],
+)
+
+# A long 1-D scan, scans along the innermost dimension of long and of short
+# rows, and one along the outer dimension.
+cumulative_configs_short = op_bench.config_list(
+    attr_names=["M", "N", "dim"],
+    attrs=[
+        [1, 1000000, 1],
+        [64, 100000, 1],
+        [256, 4096, 1],
+        [4096, 256, 1],
+        [256, 4096, 0],
+    ],
+    cross_product_configs={
+        "dtype": [torch.float],
+    },
+    tags=["short"]
+)
+
+
+cumulative_configs_long = op_bench.cross_product_configs(
+    M=[1, 64, 1024],
+    N=[1024, 65536],
+    dim=[0, 1],
+    dtype=[torch.float, torch.double],
+    tags=["long"]
+)
+
+
+class CumulativeBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dim, dtype, op_func):
+        # Close to 1, so that products neither overflow nor vanish.
+        self.input_one = 1 + torch.rand(M, N, dtype=dtype) / N
+        self.dim = dim
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, self.dim)
+
+
+op_bench.generate_pt_tests_from_op_list(cumulative_ops_list,
+                                        cumulative_configs_short + cumulative_configs_long,
+                                        CumulativeBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,68 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for index_put_ with accumulate=True and index_add_."""
+
+# N values are accumulated into N * (1 - dup_ratio) destinations, so that
+# dup_ratio is the fraction of the values that hit an already used destination.
+index_accumulate_configs_short = op_bench.cross_product_configs(
+    N=[1 << 16, 1 << 20],
+    dup_ratio=[0.0, 0.5, 0.9, 0.99, 0.999],
+    dtype=[torch.float, torch.long],
+    tags=["short"]
+)
+
+
+index_accumulate_configs_long = op_bench.cross_product_configs(
+    N=[1 << 12, 1 << 16, 1 << 20, 1 << 22],
+    dup_ratio=[0.0, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0],
+    dtype=[torch.float, torch.double, torch.int, torch.long],
+    tags=["long"]
+)
+
+
+def make_index(N, dup_ratio):
+    num_dest = max(1, int(N * (1 - dup_ratio)))
+    if num_dest == N:
+        index = torch.randperm(N)
+    else:
+        index = torch.randint(num_dest, (N,))
+    return num_dest, index
+
+
+class IndexPutAccumulateBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, dup_ratio, dtype):
+        num_dest, self.index = make_index(N, dup_ratio)
+        self.input_one = torch.zeros(num_dest, dtype=dtype)
+        self.values = torch.ones(N, dtype=dtype)
+        self.set_module_name("index_put_accumulate")
+
+    def forward(self):
+        return self.input_one.index_put_((self.index,), self.values, accumulate=True)
+
+
+class IndexAddBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, dup_ratio, dtype):
+        num_dest, self.index = make_index(N, dup_ratio)
+        self.input_one = torch.zeros(num_dest, dtype=dtype)
+        self.values = torch.ones(N, dtype=dtype)
+        self.set_module_name("index_add_")
+
+    def forward(self):
+        return self.input_one.index_add_(0, self.index, self.values)
+
+
+op_bench.generate_pt_test(index_accumulate_configs_short + index_accumulate_configs_long,
+                          IndexPutAccumulateBenchmark)
+op_bench.generate_pt_test(index_accumulate_configs_short + index_accumulate_configs_long,
+                          IndexAddBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
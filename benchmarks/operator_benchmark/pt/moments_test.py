@@ -0,0 +1,63 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for reductions computing several statistics in one pass:
+var_mean, std_mean and _aminmax."""
+
+moments_ops_list = op_bench.op_list(
+    attr_names=["op_name", "op_func"],
+    attrs=[
+        ["var_mean", lambda x, dim: torch.var_mean(x, dim)],
+        ["std_mean", lambda x, dim: torch.std_mean(x, dim)],
+        ["aminmax", lambda x, dim: torch._aminmax(x, dim)],
+    ],
+)
+
+# A long reduction of a single row, reductions along the innermost dimension
+# and along the outer dimension.
+moments_configs_short = op_bench.config_list(
+    attr_names=["M", "N", "dim"],
+    attrs=[
+        [1, 1000000, 1],
+        [256, 4096, 1],
+        [256, 4096, 0],
+    ],
+    cross_product_configs={
+        "dtype": [torch.float],
+    },
+    tags=["short"]
+)
+
+
+moments_configs_long = op_bench.cross_product_configs(
+    M=[1, 64, 1024],
+    N=[1024, 65536],
+    dim=[0, 1],
+    dtype=[torch.float, torch.double],
+    tags=["long"]
+)
+
+
+class MomentsBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dim, dtype, op_func):
+        self.input_one = torch.randn(M, N, dtype=dtype)
+        self.dim = dim
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, self.dim)
+
+
+op_bench.generate_pt_tests_from_op_list(moments_ops_list,
+                                        moments_configs_short + moments_configs_long,
+                                        MomentsBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
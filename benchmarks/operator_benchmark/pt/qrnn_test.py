@@ -27,6 +27,21 @@ qrnn_configs = op_bench.config_list(
     tags=["short"]
 )
 
+qrnn_long_configs = op_bench.config_list(
+    attrs=[
+        [256, 256, 1],
+        [512, 512, 2],
+    ],
+    # names: input_size, hidden_size, num_layers
+    attr_names=["I", "H", "NL"],
+    cross_product_configs={
+        "B": (True,),
+        "D": (False, True),
+        "dtype": (torch.qint8,)
+    },
+    tags=["long"]
+)
+
 class LSTMBenchmark(op_bench.TorchBenchmarkBase):
     def init(self, I, H, NL, B, D, dtype):
         sequence_len = 128
@@ -65,7 +80,50 @@ class LSTMBenchmark(op_bench.TorchBenchmarkBase):
     def forward(self):
         return self.cell(self.x, (self.h, self.c))
 
-op_bench.generate_pt_test(qrnn_configs, LSTMBenchmark)
+
+class GRUBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, I, H, NL, B, D, dtype):
+        sequence_len = 128
+        batch_size = 16
+
+        cell_nn = nn.GRU(
+            input_size=I,
+            hidden_size=H,
+            num_layers=NL,
+            bias=B,
+            batch_first=False,
+            dropout=0.0,
+            bidirectional=D,
+        )
+        packed_weights = torch.ops.quantized.linear_prepack
+        self.params = []
+        for layer_weights in cell_nn._all_weights:
+            w_ih, w_hh, b_ih, b_hh = (getattr(cell_nn, name) for name in layer_weights)
+            packed = []
+            for w, b in ((w_ih, b_ih), (w_hh, b_hh)):
+                w = w.detach()
+                scale = float(w.abs().max()) / 127
+                packed.append(packed_weights(torch.quantize_per_tensor(w, scale, 0, dtype), b.detach()))
+            self.params.append(torch.ops.quantized.make_quantized_cell_params_dynamic(
+                packed[0], packed[1], b_ih.detach(), b_hh.detach(), True))
+        self.num_layers = NL
+        self.bidirectional = D
+
+        self.x = torch.randn(sequence_len,  # sequence length
+                             batch_size,    # batch size
+                             I)             # Number of features in X
+        self.h = torch.randn(NL * (D + 1),  # layer_num * dir_num
+                             batch_size,    # batch size
+                             H)             # hidden size
+
+        self.set_module_name("QGRU")
+
+    def forward(self):
+        return torch.quantized_gru(self.x, self.h, self.params, True, self.num_layers,
+                                   0.0, False, self.bidirectional, False)
+
+op_bench.generate_pt_test(qrnn_configs + qrnn_long_configs, LSTMBenchmark)
+op_bench.generate_pt_test(qrnn_configs + qrnn_long_configs, GRUBenchmark)
 
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -0,0 +1,73 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""Microbenchmarks for scatter_add_ and scatter_reduce_."""
+
+# E rows of F features are reduced into N rows, with an index that is the same
+# for all the features of a row, as in the message passing of graph networks.
+scatter_reduce_configs_short = op_bench.cross_product_configs(
+    N=[1000],
+    E=[100000],
+    F=[1, 16],
+    reduce=["sum", "max", "mean"],
+    tags=["short"]
+)
+
+
+scatter_reduce_configs_long = op_bench.cross_product_configs(
+    N=[10, 1000, 100000],
+    E=[10000, 100000, 1000000],
+    F=[1, 16, 64],
+    reduce=["sum", "prod", "mean", "max", "min"],
+    tags=["long"]
+)
+
+
+class ScatterReduceBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, E, F, reduce):
+        self.input_one = torch.zeros(N, F)
+        self.index = torch.randint(N, (E, 1)).expand(E, F)
+        self.src = torch.rand(E, F)
+        self.reduce = reduce
+        self.set_module_name("scatter_reduce_")
+
+    def forward(self):
+        return self.input_one.scatter_reduce_(0, self.index, self.src, self.reduce)
+
+
+scatter_add_configs = op_bench.cross_product_configs(
+    N=[1000],
+    E=[100000],
+    F=[1, 16],
+    contiguous_index=[True, False],
+    tags=["short"]
+)
+
+
+class ScatterAddBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, E, F, contiguous_index):
+        self.input_one = torch.zeros(N, F)
+        self.index = torch.randint(N, (E, 1)).expand(E, F)
+        if contiguous_index:
+            # A materialized index with F > 1 takes the elementwise path.
+            self.index = self.index.contiguous()
+        self.src = torch.rand(E, F)
+        self.set_module_name("scatter_add_")
+
+    def forward(self):
+        return self.input_one.scatter_add_(0, self.index, self.src)
+
+
+op_bench.generate_pt_test(scatter_reduce_configs_short + scatter_reduce_configs_long,
+                          ScatterReduceBenchmark)
+op_bench.generate_pt_test(scatter_add_configs, ScatterAddBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,59 @@
+import operator_benchmark as op_bench
+import torch
+
+"""Microbenchmarks for sparse x dense matrix products, comparing the CSR and
+COO layouts."""
+
+sparse_mm_short_configs = op_bench.cross_product_configs(
+    M=[1024],
+    K=[1024],
+    N=[64],
+    density=[0.01, 0.1],
+    layout=['csr', 'coo'],
+    device=['cpu'],
+    tags=['short']
+)
+
+sparse_mm_long_configs = op_bench.cross_product_configs(
+    M=[4096, 16384],
+    K=[4096],
+    N=[16, 256],
+    density=[0.001, 0.01],
+    layout=['csr', 'coo'],
+    device=['cpu'],
+    tags=['long']
+)
+
+
+def _random_sparse(M, K, density, layout):
+    dense = torch.rand(M, K) * (torch.rand(M, K) < density).float()
+    sparse = dense.to_sparse()
+    return sparse.to_sparse_csr() if layout == 'csr' else sparse
+
+
+class SparseMMBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, K, N, density, layout, device):
+        self.sparse = _random_sparse(M, K, density, layout)
+        self.dense = torch.rand(K, N, device=device)
+        self.set_module_name('sparse_mm')
+
+    def forward(self):
+        return torch.mm(self.sparse, self.dense)
+
+
+class SparseMVBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, K, N, density, layout, device):
+        self.sparse = _random_sparse(M, K, density, layout)
+        self.vec = torch.rand(K, device=device)
+        self.set_module_name('sparse_mv')
+
+    def forward(self):
+        return torch.mv(self.sparse, self.vec)
+
+
+op_bench.generate_pt_test(sparse_mm_short_configs + sparse_mm_long_configs, SparseMMBenchmark)
+op_bench.generate_pt_test(sparse_mm_short_configs + sparse_mm_long_configs, SparseMVBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
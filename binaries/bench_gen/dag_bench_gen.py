@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import argparse
+import random
+
+from caffe2.python import core
+
+
+"""Generates a synthetic wide DAG net to benchmark net executors with
+caffe2_benchmark, e.g.:
+
+    python dag_bench_gen.py --branches 32 --max_depth 16
+    caffe2_benchmark --init_net init_net.pb --net predict_net.pb \\
+        --input data --input_dims 64,256 --iter 100 \\
+        --caffe2_net_async_critical_path_scheduling=1
+
+The input goes through `branches` independent chains of FC ops that are
+concatenated at the end. Branch depths are drawn uniformly from
+[1, max_depth] and FC sizes from `--dims`, so the branches have very
+different lengths. Adding --caffe2_net_async_profile_operators=1 makes the
+scheduler use the measured operator times instead of counting operators.
+"""
+
+
+def main(args):
+    random.seed(args.seed)
+    init_net = core.Net(args.benchmark_name + "_init")
+    predict_net = core.Net(args.benchmark_name)
+    predict_net.Proto().type = args.net_type
+    predict_net.Proto().num_workers = args.num_workers
+    predict_net.AddExternalInput(args.input_name)
+
+    dims = [int(d) for d in args.dims.split(",")]
+    branch_outputs = []
+    for branch in range(args.branches):
+        depth = random.randint(1, args.max_depth)
+        blob = args.input_name
+        dim_in = args.input_dim
+        for layer in range(depth):
+            dim_out = random.choice(dims)
+            prefix = "b{}_l{}".format(branch, layer)
+            w = init_net.XavierFill(
+                [], prefix + "_w", shape=[dim_out, dim_in])
+            b = init_net.ConstantFill([], prefix + "_b", shape=[dim_out])
+            predict_net.AddExternalInput(w, b)
+            blob = predict_net.FC([blob, w, b], prefix + "_fc")
+            blob = predict_net.Relu(blob, prefix + "_relu")
+            dim_in = dim_out
+        branch_outputs.append(blob)
+
+    output, _ = predict_net.Concat(
+        branch_outputs, [args.output_name, "concat_split_info"], axis=1)
+    predict_net.AddExternalOutput(output)
+
+    if args.debug:
+        print(predict_net.Proto())
+
+    with open(args.predict_net, 'wb') as f:
+        f.write(predict_net.Proto().SerializeToString())
+    with open(args.init_net, 'wb') as f:
+        f.write(init_net.Proto().SerializeToString())
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Utilitity to generate synthetic DAG benchmark models.")
+    parser.add_argument("--branches", type=int, default=32,
+                        help="Number of independent branches.")
+    parser.add_argument("--max_depth", type=int, default=16,
+                        help="Maximum number of FC layers in a branch.")
+    parser.add_argument("--dims", default="64,256,1024",
+                        help="Comma separated FC output sizes to pick from.")
+    parser.add_argument("--input_dim", type=int, default=256,
+                        help="Size of the input features.")
+    parser.add_argument("--net_type", default="async_scheduling",
+                        help="Type of the generated net.")
+    parser.add_argument("--num_workers", type=int, default=8,
+                        help="Number of executor threads.")
+    parser.add_argument("--seed", type=int, default=0,
+                        help="Random seed for the branch shapes.")
+    parser.add_argument("--init_net", help="Output initialization net.",
+                        default="init_net.pb")
+    parser.add_argument("--predict_net", help="Output prediction net.",
+                        default="predict_net.pb")
+    parser.add_argument("--benchmark_name",
+                        help="Name of the benchmark network",
+                        default="dag_benchmark")
+    parser.add_argument("--input_name", help="Name of the input blob.",
+                        default="data")
+    parser.add_argument("--output_name", help="Name of the output blob.",
+                        default="output")
+    parser.add_argument("-d", "--debug", help="Print the generated net.",
+                        action='store_true')
+    args = parser.parse_args()
+    main(args)
@@ -0,0 +1,118 @@
+#include <torch/torch.h>
+#include <torch/library.h>
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <c10/core/InferenceMode.h>
+
+#include "c10/util/Flags.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+C10_DEFINE_int(iter, 1000000, "Number of op calls per measurement");
+C10_DEFINE_int(warmup_iter, 10000, "Number of warmup op calls")
+C10_DEFINE_int(benchmark_iter, 3, "Number of times to run each measurement")
+
+// Measures the time the dispatcher adds to an op call, on ops that do no
+// work: a kernel that returns its input is called through the dispatcher
+// with an unboxed and a boxed call, and through the Autograd and BackendSelect
+// redispatch; small at:: ops are timed for comparison.
+
+namespace {
+
+at::Tensor noop(const at::Tensor& self) {
+  return self;
+}
+
+at::Tensor noop_autograd(const at::Tensor& self) {
+  at::AutoNonVariableTypeMode non_var_type_mode(true);
+  static auto op = c10::Dispatcher::singleton()
+      .findSchemaOrThrow("dispatch_benchmark::noop_autograd", "")
+      .typed<at::Tensor(const at::Tensor&)>();
+  return op.call(self);
+}
+
+TORCH_LIBRARY(dispatch_benchmark, m) {
+  m.def("noop(Tensor self) -> Tensor");
+  m.def("noop_catchall(Tensor self) -> Tensor", noop);
+  m.def("noop_autograd(Tensor self) -> Tensor");
+}
+
+TORCH_LIBRARY_IMPL(dispatch_benchmark, CPU, m) {
+  m.impl("noop", noop);
+  m.impl("noop_autograd", noop);
+}
+
+TORCH_LIBRARY_IMPL(dispatch_benchmark, Autograd, m) {
+  m.impl("noop_autograd", noop_autograd);
+}
+
+void runBench(const std::string& name, const std::function<void()>& fn) {
+  typedef std::chrono::high_resolution_clock clock;
+  typedef std::chrono::nanoseconds ns;
+  for (auto i = 0; i < FLAGS_warmup_iter; ++i) {
+    fn();
+  }
+  for (auto b = 0; b < FLAGS_benchmark_iter; ++b) {
+    auto start_time = clock::now();
+    for (auto i = 0; i < FLAGS_iter; ++i) {
+      fn();
+    }
+    auto duration = static_cast<float>(
+        std::chrono::duration_cast<ns>(clock::now() - start_time).count());
+    std::cout << name << ": " << (duration / FLAGS_iter) << " ns per call" << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (!c10::ParseCommandLineFlags(&argc, &argv)) {
+    std::cout << "Failed to parse command line flags" << std::endl;
+    return -1;
+  }
+
+  auto& dispatcher = c10::Dispatcher::singleton();
+  auto noop_op = dispatcher.findSchemaOrThrow("dispatch_benchmark::noop", "")
+      .typed<at::Tensor(const at::Tensor&)>();
+  auto noop_catchall_op = dispatcher.findSchemaOrThrow("dispatch_benchmark::noop_catchall", "")
+      .typed<at::Tensor(const at::Tensor&)>();
+  auto noop_autograd_op = dispatcher.findSchemaOrThrow("dispatch_benchmark::noop_autograd", "")
+      .typed<at::Tensor(const at::Tensor&)>();
+
+  auto a = torch::ones({1});
+  auto b = torch::ones({1});
+  torch::jit::Stack stack;
+
+  {
+    // Dispatch straight to the CPU kernel, as the ops below do after
+    // Autograd.
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+    runBench("unboxed CPU kernel", [&]() { noop_op.call(a); });
+    runBench("unboxed catch-all kernel", [&]() { noop_catchall_op.call(a); });
+    runBench("boxed CPU kernel", [&]() {
+      stack.clear();
+      torch::jit::push(stack, a);
+      noop_op.callBoxed(&stack);
+    });
+  }
+  runBench("unboxed Autograd and CPU kernels", [&]() { noop_autograd_op.call(a); });
+
+  runBench("at::add", [&]() { at::add(a, b); });
+  {
+    torch::NoGradGuard no_grad;
+    runBench("at::add (no grad)", [&]() { at::add(a, b); });
+  }
+  {
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+    runBench("at::add (no autograd)", [&]() { at::add(a, b); });
+    runBench("at::empty (no autograd)", [&]() { at::empty({1}); });
+  }
+  {
+    c10::InferenceMode inference_mode;
+    runBench("at::add (inference mode)", [&]() { at::add(a, b); });
+    runBench("at::empty (inference mode)", [&]() { at::empty({1}); });
+  }
+
+  return 0;
+}
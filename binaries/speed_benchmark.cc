@@ -14,13 +14,16 @@
  * limitations under the License.
  */
 
+#include <iostream>
 #include <string>
+#include <thread>
 
 #include "caffe2/core/blob_serialization.h"
 #include "caffe2/core/init.h"
 #include "caffe2/core/logging.h"
 #include "caffe2/core/operator.h"
 #include "caffe2/core/tensor_int8.h"
+#include "caffe2/predictor/predictor_pool.h"
 #ifdef CAFFE2_OPTIMIZER
 #include "caffe2/opt/optimizer.h"
 #endif
@@ -71,6 +74,25 @@ C10_DEFINE_bool(
     false,
     "Whether to benchmark individual operators.");
 
+C10_DEFINE_int(
+    predictor_instances,
+    0,
+    "If positive, benchmark requests served by a PredictorPool with this "
+    "many instances sharing the parameters, instead of running the net.");
+C10_DEFINE_int(
+    concurrent_requests,
+    1,
+    "Number of threads sending requests to the PredictorPool, each sending "
+    "iter requests.");
+C10_DEFINE_int(
+    max_batch_size,
+    1,
+    "Maximum number of rows the PredictorPool batches requests into.");
+C10_DEFINE_int(
+    max_batch_delay_us,
+    0,
+    "How long the PredictorPool waits for requests to fill a batch.");
+
 C10_DEFINE_bool(force_engine, false, "Force engine field for all operators");
 C10_DEFINE_string(engine, "", "Forced engine field value");
 C10_DEFINE_bool(force_algo, false, "Force algo arg for all operators");
@@ -80,6 +102,66 @@ using std::string;
 using std::unique_ptr;
 using std::vector;
 
+namespace {
+
+// Sends the inputs in the workspace as concurrent requests to a pool of
+// predictors and reports the throughput and latency of the requests.
+void benchmarkPredictorPool(
+    caffe2::Workspace* workspace,
+    const caffe2::NetDef& net_def,
+    const vector<string>& input_names) {
+  caffe2::PredictorPoolOptions options;
+  options.num_instances = FLAGS_predictor_instances;
+  options.max_batch_size = FLAGS_max_batch_size;
+  options.max_batch_delay = std::chrono::microseconds(FLAGS_max_batch_delay_us);
+  options.input_names = input_names;
+  options.optimization = 0;
+  caffe2::PredictorPool pool(workspace, net_def, options);
+
+  caffe2::PredictorPool::TensorList inputs;
+  for (const string& name : input_names) {
+    const caffe2::Blob* blob = workspace->GetBlob(name);
+    CAFFE_ENFORCE(
+        blob && caffe2::BlobIsTensorType(*blob, caffe2::CPU),
+        "Requests can only be made of CPU tensors, ",
+        name,
+        " is not one.");
+    inputs.push_back(
+        caffe2::BlobGetTensor(*blob, caffe2::CPU).UnsafeSharedInstance());
+  }
+
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    caffe2::PredictorPool::TensorList outputs;
+    CAFFE_ENFORCE(pool(inputs, &outputs), "Warmup request ", i, " failed.");
+  }
+  pool.ResetStats();
+  vector<std::thread> clients;
+  for (int t = 0; t < FLAGS_concurrent_requests; ++t) {
+    clients.emplace_back([&]() {
+      for (int i = 0; i < FLAGS_iter; ++i) {
+        caffe2::PredictorPool::TensorList outputs;
+        CAFFE_ENFORCE(pool(inputs, &outputs), "Request ", i, " failed.");
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  const auto stats = pool.stats();
+  std::cout << "PredictorPool with " << pool.num_instances()
+            << " instances, " << FLAGS_concurrent_requests
+            << " concurrent clients:" << std::endl;
+  std::cout << "  requests: " << stats.num_requests
+            << ", throughput: " << stats.throughput << " requests/s"
+            << ", mean batch size: " << stats.mean_batch_size << std::endl;
+  std::cout << "  latency (ms): p50 " << stats.latency_p50 << ", p90 "
+            << stats.latency_p90 << ", p99 " << stats.latency_p99 << ", max "
+            << stats.latency_max << std::endl;
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
   caffe2::GlobalInit(&argc, &argv);
   unique_ptr<caffe2::Workspace> workspace(new caffe2::Workspace());
@@ -183,6 +265,15 @@ int main(int argc, char** argv) {
 #endif
   }
 
+  if (FLAGS_predictor_instances > 0) {
+    CAFFE_ENFORCE(
+        FLAGS_input.size(),
+        "Benchmarking a PredictorPool requires the inputs to be given.");
+    benchmarkPredictorPool(
+        workspace.get(), net_def, caffe2::split(',', FLAGS_input));
+    return 0;
+  }
+
   caffe2::NetBase* net = workspace->CreateNet(net_def);
   CHECK_NOTNULL(net);
   CAFFE_ENFORCE(net->Run());
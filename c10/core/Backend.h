@@ -40,6 +40,7 @@ enum class Backend {
   QuantizedCUDA,
   Undefined,
   MkldnnCPU,
+  SparseCsrCPU,
   NumOptions
 };
 
@@ -114,6 +115,8 @@ static inline Backend dispatchKeyToBackend(DispatchKey t) {
     return Backend::SparseHIP;
   } else if (t == DispatchKey::MkldnnCPU) {
     return Backend::MkldnnCPU;
+  } else if (t == DispatchKey::SparseCsrCPU) {
+    return Backend::SparseCsrCPU;
   } else if (t == DispatchKey::QuantizedCPU) {
     return Backend::QuantizedCPU;
   } else if (t == DispatchKey::QuantizedCUDA) {
@@ -147,6 +150,8 @@ static inline DispatchKey backendToDispatchKey(Backend b) {
       return DispatchKey::SparseHIP;
     case Backend::MkldnnCPU:
       return DispatchKey::MkldnnCPU;
+    case Backend::SparseCsrCPU:
+      return DispatchKey::SparseCsrCPU;
     case Backend::Vulkan:
       return DispatchKey::Vulkan;
     case Backend::QuantizedCPU:
@@ -181,6 +186,7 @@ static inline DeviceType backendToDeviceType(Backend b) {
     case Backend::SparseHIP:
       return DeviceType::HIP;
     case Backend::MkldnnCPU:
+    case Backend::SparseCsrCPU:
     case Backend::QuantizedCPU:
       return DeviceType::CPU;
     case Backend::QuantizedCUDA:
@@ -215,6 +221,8 @@ static inline Backend backendToCPU(Backend b) {
       return Backend::CPU;
     case Backend::MkldnnCPU:
       return Backend::MkldnnCPU;
+    case Backend::SparseCsrCPU:
+      return Backend::SparseCsrCPU;
     case Backend::QuantizedCPU:
       return Backend::QuantizedCPU;
     case Backend::QuantizedCUDA:
@@ -289,6 +297,8 @@ static inline const char* toString(Backend b) {
       return "SparseHIP";
     case Backend::MkldnnCPU:
       return "MkldnnCPU";
+    case Backend::SparseCsrCPU:
+      return "SparseCsrCPU";
     case Backend::Vulkan:
       return "Vulkan";
     case Backend::QuantizedCPU:
@@ -36,6 +36,8 @@ const char* toString(DispatchKey t) {
       return "Vulkan";
     case DispatchKey::MkldnnCPU:
       return "MkldnnCPU";
+    case DispatchKey::SparseCsrCPU:
+      return "SparseCsrCPU";
     case DispatchKey::QuantizedCPU:
       return "QuantizedCPU";
     case DispatchKey::Autograd:
@@ -54,6 +56,8 @@ const char* toString(DispatchKey t) {
       return "Profiler";
     case DispatchKey::Named:
       return "Named";
+    case DispatchKey::InplaceOrView:
+      return "InplaceOrView";
     case DispatchKey::Tracer:
       return "Tracer";
     case DispatchKey::Meta:
@@ -132,15 +132,18 @@ enum class DispatchKey : uint8_t {
   // 20
   SparseHIP, // TODO: I think this is not actually used, due to Note
              // [Masquerading as CUDA]
+  // 21
+  SparseCsrCPU, // compressed sparse row, registered at
+                // build/aten/src/ATen/SparseCsrCPUType.cpp
 
   // Here are reserved backends for user-defined backends, see Note [Private use
   // DispatchKey]
   // To see some example about how to use this, check out MSNPU
-  // 21
-  PrivateUse1,
   // 22
-  PrivateUse2,
+  PrivateUse1,
   // 23
+  PrivateUse2,
+  // 24
   PrivateUse3,
 
   // The meta function characterizes how an operation affects the metadata of a
@@ -193,7 +196,7 @@ enum class DispatchKey : uint8_t {
   //    }
   //  }
   //
-  // 24
+  // 25
   Meta,
 
   // In some situations, it is not immediately obvious what the correct
@@ -201,7 +204,7 @@ enum class DispatchKey : uint8_t {
   // have any "tensor" arguments.  In this case, a BackendSelect function
   // can be registered to implement the custom determination of the
   // correct backend.
-  // 25
+  // 26
   BackendSelect,
 
   // The named dispatch key is set for any tensors with named dimensions.
@@ -216,9 +219,16 @@ enum class DispatchKey : uint8_t {
   // key that triggers before composite operators, in case a composite operator
   // has named dimension propagation that doesn't match that of its
   // constituent parts.
-  // 26
+  // 27
   Named,
 
+  // Tracks version counters and views of normal tensors in InferenceMode,
+  // where the Autograd kernels, which normally do this, are skipped.  Only
+  // in-place, out= and view ops have kernels for it; InferenceMode adds it
+  // to the thread local included set.  See c10/core/InferenceMode.h
+  // 28
+  InplaceOrView,
+
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~ AUTOGRAD ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
   // All backends are oblivious to autograd; autograd is handled as a
   // layer which happens on top of all backends.  It inspects the autograd
@@ -226,13 +236,13 @@ enum class DispatchKey : uint8_t {
   // constructed by the output, and otherwise defers to the backend to
   // actually do the numeric computation.  Autograd contains
   // the bulk of this logic.
-  // 27
+  // 29
   Autograd,
 
-  // 28
+  // 30
   Profiler,
 
-  // 29
+  // 31
   Tracer,
 
   // Pre-autograd dispatch keys allow backends to override the autograd behavior
@@ -246,21 +256,21 @@ enum class DispatchKey : uint8_t {
   // operator, which you're trying to skip).  In PreAutograd implementations,
   // you are responsible for handling autograd yourself, or deferring to other
   // operators which support autograd.
-  // 30
+  // 32
   XLAPreAutograd,
 
   // Autocasting precedes VariableTypeId, to ensure casts are autograd-exposed
   // and inputs are saved for backward in the post-autocast type.
-  // 31
+  // 33
   Autocast,
 
   // Here are some reserved pre-autograd keys for user-defined backends, see
   // Note [Private use DispatchKey]
-  // 32
+  // 34
   PrivateUse1_PreAutograd,
-  // 33
+  // 35
   PrivateUse2_PreAutograd,
-  // 34
+  // 36
   PrivateUse3_PreAutograd,
 
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~ WRAPPERS ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
@@ -270,7 +280,7 @@ enum class DispatchKey : uint8_t {
 
   // This is the dispatch key for BatchedTensorImpl, which is used to implement
   // batching rules for vmap.
-  // 35
+  // 37
   Batched,
 
   // TESTING: This is intended to be a generic testing tensor type id.
@@ -278,7 +288,7 @@ enum class DispatchKey : uint8_t {
   // process test.  Use it by creating a TensorImpl with this DispatchKey, and
   // then registering operators to operate on this type id.  See
   // aten/src/ATen/core/dispatch/backend_fallback_test.cpp for a usage example.
-  // 36
+  // 38
   TESTING_ONLY_GenericWrapper,
 
   // TESTING: This is intended to be a generic testing tensor type id.
@@ -288,19 +298,19 @@ enum class DispatchKey : uint8_t {
   // to operate on this type id.  See
   // aten/src/ATen/core/dispatch/backend_fallback_test.cpp
   // for a usage example
-  // 37
+  // 39
   TESTING_ONLY_GenericMode,
 
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ FIN ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-  // 38
+  // 40
   NumDispatchKeys, // Sentinel
 
   // ~~~~~~~~~~~~~~~~~~~~~~~~~ BC ALIASES ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
   // The aliases exist for backwards compatibility reasons, they shouldn't
   // be used
-  // 39
+  // 41
   CPUTensorId = CPU,
-  // 40
+  // 42
   CUDATensorId = CUDA,
 };
 
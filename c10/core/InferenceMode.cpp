@@ -0,0 +1,47 @@
+#include <c10/core/InferenceMode.h>
+
+namespace c10 {
+
+/// In the CAFFE2_FB_LIMITED_MOBILE_CAPABILITY build setting,
+/// thread_local is not supported.
+#ifndef CAFFE2_FB_LIMITED_MOBILE_CAPABILITY
+thread_local bool InferenceMode_enabled = false;
+#else
+namespace {
+static bool InferenceMode_enabled = false;
+} // anonymous namespace
+#endif
+
+InferenceMode::InferenceMode(bool enabled)
+  : prev_mode_(InferenceMode_enabled)
+  , prev_autograd_excluded_(impl::tls_is_dispatch_key_excluded(DispatchKey::Autograd))
+  , prev_inplace_or_view_included_(impl::tls_is_dispatch_key_included(DispatchKey::InplaceOrView)) {
+  InferenceMode_enabled = enabled;
+  // Turning inference mode off only re-includes Autograd if it was us that
+  // excluded it; an AutoNonVariableTypeMode around an InferenceMode(false)
+  // would otherwise be undone.
+  if (enabled) {
+    impl::tls_set_dispatch_key_excluded(DispatchKey::Autograd, true);
+  } else if (prev_mode_) {
+    impl::tls_set_dispatch_key_excluded(DispatchKey::Autograd, false);
+  }
+  // The Autograd kernels bump versions and set up views themselves, so the
+  // InplaceOrView kernels only run when those are skipped.
+  impl::tls_set_dispatch_key_included(DispatchKey::InplaceOrView, enabled);
+}
+
+InferenceMode::~InferenceMode() {
+  InferenceMode_enabled = prev_mode_;
+  impl::tls_set_dispatch_key_excluded(DispatchKey::Autograd, prev_autograd_excluded_);
+  impl::tls_set_dispatch_key_included(DispatchKey::InplaceOrView, prev_inplace_or_view_included_);
+}
+
+bool InferenceMode::is_enabled() {
+  return InferenceMode_enabled;
+}
+
+void InferenceMode::_set_enabled(bool enabled) {
+  InferenceMode_enabled = enabled;
+}
+
+} // namespace c10
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <c10/core/impl/LocalDispatchKeySet.h>
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+
+// A RAII, thread local (!) guard that turns on inference mode.
+//
+// Inference mode is meant for code that will never call backward, such as
+// serving a model from C++.  It goes further than NoGradGuard: instead of
+// running the Autograd kernels and having them decide not to record a graph,
+// it excludes the Autograd dispatch key, so ops go straight to the backend
+// kernels.  Tensors created in inference mode ("inference tensors") also do
+// not allocate a version counter, and never get an AutogradMeta.
+//
+// Because of this, inference tensors can't be used with autograd later on:
+//
+//  - they can't be made to require grad, or be saved for backward;
+//  - they can't be modified in-place outside inference mode, since that
+//    would need a version counter bump.
+//
+// Both raise an error; clone() an inference tensor outside inference mode to
+// get a normal tensor.  Functional ops on inference tensors outside inference
+// mode are fine.
+//
+// Normal tensors keep tracking their version inside inference mode: in-place
+// ops on them still bump their version counter, and views of them share it
+// (and so are normal tensors too).  This is done by the InplaceOrView
+// dispatch key, which inference mode turns on in place of Autograd, and which
+// only has kernels for in-place, out= and view ops.
+//
+// InferenceMode(false) turns inference mode back off inside an enclosing
+// InferenceMode, e.g. to run a piece of code that needs autograd.
+struct C10_API InferenceMode {
+  InferenceMode(bool enabled = true);
+  InferenceMode(const InferenceMode&) = delete;
+  InferenceMode& operator=(const InferenceMode&) = delete;
+  ~InferenceMode();
+
+  static bool is_enabled();
+
+  // Internal, use InferenceMode or ThreadLocalStateGuard
+  static void _set_enabled(bool enabled);
+
+ private:
+  bool prev_mode_;
+  bool prev_autograd_excluded_;
+  bool prev_inplace_or_view_included_;
+};
+
+} // namespace c10
@@ -1,6 +1,7 @@
 #include <c10/core/TensorImpl.h>
 
 #include <c10/core/Backend.h>
+#include <c10/core/InferenceMode.h>
 #include <c10/core/WrapDimMinimal.h>
 #include <c10/core/impl/LocalDispatchKeySet.h>
 #include <c10/util/Optional.h>
@@ -56,6 +57,10 @@ TensorImpl::TensorImpl(DispatchKeySet key_set, const caffe2::TypeMeta& data_type
 TensorImpl::TensorImpl(Storage&& storage, DispatchKeySet key_set, const caffe2::TypeMeta& data_type,
                        c10::optional<c10::Device> device_opt)
     : storage_(std::move(storage)),
+      // Inference tensors don't track their version; see InferenceMode.h
+      version_counter_(
+          InferenceMode::is_enabled() ? VariableVersion(VariableVersion::DISABLED)
+                                      : VariableVersion(0)),
       sizes_{0},
       storage_offset_(0),
       numel_(0),
@@ -250,6 +255,9 @@ AutogradMetaInterface::~AutogradMetaInterface() {}
 
 void TensorImpl::set_requires_grad(bool requires_grad) {
   if (!requires_grad && !autograd_meta_) return;
+  TORCH_CHECK(!is_inference(),
+      "Setting requires_grad=True on an inference tensor is not allowed. "
+      "You can make a clone to get a normal tensor that can require grad.");
   if (!autograd_meta_) autograd_meta_ = impl::GetAutogradMetaFactory()->make();
   // NB: In principle, setting requires_grad to false could result in
   // the AutogradMeta becoming equal to a default constructed state,
@@ -271,6 +279,9 @@ bool TensorImpl::requires_grad() const {
 void TensorImpl::set_autograd_meta(std::unique_ptr<c10::AutogradMetaInterface> autograd_meta) {
   // NB: autograd_meta may be null!  That just means it's the default
   // constructor
+  TORCH_CHECK(!autograd_meta || !is_inference(),
+      "Inference tensors cannot be used in autograd. "
+      "You can make a clone to get a normal tensor that can be used in autograd.");
   autograd_meta_ = std::move(autograd_meta);
 }
 
@@ -227,17 +227,32 @@ struct C10_API VariableVersion {
   bool unique() const {
     return 1 == version_counter_.use_count();
   }
+  // Tensors created in InferenceMode don't track their version, and get a
+  // disabled VariableVersion that doesn't allocate a counter.
+  enum Disabled { DISABLED };
+
   // NOTE: As of C++11 and 14, default-constructing a std::atomic variable
   // leaves it in a persistently undefined state. See
   // https://cplusplus.github.io/LWG/issue2334.
   VariableVersion(uint32_t version = 0)
       : version_counter_(c10::make_intrusive<VersionCounter>(version)) {}
+  VariableVersion(Disabled) {}
+
+  bool enabled() const {
+    return version_counter_.defined();
+  }
 
-  void bump() noexcept {
+  void bump() {
+    TORCH_CHECK(enabled(),
+        "Inplace update to an inference tensor outside InferenceMode is not allowed. "
+        "You can make a clone to get a normal tensor before doing inplace update.");
     ++version_counter_->version_;
   }
 
-  uint32_t current_version() const noexcept {
+  uint32_t current_version() const {
+    TORCH_CHECK(enabled(),
+        "Inference tensors do not track version counter. "
+        "You can make a clone to get a normal tensor that can be used in autograd.");
     return version_counter_->version_;
   }
 };
@@ -437,6 +452,11 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
            key_set_.has(DispatchKey::SparseHIP);
   }
 
+  bool is_sparse_csr() const {
+    // NB: This method is not virtual and avoid dispatches for performance reasons.
+    return key_set_.has(DispatchKey::SparseCsrCPU);
+  }
+
   bool is_quantized() const {
     // NB: This method is not virtual and avoid dispatches for performance reasons.
     return key_set_.has(DispatchKey::QuantizedCPU) ||
@@ -491,6 +511,8 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
       return kSparse;
     } else if (is_mkldnn()) {
       return kMkldnn;
+    } else if (is_sparse_csr()) {
+      return kSparseCsr;
     } else {
       return kStrided;
     }
@@ -961,10 +983,18 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     return version_counter_;
   }
 
-  void bump_version() noexcept {
+  void bump_version() {
     version_counter_.bump();
   }
 
+  /**
+   * Whether this tensor was created in InferenceMode.  Inference tensors have
+   * no version counter and can't be used in autograd; see InferenceMode.h.
+   */
+  bool is_inference() const {
+    return !version_counter_.enabled();
+  }
+
   inline void set_pyobj(PyObject* pyobj) noexcept {
     pyobj_ = pyobj;
   }
@@ -447,6 +447,13 @@ struct C10_API TensorOptions {
           default:
             AT_ERROR("Unsupported device type for mkldnn layout: ", device().type());
         }
+      case Layout::SparseCsr:
+        switch (device().type()) {
+          case DeviceType::CPU:
+            return DispatchKey::SparseCsrCPU;
+          default:
+            AT_ERROR("Unsupported device type for sparse CSR layout: ", device().type());
+        }
       default:
         AT_ERROR("Unsupported layout: ", layout());
     }
@@ -674,6 +681,8 @@ inline DeviceType computeDeviceType(DispatchKey tid) {
     return DeviceType::HIP;
   } else if (tid == DispatchKey::MkldnnCPU) {
     return DeviceType::CPU;
+  } else if (tid == DispatchKey::SparseCsrCPU) {
+    return DeviceType::CPU;
   } else if (tid == DispatchKey::Vulkan) {
     return DeviceType::Vulkan;
   } else {
@@ -7,8 +7,6 @@ namespace impl {
 
 C10_DEFINE_bool(disable_variable_dispatch, false, "This flag forcibly disables the Variable code paths from executing, which currently breaks profiling in the process.");
 
-namespace {
-
 /// In the CAFFE2_FB_LIMITED_MOBILE_CAPABILITY build setting,
 /// thread_local is not supported.
 #ifndef CAFFE2_FB_LIMITED_MOBILE_CAPABILITY
@@ -18,13 +16,17 @@ thread_local PODLocalDispatchKeySet raw_local_dispatch_key_set;
 
 #else // defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
 
+namespace {
 static PODLocalDispatchKeySet raw_local_dispatch_key_set;
+} // anonymous namespace
 
 #endif
 
-} // anonymous namespace
-
+#if defined(_MSC_VER) || defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
 LocalDispatchKeySet tls_local_dispatch_key_set() {
+#else
+LocalDispatchKeySet tls_local_dispatch_key_set_slow() {
+#endif
   // Hack until variable performance is fixed
   //
   // ezyang: I'm pretty unhappy about this implementation, it looks wrong
@@ -54,8 +54,30 @@ struct C10_API LocalDispatchKeySet {
   DispatchKeySet excluded_;
 };
 
+// The thread-local state is read on every dispatch, so where the compiler
+// supports exporting a thread_local from the shared library we read it inline
+// rather than through a function call.
+#if defined(_MSC_VER) || defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
+
 C10_API LocalDispatchKeySet tls_local_dispatch_key_set();
 
+#else // !defined(_MSC_VER) && !defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
+
+// NB: POD, zero initialized!  Don't access it directly, use the functions
+// below.
+C10_API extern thread_local PODLocalDispatchKeySet raw_local_dispatch_key_set;
+
+C10_API LocalDispatchKeySet tls_local_dispatch_key_set_slow();
+
+inline LocalDispatchKeySet tls_local_dispatch_key_set() {
+  if (C10_UNLIKELY(FLAGS_disable_variable_dispatch)) {
+    return tls_local_dispatch_key_set_slow();
+  }
+  return raw_local_dispatch_key_set;
+}
+
+#endif
+
 // Internal, use ThreadLocalStateGuard
 C10_API void _force_tls_local_dispatch_key_set(LocalDispatchKeySet key_set);
 
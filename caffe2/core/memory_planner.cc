@@ -0,0 +1,111 @@
+#include "caffe2/core/memory_planner.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "caffe2/core/logging.h"
+
+namespace caffe2 {
+
+namespace {
+
+size_t AlignUp(size_t nbytes, size_t alignment) {
+  return (nbytes + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+std::vector<BlobLifetime> ComputeBlobLifetimes(const NetDef& net) {
+  for (const auto& op : net.op()) {
+    for (const auto& arg : op.arg()) {
+      if (arg.has_n() || arg.nets_size() > 0) {
+        // Operators running nested nets read and write blobs that are not
+        // listed as their inputs and outputs.
+        LOG(INFO) << "Cannot compute blob lifetimes of net " << net.name()
+                  << ": operator " << op.type() << " has a nested net";
+        return {};
+      }
+    }
+  }
+
+  std::unordered_set<std::string> excluded(
+      net.external_input().begin(), net.external_input().end());
+  excluded.insert(net.external_output().begin(), net.external_output().end());
+
+  std::vector<BlobLifetime> lifetimes;
+  std::unordered_map<std::string, size_t> index;
+  for (int idx = 0; idx < net.op_size(); ++idx) {
+    const auto& op = net.op(idx);
+    for (const auto& name : op.input()) {
+      auto it = index.find(name);
+      if (it != index.end()) {
+        lifetimes[it->second].last_op = idx;
+      } else {
+        // Read before it is written in this run, the value comes from outside
+        // of the net.
+        excluded.insert(name);
+      }
+    }
+    for (const auto& name : op.output()) {
+      if (excluded.count(name)) {
+        continue;
+      }
+      auto it = index.find(name);
+      if (it != index.end()) {
+        lifetimes[it->second].last_op = idx;
+      } else {
+        index[name] = lifetimes.size();
+        lifetimes.push_back(BlobLifetime{name, idx, idx});
+      }
+    }
+  }
+  return lifetimes;
+}
+
+MemoryPlan PlanStaticMemory(
+    const std::vector<BlobLifetime>& lifetimes,
+    const std::vector<size_t>& nbytes,
+    size_t alignment) {
+  CAFFE_ENFORCE_EQ(lifetimes.size(), nbytes.size());
+  CAFFE_ENFORCE_GT(alignment, 0);
+
+  std::vector<size_t> order(lifetimes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return nbytes[a] > nbytes[b];
+  });
+
+  MemoryPlan plan;
+  plan.offsets.resize(lifetimes.size());
+  // Blobs placed so far, as (offset, end offset) pairs.
+  std::vector<std::pair<size_t, size_t>> conflicts;
+  std::vector<size_t> placed;
+  for (size_t idx : order) {
+    const size_t size = AlignUp(nbytes[idx], alignment);
+    conflicts.clear();
+    for (size_t other : placed) {
+      if (lifetimes[idx].OverlapsWith(lifetimes[other])) {
+        conflicts.emplace_back(
+            plan.offsets[other],
+            plan.offsets[other] + AlignUp(nbytes[other], alignment));
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+    // Take the first gap between the live blobs that is large enough.
+    size_t offset = 0;
+    for (const auto& range : conflicts) {
+      if (range.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    plan.offsets[idx] = offset;
+    plan.total_bytes = std::max(plan.total_bytes, offset + size);
+    placed.push_back(idx);
+  }
+  return plan;
+}
+
+} // namespace caffe2
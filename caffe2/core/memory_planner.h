@@ -0,0 +1,51 @@
+#ifndef CAFFE2_CORE_MEMORY_PLANNER_H_
+#define CAFFE2_CORE_MEMORY_PLANNER_H_
+
+#include <string>
+#include <vector>
+
+#include "caffe2/core/common.h"
+#include "caffe2/proto/caffe2_pb.h"
+
+namespace caffe2 {
+
+// The range of operators, inclusive on both ends, during which a blob holds a
+// value that is still going to be read: from the first operator writing it to
+// the last operator reading or writing it.
+struct BlobLifetime {
+  std::string name;
+  int first_op;
+  int last_op;
+
+  bool OverlapsWith(const BlobLifetime& other) const {
+    return first_op <= other.last_op && other.first_op <= last_op;
+  }
+};
+
+// Computes the lifetimes of the temporary blobs of a net, i.e. the blobs that
+// are produced by an operator of the net before any operator reads them and
+// that are not external inputs or outputs. Blobs that are read before they
+// are written carry a value across runs and are not returned. The result is
+// ordered by first_op.
+CAFFE2_API std::vector<BlobLifetime> ComputeBlobLifetimes(const NetDef& net);
+
+struct MemoryPlan {
+  // Byte offset of each blob in the arena, in the order the blobs were passed
+  // to PlanStaticMemory.
+  std::vector<size_t> offsets;
+  // Size of the arena needed to hold all the blobs.
+  size_t total_bytes = 0;
+};
+
+// Assigns an arena offset to every blob such that two blobs with overlapping
+// lifetimes never share bytes. Blobs are placed greedily, the largest first,
+// at the lowest aligned offset that does not conflict with a blob placed
+// before and live at the same time.
+CAFFE2_API MemoryPlan PlanStaticMemory(
+    const std::vector<BlobLifetime>& lifetimes,
+    const std::vector<size_t>& nbytes,
+    size_t alignment);
+
+} // namespace caffe2
+
+#endif // CAFFE2_CORE_MEMORY_PLANNER_H_
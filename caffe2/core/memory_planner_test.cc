@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "caffe2/core/memory_planner.h"
+#include "caffe2/core/operator.h"
+
+namespace caffe2 {
+
+namespace {
+
+NetDef ChainNetDef() {
+  NetDef net_def;
+  net_def.add_external_input("in");
+  net_def.add_external_output("out");
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"in"}, {"a"}));
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"a"}, {"b"}));
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"b"}, {"c"}));
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"c"}, {"d"}));
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"d", "a"}, {"out"}));
+  return net_def;
+}
+
+} // namespace
+
+TEST(MemoryPlannerTest, BlobLifetimes) {
+  auto lifetimes = ComputeBlobLifetimes(ChainNetDef());
+  ASSERT_EQ(lifetimes.size(), 4);
+  EXPECT_EQ(lifetimes[0].name, "a");
+  EXPECT_EQ(lifetimes[0].first_op, 0);
+  EXPECT_EQ(lifetimes[0].last_op, 4);
+  EXPECT_EQ(lifetimes[1].name, "b");
+  EXPECT_EQ(lifetimes[1].first_op, 1);
+  EXPECT_EQ(lifetimes[1].last_op, 2);
+  EXPECT_EQ(lifetimes[2].name, "c");
+  EXPECT_EQ(lifetimes[2].first_op, 2);
+  EXPECT_EQ(lifetimes[2].last_op, 3);
+  EXPECT_EQ(lifetimes[3].name, "d");
+  EXPECT_EQ(lifetimes[3].first_op, 3);
+  EXPECT_EQ(lifetimes[3].last_op, 4);
+}
+
+TEST(MemoryPlannerTest, BlobLifetimesSkipStateAndNestedNets) {
+  NetDef net_def;
+  // "iter" is read before it is written, its value is kept across runs.
+  net_def.add_op()->CopyFrom(
+      CreateOperatorDef("Op", "", {"iter"}, {"iter", "tmp"}));
+  net_def.add_op()->CopyFrom(CreateOperatorDef("Op", "", {"tmp"}, {"out"}));
+  auto lifetimes = ComputeBlobLifetimes(net_def);
+  ASSERT_EQ(lifetimes.size(), 2);
+  EXPECT_EQ(lifetimes[0].name, "tmp");
+  EXPECT_EQ(lifetimes[1].name, "out");
+
+  auto* arg = net_def.mutable_op(1)->add_arg();
+  arg->set_name("then_net");
+  arg->mutable_n()->set_name("nested");
+  EXPECT_TRUE(ComputeBlobLifetimes(net_def).empty());
+}
+
+TEST(MemoryPlannerTest, PlanReusesMemoryOfDeadBlobs) {
+  auto lifetimes = ComputeBlobLifetimes(ChainNetDef());
+  auto plan = PlanStaticMemory(lifetimes, {100, 200, 100, 200}, 64);
+  ASSERT_EQ(plan.offsets.size(), 4);
+  // d reuses the memory of b, which is dead once c is computed. a and c are
+  // live at the same time as both.
+  EXPECT_EQ(plan.offsets[1], 0);
+  EXPECT_EQ(plan.offsets[3], 0);
+  EXPECT_EQ(plan.offsets[0], 256);
+  EXPECT_EQ(plan.offsets[2], 384);
+  EXPECT_EQ(plan.total_bytes, 512);
+}
+
+TEST(MemoryPlannerTest, PlanKeepsLiveBlobsApart) {
+  std::vector<BlobLifetime> lifetimes;
+  std::vector<size_t> nbytes;
+  for (int i = 0; i < 16; ++i) {
+    lifetimes.push_back(BlobLifetime{c10::to_string(i), i % 5, i % 5 + i % 3});
+    nbytes.push_back(1 + 37 * i % 101);
+  }
+  auto plan = PlanStaticMemory(lifetimes, nbytes, 16);
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    EXPECT_EQ(plan.offsets[i] % 16, 0);
+    EXPECT_LE(plan.offsets[i] + nbytes[i], plan.total_bytes);
+    for (size_t j = 0; j < i; ++j) {
+      if (lifetimes[i].OverlapsWith(lifetimes[j])) {
+        EXPECT_TRUE(
+            plan.offsets[i] + nbytes[i] <= plan.offsets[j] ||
+            plan.offsets[j] + nbytes[j] <= plan.offsets[i]);
+      }
+    }
+  }
+}
+
+} // namespace caffe2
@@ -56,6 +56,12 @@ C10_DEFINE_bool(
     false,
     "Run root tasks in current thread instread of scheduling to threadpool");
 
+C10_DEFINE_bool(
+    caffe2_net_async_critical_path_scheduling,
+    false,
+    "Run ready tasks with the longest expected time to the end of the net "
+    "first, using operator times from the net's profiling stats");
+
 namespace caffe2 {
 
 std::vector<int>& AsyncNetBase::getStreamCounters() {
@@ -588,6 +594,8 @@ ExecutionOptions::ExecutionOptions(
   }
 
   use_dfs_scheduling_ = false;
+  use_critical_path_scheduling_ =
+      FLAGS_caffe2_net_async_critical_path_scheduling;
 
   for (int arg_idx = 0; arg_idx < net_def->arg_size(); ++arg_idx) {
     auto& arg = net_def->arg(arg_idx);
@@ -599,6 +607,10 @@ ExecutionOptions::ExecutionOptions(
       CAFFE_ENFORCE(arg.has_i(), "deferrable_mode should be an int");
       use_dfs_scheduling_ = arg.i() == 1; // corr. to DFS scheduling
     }
+    if (arg.has_name() && arg.name() == "critical_path_scheduling") {
+      CAFFE_ENFORCE(arg.has_i(), "critical_path_scheduling should be an int");
+      use_critical_path_scheduling_ = arg.i() == 1;
+    }
   }
 
   if (FLAGS_caffe2_net_async_profile_operators) {
@@ -2,12 +2,26 @@
 
 #include "caffe2/core/net_async_tracing.h"
 
+#include <algorithm>
+
 namespace caffe2 {
 
+namespace {
+// Running the most critical ready child inline nests one schedule() call per
+// task of the chain. Past this depth the child goes to the ready queue
+// instead, so that long chains don't overflow the stack.
+constexpr int kMaxInlineScheduleDepth = 64;
+thread_local int inline_schedule_depth = 0;
+} // namespace
+
 AsyncSchedulingNet::AsyncSchedulingNet(
     const std::shared_ptr<const NetDef>& net_def,
     Workspace* ws)
-    : AsyncNetBase(net_def, ws), running_(false) {}
+    : AsyncNetBase(net_def, ws), running_(false) {
+  if (options_.use_critical_path_scheduling_) {
+    updateTaskPriorities();
+  }
+}
 
 void AsyncSchedulingNet::reset() {
   AsyncNetBase::reset();
@@ -72,6 +86,17 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
         }
       }
 
+      std::vector<int> ready_children;
+      auto schedule_child = [this, task_id, &ready_children](int child_id) {
+        if (options_.use_critical_path_scheduling_) {
+          ready_children.push_back(child_id);
+        } else {
+          // if DFS scheduling is enabled, run children inline,
+          // ignore DFS scheduling in callbacks
+          schedule(child_id, isInlineTask(task_id, child_id));
+        }
+      };
+
       for (auto child_id : children(task_id)) {
         int parent_count = updateParentCount(child_id);
         if (parent_count == 0) {
@@ -83,9 +108,7 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
           // - in all other cases, check parents with canSchedule
           if (!success_ || options_.always_schedule_child_ ||
               options_.finish_chain_ || canSchedule(child_id)) {
-            // if DFS scheduling is enabled, run children inline,
-            // ignore DFS scheduling in callbacks
-            schedule(child_id, isInlineTask(task_id, child_id));
+            schedule_child(child_id);
           } else {
             bool parent_failed = false;
             bool parent_needs_polling = false;
@@ -123,7 +146,7 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
             if (parent_failed) {
               // one of parents failed, set failure flag and wrap up execution
               success_ = false;
-              schedule(child_id, isInlineTask(task_id, child_id));
+              schedule_child(child_id);
             } else if (parent_needs_polling) {
               // some parents are blocking us from scheduling a child and don't
               // support callbacks, using polling
@@ -141,12 +164,16 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
               }
             } else {
               // we're ready to schedule a child
-              schedule(child_id, isInlineTask(task_id, child_id));
+              schedule_child(child_id);
             }
           }
         }
       }
 
+      if (!ready_children.empty()) {
+        scheduleReadyChildren(task_id, ready_children);
+      }
+
       // In case of net's failure, make sure all pending tasks are finished
       if (!success_) {
         CancelAndFinishAsyncTasks();
@@ -174,10 +201,132 @@ void AsyncSchedulingNet::schedule(int task_id, bool run_inline) noexcept {
     schedule_func();
   } else {
     const auto& device_option = event(task_id).GetDeviceOption();
-    pool(device_option)->run(schedule_func);
+    auto* task_pool = pool(device_option);
+    if (options_.use_critical_path_scheduling_) {
+      enqueueReadyTask(task_pool, task_id, std::move(schedule_func));
+    } else {
+      task_pool->run(schedule_func);
+    }
   }
 }
 
+void AsyncSchedulingNet::scheduleReadyChildren(
+    int parent_id,
+    std::vector<int>& child_ids) {
+  std::sort(child_ids.begin(), child_ids.end(), [this](int a, int b) {
+    return task_priorities_[a] > task_priorities_[b] ||
+        (task_priorities_[a] == task_priorities_[b] && a < b);
+  });
+  // keep running the most critical child in this thread, the other children
+  // go to the ready queue where idle threads can take them
+  int inline_child_id = -1;
+  if (inline_schedule_depth < kMaxInlineScheduleDepth &&
+      IsSameDevice(
+          lastTaskOp(parent_id)->device_option(),
+          firstTaskOp(child_ids.front())->device_option())) {
+    inline_child_id = child_ids.front();
+  }
+  for (auto child_id : child_ids) {
+    if (child_id != inline_child_id) {
+      schedule(child_id);
+    }
+  }
+  if (inline_child_id >= 0) {
+    // schedule() doesn't throw
+    ++inline_schedule_depth;
+    schedule(inline_child_id, /* run_inline */ true);
+    --inline_schedule_depth;
+  }
+}
+
+void AsyncSchedulingNet::enqueueReadyTask(
+    TaskThreadPoolBase* pool,
+    int task_id,
+    std::function<void()> func) {
+  {
+    std::lock_guard<std::mutex> lock(ready_tasks_mutex_);
+    auto& ready_tasks = ready_tasks_[pool];
+    ready_tasks.push_back(
+        ReadyTask{task_priorities_[task_id], task_id, std::move(func)});
+    std::push_heap(ready_tasks.begin(), ready_tasks.end());
+  }
+  // one job per ready task; the job runs whichever task of the pool has the
+  // highest priority by the time a thread gets to it
+  pool->run(std::bind(&AsyncSchedulingNet::runReadyTask, this, pool));
+}
+
+void AsyncSchedulingNet::runReadyTask(TaskThreadPoolBase* pool) {
+  std::function<void()> func;
+  {
+    std::lock_guard<std::mutex> lock(ready_tasks_mutex_);
+    auto& ready_tasks = ready_tasks_[pool];
+    if (ready_tasks.empty()) {
+      LOG(ERROR) << "No ready task for a scheduled job";
+      return;
+    }
+    std::pop_heap(ready_tasks.begin(), ready_tasks.end());
+    func = std::move(ready_tasks.back().func);
+    ready_tasks.pop_back();
+  }
+  func();
+}
+
+void AsyncSchedulingNet::updateTaskPriorities() {
+  // A task's priority is its cost plus the highest priority of its
+  // children, computed from the leaves of the task graph up
+  std::vector<int> children_left(tasksNum());
+  std::vector<int> ready;
+  for (auto task_id = 0; task_id < tasksNum(); ++task_id) {
+    children_left[task_id] = children(task_id).size();
+    if (children_left[task_id] == 0) {
+      ready.push_back(task_id);
+    }
+  }
+  task_priorities_.assign(tasksNum(), 0.0f);
+  while (!ready.empty()) {
+    auto task_id = ready.back();
+    ready.pop_back();
+    float cost = 0.0f;
+    for (auto op_id : chains_[task_id]) {
+      cost += op_costs_.empty() ? 1.0f : op_costs_[op_id];
+    }
+    float children_priority = 0.0f;
+    for (auto child_id : children(task_id)) {
+      children_priority =
+          std::max(children_priority, task_priorities_[child_id]);
+    }
+    task_priorities_[task_id] = cost + children_priority;
+    for (auto parent_id : parents(task_id)) {
+      if (--children_left[parent_id] == 0) {
+        ready.push_back(parent_id);
+      }
+    }
+  }
+}
+
+void AsyncSchedulingNet::updateOperatorCosts() {
+  if (!options_.report_stats_) {
+    return;
+  }
+  auto num_runs = counters_.GetNumProfiledRuns();
+  if (num_runs > op_costs_num_runs_) {
+    op_costs_ = counters_.GetPerOpMeanTimes();
+    op_costs_num_runs_ = num_runs;
+    updateTaskPriorities();
+  }
+}
+
+void AsyncSchedulingNet::SetOperatorCosts(const std::vector<float>& op_costs) {
+  std::unique_lock<std::mutex> lock(running_mutex_);
+  CAFFE_ENFORCE(!running_, "Can't set operator costs of a running net");
+  CAFFE_ENFORCE_EQ(
+      op_costs.size(),
+      operators_.size(),
+      "Expected one cost per operator of the net");
+  op_costs_ = op_costs;
+  updateTaskPriorities();
+}
+
 void AsyncSchedulingNet::parentCallback(int parent_id) {
   if (event(parent_id).Query() != EventStatus::EVENT_SUCCESS) {
     success_ = false;
@@ -233,6 +382,9 @@ bool AsyncSchedulingNet::RunAsync() {
     }
     running_ = true;
     reset();
+    if (options_.use_critical_path_scheduling_) {
+      updateOperatorCosts();
+    }
 
     StartAllObservers();
     tracing::startIter(tracer_);
@@ -16,6 +16,13 @@ class CAFFE2_API AsyncSchedulingNet : public AsyncNetBase {
 
   void Cancel() override;
 
+  // Sets the expected run time of each of the net's operators, in ms, for
+  // critical path scheduling (e.g. the means from GetPerOperatorCost() of a
+  // profiled net with the same ops). Without costs every operator counts as
+  // one unit of time; a net that collects profiling stats itself switches
+  // to the measured times once it has them.
+  void SetOperatorCosts(const std::vector<float>& op_costs);
+
  protected:
   bool RunAsync() override;
 
@@ -28,6 +35,39 @@ class CAFFE2_API AsyncSchedulingNet : public AsyncNetBase {
 
   void CancelAndFinishAsyncTasks();
 
+  // Critical path scheduling: every task gets a priority equal to the
+  // expected time from its start to the end of the net. Tasks that become
+  // ready are put in a per pool priority queue, and each job that we run on
+  // a pool picks the highest priority task of the queue. When a task readies
+  // several children, the thread that ran it continues with the highest
+  // priority one, and the others can be picked up by idle threads.
+  struct ReadyTask {
+    float priority;
+    int task_id;
+    std::function<void()> func;
+
+    bool operator<(const ReadyTask& other) const {
+      return priority < other.priority ||
+          (priority == other.priority && task_id > other.task_id);
+    }
+  };
+
+  void updateTaskPriorities();
+  void updateOperatorCosts();
+  void scheduleReadyChildren(int parent_id, std::vector<int>& child_ids);
+  void enqueueReadyTask(
+      TaskThreadPoolBase* pool,
+      int task_id,
+      std::function<void()> func);
+  void runReadyTask(TaskThreadPoolBase* pool);
+
+  std::vector<float> op_costs_;
+  size_t op_costs_num_runs_ = 0;
+  std::vector<float> task_priorities_;
+  std::mutex ready_tasks_mutex_;
+  // ready tasks of each pool, as a max-heap
+  std::unordered_map<TaskThreadPoolBase*, std::vector<ReadyTask>> ready_tasks_;
+
   std::mutex running_mutex_;
   std::condition_variable running_cv_;
   std::atomic<bool> running_;
@@ -0,0 +1,302 @@
+#include "caffe2/core/net_simple_static_memory.h"
+#include "caffe2/core/net.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "c10/core/CPUAllocator.h"
+#include "caffe2/core/operator.h"
+#include "caffe2/core/types.h"
+#include "caffe2/proto/caffe2_pb.h"
+#include "caffe2/utils/proto_utils.h"
+
+namespace caffe2 {
+
+SimpleStaticMemoryNet::SimpleStaticMemoryNet(
+    const std::shared_ptr<const NetDef>& net_def,
+    Workspace* ws)
+    : SimpleNet(net_def, ws), ws_(ws) {
+  VLOG(1) << "Constructing SimpleStaticMemoryNet " << net_def->name();
+  lifetimes_ = ComputeBlobLifetimes(*net_def);
+  const size_t num_blobs = lifetimes_.size();
+  nbytes_.assign(num_blobs, 0);
+  unplannable_.assign(num_blobs, false);
+  inferred_types_.resize(num_blobs);
+  inferred_dims_.resize(num_blobs);
+  offsets_.assign(num_blobs, -1);
+  slot_bytes_.assign(num_blobs, 0);
+  bound_.assign(num_blobs, false);
+  bind_list_.resize(net_def->op_size());
+
+  std::unordered_map<std::string, int> index;
+  for (size_t idx = 0; idx < num_blobs; ++idx) {
+    const auto& lifetime = lifetimes_[idx];
+    index[lifetime.name] = idx;
+    blobs_.push_back(ws->GetBlob(lifetime.name));
+    CAFFE_ENFORCE(blobs_.back(), "Blob ", lifetime.name, " does not exist");
+    bind_list_[lifetime.first_op].push_back(idx);
+  }
+  outputs_.resize(net_def->op_size());
+  for (int op_idx = 0; op_idx < net_def->op_size(); ++op_idx) {
+    std::unordered_set<std::string> seen;
+    for (const auto& name : net_def->op(op_idx).output()) {
+      if (!seen.insert(name).second) {
+        continue;
+      }
+      auto it = index.find(name);
+      outputs_[op_idx].emplace_back(
+          ws->GetBlob(name), it == index.end() ? -1 : it->second);
+    }
+  }
+}
+
+SimpleStaticMemoryNet::~SimpleStaticMemoryNet() {
+  // Do not leave tensors pointing to the arena once it is freed.
+  ReleaseArena();
+}
+
+size_t SimpleStaticMemoryNet::PlannedBytes() const {
+  size_t total = 0;
+  for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+    if (offsets_[idx] >= 0) {
+      total += slot_bytes_[idx];
+    }
+  }
+  return total;
+}
+
+bool SimpleStaticMemoryNet::IsPlanned(const std::string& blob_name) const {
+  for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+    if (lifetimes_[idx].name == blob_name) {
+      return offsets_[idx] >= 0;
+    }
+  }
+  return false;
+}
+
+void SimpleStaticMemoryNet::InferSizes() {
+  TensorShapes shapes;
+  try {
+    NetDef net_def(*net_def_);
+    shapes = InferBlobShapesAndTypesFromWorkspace(ws_, {&net_def});
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Shape inference failed for net " << name_ << ": "
+                 << e.what();
+    return;
+  }
+  std::unordered_map<std::string, const TensorShape*> shape_of;
+  for (const auto& shape : shapes.shapes()) {
+    shape_of[shape.name()] = &shape;
+  }
+  for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+    auto it = shape_of.find(lifetimes_[idx].name);
+    if (it == shape_of.end()) {
+      continue;
+    }
+    const TensorShape& shape = *it->second;
+    if (shape.unknown_shape() ||
+        shape.data_type() == TensorProto_DataType_UNDEFINED) {
+      continue;
+    }
+    const TypeMeta& type = DataTypeToTypeMeta(shape.data_type());
+    if (type.placementNew() != nullptr) {
+      continue;
+    }
+    std::vector<int64_t> dims(shape.dims().begin(), shape.dims().end());
+    int64_t numel = 1;
+    for (int64_t d : dims) {
+      numel *= std::max<int64_t>(d, 0);
+    }
+    inferred_types_[idx] = type;
+    inferred_dims_[idx] = std::move(dims);
+    nbytes_[idx] =
+        std::max(nbytes_[idx], static_cast<size_t>(numel) * type.itemsize());
+  }
+}
+
+void SimpleStaticMemoryNet::Replan() {
+  if (!sizes_inferred_) {
+    InferSizes();
+    sizes_inferred_ = true;
+  }
+  // Tensors are placed again at their new offsets before their operators run.
+  ReleaseArena();
+
+  std::vector<size_t> planned;
+  std::vector<BlobLifetime> lifetimes;
+  std::vector<size_t> nbytes;
+  for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+    offsets_[idx] = -1;
+    slot_bytes_[idx] = 0;
+    if (!unplannable_[idx] && nbytes_[idx] > 0) {
+      planned.push_back(idx);
+      lifetimes.push_back(lifetimes_[idx]);
+      nbytes.push_back(nbytes_[idx]);
+    }
+  }
+  auto plan = PlanStaticMemory(lifetimes, nbytes, c10::gAlignment);
+  for (size_t i = 0; i < planned.size(); ++i) {
+    offsets_[planned[i]] = plan.offsets[i];
+    slot_bytes_[planned[i]] = nbytes[i];
+  }
+  if (plan.total_bytes > arena_bytes_) {
+    arena_ = GetCPUAllocator()->allocate(plan.total_bytes);
+    arena_bytes_ = plan.total_bytes;
+  }
+  needs_replan_ = false;
+  VLOG(1) << "Net " << name_ << " places " << planned.size() << " tensors of "
+          << PlannedBytes() << " bytes in an arena of " << arena_bytes_
+          << " bytes";
+}
+
+void SimpleStaticMemoryNet::ReleaseArena() {
+  if (!arena_) {
+    return;
+  }
+  for (const auto& op_outputs : outputs_) {
+    for (const auto& output : op_outputs) {
+      Blob* blob = output.first;
+      if (BlobIsTensorType(*blob, CPU) &&
+          InArena(blob->Get<Tensor>().storage().data())) {
+        BlobGetMutableTensor(blob, CPU)->FreeMemory();
+      }
+    }
+  }
+}
+
+bool SimpleStaticMemoryNet::Bind(size_t idx) {
+  Blob* blob = blobs_[idx];
+  void* slot = Slot(idx);
+  Tensor* tensor = nullptr;
+  if (BlobIsTensorType(*blob, CPU)) {
+    tensor = BlobGetMutableTensor(blob, CPU);
+    if (tensor->storage().data() == slot) {
+      return true;
+    }
+  }
+  TypeMeta type = tensor ? tensor->dtype() : TypeMeta();
+  if (type.id() == TypeIdentifier::uninitialized()) {
+    if (inferred_types_[idx].id() == TypeIdentifier::uninitialized()) {
+      return false;
+    }
+    type = inferred_types_[idx];
+    tensor = BlobGetMutableTensor(blob, CPU);
+    tensor->Resize(inferred_dims_[idx]);
+  }
+  if (type.placementNew() != nullptr) {
+    return false;
+  }
+  tensor->ShareExternalPointer(slot, type, slot_bytes_[idx]);
+  return true;
+}
+
+bool SimpleStaticMemoryNet::CheckOutput(Blob* blob, int idx) {
+  if (!BlobIsTensorType(*blob, CPU)) {
+    if (idx >= 0 && !unplannable_[idx]) {
+      MarkUnplannable(idx);
+    }
+    return true;
+  }
+  const auto& tensor = blob->Get<Tensor>();
+  const void* data = tensor.storage().data();
+  const bool in_arena = InArena(data);
+  const bool planned = idx >= 0 && offsets_[idx] >= 0;
+  if (in_arena && !(planned && data == Slot(idx))) {
+    // The operator made its output share data with another tensor in the
+    // arena, whose slot may be reused while the output is still alive.
+    const int owner = SlotOwner(data);
+    if (owner >= 0) {
+      MarkUnplannable(owner);
+    }
+    if (idx >= 0) {
+      MarkUnplannable(idx);
+    }
+    return false;
+  }
+  if (idx < 0 || unplannable_[idx]) {
+    return true;
+  }
+  if (tensor.dtype().placementNew() != nullptr) {
+    MarkUnplannable(idx);
+    return true;
+  }
+  if (tensor.nbytes() > nbytes_[idx]) {
+    nbytes_[idx] = tensor.nbytes();
+    needs_replan_ = true;
+  }
+  if (planned && data != Slot(idx)) {
+    // Not placed in the arena in this run, reallocated by the operator, or
+    // sharing data with a tensor outside of the arena. Only the last case
+    // keeps the blob from being planned.
+    if (bound_[idx] && tensor.nbytes() <= slot_bytes_[idx]) {
+      MarkUnplannable(idx);
+    }
+    needs_replan_ = true;
+  }
+  return true;
+}
+
+int SimpleStaticMemoryNet::SlotOwner(const void* data) const {
+  const char* ptr = static_cast<const char*>(data);
+  for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+    if (offsets_[idx] < 0) {
+      continue;
+    }
+    const char* slot = static_cast<const char*>(Slot(idx));
+    if (ptr >= slot && ptr < slot + std::max<size_t>(slot_bytes_[idx], 1)) {
+      return idx;
+    }
+  }
+  return -1;
+}
+
+void SimpleStaticMemoryNet::MarkUnplannable(int idx) {
+  VLOG(1) << "Net " << name_ << " leaves blob " << lifetimes_[idx].name
+          << " to the default allocator";
+  unplannable_[idx] = true;
+  needs_replan_ = true;
+}
+
+bool SimpleStaticMemoryNet::Run() {
+  if (needs_replan_) {
+    Replan();
+  }
+  StartAllObservers();
+  VLOG(1) << "Running net " << name_;
+  bool use_arena = true;
+  for (auto op_id = 0U; op_id < operators_.size(); ++op_id) {
+    auto& op = operators_[op_id];
+    for (size_t idx : bind_list_[op_id]) {
+      bound_[idx] = use_arena && offsets_[idx] >= 0 && Bind(idx);
+    }
+    VLOG(1) << "Running operator " << op->debug_def().name() << "("
+            << op->debug_def().type() << ").";
+    bool res = op->Run();
+    if (!res) {
+      LOG(ERROR) << "Operator failed: " << ProtoDebugString(op->debug_def());
+      return false;
+    }
+    for (const auto& output : outputs_[op_id]) {
+      if (!CheckOutput(output.first, output.second) && use_arena) {
+        // Move the tensors produced later in this run out of the arena, the
+        // aliased slot may be reused by one of them.
+        use_arena = false;
+        for (size_t idx = 0; idx < lifetimes_.size(); ++idx) {
+          Blob* blob = blobs_[idx];
+          if (lifetimes_[idx].first_op > static_cast<int>(op_id) &&
+              BlobIsTensorType(*blob, CPU) &&
+              InArena(blob->Get<Tensor>().storage().data())) {
+            BlobGetMutableTensor(blob, CPU)->FreeMemory();
+          }
+        }
+      }
+    }
+  }
+  StopAllObservers();
+  return true;
+}
+
+REGISTER_NET(simple_static_memory, SimpleStaticMemoryNet);
+
+} // namespace caffe2
@@ -0,0 +1,112 @@
+#ifndef CAFFE2_CORE_NET_SIMPLE_STATIC_MEMORY_H_
+#define CAFFE2_CORE_NET_SIMPLE_STATIC_MEMORY_H_
+
+#include <vector>
+
+#include "c10/util/Registry.h"
+#include "caffe2/core/common.h"
+#include "caffe2/core/logging.h"
+#include "caffe2/core/memory_planner.h"
+#include "caffe2/core/net.h"
+#include "caffe2/core/net_simple.h"
+#include "caffe2/core/tensor.h"
+#include "caffe2/core/workspace.h"
+#include "caffe2/proto/caffe2_pb.h"
+
+namespace caffe2 {
+
+// SimpleStaticMemoryNet runs operators in sequence like SimpleNet, but places
+// the temporary CPU tensors of the net (see ComputeBlobLifetimes) in a single
+// arena owned by the net instance. Tensors whose lifetimes do not overlap share
+// arena bytes, and once the plan is stable a run does not allocate memory for
+// them at all.
+//
+// Tensor sizes are seeded with shape inference on the workspace before the
+// first run and refined with the sizes observed while running: an operator
+// that needs more memory than planned reallocates its output on the heap as
+// usual and the net is replanned before the next run. Blobs that do not hold
+// CPU tensors, tensors of types that need constructors, and tensors sharing
+// data with another blob (e.g. through Alias or in-place reshapes) are left to
+// the default allocator.
+//
+// As with SimpleRefCountNet, the contents of temporary blobs are not preserved
+// once the net has finished running, and operators keeping state in their
+// outputs across runs are not supported.
+class CAFFE2_API SimpleStaticMemoryNet final : public SimpleNet {
+ public:
+  SimpleStaticMemoryNet(
+      const std::shared_ptr<const NetDef>& net_def,
+      Workspace* ws);
+  ~SimpleStaticMemoryNet() override;
+
+  // Bytes held by the arena.
+  size_t ArenaBytes() const {
+    return arena_bytes_;
+  }
+  // Sum of the sizes of the tensors placed in the arena by the current plan.
+  size_t PlannedBytes() const;
+  // Whether the blob is placed in the arena by the current plan.
+  bool IsPlanned(const std::string& blob_name) const;
+
+ protected:
+  bool Run() override;
+
+  using SimpleNet::operators_;
+
+ private:
+  void InferSizes();
+  void Replan();
+  void ReleaseArena();
+  // Points the tensor of a temporary blob to its arena slot. Returns false if
+  // the type of the tensor is not known yet.
+  bool Bind(size_t idx);
+  // Checks an output of the operator that has just run. Returns false when it
+  // shares data with an arena slot other than its own.
+  bool CheckOutput(Blob* blob, int idx);
+  int SlotOwner(const void* data) const;
+  void MarkUnplannable(int idx);
+  bool InArena(const void* data) const {
+    const char* ptr = static_cast<const char*>(data);
+    const char* arena = static_cast<const char*>(arena_.get());
+    return arena && ptr >= arena && ptr < arena + arena_bytes_;
+  }
+  void* Slot(size_t idx) const {
+    return static_cast<char*>(arena_.get()) + offsets_[idx];
+  }
+
+  Workspace* ws_;
+
+  // Per temporary blob, in the order of ComputeBlobLifetimes.
+  std::vector<BlobLifetime> lifetimes_;
+  std::vector<Blob*> blobs_;
+  // Largest size seen so far, 0 if unknown.
+  std::vector<size_t> nbytes_;
+  std::vector<bool> unplannable_;
+  // Type and shape from shape inference, used to place a tensor in the arena
+  // before the operator producing it has ever run.
+  std::vector<TypeMeta> inferred_types_;
+  std::vector<std::vector<int64_t>> inferred_dims_;
+  // Arena offset and size of the blob in the current plan, -1 if the blob is
+  // not planned.
+  std::vector<int64_t> offsets_;
+  std::vector<size_t> slot_bytes_;
+  // Whether the blob was placed in its slot before its first operator ran in
+  // the current run.
+  std::vector<bool> bound_;
+
+  // Temporary blobs to place in the arena before each operator runs.
+  std::vector<std::vector<size_t>> bind_list_;
+  // Outputs of each operator, with their index in lifetimes_ or -1.
+  std::vector<std::vector<std::pair<Blob*, int>>> outputs_;
+
+  at::DataPtr arena_;
+  size_t arena_bytes_ = 0;
+  bool sizes_inferred_ = false;
+  bool needs_replan_ = true;
+
+  C10_DISABLE_COPY_AND_ASSIGN(SimpleStaticMemoryNet);
+};
+
+} // namespace caffe2
+
+#endif // CAFFE2_CORE_NET_SIMPLE_STATIC_MEMORY_H_
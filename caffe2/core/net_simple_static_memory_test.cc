@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include "caffe2/core/net.h"
+#include "caffe2/core/net_simple_static_memory.h"
+#include "caffe2/core/operator.h"
+
+namespace caffe2 {
+
+namespace {
+
+// Fills a float tensor of the given shape with a value.
+class StaticMemoryTestFillOp final : public Operator<CPUContext> {
+ public:
+  StaticMemoryTestFillOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<CPUContext>(operator_def, ws),
+        shape_(this->template GetRepeatedArgument<int64_t>("shape")),
+        value_(this->template GetSingleArgument<float>("value", 0)) {}
+  USE_OPERATOR_FUNCTIONS(CPUContext);
+
+  bool RunOnDevice() override {
+    auto* output = Output(0, shape_, at::dtype<float>());
+    std::fill_n(output->template mutable_data<float>(), output->numel(), value_);
+    return true;
+  }
+
+ private:
+  std::vector<int64_t> shape_;
+  float value_;
+};
+
+// Adds two float tensors of the same shape.
+class StaticMemoryTestAddOp final : public Operator<CPUContext> {
+ public:
+  StaticMemoryTestAddOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<CPUContext>(operator_def, ws) {}
+  USE_OPERATOR_FUNCTIONS(CPUContext);
+
+  bool RunOnDevice() override {
+    const auto& a = Input(0);
+    const auto& b = Input(1);
+    auto* output = Output(0, a.sizes(), at::dtype<float>());
+    const float* a_data = a.template data<float>();
+    const float* b_data = b.template data<float>();
+    float* output_data = output->template mutable_data<float>();
+    for (int64_t i = 0; i < a.numel(); ++i) {
+      output_data[i] = a_data[i] + b_data[i];
+    }
+    return true;
+  }
+};
+
+// Makes its output share the data of its input.
+class StaticMemoryTestAliasOp final : public Operator<CPUContext> {
+ public:
+  StaticMemoryTestAliasOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<CPUContext>(operator_def, ws) {}
+  USE_OPERATOR_FUNCTIONS(CPUContext);
+
+  bool RunOnDevice() override {
+    const auto& input = Input(0);
+    auto* output = OutputTensorAlias(0, input);
+    (void)output;
+    return true;
+  }
+};
+
+REGISTER_CPU_OPERATOR(StaticMemoryTestFill, StaticMemoryTestFillOp);
+REGISTER_CPU_OPERATOR(StaticMemoryTestAdd, StaticMemoryTestAddOp);
+REGISTER_CPU_OPERATOR(StaticMemoryTestAlias, StaticMemoryTestAliasOp);
+
+OPERATOR_SCHEMA(StaticMemoryTestFill)
+    .NumInputs(0)
+    .NumOutputs(1)
+    .TensorInferenceFunction([](const OperatorDef& def,
+                                const vector<TensorShape>& /* unused */) {
+      ArgumentHelper helper(def);
+      vector<TensorShape> out(1);
+      for (auto d : helper.GetRepeatedArgument<int64_t>("shape")) {
+        out[0].add_dims(d);
+      }
+      out[0].set_data_type(TensorProto_DataType_FLOAT);
+      return out;
+    });
+OPERATOR_SCHEMA(StaticMemoryTestAdd).NumInputs(2).NumOutputs(1);
+OPERATOR_SCHEMA(StaticMemoryTestAlias).NumInputs(1).NumOutputs(1);
+
+constexpr int kSize = 1000;
+
+OperatorDef FillOp(const std::string& output, float value) {
+  auto def = CreateOperatorDef("StaticMemoryTestFill", "", {}, {output});
+  AddArgument("shape", std::vector<int64_t>{kSize}, &def);
+  AddArgument("value", value, &def);
+  return def;
+}
+
+OperatorDef AddOp(
+    const std::string& a,
+    const std::string& b,
+    const std::string& output) {
+  return CreateOperatorDef("StaticMemoryTestAdd", "", {a, b}, {output});
+}
+
+void ExpectFilledWith(const Workspace& ws, const std::string& name, float value) {
+  const auto& tensor = ws.GetBlob(name)->Get<Tensor>();
+  ASSERT_EQ(tensor.numel(), kSize);
+  for (int i = 0; i < kSize; ++i) {
+    ASSERT_EQ(tensor.data<float>()[i], value);
+  }
+}
+
+const void* DataOf(const Workspace& ws, const std::string& name) {
+  return ws.GetBlob(name)->Get<Tensor>().raw_data();
+}
+
+} // namespace
+
+TEST(SimpleStaticMemoryNetTest, ReusesArenaAcrossRuns) {
+  Workspace ws;
+  NetDef net_def;
+  net_def.set_type("simple_static_memory");
+  net_def.add_external_output("out");
+  net_def.add_op()->CopyFrom(FillOp("a", 1));
+  net_def.add_op()->CopyFrom(AddOp("a", "a", "b"));
+  net_def.add_op()->CopyFrom(AddOp("b", "b", "c"));
+  net_def.add_op()->CopyFrom(AddOp("c", "c", "d"));
+  net_def.add_op()->CopyFrom(AddOp("d", "a", "out"));
+  std::unique_ptr<NetBase> net(CreateNet(net_def, &ws));
+  auto* static_net = dynamic_cast<SimpleStaticMemoryNet*>(net.get());
+  ASSERT_NE(static_net, nullptr);
+
+  ASSERT_TRUE(net->Run());
+  ExpectFilledWith(ws, "out", 9);
+  // The size of a comes from shape inference, the other sizes are only known
+  // after the first run.
+  EXPECT_TRUE(static_net->IsPlanned("a"));
+  EXPECT_FALSE(static_net->IsPlanned("b"));
+
+  ASSERT_TRUE(net->Run());
+  ExpectFilledWith(ws, "out", 9);
+  for (const char* name : {"a", "b", "c", "d"}) {
+    EXPECT_TRUE(static_net->IsPlanned(name)) << name;
+  }
+  EXPECT_FALSE(static_net->IsPlanned("out"));
+  const size_t tensor_bytes = kSize * sizeof(float);
+  EXPECT_EQ(static_net->PlannedBytes(), 4 * tensor_bytes);
+  // b and d share memory.
+  EXPECT_LT(static_net->ArenaBytes(), 4 * tensor_bytes);
+  EXPECT_EQ(DataOf(ws, "b"), DataOf(ws, "d"));
+
+  std::vector<const void*> data;
+  for (const char* name : {"a", "b", "c", "d", "out"}) {
+    data.push_back(DataOf(ws, name));
+  }
+  for (int run = 0; run < 3; ++run) {
+    ASSERT_TRUE(net->Run());
+    ExpectFilledWith(ws, "out", 9);
+    int i = 0;
+    for (const char* name : {"a", "b", "c", "d", "out"}) {
+      EXPECT_EQ(DataOf(ws, name), data[i++]) << name;
+    }
+  }
+}
+
+TEST(SimpleStaticMemoryNetTest, AliasedTensorsAreNotPlanned) {
+  Workspace ws;
+  NetDef net_def;
+  net_def.set_type("simple_static_memory");
+  net_def.add_external_output("out");
+  net_def.add_op()->CopyFrom(FillOp("a", 1));
+  net_def.add_op()->CopyFrom(AddOp("a", "a", "b"));
+  // e keeps the value of b alive after the last use of b.
+  net_def.add_op()->CopyFrom(
+      CreateOperatorDef("StaticMemoryTestAlias", "", {"b"}, {"e"}));
+  net_def.add_op()->CopyFrom(FillOp("c", 5));
+  net_def.add_op()->CopyFrom(AddOp("e", "c", "out"));
+  std::unique_ptr<NetBase> net(CreateNet(net_def, &ws));
+  auto* static_net = dynamic_cast<SimpleStaticMemoryNet*>(net.get());
+  ASSERT_NE(static_net, nullptr);
+
+  for (int run = 0; run < 4; ++run) {
+    ASSERT_TRUE(net->Run());
+    ExpectFilledWith(ws, "out", 7);
+  }
+  EXPECT_TRUE(static_net->IsPlanned("a"));
+  EXPECT_TRUE(static_net->IsPlanned("c"));
+  EXPECT_FALSE(static_net->IsPlanned("b"));
+  EXPECT_FALSE(static_net->IsPlanned("e"));
+}
+
+TEST(SimpleStaticMemoryNetTest, GrowingTensorsAreReplanned) {
+  Workspace ws;
+  auto* in = BlobGetMutableTensor(ws.CreateBlob("in"), CPU);
+  in->Resize(kSize);
+  std::fill_n(in->mutable_data<float>(), kSize, 1);
+  NetDef net_def;
+  net_def.set_type("simple_static_memory");
+  net_def.add_external_input("in");
+  net_def.add_external_output("out");
+  net_def.add_op()->CopyFrom(AddOp("in", "in", "a"));
+  net_def.add_op()->CopyFrom(AddOp("a", "in", "out"));
+  std::unique_ptr<NetBase> net(CreateNet(net_def, &ws));
+  auto* static_net = dynamic_cast<SimpleStaticMemoryNet*>(net.get());
+  ASSERT_NE(static_net, nullptr);
+
+  ASSERT_TRUE(net->Run());
+  ASSERT_TRUE(net->Run());
+  EXPECT_TRUE(static_net->IsPlanned("a"));
+  EXPECT_EQ(static_net->PlannedBytes(), kSize * sizeof(float));
+
+  in->Resize(2 * kSize);
+  std::fill_n(in->mutable_data<float>(), 2 * kSize, 1);
+  ASSERT_TRUE(net->Run());
+  EXPECT_EQ(ws.GetBlob("out")->Get<Tensor>().numel(), 2 * kSize);
+  ASSERT_TRUE(net->Run());
+  EXPECT_TRUE(static_net->IsPlanned("a"));
+  EXPECT_EQ(static_net->PlannedBytes(), 2 * kSize * sizeof(float));
+  const auto& out = ws.GetBlob("out")->Get<Tensor>();
+  for (int i = 0; i < 2 * kSize; ++i) {
+    ASSERT_EQ(out.data<float>()[i], 3);
+  }
+}
+
+} // namespace caffe2
@@ -1111,4 +1111,161 @@ TEST(NetTest, ProfDAGNetErrorTest) {
   testProfDAGNetErrorCase(/*test_error=*/true);
 }
 
+static std::mutex run_order_mutex;
+static std::vector<int> run_order;
+
+class RunOrderOp final : public Operator<CPUContext> {
+ public:
+  RunOrderOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<CPUContext>(operator_def, ws),
+        id_(OperatorBase::GetSingleArgument<int>("id", -1)) {}
+
+  bool RunOnDevice() override {
+    std::lock_guard<std::mutex> lock(run_order_mutex);
+    run_order.push_back(id_);
+    return true;
+  }
+
+ private:
+  int id_;
+};
+
+REGISTER_CPU_OPERATOR(RunOrderOp, RunOrderOp);
+OPERATOR_SCHEMA(RunOrderOp).NumInputs(0, INT_MAX).NumOutputs(0, INT_MAX);
+
+std::vector<int> runCriticalPathNet(
+    bool critical_path_scheduling,
+    const std::vector<float>& op_costs = {},
+    bool enable_profiling = false,
+    int num_runs = 1) {
+  // op 0 is followed by a short branch (op 1) and a long one (ops 2-4),
+  // run on a single thread so that the order of the ops is deterministic
+  const auto spec = R"DOC(
+        name: "critical_path"
+        type: "async_scheduling"
+        num_workers: 1
+        arg {
+          name: "critical_path_scheduling"
+          i: <CRITICAL_PATH>
+        }
+        arg {
+          name: "enable_profiling"
+          i: <PROFILING>
+        }
+        op {
+          type: "RunOrderOp"
+          input: "in"
+          output: "a"
+          arg { name: "id" i: 0 }
+        }
+        op {
+          type: "RunOrderOp"
+          input: "a"
+          output: "short"
+          arg { name: "id" i: 1 }
+        }
+        op {
+          type: "RunOrderOp"
+          input: "a"
+          output: "long1"
+          arg { name: "id" i: 2 }
+        }
+        op {
+          type: "RunOrderOp"
+          input: "long1"
+          output: "long2"
+          arg { name: "id" i: 3 }
+        }
+        op {
+          type: "RunOrderOp"
+          input: "long2"
+          output: "long3"
+          arg { name: "id" i: 4 }
+        }
+)DOC";
+
+  Workspace ws;
+  ws.CreateBlob("in");
+  std::string net_spec = spec;
+  ReplaceAll(net_spec, "<CRITICAL_PATH>", critical_path_scheduling ? "1" : "0");
+  ReplaceAll(net_spec, "<PROFILING>", enable_profiling ? "1" : "0");
+  NetDef net_def;
+  CAFFE_ENFORCE(TextFormat::ParseFromString(net_spec, &net_def));
+  auto net = CreateNet(net_def, &ws);
+  if (!op_costs.empty()) {
+    auto* scheduling_net = dynamic_cast_if_rtti<AsyncSchedulingNet*>(net.get());
+    CHECK_NOTNULL(scheduling_net);
+    scheduling_net->SetOperatorCosts(op_costs);
+  }
+
+  for (auto run = 0; run < num_runs; ++run) {
+    run_order.clear();
+    CAFFE_ENFORCE(net->Run());
+    net->Wait();
+  }
+  return run_order;
+}
+
+TEST(NetTest, CriticalPathScheduling) {
+  // ready tasks run in FIFO order by default
+  ASSERT_EQ(runCriticalPathNet(false), std::vector<int>({0, 1, 2, 3, 4}));
+  // the longest chain first with critical path scheduling
+  ASSERT_EQ(runCriticalPathNet(true), std::vector<int>({0, 2, 3, 4, 1}));
+  // unless the operator costs make the short branch the critical one
+  ASSERT_EQ(
+      runCriticalPathNet(true, {1, 10, 1, 1, 1}),
+      std::vector<int>({0, 1, 2, 3, 4}));
+  // operator costs measured by the net itself
+  auto profiled_order = runCriticalPathNet(true, {}, true, 5);
+  std::sort(profiled_order.begin() + 1, profiled_order.end());
+  ASSERT_EQ(profiled_order, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(NetTest, CriticalPathSchedulingLongChain) {
+  // every op of the spine readies the next one and a leaf, so each of them is
+  // a task of its own and the spine is run inline, one task after the other;
+  // the nesting is bounded, or a long spine would overflow the stack
+  const int spine_length = 10000;
+  NetDef net_def;
+  net_def.set_name("long_chain");
+  net_def.set_type("async_scheduling");
+  net_def.set_num_workers(1);
+  auto* arg = net_def.add_arg();
+  arg->set_name("critical_path_scheduling");
+  arg->set_i(1);
+  for (int i = 0; i < spine_length; ++i) {
+    const std::string input = i == 0 ? "in" : "spine" + c10::to_string(i - 1);
+    auto* spine_op = net_def.add_op();
+    spine_op->set_type("RunOrderOp");
+    spine_op->add_input(input);
+    spine_op->add_output("spine" + c10::to_string(i));
+    auto* leaf_op = net_def.add_op();
+    leaf_op->set_type("RunOrderOp");
+    leaf_op->add_input(input);
+    leaf_op->add_output("leaf" + c10::to_string(i));
+  }
+
+  Workspace ws;
+  ws.CreateBlob("in");
+  auto net = CreateNet(net_def, &ws);
+  run_order.clear();
+  ASSERT_TRUE(net->Run());
+  net->Wait();
+  ASSERT_EQ(run_order.size(), 2 * spine_length);
+}
+
+TEST(NetTest, CriticalPathSchedulingErrors) {
+  for (bool fail_in_sync : {false, true}) {
+    Workspace ws;
+    NetDef net_def =
+        AsyncErrorNet(&ws, "critical_path_error", false, fail_in_sync)
+            ->debug_def();
+    auto* arg = net_def.add_arg();
+    arg->set_name("critical_path_scheduling");
+    arg->set_i(1);
+    std::unique_ptr<NetBase> net(CreateNet(net_def, &ws));
+    ASSERT_FALSE(net->Run());
+  }
+}
+
 } // namespace caffe2
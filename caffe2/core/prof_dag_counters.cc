@@ -124,6 +124,25 @@ ProfDAGReport ProfDAGCounters::GetReport() const {
   return report_;
 }
 
+size_t ProfDAGCounters::GetNumProfiledRuns() const {
+  return report_.runtime_stats_.cnt();
+}
+
+std::vector<float> ProfDAGCounters::GetPerOpMeanTimes() const {
+  std::vector<float> op_times;
+  if (!report_.hasStats()) {
+    return op_times;
+  }
+  op_times.reserve(report_.time_per_op_total_.size());
+  for (const auto& op_stats : report_.time_per_op_total_) {
+    // operators that never ran (e.g. skipped after a failure) have no
+    // timings; count them as one unit, like when no costs are known
+    op_times.push_back(
+        op_stats.cnt() > 0 ? op_stats.sum() / op_stats.cnt() : 1.0f);
+  }
+  return op_times;
+}
+
 bool ProfDAGReport::hasStats() const {
   return runtime_stats_.cnt() > 0;
 }
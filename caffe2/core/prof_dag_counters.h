@@ -105,6 +105,12 @@ class ProfDAGCounters {
   void AddPerOpAsyncEndTime(size_t op_id);
   ProfDAGReport GetReport() const;
 
+  // Number of runs with complete per operator timings
+  size_t GetNumProfiledRuns() const;
+  // Mean time of each operator over the profiled runs, in ms, or 1.0 for
+  // operators without timings; empty if there are no profiled runs yet
+  std::vector<float> GetPerOpMeanTimes() const;
+
  private:
   Timer timer_;
 
@@ -0,0 +1,340 @@
+#include "caffe2/predictor/predictor_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+namespace caffe2 {
+
+namespace {
+
+// Rows of the request, i.e. the common first dimension of its inputs, or -1
+// if the inputs have none.
+int64_t batchRows(const Predictor::TensorList& inputs) {
+  if (inputs.empty()) {
+    return -1;
+  }
+  for (const auto& input : inputs) {
+    if (input.dim() == 0 || input.size(0) != inputs[0].size(0)) {
+      return -1;
+    }
+  }
+  return inputs[0].size(0);
+}
+
+float percentile(const std::vector<float>& sorted, float p) {
+  const auto rank = static_cast<int64_t>(std::ceil(p / 100 * sorted.size()));
+  return sorted[std::max<int64_t>(rank - 1, 0)];
+}
+
+} // namespace
+
+PredictorPool::PredictorPool(
+    const NetDef& init_net,
+    const NetDef& run_net,
+    PredictorPoolOptions options)
+    : options_(std::move(options)),
+      owned_parameters_(make_unique<Workspace>()),
+      parameters_(owned_parameters_.get()) {
+  CAFFE_ENFORCE(parameters_->RunNetOnce(init_net));
+  init(run_net);
+}
+
+PredictorPool::PredictorPool(
+    Workspace* parameters,
+    const NetDef& run_net,
+    PredictorPoolOptions options)
+    : options_(std::move(options)), parameters_(parameters) {
+  CAFFE_ENFORCE(parameters_);
+  init(run_net);
+}
+
+void PredictorPool::init(const NetDef& run_net) {
+  CAFFE_ENFORCE_GT(options_.num_instances, 0);
+  CAFFE_ENFORCE_GT(options_.latency_window, 0);
+  latencies_.reserve(options_.latency_window);
+  if (options_.input_names.empty()) {
+    for (const auto& name : run_net.external_input()) {
+      if (!parameters_->HasBlob(name)) {
+        options_.input_names.push_back(name);
+      }
+    }
+  }
+
+  for (int i = 0; i < options_.num_instances; ++i) {
+    auto config = makePredictorConfig(
+        NetDef(),
+        run_net,
+        parameters_,
+        /*run_init=*/false,
+        options_.optimization);
+    // Everything the instance writes must not resolve to a blob of the
+    // parameter workspace, which is shared by all the instances.
+    for (const auto& name : options_.input_names) {
+      BlobGetMutableTensor(config.ws->CreateLocalBlob(name), CPU);
+    }
+    for (const auto& op : config.predict_net->op()) {
+      for (const auto& name : op.output()) {
+        config.ws->CreateLocalBlob(name);
+      }
+    }
+    config.input_names = options_.input_names;
+    config.output_names.assign(
+        config.predict_net->external_output().begin(),
+        config.predict_net->external_output().end());
+    predictors_.push_back(make_unique<Predictor>(std::move(config)));
+  }
+
+  stats_start_ = Clock::now();
+  for (auto& predictor : predictors_) {
+    Predictor* p = predictor.get();
+    workers_.emplace_back([this, p]() { workerLoop(p); });
+  }
+}
+
+PredictorPool::~PredictorPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+bool PredictorPool::operator()(const TensorList& inputs, TensorList* outputs) {
+  CAFFE_ENFORCE_EQ(
+      inputs.size(),
+      options_.input_names.size(),
+      "Expected one input per input name");
+  Request request;
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.rows = batchRows(inputs);
+  request.submitted = Clock::now();
+  auto done = request.done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CAFFE_ENFORCE(!stop_, "PredictorPool is shutting down");
+    queue_.push_back(&request);
+  }
+  cv_.notify_all();
+  return done.get();
+}
+
+void PredictorPool::workerLoop(Predictor* predictor) {
+  while (true) {
+    auto batch = takeBatch();
+    if (batch.empty()) {
+      return;
+    }
+    runBatch(predictor, batch);
+  }
+}
+
+std::vector<PredictorPool::Request*> PredictorPool::takeBatch() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() {
+    return (!forming_batch_ && !queue_.empty()) || (stop_ && queue_.empty());
+  });
+  if (queue_.empty()) {
+    return {};
+  }
+  std::vector<Request*> batch{queue_.front()};
+  queue_.pop_front();
+  int64_t rows = batch[0]->rows;
+  if (rows < 0 || options_.max_batch_size <= 1) {
+    return batch;
+  }
+
+  forming_batch_ = true;
+  const auto deadline = batch[0]->submitted + options_.max_batch_delay;
+  while (rows < options_.max_batch_size) {
+    if (queue_.empty() &&
+        !cv_.wait_until(lock, deadline, [this]() {
+          return stop_ || !queue_.empty();
+        })) {
+      break;
+    }
+    if (queue_.empty()) {
+      break;
+    }
+    Request* next = queue_.front();
+    if (!canBatch(*batch[0], *next) ||
+        rows + next->rows > options_.max_batch_size) {
+      break;
+    }
+    queue_.pop_front();
+    rows += next->rows;
+    batch.push_back(next);
+  }
+  forming_batch_ = false;
+  lock.unlock();
+  cv_.notify_all();
+  return batch;
+}
+
+bool PredictorPool::canBatch(const Request& first, const Request& other)
+    const {
+  if (other.rows < 0) {
+    return false;
+  }
+  for (size_t i = 0; i < first.inputs->size(); ++i) {
+    const auto& a = (*first.inputs)[i];
+    const auto& b = (*other.inputs)[i];
+    if (a.dtype() != b.dtype() || a.dim() != b.dim()) {
+      return false;
+    }
+    for (int d = 1; d < a.dim(); ++d) {
+      if (a.size(d) != b.size(d)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void PredictorPool::runBatch(
+    Predictor* predictor,
+    const std::vector<Request*>& batch) {
+  bool success = false;
+  std::exception_ptr error;
+  try {
+    CPUContext context;
+    int64_t total_rows = 0;
+    for (const auto* request : batch) {
+      total_rows += request->rows;
+    }
+
+    Predictor::TensorMap inputs;
+    for (size_t i = 0; i < options_.input_names.size(); ++i) {
+      const auto& first = (*batch[0]->inputs)[i];
+      if (batch.size() == 1) {
+        inputs.emplace(options_.input_names[i], first.UnsafeSharedInstance());
+        continue;
+      }
+      auto dims = first.sizes().vec();
+      dims[0] = total_rows;
+      Tensor batched(dims, CPU);
+      char* dst = static_cast<char*>(batched.raw_mutable_data(first.dtype()));
+      for (const auto* request : batch) {
+        const auto& part = (*request->inputs)[i];
+        if (part.numel() > 0) {
+          context.CopyItemsSameDevice(
+              part.dtype(), part.numel(), part.raw_data(), dst);
+        }
+        dst += part.nbytes();
+      }
+      inputs.emplace(options_.input_names[i], std::move(batched));
+    }
+
+    TensorList outputs;
+    success = (*predictor)(inputs, &outputs);
+    if (success && batch.size() == 1) {
+      // The outputs live in the workspace of the instance until its next run.
+      batch[0]->outputs->clear();
+      for (const auto& output : outputs) {
+        batch[0]->outputs->push_back(output.Clone());
+      }
+    } else if (success) {
+      for (auto* request : batch) {
+        request->outputs->clear();
+      }
+      for (size_t o = 0; o < outputs.size(); ++o) {
+        const auto& output = outputs[o];
+        CAFFE_ENFORCE(
+            output.dim() > 0 && output.size(0) == total_rows,
+            "Output ",
+            predictor->output_names()[o],
+            " of a batch of ",
+            total_rows,
+            " rows does not have the batch size as its first dimension");
+        const size_t row_items = total_rows > 0 ? output.numel() / total_rows : 0;
+        const char* src = static_cast<const char*>(output.raw_data());
+        for (auto* request : batch) {
+          auto dims = output.sizes().vec();
+          dims[0] = request->rows;
+          Tensor part(dims, CPU);
+          void* dst = part.raw_mutable_data(output.dtype());
+          const size_t items = request->rows * row_items;
+          if (items > 0) {
+            context.CopyItemsSameDevice(output.dtype(), items, src, dst);
+          }
+          src += items * output.itemsize();
+          request->outputs->push_back(std::move(part));
+        }
+      }
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  recordBatch(batch);
+  for (auto* request : batch) {
+    if (error) {
+      request->done.set_exception(error);
+    } else {
+      request->done.set_value(success);
+    }
+  }
+}
+
+void PredictorPool::recordBatch(const std::vector<Request*>& batch) {
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  ++num_batches_;
+  num_requests_ += batch.size();
+  for (const auto* request : batch) {
+    const float latency =
+        std::chrono::duration<float, std::milli>(now - request->submitted)
+            .count();
+    latency_max_ = std::max(latency_max_, latency);
+    if (latencies_.size() < static_cast<size_t>(options_.latency_window)) {
+      latencies_.push_back(latency);
+    } else {
+      latencies_[latencies_next_] = latency;
+      latencies_next_ = (latencies_next_ + 1) % latencies_.size();
+    }
+  }
+}
+
+PredictorPoolStats PredictorPool::stats() const {
+  std::vector<float> sorted;
+  PredictorPoolStats stats;
+  double elapsed;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats.num_requests = num_requests_;
+    stats.num_batches = num_batches_;
+    elapsed = std::chrono::duration<double>(Clock::now() - stats_start_).count();
+    sorted = latencies_;
+    stats.latency_max = latency_max_;
+  }
+  if (elapsed > 0) {
+    stats.throughput = stats.num_requests / elapsed;
+  }
+  if (stats.num_batches > 0) {
+    stats.mean_batch_size =
+        static_cast<double>(stats.num_requests) / stats.num_batches;
+  }
+  if (!sorted.empty()) {
+    std::sort(sorted.begin(), sorted.end());
+    stats.latency_p50 = percentile(sorted, 50);
+    stats.latency_p90 = percentile(sorted, 90);
+    stats.latency_p99 = percentile(sorted, 99);
+  }
+  return stats;
+}
+
+void PredictorPool::ResetStats() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_start_ = Clock::now();
+  num_requests_ = 0;
+  num_batches_ = 0;
+  latency_max_ = 0;
+  latencies_.clear();
+  latencies_next_ = 0;
+}
+
+} // namespace caffe2
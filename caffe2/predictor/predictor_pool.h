@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "caffe2/core/context.h"
+#include "caffe2/core/workspace.h"
+#include "caffe2/predictor/predictor.h"
+
+namespace caffe2 {
+
+struct CAFFE2_API PredictorPoolOptions {
+  // Number of predictor instances, each running requests on its own thread
+  // and in its own workspace.
+  int num_instances = 1;
+  // Requests are coalesced into batches of up to max_batch_size rows, the
+  // first dimension of the inputs. 1 disables batching.
+  int64_t max_batch_size = 1;
+  // How long the oldest request of a batch may wait for more requests.
+  std::chrono::microseconds max_batch_delay{0};
+  // Names of the blobs fed by requests, in the order of the request inputs.
+  // Defaults to the external inputs of the run net that are not parameters.
+  std::vector<std::string> input_names;
+  int optimization = 1;
+  // The latency percentiles are computed over the most recent
+  // latency_window requests.
+  int64_t latency_window = 4096;
+};
+
+struct CAFFE2_API PredictorPoolStats {
+  int64_t num_requests = 0;
+  int64_t num_batches = 0;
+  // Requests per second since the pool was created or the stats were reset.
+  double throughput = 0;
+  double mean_batch_size = 0;
+  // Request latencies in milliseconds, from submission to completion. The
+  // percentiles are over the last latency_window requests, the max is over
+  // all of them.
+  float latency_p50 = 0;
+  float latency_p90 = 0;
+  float latency_p99 = 0;
+  float latency_max = 0;
+};
+
+/**
+ * Runs a net on many concurrent requests with several predictor instances.
+ *
+ * The instances share the parameter blobs of a parent workspace, which
+ * holds a single copy of them, and only read them. The blobs fed by requests
+ * and the blobs written by the run net are local to each instance.
+ *
+ * Concurrent requests are batched dynamically: an idle instance takes the
+ * oldest request and waits up to max_batch_delay for more requests until the
+ * batch reaches max_batch_size rows. The inputs of the requests are
+ * concatenated along their first dimension and the outputs split back, so
+ * batching requires a net that treats the first dimension of all its inputs
+ * and outputs as the batch dimension. Requests whose inputs differ in type or
+ * in the other dimensions are run in separate batches.
+ */
+class CAFFE2_API PredictorPool {
+ public:
+  using TensorList = Predictor::TensorList;
+
+  // Runs init_net once in a parameter workspace owned by the pool.
+  PredictorPool(
+      const NetDef& init_net,
+      const NetDef& run_net,
+      PredictorPoolOptions options = PredictorPoolOptions());
+
+  // Uses the parameters already in `parameters`, which must outlive the pool.
+  PredictorPool(
+      Workspace* parameters,
+      const NetDef& run_net,
+      PredictorPoolOptions options = PredictorPoolOptions());
+
+  ~PredictorPool();
+
+  // Runs the net on the inputs, given in the order of input_names(), and
+  // blocks until the outputs are ready. Unlike with Predictor, the outputs
+  // are owned by the caller. Can be called from any number of threads.
+  bool operator()(const TensorList& inputs, TensorList* outputs);
+
+  const std::vector<std::string>& input_names() const {
+    return options_.input_names;
+  }
+
+  int num_instances() const {
+    return static_cast<int>(predictors_.size());
+  }
+
+  PredictorPoolStats stats() const;
+  void ResetStats();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Request {
+    const TensorList* inputs;
+    TensorList* outputs;
+    // Rows of the inputs, -1 if the request cannot be batched.
+    int64_t rows;
+    Clock::time_point submitted;
+    std::promise<bool> done;
+  };
+
+  void init(const NetDef& run_net);
+  void workerLoop(Predictor* predictor);
+  std::vector<Request*> takeBatch();
+  bool canBatch(const Request& first, const Request& other) const;
+  void runBatch(Predictor* predictor, const std::vector<Request*>& batch);
+  void recordBatch(const std::vector<Request*>& batch);
+
+  PredictorPoolOptions options_;
+  std::unique_ptr<Workspace> owned_parameters_;
+  Workspace* parameters_;
+  std::vector<std::unique_ptr<Predictor>> predictors_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request*> queue_;
+  // Set while a worker is forming a batch, so that requests arriving in the
+  // meantime join that batch instead of being taken by idle workers.
+  bool forming_batch_ = false;
+  bool stop_ = false;
+
+  mutable std::mutex stats_mutex_;
+  Clock::time_point stats_start_;
+  int64_t num_requests_ = 0;
+  int64_t num_batches_ = 0;
+  float latency_max_ = 0;
+  // Ring buffer of the latencies of the last latency_window requests; the
+  // oldest one is at latencies_next_ once the buffer is full.
+  std::vector<float> latencies_;
+  size_t latencies_next_ = 0;
+};
+
+} // namespace caffe2
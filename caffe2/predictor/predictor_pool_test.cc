@@ -0,0 +1,215 @@
+#include "caffe2/core/operator.h"
+#include "caffe2/core/tensor.h"
+#include "caffe2/predictor/predictor_pool.h"
+#include "caffe2/utils/proto_utils.h"
+
+#include <gtest/gtest.h>
+
+namespace caffe2 {
+
+namespace {
+
+const char* predictSpec = R"DOC(
+        name: "predict"
+        type: "simple"
+        external_input: "data"
+        external_input: "W"
+        external_input: "b"
+        external_output: "y"
+        op {
+          input: "data"
+          input: "W"
+          input: "b"
+          output: "y"
+          type: "FC"
+        }
+)DOC";
+
+const char* initSpec = R"DOC(
+        name: "init"
+        type: "simple"
+        op {
+          type: "ConstantFill"
+          output: "W"
+          arg {
+            name: "shape"
+            ints: 10
+            ints: 4
+          }
+          arg {
+            name: "value"
+            f: 2.0
+          }
+        }
+        op {
+          type: "ConstantFill"
+          output: "b"
+          arg {
+            name: "shape"
+            ints: 10
+          }
+          arg {
+            name: "value"
+            f: 1.0
+          }
+        }
+)DOC";
+
+NetDef parseNetDef(const std::string& value) {
+  NetDef def;
+  CAFFE_ENFORCE(
+      TextFormat::ParseFromString(value, &def),
+      "Failed to parse NetDef with value: ",
+      value);
+  return def;
+}
+
+// A request of `rows` rows, where every element of row i is first + i.
+TensorCPU makeInput(int64_t rows, float first) {
+  auto input = caffe2::empty({rows, 4}, at::dtype<float>().device(CPU));
+  float* data = input.mutable_data<float>();
+  for (int64_t i = 0; i < rows; ++i) {
+    std::fill_n(data + i * 4, 4, first + i);
+  }
+  return input;
+}
+
+void expectOutput(const TensorCPU& output, int64_t rows, float first) {
+  ASSERT_EQ(output.dim(), 2);
+  ASSERT_EQ(output.size(0), rows);
+  ASSERT_EQ(output.size(1), 10);
+  for (int64_t i = 0; i < rows; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      EXPECT_FLOAT_EQ(output.data<float>()[i * 10 + j], 8 * (first + i) + 1);
+    }
+  }
+}
+
+} // namespace
+
+TEST(PredictorPoolTest, SharesParameters) {
+  PredictorPoolOptions options;
+  options.num_instances = 3;
+  PredictorPool pool(parseNetDef(initSpec), parseNetDef(predictSpec), options);
+  EXPECT_EQ(pool.num_instances(), 3);
+  ASSERT_EQ(pool.input_names().size(), 1);
+  EXPECT_EQ(pool.input_names()[0], "data");
+
+  PredictorPool::TensorList inputs, outputs;
+  inputs.push_back(makeInput(2, 1));
+  ASSERT_TRUE(pool(inputs, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+  expectOutput(outputs[0], 2, 1);
+}
+
+TEST(PredictorPoolTest, ConcurrentRequests) {
+  PredictorPoolOptions options;
+  options.num_instances = 2;
+  options.max_batch_size = 8;
+  options.max_batch_delay = std::chrono::milliseconds(1);
+  PredictorPool pool(parseNetDef(initSpec), parseNetDef(predictSpec), options);
+
+  const int kThreads = 8;
+  const int kRequests = 20;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&pool, t]() {
+      for (int r = 0; r < kRequests; ++r) {
+        const int64_t rows = 1 + (t + r) % 3;
+        const float first = t * 100 + r;
+        PredictorPool::TensorList inputs, outputs;
+        inputs.push_back(makeInput(rows, first));
+        ASSERT_TRUE(pool(inputs, &outputs));
+        ASSERT_EQ(outputs.size(), 1);
+        expectOutput(outputs[0], rows, first);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.num_requests, kThreads * kRequests);
+  EXPECT_LE(stats.num_batches, stats.num_requests);
+  EXPECT_GT(stats.throughput, 0);
+  EXPECT_LE(stats.latency_p50, stats.latency_p90);
+  EXPECT_LE(stats.latency_p90, stats.latency_p99);
+  EXPECT_LE(stats.latency_p99, stats.latency_max);
+
+  pool.ResetStats();
+  EXPECT_EQ(pool.stats().num_requests, 0);
+}
+
+TEST(PredictorPoolTest, LatencyWindow) {
+  PredictorPoolOptions options;
+  options.latency_window = 4;
+  PredictorPool pool(parseNetDef(initSpec), parseNetDef(predictSpec), options);
+
+  for (int r = 0; r < 10; ++r) {
+    PredictorPool::TensorList inputs, outputs;
+    inputs.push_back(makeInput(1, r));
+    ASSERT_TRUE(pool(inputs, &outputs));
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.num_requests, 10);
+  EXPECT_LE(stats.latency_p50, stats.latency_p99);
+  EXPECT_LE(stats.latency_p99, stats.latency_max);
+
+  pool.ResetStats();
+  stats = pool.stats();
+  EXPECT_EQ(stats.latency_p99, 0);
+  EXPECT_EQ(stats.latency_max, 0);
+}
+
+TEST(PredictorPoolTest, BatchesRequests) {
+  PredictorPoolOptions options;
+  options.max_batch_size = 4;
+  // Long enough for all the requests to arrive, the batch is run as soon as
+  // it is full.
+  options.max_batch_delay = std::chrono::seconds(10);
+  PredictorPool pool(parseNetDef(initSpec), parseNetDef(predictSpec), options);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, t]() {
+      PredictorPool::TensorList inputs, outputs;
+      inputs.push_back(makeInput(1, t));
+      ASSERT_TRUE(pool(inputs, &outputs));
+      expectOutput(outputs[0], 1, t);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto stats = pool.stats();
+  EXPECT_EQ(stats.num_requests, 4);
+  EXPECT_EQ(stats.num_batches, 1);
+  EXPECT_EQ(stats.mean_batch_size, 4);
+}
+
+TEST(PredictorPoolTest, RunsIncompatibleRequestsSeparately) {
+  PredictorPoolOptions options;
+  options.max_batch_size = 16;
+  options.max_batch_delay = std::chrono::milliseconds(50);
+  PredictorPool pool(parseNetDef(initSpec), parseNetDef(predictSpec), options);
+
+  // The second request cannot be concatenated with the first one, and the
+  // net fails on it.
+  std::thread good([&pool]() {
+    PredictorPool::TensorList inputs, outputs;
+    inputs.push_back(makeInput(3, 1));
+    ASSERT_TRUE(pool(inputs, &outputs));
+    expectOutput(outputs[0], 3, 1);
+  });
+  std::thread bad([&pool]() {
+    PredictorPool::TensorList inputs, outputs;
+    inputs.push_back(caffe2::empty({3, 5}, at::dtype<float>().device(CPU)));
+    EXPECT_ANY_THROW(pool(inputs, &outputs));
+  });
+  good.join();
+  bad.join();
+  EXPECT_EQ(pool.stats().num_batches, 2);
+}
+
+} // namespace caffe2
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cpuinfo.h>
+
 #include <torch/torch.h>
 #include <ATen/native/Pow.h>
 #include <torch/types.h>
@@ -9,20 +11,111 @@
 #include <vector>
 #include <type_traits>
 #include <cstdlib>
+#include <string>
 
 
 struct DispatchTest : torch::test::SeedingFixture {};
 
+// Sets ATEN_CPU_CAPABILITY for the duration of a test, and restores the
+// previous value afterwards so that later tests are unaffected.
+struct CPUCapabilityGuard {
+  explicit CPUCapabilityGuard(const std::string& capability) {
+    const char* previous = std::getenv("ATEN_CPU_CAPABILITY");
+    if (previous) {
+      previous_ = previous;
+    }
+    set(capability);
+  }
+  ~CPUCapabilityGuard() {
+    set(previous_.value_or(""));
+  }
+
+ private:
+  static void set(const std::string& value) {
+#ifdef _WIN32
+    _putenv(("ATEN_CPU_CAPABILITY=" + value).c_str());
+#else
+    if (value.empty()) {
+      unsetenv("ATEN_CPU_CAPABILITY");
+    } else {
+      setenv("ATEN_CPU_CAPABILITY", value.c_str(), 1);
+    }
+#endif
+  }
+
+  c10::optional<std::string> previous_;
+};
+
+// Defined in vec512.cpp, which is compiled for AVX512.
+namespace vec512_test {
+void check_float();
+void check_double();
+void check_int();
+void check_bfloat16();
+void check_qint();
+void check_complex();
+} // namespace vec512_test
+
+// The AVX512 Vec256 specializations are only run on CPUs that have the
+// subsets they are compiled for, whatever ATEN_CPU_CAPABILITY says.
+static bool cpu_has_avx512() {
+#if !defined(__powerpc__) && !defined(__s390x__)
+  return cpuinfo_initialize() && cpuinfo_has_x86_avx512f() &&
+      cpuinfo_has_x86_avx512bw() && cpuinfo_has_x86_avx512vl() &&
+      cpuinfo_has_x86_avx512dq() && cpuinfo_has_x86_fma3();
+#else
+  return false;
+#endif
+}
+
+TEST_F(DispatchTest, TestVec512Float) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_float();
+}
+
+TEST_F(DispatchTest, TestVec512Double) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_double();
+}
+
+TEST_F(DispatchTest, TestVec512Int) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_int();
+}
+
+TEST_F(DispatchTest, TestVec512BFloat16) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_bfloat16();
+}
+
+TEST_F(DispatchTest, TestVec512Quantized) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_qint();
+}
+
+TEST_F(DispatchTest, TestVec512Complex) {
+  if (!cpu_has_avx512()) {
+    return;
+  }
+  vec512_test::check_complex();
+}
+
 TEST_F(DispatchTest, TestAVX2) {
   const std::vector<int> ints {1, 2, 3, 4};
   const std::vector<int> result {1, 4, 27, 256};
   const auto vals_tensor = torch::tensor(ints);
   const auto pows_tensor = torch::tensor(ints);
-#ifdef _WIN32
-  _putenv("ATEN_CPU_CAPABILITY=avx2");
-#else
-  setenv("ATEN_CPU_CAPABILITY", "avx2", 1);
-#endif
+  CPUCapabilityGuard guard("avx2");
   const auto actual_pow_avx2 = vals_tensor.pow(pows_tensor);
   for (int i = 0; i < 4; i++) {
     ASSERT_EQ(result[i], actual_pow_avx2[i].item<int>());
@@ -34,11 +127,7 @@ TEST_F(DispatchTest, TestAVX) {
   const std::vector<int> result {1, 4, 27, 256};
   const auto vals_tensor = torch::tensor(ints);
   const auto pows_tensor = torch::tensor(ints);
-#ifdef _WIN32
-  _putenv("ATEN_CPU_CAPABILITY=avx");
-#else
-  setenv("ATEN_CPU_CAPABILITY", "avx", 1);
-#endif
+  CPUCapabilityGuard guard("avx");
   const auto actual_pow_avx = vals_tensor.pow(pows_tensor);
   for (int i = 0; i < 4; i++) {
     ASSERT_EQ(result[i], actual_pow_avx[i].item<int>());
@@ -50,11 +139,7 @@ TEST_F(DispatchTest, TestDefault) {
   const std::vector<int> result {1, 4, 27, 256};
   const auto vals_tensor = torch::tensor(ints);
   const auto pows_tensor = torch::tensor(ints);
-#ifdef _WIN32
-  _putenv("ATEN_CPU_CAPABILITY=default");
-#else
-  setenv("ATEN_CPU_CAPABILITY", "default", 1);
-#endif
+  CPUCapabilityGuard guard("default");
   const auto actual_pow_default = vals_tensor.pow(pows_tensor);
   for (int i = 0; i < 4; i++) {
     ASSERT_EQ(result[i], actual_pow_default[i].item<int>());
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <ATen/native/PackedLinear.h>
+#include <torch/torch.h>
+
+#include <test/cpp/api/support.h>
+
+#include <future>
+
+TEST(InferenceModeTest, TensorsCreatedInInferenceMode) {
+  auto x = torch::ones({2, 3});
+  torch::Tensor y, z;
+  {
+    torch::InferenceMode guard;
+    ASSERT_TRUE(torch::InferenceMode::is_enabled());
+    y = x * 2;
+    z = torch::ones({2, 3});
+    ASSERT_TRUE(y.is_inference());
+    ASSERT_TRUE(z.is_inference());
+    ASSERT_FALSE(x.is_inference());
+    ASSERT_FALSE(y.requires_grad());
+    ASSERT_EQ(y.unsafeGetTensorImpl()->autograd_meta(), nullptr);
+  }
+  ASSERT_FALSE(torch::InferenceMode::is_enabled());
+  ASSERT_TRUE(torch::allclose(y, x * 2));
+  ASSERT_FALSE((y + 1).is_inference());
+}
+
+TEST(InferenceModeTest, SkipsAutograd) {
+  auto w = torch::ones({2, 2}, torch::requires_grad());
+  auto x = torch::ones({2, 2});
+  {
+    torch::InferenceMode guard;
+    auto y = torch::mm(x, w);
+    ASSERT_FALSE(y.requires_grad());
+    ASSERT_FALSE(y.grad_fn());
+    // In-place ops on inference tensors are fine in inference mode, and views
+    // of them are inference tensors.
+    y.add_(1);
+    ASSERT_TRUE(y.view({4}).is_inference());
+  }
+  ASSERT_TRUE(torch::mm(x, w).requires_grad());
+}
+
+TEST(InferenceModeTest, InferenceTensorsCannotEnterAutograd) {
+  torch::Tensor y;
+  {
+    torch::InferenceMode guard;
+    y = torch::ones({2, 2});
+  }
+  ASSERT_THROWS_WITH(y.requires_grad_(), "inference tensor");
+  ASSERT_THROWS_WITH(y.add_(1), "Inplace update to an inference tensor");
+  ASSERT_THROWS_WITH(y._version(), "Inference tensors do not track version counter");
+
+  auto w = torch::ones({2, 2}, torch::requires_grad());
+  ASSERT_THROWS_WITH(torch::mm(y, w), "Inference tensors cannot be saved for backward");
+
+  // Views stay inference tensors outside inference mode.
+  ASSERT_TRUE(y.view({4}).is_inference());
+
+  // A clone is a normal tensor.
+  auto c = y.clone();
+  ASSERT_FALSE(c.is_inference());
+  c.requires_grad_();
+  torch::mm(c, w).sum().backward();
+  ASSERT_TRUE(torch::allclose(c.grad(), torch::full({2, 2}, 2.)));
+}
+
+TEST(InferenceModeTest, NormalTensorsInInferenceMode) {
+  auto x = torch::ones({2, 2});
+  auto version = x._version();
+  torch::Tensor view;
+  {
+    torch::InferenceMode guard;
+    // In-place and out= ops on normal tensors still bump their version.
+    x.add_(1);
+    ASSERT_FALSE(x.is_inference());
+    ASSERT_EQ(x._version(), version + 1);
+    x.copy_(torch::full({2, 2}, 2.));
+    ASSERT_EQ(x._version(), version + 2);
+    torch::add_out(x, x, torch::ones({2, 2}));
+    ASSERT_EQ(x._version(), version + 3);
+
+    // Views of normal tensors are normal tensors sharing their version.
+    view = x.view({4});
+    ASSERT_FALSE(view.is_inference());
+    view.sub_(1);
+    ASSERT_EQ(x._version(), version + 4);
+    for (const auto& row : x.unbind()) {
+      ASSERT_FALSE(row.is_inference());
+    }
+  }
+  ASSERT_EQ(x._version(), version + 4);
+  ASSERT_EQ(view._version(), x._version());
+  ASSERT_TRUE(torch::allclose(x, torch::full({2, 2}, 2.)));
+  view.mul_(2);
+  ASSERT_EQ(x._version(), version + 5);
+}
+
+TEST(InferenceModeTest, Nesting) {
+  {
+    torch::InferenceMode guard;
+    {
+      torch::InferenceMode no_inference(false);
+      ASSERT_FALSE(torch::InferenceMode::is_enabled());
+      ASSERT_FALSE(c10::impl::tls_is_dispatch_key_included(c10::DispatchKey::InplaceOrView));
+      auto w = torch::ones({2, 2}, torch::requires_grad());
+      auto y = w * 2;
+      ASSERT_FALSE(y.is_inference());
+      ASSERT_TRUE(y.requires_grad());
+    }
+    ASSERT_TRUE(torch::InferenceMode::is_enabled());
+    ASSERT_TRUE(c10::impl::tls_is_dispatch_key_excluded(c10::DispatchKey::Autograd));
+    ASSERT_TRUE(c10::impl::tls_is_dispatch_key_included(c10::DispatchKey::InplaceOrView));
+  }
+  ASSERT_FALSE(torch::InferenceMode::is_enabled());
+  ASSERT_FALSE(c10::impl::tls_is_dispatch_key_excluded(c10::DispatchKey::Autograd));
+  ASSERT_FALSE(c10::impl::tls_is_dispatch_key_included(c10::DispatchKey::InplaceOrView));
+}
+
+TEST(InferenceModeTest, PropagatesToLaunchedTasks) {
+  torch::InferenceMode guard;
+  std::promise<bool> enabled;
+  at::launch([&]() {
+    enabled.set_value(torch::InferenceMode::is_enabled());
+  });
+  ASSERT_TRUE(enabled.get_future().get());
+}
+
+TEST(InferenceModeTest, PackedLinear) {
+  const bool prev_enabled = at::globalContext().userEnabledPackedLinear();
+  at::globalContext().setUserEnabledPackedLinear(true);
+  auto input = torch::randn({4, 8});
+  auto weight = torch::randn({3, 8});
+  auto bias = torch::randn({3});
+  auto expected = torch::addmm(bias, input, weight.t());
+  {
+    torch::InferenceMode guard;
+    ASSERT_TRUE(torch::allclose(torch::linear(input, weight, bias), expected, 1e-4, 1e-5));
+    // In-place updates in inference mode bump the version of normal tensors,
+    // so the second call must not reuse the weight packed by the first one.
+    weight.mul_(2);
+    ASSERT_TRUE(torch::allclose(
+        torch::linear(input, weight, bias), torch::addmm(bias, input, weight.t()), 1e-4, 1e-5));
+
+    auto inference_weight = torch::randn({3, 8});
+    auto out = torch::linear(input, inference_weight, bias);
+    ASSERT_TRUE(torch::allclose(out, torch::addmm(bias, input, inference_weight.t()), 1e-4, 1e-5));
+    inference_weight.add_(1);
+    ASSERT_TRUE(torch::allclose(
+        torch::linear(input, inference_weight, bias),
+        torch::addmm(bias, input, inference_weight.t()), 1e-4, 1e-5));
+  }
+  // Functional use of an inference weight outside inference mode
+  auto inference_weight = [] {
+    torch::InferenceMode guard;
+    return torch::randn({3, 8});
+  }();
+  ASSERT_TRUE(torch::allclose(
+      torch::linear(input, inference_weight, bias),
+      torch::addmm(bias, input, inference_weight.t()), 1e-4, 1e-5));
+  at::native::packed_linear_clear_cache();
+  at::globalContext().setUserEnabledPackedLinear(prev_enabled);
+}
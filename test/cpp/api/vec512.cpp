@@ -0,0 +1,342 @@
+// This file is compiled with the AVX512 flags (see CMakeLists.txt), so that
+// Vec256 resolves to the 512-bit specializations of ATen/cpu/vec512. It only
+// defines functions: the tests in dispatch.cpp call them after checking
+// that the CPU supports AVX512.
+
+#include <gtest/gtest.h>
+
+#include <ATen/cpu/vec256/vec256.h>
+#include <c10/util/BFloat16.h>
+#include <c10/util/complex_type.h>
+#include <c10/util/qint32.h>
+#include <c10/util/qint8.h>
+#include <c10/util/quint8.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace vec512_test {
+
+#ifdef CPU_CAPABILITY_AVX512
+
+namespace {
+
+using at::vec256::Vec256;
+
+template <typename T>
+std::vector<T> iota(int64_t n, T start, T step) {
+  std::vector<T> values(n);
+  for (int64_t i = 0; i < n; ++i) {
+    values[i] = static_cast<T>(start + step * static_cast<T>(i));
+  }
+  return values;
+}
+
+// +, -, *, blend, set and partial loadu/store, shared by the float and
+// integer types.
+template <typename T>
+void check_common(T a_start, T b_start) {
+  using Vec = Vec256<T>;
+  constexpr int64_t N = Vec::size();
+  ASSERT_EQ(N * sizeof(T), 64);
+  const auto a = iota<T>(N, a_start, 3);
+  const auto b = iota<T>(N, b_start, -2);
+  const Vec a_vec = Vec::loadu(a.data());
+  const Vec b_vec = Vec::loadu(b.data());
+
+  T out[N];
+  (a_vec + b_vec).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], static_cast<T>(a[i] + b[i])) << "add, lane " << i;
+  }
+  (a_vec - b_vec).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], static_cast<T>(a[i] - b[i])) << "sub, lane " << i;
+  }
+  (a_vec * b_vec).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], static_cast<T>(a[i] * b[i])) << "mul, lane " << i;
+  }
+
+  // every other lane from b
+  constexpr int64_t mask = static_cast<int64_t>(0xaaaaaaaaaaaaaaaaULL);
+  Vec::template blend<mask>(a_vec, b_vec).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], i % 2 ? b[i] : a[i]) << "blend, lane " << i;
+  }
+
+  for (int64_t count : {int64_t(0), int64_t(1), N / 2 + 1, N - 1, N}) {
+    Vec::set(a_vec, b_vec, count).store(out);
+    for (int64_t i = 0; i < N; ++i) {
+      ASSERT_EQ(out[i], i < count ? b[i] : a[i])
+          << "set, count " << count << ", lane " << i;
+    }
+
+    Vec::loadu(a.data(), count).store(out);
+    for (int64_t i = 0; i < N; ++i) {
+      ASSERT_EQ(out[i], i < count ? a[i] : T(0))
+          << "partial loadu, count " << count << ", lane " << i;
+    }
+
+    std::fill(out, out + N, T(7));
+    a_vec.store(out, count);
+    for (int64_t i = 0; i < N; ++i) {
+      ASSERT_EQ(out[i], i < count ? a[i] : T(7))
+          << "partial store, count " << count << ", lane " << i;
+    }
+  }
+}
+
+template <typename T>
+void check_floating() {
+  check_common<T>(-5.5, 2.25);
+  using Vec = Vec256<T>;
+  constexpr int64_t N = Vec::size();
+  const auto a = iota<T>(N, -3.5, 0.75);
+  const auto b = iota<T>(N, 1.25, 0.5);
+  const auto c = iota<T>(N, 4, -1);
+  T out[N];
+  (Vec::loadu(a.data()) / Vec::loadu(b.data())).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], a[i] / b[i]) << "div, lane " << i;
+  }
+  at::vec256::fmadd(Vec::loadu(a.data()), Vec::loadu(b.data()), Vec::loadu(c.data()))
+      .store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_NEAR(out[i], a[i] * b[i] + c[i], 1e-5) << "fmadd, lane " << i;
+  }
+  // blendv selects by the sign bit of the mask lanes
+  const auto mask = iota<T>(N, -1, 1);
+  Vec::blendv(Vec::loadu(a.data()), Vec::loadu(b.data()), Vec::loadu(mask.data()))
+      .store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], std::signbit(mask[i]) ? b[i] : a[i]) << "blendv, lane " << i;
+  }
+}
+
+} // namespace
+
+void check_float() {
+  check_floating<float>();
+}
+
+void check_double() {
+  check_floating<double>();
+}
+
+void check_int() {
+  check_common<int64_t>(-40, 1000);
+  check_common<int32_t>(-40, 1000);
+  check_common<int16_t>(-40, 100);
+
+  constexpr int64_t N = Vec256<int32_t>::size();
+  const auto u8 = iota<uint8_t>(N, 200, 3);
+  const auto i8 = iota<int8_t>(N, -100, 9);
+  int32_t out[N];
+  at::vec256::convert_to_int32<uint8_t>(u8.data()).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], u8[i]) << "convert_to_int32<uint8_t>, lane " << i;
+  }
+  at::vec256::convert_to_int32<int8_t>(i8.data()).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], i8[i]) << "convert_to_int32<int8_t>, lane " << i;
+  }
+}
+
+void check_bfloat16() {
+  using at::BFloat16;
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  constexpr int64_t N = bVec::size();
+  ASSERT_EQ(N, 2 * fVec::size());
+  std::vector<float> values(N);
+  for (int64_t i = 0; i < N; ++i) {
+    values[i] = (i - 13) * 1.37f;
+  }
+  values[3] = std::numeric_limits<float>::quiet_NaN();
+  values[5] = std::numeric_limits<float>::infinity();
+  std::vector<BFloat16> bvalues(values.begin(), values.end());
+
+  fVec lo, hi;
+  std::tie(lo, hi) = at::vec256::convert_bfloat16_float(bVec::loadu(bvalues.data()));
+  float fout[N];
+  lo.store(fout);
+  hi.store(fout + fVec::size());
+  for (int64_t i = 0; i < N; ++i) {
+    const float expected = static_cast<float>(bvalues[i]);
+    if (std::isnan(expected)) {
+      ASSERT_TRUE(std::isnan(fout[i])) << "bfloat16 to float, lane " << i;
+    } else {
+      ASSERT_EQ(fout[i], expected) << "bfloat16 to float, lane " << i;
+    }
+  }
+
+  // float to bfloat16 rounds to nearest even, like the scalar conversion
+  BFloat16 bout[N];
+  at::vec256::convert_float_bfloat16(
+      fVec::loadu(values.data()), fVec::loadu(values.data() + fVec::size()))
+      .store(bout);
+  for (int64_t i = 0; i < N; ++i) {
+    if (std::isnan(values[i])) {
+      ASSERT_TRUE(std::isnan(static_cast<float>(bout[i])))
+          << "float to bfloat16, lane " << i;
+    } else {
+      ASSERT_EQ(bout[i].x, BFloat16(values[i]).x) << "float to bfloat16, lane " << i;
+    }
+  }
+
+  // the array conversions handle lengths that are not a multiple of N
+  const int64_t n = 3 * N + 5;
+  std::vector<float> src(n);
+  for (int64_t i = 0; i < n; ++i) {
+    src[i] = std::sin(static_cast<float>(i)) * 100;
+  }
+  std::vector<BFloat16> bdst(n);
+  std::vector<float> fdst(n);
+  at::vec256::convert(src.data(), bdst.data(), n);
+  at::vec256::convert(bdst.data(), fdst.data(), n);
+  for (int64_t i = 0; i < n; ++i) {
+    ASSERT_EQ(bdst[i].x, BFloat16(src[i]).x) << "convert to bfloat16, " << i;
+    ASSERT_EQ(fdst[i], static_cast<float>(bdst[i])) << "convert to float, " << i;
+  }
+}
+
+namespace {
+
+template <typename T>
+typename T::underlying quantize_ref(float value, float inverse_scale, int32_t zero_point) {
+  using underlying = typename T::underlying;
+  const float q = zero_point + std::nearbyint(value * inverse_scale);
+  return static_cast<underlying>(std::min<float>(
+      std::max<float>(q, std::numeric_limits<underlying>::min()),
+      std::numeric_limits<underlying>::max()));
+}
+
+template <typename T>
+void check_quantized(int32_t zero_point) {
+  using qVec = Vec256<T>;
+  using fVec = Vec256<float>;
+  using underlying = typename T::underlying;
+  constexpr int64_t N = qVec::size();
+  ASSERT_EQ(N, 64);
+  const float scale = 0.25f;
+  const float inverse_scale = 1.0f / scale;
+
+  std::vector<float> values(N);
+  for (int64_t i = 0; i < N; ++i) {
+    // covers both clamps and the halfway cases
+    values[i] = (i - N / 2) * 1.125f + (i % 3 ? 0.0f : 0.125f);
+  }
+  values[0] = -1e6f;
+  values[1] = 1e6f;
+  typename qVec::float_vec_return_type float_vecs;
+  for (int i = 0; i < qVec::float_num_vecs(); ++i) {
+    float_vecs[i] = fVec::loadu(values.data() + i * fVec::size());
+  }
+  underlying qout[N];
+  qVec::quantize(float_vecs, scale, zero_point, inverse_scale).store(qout);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(qout[i], quantize_ref<T>(values[i], inverse_scale, zero_point))
+        << "quantize, lane " << i;
+  }
+
+  const auto dequantized = qVec::loadu(qout).dequantize(
+      fVec(scale), fVec(zero_point), fVec(-zero_point * scale));
+  for (int i = 0; i < qVec::float_num_vecs(); ++i) {
+    float fout[fVec::size()];
+    dequantized[i].store(fout);
+    for (int64_t j = 0; j < fVec::size(); ++j) {
+      const int64_t k = i * fVec::size() + j;
+      ASSERT_EQ(fout[j], (qout[k] - zero_point) * scale) << "dequantize, lane " << k;
+    }
+  }
+
+  // the partial store writes only the first count values
+  underlying partial[N];
+  std::fill(partial, partial + N, underlying(7));
+  qVec::loadu(qout).store(partial, 5);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(partial[i], i < 5 ? qout[i] : underlying(7)) << "partial store, lane " << i;
+  }
+
+  std::vector<int32_t> ints(N);
+  for (int64_t i = 0; i < N; ++i) {
+    ints[i] = (i - N / 2) * 1001 + (i % 2 ? 500 : 0);
+  }
+  typename qVec::int_vec_return_type int_vecs;
+  for (int i = 0; i < qVec::int_num_vecs(); ++i) {
+    int_vecs[i] = Vec256<c10::qint32>::loadu(ints.data() + i * Vec256<c10::qint32>::size());
+  }
+  const float multiplier = 0.01f;
+  qVec::requantize_from_int(int_vecs, multiplier, zero_point).store(qout);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(qout[i], quantize_ref<T>(ints[i], multiplier, zero_point))
+        << "requantize, lane " << i;
+  }
+}
+
+} // namespace
+
+void check_qint() {
+  check_quantized<c10::quint8>(0);
+  check_quantized<c10::quint8>(130);
+  check_quantized<c10::qint8>(0);
+  check_quantized<c10::qint8>(-20);
+}
+
+namespace {
+
+template <typename T>
+void check_complex_type() {
+  using Vec = Vec256<c10::complex<T>>;
+  // the AVX2 specializations, not the generic Vec256 of the same width
+  static_assert(
+      std::is_convertible<Vec, __m256>::value || std::is_convertible<Vec, __m256d>::value,
+      "expected the AVX2 specialization");
+  constexpr int64_t N = Vec::size();
+  ASSERT_EQ(N * sizeof(c10::complex<T>), 32);
+  std::vector<c10::complex<T>> a(N), b(N);
+  for (int64_t i = 0; i < N; ++i) {
+    a[i] = c10::complex<T>(i - 1.5, 2 * i + 0.25);
+    b[i] = c10::complex<T>(0.5 * i + 1, -i);
+  }
+  c10::complex<T> out[N];
+  (Vec::loadu(a.data()) + Vec::loadu(b.data())).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_EQ(out[i], a[i] + b[i]) << "add, lane " << i;
+  }
+  (Vec::loadu(a.data()) * Vec::loadu(b.data())).store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_NEAR(out[i].real(), (a[i] * b[i]).real(), 1e-5) << "mul, lane " << i;
+    ASSERT_NEAR(out[i].imag(), (a[i] * b[i]).imag(), 1e-5) << "mul, lane " << i;
+  }
+  Vec::loadu(a.data()).abs().store(out);
+  for (int64_t i = 0; i < N; ++i) {
+    ASSERT_NEAR(out[i].real(), std::abs(a[i]), 1e-5) << "abs, lane " << i;
+  }
+}
+
+} // namespace
+
+// Complex numbers have no 512-bit specializations; the AVX512 kernels use
+// the AVX2 ones.
+void check_complex() {
+  check_complex_type<float>();
+  check_complex_type<double>();
+}
+
+#else
+
+void check_float() {}
+void check_double() {}
+void check_int() {}
+void check_bfloat16() {}
+void check_qint() {}
+void check_complex() {}
+
+#endif // CPU_CAPABILITY_AVX512
+
+} // namespace vec512_test
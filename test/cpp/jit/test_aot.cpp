@@ -0,0 +1,108 @@
+#include "test/cpp/jit/test_base.h"
+
+#include "torch/csrc/jit/codegen/aot/aot_compiler.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/tensorexpr_fuser.h"
+#include "torch/csrc/jit/testing/file_check.h"
+
+namespace torch {
+namespace jit {
+
+void testAotSourceGeneration() {
+  const auto graph_string = R"IR(
+    graph(%x : Tensor,
+          %w : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %two : int = prim::Constant[value=2]()
+      %three : int = prim::Constant[value=3]()
+      %none : NoneType = prim::Constant()
+      %y : Tensor = aten::add(%x, %w, %one)
+      %z : Tensor = aten::relu_(%y)
+      %s : int[] = prim::ListConstruct(%two, %three)
+      %v : Tensor = aten::view(%z, %s)
+      %o : Tensor = aten::zeros(%s, %none, %none, %none, %none)
+      return (%v, %o))IR";
+  auto g = std::make_shared<Graph>();
+  parseIR(graph_string, g.get());
+
+  auto unit = aot::generateAotSource(g);
+  ASSERT_EQ(unit.num_inputs, 2);
+  ASSERT_EQ(unit.num_outputs, 2);
+  ASSERT_EQ(unit.constants.size(), 0);
+  testing::FileCheck()
+      .check("at::add(")
+      ->check(".relu_()")
+      ->check("std::vector<int64_t>")
+      ->check(".view(")
+      ->check("at::zeros(")
+      ->check("at::TensorOptions()")
+      ->check("outputs[1]")
+      ->check("torch_aot_num_inputs")
+      ->check("torch_aot_run")
+      ->run(unit.source);
+
+  // Graphs must be frozen, i.e. take only tensors
+  const auto unfrozen_string = R"IR(
+    graph(%x : Tensor,
+          %n : int):
+      %y : Tensor = aten::mul(%x, %x)
+      return (%y))IR";
+  auto unfrozen = std::make_shared<Graph>();
+  parseIR(unfrozen_string, unfrozen.get());
+  ASSERT_THROWS_WITH(aot::generateAotSource(unfrozen), "Freeze");
+
+  // Control flow has no unboxed equivalent
+  const auto loop_string = R"IR(
+    graph(%x : Tensor):
+      %max : int = prim::Constant[value=3]()
+      %cond : bool = prim::Constant[value=1]()
+      %y : Tensor = prim::Loop(%max, %cond, %x)
+        block0(%i : int, %acc : Tensor):
+          %next : Tensor = aten::mul(%acc, %acc)
+          -> (%cond, %next)
+      return (%y))IR";
+  auto loop = std::make_shared<Graph>();
+  parseIR(loop_string, loop.get());
+  ASSERT_THROWS_WITH(aot::generateAotSource(loop), "control flow");
+}
+
+void testAotTensorExprGroup() {
+  const auto graph_string = R"IR(
+    graph(%x : Float(2:3, 3:1),
+          %y : Float(2:3, 3:1)):
+      %one : int = prim::Constant[value=1]()
+      %a : Float(2:3, 3:1) = aten::mul(%x, %y)
+      %b : Float(2:3, 3:1) = aten::add(%a, %x, %one)
+      return (%b))IR";
+  auto g = std::make_shared<Graph>();
+  parseIR(graph_string, g.get());
+  FuseTensorExprs(g);
+  testing::FileCheck().check("tensorexpr::Group")->run(*g);
+
+  // The ATen ops of the group are always emitted, and are the only path
+  // when the group cannot be compiled with LLVM.
+  auto unit = aot::generateAotSource(g);
+#ifdef TORCH_ENABLE_LLVM
+  ASSERT_EQ(unit.kernel_objects.size(), 1);
+  ASSERT_FALSE(unit.kernel_objects[0].empty());
+  testing::FileCheck()
+      .check("extern \"C\" int32_t aot_kernel_0(void** args);")
+      ->check("aot_matches(")
+      ->check("at::empty(")
+      ->check("aot_kernel_0(")
+      ->check("} else {")
+      ->check("at::mul(")
+      ->check("at::add(")
+      ->run(unit.source);
+#else
+  ASSERT_EQ(unit.kernel_objects.size(), 0);
+  testing::FileCheck()
+      .check_not("aot_kernel_0")
+      ->check("at::mul(")
+      ->check("at::add(")
+      ->run(unit.source);
+#endif
+}
+
+} // namespace jit
+} // namespace torch
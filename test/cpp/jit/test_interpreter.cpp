@@ -1,6 +1,10 @@
 #include "test/cpp/jit/test_base.h"
 #include "test/cpp/jit/test_utils.h"
 
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/runtime/instruction.h"
+#include "torch/csrc/jit/testing/file_check.h"
+
 namespace torch {
 namespace jit {
 
@@ -27,5 +31,65 @@ void testInterp() {
   ASSERT_TRUE(exactlyEqual(outputs[0], hx));
   ASSERT_TRUE(exactlyEqual(outputs[1], cx));
 }
+
+void testInterpSuperinstructions() {
+  const auto graph_string = R"IR(
+    graph(%x : Tensor,
+          %n : int):
+      %one : int = prim::Constant[value=1]()
+      %true : bool = prim::Constant[value=1]()
+      %y : Tensor = prim::Loop(%n, %true, %x)
+        block0(%i : int, %acc : Tensor):
+          %a : Tensor = aten::add(%acc, %x, %one)
+          %b : Tensor = aten::mul(%a, %a)
+          -> (%true, %b)
+      %z : Tensor = aten::relu(%y)
+      %w : Tensor = aten::add(%z, %x, %one)
+      return (%w))IR";
+  auto g = std::make_shared<Graph>();
+  parseIR(graph_string, g.get());
+
+  auto dumpAndRun = [&](bool superinstructions, Stack& stack) {
+    bool old_state = getInterpreterSuperinstructions();
+    getInterpreterSuperinstructions() = superinstructions;
+    Code code(g, "");
+    getInterpreterSuperinstructions() = old_state;
+    // superinstructions are never exposed, e.g. to the mobile export
+    for (const Instruction& inst : code.instructions()) {
+      ASSERT_TRUE(isOpSupportedInMobile(inst.op));
+    }
+    InterpreterState(code).run(stack);
+    std::stringstream ss;
+    ss << code;
+    return ss.str();
+  };
+
+  auto x = at::rand({4}) - 0.5;
+  Stack stack{x, 3};
+  auto fused_code = dumpAndRun(true, stack);
+  // aten::add pushes the constant last and stores its output
+  testing::FileCheck()
+      .check("LOADC_OP_STORE")
+      ->check("MOVE_OP")
+      ->check("JMP")
+      ->check("MOVE_OP")
+      ->check("LOADC_OP")
+      ->run(fused_code);
+  auto fused_out = pop(stack).toTensor();
+
+  stack = {x, 3};
+  auto code = dumpAndRun(false, stack);
+  testing::FileCheck().check_not("OP_STORE")->check_not("_OP ")->run(code);
+  auto out = pop(stack).toTensor();
+
+  auto expected = x;
+  for (int i = 0; i < 3; ++i) {
+    expected = (expected + x) * (expected + x);
+  }
+  expected = expected.relu() + x;
+  ASSERT_TRUE(almostEqual(fused_out, expected));
+  ASSERT_TRUE(exactlyEqual(fused_out, out));
+}
+
 } // namespace jit
 } // namespace torch
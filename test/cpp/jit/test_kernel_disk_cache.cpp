@@ -0,0 +1,88 @@
+#include "test/cpp/jit/test_base.h"
+
+#include "torch/csrc/jit/codegen/kernel_disk_cache.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+void testKernelDiskCache() {
+#ifndef _WIN32
+  std::string tmpl = "/tmp/pytorch_kernel_cacheXXXXXX";
+  std::vector<char> buf(tmpl.c_str(), tmpl.c_str() + tmpl.size() + 1);
+  ASSERT_TRUE(mkdtemp(buf.data()) != nullptr);
+  const std::string dir(buf.data());
+
+  auto& cache = KernelDiskCache::get();
+  const std::string prev_dir = cache.directory();
+  cache.setDirectory(dir);
+  cache.resetStats();
+  ASSERT_TRUE(cache.enabled());
+  ASSERT_EQ(cache.stats().loaded, 0);
+
+  // Miss, store, then hit
+  ASSERT_FALSE(cache.lookup("kernel_a", "so").has_value());
+  auto stored = cache.store("kernel_a", "so", std::string("\0\1\2", 3));
+  ASSERT_TRUE(stored.has_value());
+  auto found = cache.lookup("kernel_a", "so");
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(*found, *stored);
+  {
+    std::ifstream in(*found, std::ios::binary);
+    std::string contents(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(contents, std::string("\0\1\2", 3));
+  }
+
+  // Different keys and extensions do not alias
+  ASSERT_FALSE(cache.lookup("kernel_b", "so").has_value());
+  ASSERT_FALSE(cache.lookup("kernel_a", "o").has_value());
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.hits, 1);
+  ASSERT_EQ(stats.misses, 3);
+  ASSERT_EQ(stats.stores, 1);
+
+  // Looking up several keys counts a single hit or miss
+  found = cache.lookup(std::vector<std::string>{"kernel_b", "kernel_a"}, "so");
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(*found, *stored);
+  ASSERT_FALSE(
+      cache.lookup(std::vector<std::string>{"kernel_b", "kernel_c"}, "so")
+          .has_value());
+  stats = cache.stats();
+  ASSERT_EQ(stats.hits, 2);
+  ASSERT_EQ(stats.misses, 4);
+
+  // Reopening the directory loads the stored entry
+  cache.setDirectory(dir);
+  ASSERT_EQ(cache.stats().loaded, 1);
+  ASSERT_TRUE(cache.lookup("kernel_a", "so").has_value());
+
+  // Missing parent directories are created
+  const std::string nested = dir + "/a/b";
+  cache.setDirectory(nested);
+  ASSERT_TRUE(cache.enabled());
+  ASSERT_EQ(cache.directory(), nested);
+
+  cache.setDirectory(prev_dir);
+  cache.resetStats();
+  const std::string hash = kernelDiskCacheHash("kernel_a");
+  unlink((dir + "/" + hash + ".so").c_str());
+  unlink((dir + "/" + hash + ".key").c_str());
+  rmdir(nested.c_str());
+  rmdir((dir + "/a").c_str());
+  rmdir(dir.c_str());
+#endif
+}
+
+} // namespace jit
+} // namespace torch
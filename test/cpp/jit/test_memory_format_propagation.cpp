@@ -0,0 +1,84 @@
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/memory_format_propagation.h"
+
+namespace torch {
+namespace jit {
+
+void testPropagateChannelsLast() {
+#ifdef USE_XNNPACK
+  // %x reaches the first convolution in NCHW, and the result of the add is
+  // flattened, which needs contiguous input. Everything in between can stay
+  // channels-last: 2 conversions instead of the 4 the convolutions make.
+  const auto graph_string = R"IR(
+    graph(%x : Tensor,
+          %w : Tensor,
+          %b : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %minus_one : int = prim::Constant[value=-1]()
+      %none : NoneType = prim::Constant()
+      %ones : int[] = prim::ListConstruct(%one, %one)
+      %ctx : __torch__.torch.classes.xnnpack.Conv2dOpContext = prepacked::conv2d_clamp_prepack(%w, %b, %ones, %ones, %ones, %one, %none, %none)
+      %c1 : Tensor = prepacked::conv2d_clamp_run(%x, %ctx)
+      %r1 : Tensor = aten::relu(%c1)
+      %c2 : Tensor = prepacked::conv2d_clamp_run(%r1, %ctx)
+      %s : Tensor = aten::add(%c2, %r1, %one)
+      %n : int = aten::dim(%s)
+      %f : Tensor = aten::flatten(%s, %one, %minus_one)
+      return (%f))IR";
+  auto g = std::make_shared<Graph>();
+  parseIR(graph_string, g.get());
+  auto original = g->copy();
+  ASSERT_TRUE(PropagateChannelsLast(g));
+  g->lint();
+  size_t conversions = 0;
+  for (Node* n : g->nodes()) {
+    conversions += n->kind() == aten::contiguous;
+  }
+  ASSERT_EQ(conversions, 2);
+  testing::FileCheck()
+      .check("aten::contiguous")
+      ->check("prepacked::conv2d_clamp_run")
+      ->check("aten::relu")
+      ->check("prepacked::conv2d_clamp_run")
+      ->check("aten::add")
+      ->check("aten::contiguous")
+      ->check("aten::dim")
+      ->check("aten::flatten")
+      ->run(*g);
+
+  auto x = at::randn({1, 4, 8, 8});
+  auto w = at::randn({4, 4, 3, 3});
+  auto b = at::randn({4});
+  auto runGraph = [&](const std::shared_ptr<Graph>& graph) {
+    Code code(graph, "");
+    InterpreterState interp(code);
+    return run(interp, {x, w, b})[0];
+  };
+  auto result = runGraph(g);
+  ASSERT_TRUE(result.is_contiguous());
+  ASSERT_TRUE(almostEqual(result, runGraph(original)));
+
+  // a single convolution whose result is returned needs 2 conversions either
+  // way, so the graph is left alone
+  const auto single_conv_string = R"IR(
+    graph(%x : Tensor,
+          %w : Tensor,
+          %b : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %none : NoneType = prim::Constant()
+      %ones : int[] = prim::ListConstruct(%one, %one)
+      %ctx : __torch__.torch.classes.xnnpack.Conv2dOpContext = prepacked::conv2d_clamp_prepack(%w, %b, %ones, %ones, %ones, %one, %none, %none)
+      %c : Tensor = prepacked::conv2d_clamp_run(%x, %ctx)
+      %r : Tensor = aten::relu(%c)
+      return (%r))IR";
+  auto single_conv = std::make_shared<Graph>();
+  parseIR(single_conv_string, single_conv.get());
+  ASSERT_FALSE(PropagateChannelsLast(single_conv));
+#endif
+}
+
+} // namespace jit
+} // namespace torch
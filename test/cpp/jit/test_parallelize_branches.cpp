@@ -0,0 +1,95 @@
+#include "test/cpp/jit/test_base.h"
+#include "test/cpp/jit/test_utils.h"
+
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/passes/parallelize_branches.h"
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+std::vector<Node*> nodesOfKind(const std::shared_ptr<Graph>& g, Symbol kind) {
+  std::vector<Node*> result;
+  for (Node* n : g->nodes()) {
+    if (n->kind() == kind) {
+      result.push_back(n);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+void testParallelizeBranches() {
+  // Unprofiled ops on tensors of unknown size are estimated at 5us each, so
+  // the %a branch costs 15us and the %b branch 10us.
+  const auto graph_string = R"IR(
+    graph(%x : Tensor,
+          %y : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %a1 : Tensor = aten::relu(%x)
+      %b1 : Tensor = aten::relu(%y)
+      %a2 : Tensor = aten::sigmoid(%a1)
+      %b2 : Tensor = aten::add(%b1, %y, %one)
+      %a3 : Tensor = aten::tanh(%a2)
+      %c : Tensor = aten::add(%a3, %b2, %one)
+      return (%c))IR";
+  {
+    auto g = std::make_shared<Graph>();
+    parseIR(graph_string, g.get());
+    ASSERT_FALSE(ParallelizeBranches(g, /*min_branch_cost_us=*/20));
+    ASSERT_TRUE(nodesOfKind(g, prim::fork).empty());
+  }
+
+  auto g = std::make_shared<Graph>();
+  parseIR(graph_string, g.get());
+  auto original = g->copy();
+  ASSERT_TRUE(ParallelizeBranches(g, /*min_branch_cost_us=*/10));
+  g->lint();
+
+  // the cheaper branch is forked, the other one stays inline
+  auto forks = nodesOfKind(g, prim::fork);
+  ASSERT_EQ(forks.size(), 1);
+  auto subgraph = forks[0]->g(attr::Subgraph);
+  testing::FileCheck()
+      .check("aten::relu")
+      ->check("prim::Constant")
+      ->check("aten::add")
+      ->run(*subgraph);
+  ASSERT_EQ(nodesOfKind(g, aten::relu).size(), 1);
+  ASSERT_EQ(nodesOfKind(g, aten::tanh).size(), 1);
+  auto waits = nodesOfKind(g, aten::wait);
+  ASSERT_EQ(waits.size(), 1);
+  ASSERT_EQ(waits[0]->next()->kind(), aten::add);
+  // the fork is launched before the inline branch runs
+  ASSERT_TRUE(forks[0]->isBefore(nodesOfKind(g, aten::relu)[0]));
+
+  auto x = at::randn({4, 4});
+  auto y = at::randn({4, 4});
+  auto runGraph = [&](const std::shared_ptr<Graph>& graph) {
+    Code code(graph, "");
+    InterpreterState interp(code);
+    return run(interp, {x, y})[0];
+  };
+  ASSERT_TRUE(exactlyEqual(runGraph(g), runGraph(original)));
+
+  // a branch reading a value that is written in place can't be moved
+  const auto mutation_string = R"IR(
+    graph(%x : Tensor,
+          %y : Tensor):
+      %one : int = prim::Constant[value=1]()
+      %a1 : Tensor = aten::relu(%x)
+      %b1 : Tensor = aten::relu(%y)
+      %a2 : Tensor = aten::sigmoid(%a1)
+      %b2 : Tensor = aten::add(%b1, %y, %one)
+      %c : Tensor = aten::add(%a2, %b2, %one)
+      %d : Tensor = aten::add_(%y, %one, %one)
+      return (%c, %d))IR";
+  auto mutated = std::make_shared<Graph>();
+  parseIR(mutation_string, mutated.get());
+  ASSERT_FALSE(ParallelizeBranches(mutated, /*min_branch_cost_us=*/0));
+}
+
+} // namespace jit
+} // namespace torch
@@ -94,7 +94,13 @@ namespace jit {
   _(LiteInterpreterSetState)           \
   _(TorchbindIValueAPI)                \
   _(LiteInterpreterDict)               \
-  _(FusionAliasing)
+  _(FusionAliasing)                    \
+  _(KernelDiskCache)                   \
+  _(AotSourceGeneration)               \
+  _(AotTensorExprGroup)                \
+  _(InterpSuperinstructions)           \
+  _(ParallelizeBranches)               \
+  _(PropagateChannelsLast)
 
 #if defined(USE_CUDA)
 #define TH_FORALL_TESTS_CUDA(_)  \
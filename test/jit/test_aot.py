@@ -0,0 +1,62 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+import torch
+from torch.testing import FileCheck
+from torch.testing._internal.common_utils import IS_WINDOWS
+from torch.testing._internal.jit_utils import JitTestCase
+from torch.utils.cpp_extension import include_paths, library_paths
+
+if __name__ == '__main__':
+    raise RuntimeError("This test file is not meant to be run directly, use:\n\n"
+                       "\tpython test/test_jit.py TESTNAME\n\n"
+                       "instead.")
+
+@unittest.skipIf(IS_WINDOWS, "requires a C++ compiler on the PATH")
+class TestAot(JitTestCase):
+    def compile(self, graph):
+        tmp = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, tmp)
+        # the space and the quote check that the paths reach the compiler intact
+        so_path = os.path.join(tmp, "aot 'module'.so")
+        torch._C._jit_aot_compile(graph, so_path, include_paths(), library_paths())
+        return torch._C._AotModule(so_path)
+
+    def test_compile_and_run(self):
+        def fn(x, w):
+            y = torch.mm(x, w) + 1
+            return y.relu(), y.sum(0)
+
+        x = torch.randn(3, 4)
+        w = torch.randn(4, 5)
+        module = self.compile(torch.jit.script(fn).graph)
+        self.assertEqual(module.num_inputs, 2)
+        self.assertEqual(module.num_outputs, 2)
+        out = module.run([x, w])
+        self.assertEqual(len(out), 2)
+        self.assertEqual(out[0], fn(x, w)[0])
+        self.assertEqual(out[1], fn(x, w)[1])
+
+    def test_compile_tensorexpr_group(self):
+        def fn(x, y):
+            return (x * y + x).relu()
+
+        x = torch.randn(4, 8)
+        y = torch.randn(4, 8)
+        graph = torch.jit.script(fn).graph.copy()
+        torch._C._jit_pass_complete_shape_analysis(graph, (x, y), False)
+        torch._C._jit_pass_fuse_tensorexprs(graph)
+        FileCheck().check("tensorexpr::Group").run(graph)
+        module = self.compile(graph)
+
+        # matches the types the group was compiled for
+        self.assertEqual(module.run([x, y])[0], fn(x, y))
+        # strides differ from the compiled ones, so the ATen ops run instead
+        xt = torch.randn(8, 4).t()
+        self.assertEqual(module.run([xt, y])[0], fn(xt, y))
+        # as do shapes
+        x2 = torch.randn(2, 8)
+        y2 = torch.randn(2, 8)
+        self.assertEqual(module.run([x2, y2])[0], fn(x2, y2))
@@ -2209,6 +2209,58 @@ class TestQuantizeJitOps(QuantizationTestCase):
             FileCheck().check_not("aten::layer_norm") \
                        .run(m.graph)
 
+    def test_softmax(self):
+        class FunctionalSoftmax(torch.nn.Module):
+            def forward(self, input):
+                return torch.nn.functional.softmax(input, dim=-1)
+
+        modules = [torch.nn.Softmax(dim=1), FunctionalSoftmax()]
+        for tracing, m in itertools.product([True, False], modules):
+            m = self.checkGraphModeOp(m, self.img_data, "quantized::softmax", tracing)
+            FileCheck().check_not("aten::softmax") \
+                       .run(m.graph)
+
+        # quantized::softmax has no dtype argument, so softmax with an
+        # explicit dtype is left alone
+        for dtype, fused in [("%dtype : None = prim::Constant()", True),
+                             ("%dtype : int = prim::Constant[value=6]()", False)]:
+            graph = torch._C.parse_ir("""
+graph(%a_quant, %r_scale, %r_zero_point, %r_dtype):
+    %dim : int = prim::Constant[value=-1]()
+    {}
+    %a_dequant = aten::dequantize(%a_quant)
+    %r = aten::softmax(%a_dequant, %dim, %dtype)
+    %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+    return (%r_quant)""".format(dtype))
+            torch._C._jit_pass_quant_fusion(graph)
+            FileCheck().check_count("quantized::softmax", 1 if fused else 0, exactly=True) \
+                       .run(graph)
+            FileCheck().check_count("aten::softmax", 0 if fused else 1, exactly=True) \
+                       .run(graph)
+
+    def test_gelu(self):
+        class FunctionalGELU(torch.nn.Module):
+            def forward(self, input):
+                return torch.nn.functional.gelu(input)
+
+        for tracing, m in itertools.product([True, False], [torch.nn.GELU(), FunctionalGELU()]):
+            m = self.checkGraphModeOp(m, self.img_data, "quantized::gelu", tracing)
+            FileCheck().check_not("aten::gelu") \
+                       .run(m.graph)
+
+    def test_matmul(self):
+        class Matmul(torch.nn.Module):
+            def forward(self, x, y):
+                return torch.matmul(x, y.transpose(-1, -2))
+
+        data = [(torch.randn(1, 2, 5, 5, dtype=torch.float),
+                 torch.randn(1, 2, 5, 5, dtype=torch.float),
+                 torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
+        for tracing in [True, False]:
+            m = self.checkGraphModeOp(Matmul(), data, "quantized::matmul", tracing)
+            FileCheck().check_not("aten::matmul") \
+                       .run(m.graph)
+
     def test_group_norm(self):
         data = [(torch.rand((1, 4, 5, 5), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
         group_norm = torch.nn.GroupNorm(2, 4)
@@ -416,6 +416,100 @@ class TestQuantizedOps(TestCase):
                 self.assertTrue(pct_diff < 1e-6)
                 self.assertTrue(pct_diff_off_by_one < 0.01)
 
+    """Tests the correctness of the quantized::gelu op."""
+    def test_qgelu(self):
+        shapes = ((4,), (2, 3, 5), (2, 4, 3, 3))
+        dtypes = (torch.quint8, torch.qint8)
+        for shape, dtype in itertools.product(shapes, dtypes):
+            X = torch.randn(shape) * 3
+            qX = torch.quantize_per_tensor(X, scale=0.05, zero_point=0 if dtype == torch.qint8 else 128,
+                                           dtype=dtype)
+            output_scale, output_zero_point = 0.03, 10 if dtype == torch.quint8 else -20
+            qY = torch.ops.quantized.gelu(qX, output_scale, output_zero_point)
+            qY_hat = torch.quantize_per_tensor(F.gelu(qX.dequantize()), scale=output_scale,
+                                               zero_point=output_zero_point, dtype=dtype)
+            # The table is built with the scalar erf, which can differ in the
+            # last bit from the vectorized float kernel.
+            self.assertEqual(qY.dequantize(), qY_hat.dequantize(), atol=output_scale * 1.01, rtol=0)
+
+    """Tests the correctness of the quantized::softmax op."""
+    def test_qsoftmax(self):
+        shapes = ((7,), (2, 3, 16), (3, 1, 5, 5))
+        dtypes = (torch.quint8, torch.qint8)
+        for shape, dtype in itertools.product(shapes, dtypes):
+            X = torch.randn(shape) * 4
+            qX = torch.quantize_per_tensor(X, scale=0.04, zero_point=0 if dtype == torch.qint8 else 128,
+                                           dtype=dtype)
+            output_scale = 1.0 / 256
+            output_zero_point = 0 if dtype == torch.quint8 else -128
+            for dim in range(-len(shape), len(shape)):
+                qY = torch.ops.quantized.softmax(qX, dim, output_scale, output_zero_point)
+                Y_hat = F.softmax(qX.dequantize(), dim)
+                self.assertEqual(qY.q_scale(), output_scale)
+                self.assertEqual(qY.q_zero_point(), output_zero_point)
+                # The sum is accumulated in a different order than in the
+                # float kernel, so values on a bin boundary may round the
+                # other way.
+                self.assertEqual(qY.dequantize(), Y_hat, atol=output_scale * 1.01, rtol=0)
+
+    """Tests the correctness of the quantized::matmul op."""
+    def test_qmatmul(self):
+        cases = [((5, 7), (7, 3)),
+                 ((2, 4, 6), (2, 6, 5)),
+                 ((2, 3, 4, 8), (8, 4)),
+                 ((3, 1, 2, 4), (5, 4, 3)),
+                 ((3, 45), (45, 6))]
+        dtypes = (torch.quint8, torch.qint8)
+        for (a_shape, b_shape), dtype in itertools.product(cases, dtypes):
+            zero_point = 0 if dtype == torch.qint8 else 100
+            qA = torch.quantize_per_tensor(torch.randn(a_shape), scale=0.03, zero_point=zero_point,
+                                           dtype=dtype)
+            qB = torch.quantize_per_tensor(torch.randn(b_shape), scale=0.02, zero_point=zero_point + 3,
+                                           dtype=dtype)
+            output_scale, output_zero_point = 0.01, zero_point
+            qC = torch.ops.quantized.matmul(qA, qB, output_scale, output_zero_point)
+            C_hat = torch.matmul(qA.dequantize(), qB.dequantize())
+            qC_hat = torch.quantize_per_tensor(C_hat, scale=output_scale,
+                                               zero_point=output_zero_point, dtype=dtype)
+            self.assertEqual(qC.dequantize(), qC_hat.dequantize(), atol=output_scale * 1.01, rtol=0)
+
+        # sums of products over a long K exceed the int32 range
+        K = 40000
+        qA = torch.quantize_per_tensor(torch.full((2, K), 255.), scale=1.0, zero_point=0, dtype=torch.quint8)
+        qB = torch.quantize_per_tensor(torch.full((K, 3), 255.), scale=1.0, zero_point=0, dtype=torch.quint8)
+        qC = torch.ops.quantized.matmul(qA, qB, 2e7, 0)
+        self.assertEqual(qC.int_repr(), torch.full((2, 3), 130, dtype=torch.uint8))
+
+    """Tests the correctness of the quantized::embedding_bag op."""
+    def test_qembedding_bag(self):
+        num_embeddings, embedding_dim = 10, 12
+        weight = torch.randn(num_embeddings, embedding_dim)
+        qweights = [
+            torch.quantize_per_tensor(weight, scale=0.02, zero_point=128, dtype=torch.quint8),
+            torch.quantize_per_channel(weight, scales=torch.rand(num_embeddings).double() * 0.05 + 0.01,
+                                       zero_points=torch.randint(100, 150, (num_embeddings,)),
+                                       axis=0, dtype=torch.quint8),
+        ]
+        indices = torch.tensor([1, 2, 4, 5, 4, 3, 2, 9, 0])
+        offsets = torch.tensor([0, 3, 3, 7])
+        per_sample_weights = torch.rand(indices.numel())
+        output_scale, output_zero_point = 0.05, 128
+        modes = ['sum', 'mean', 'max']
+        for qweight, mode, include_last_offset in itertools.product(qweights, modes, (True, False)):
+            bag_offsets = torch.cat([offsets, torch.tensor([indices.numel()])]) \
+                if include_last_offset else offsets
+            for sample_weights in ([None, per_sample_weights] if mode == 'sum' else [None]):
+                qY = torch.ops.quantized.embedding_bag(
+                    qweight, indices, bag_offsets, output_scale, output_zero_point,
+                    mode=modes.index(mode), per_sample_weights=sample_weights,
+                    include_last_offset=include_last_offset)
+                Y_hat = F.embedding_bag(indices, qweight.dequantize(), bag_offsets, mode=mode,
+                                        per_sample_weights=sample_weights,
+                                        include_last_offset=include_last_offset)
+                qY_hat = torch.quantize_per_tensor(Y_hat, scale=output_scale,
+                                                   zero_point=output_zero_point, dtype=torch.quint8)
+                self.assertEqual(qY.dequantize(), qY_hat.dequantize(), atol=output_scale * 1.01, rtol=0)
+
 
     """Tests the correctness of the quantized::qnnpack_tanh op."""
     @given(X=hu.tensor(shapes=hu.array_shapes(1, 5, 1, 5),
@@ -2367,6 +2461,65 @@ class TestDynamicQuantizedRNNOp(TestCase):
                 result_dynamic = qfn_dict[rnn_type](Xq.dequantize()[0], state[rnn_type], packed_ih, packed_hh, b1, b2)
                 self.assertEqual(result_ref[0], result_dynamic[0], msg="torch.quantized_rnncell results are off")
 
+    @override_qengines
+    def test_qlstmGRU_multi_step(self):
+        # The dynamic quantized LSTM and GRU quantize the input of all time steps
+        # at once, and the hidden state at every step. Model that with
+        # linear_dynamic, over padded and packed sequences.
+        seq_len, num_batches, input_size, hidden_size = 5, 3, 16, 8
+        lengths = [5, 3, 2]
+        for rnn_type, per_channel_quant in itertools.product(['LSTM', 'GRU'], [False, True]):
+            Xq, Hq, Cq = self._get_rnn_inputs(seq_len, num_batches, input_size, hidden_size, 1)
+            Wq1, Wq2, b1, b2 = self._get_rnn_weights_and_bias(input_size, hidden_size, 1,
+                                                              per_channel_quant, rnn_type)
+            b1 = torch.randn_like(b1)
+            b2 = torch.randn_like(b2)
+            packed_ih = torch.ops.quantized.linear_prepack(Wq1, b1)
+            packed_hh = torch.ops.quantized.linear_prepack(Wq2, b2)
+            cell_params = torch.ops.quantized.make_quantized_cell_params_dynamic(packed_ih, packed_hh, b1, b2, True)
+            X, H, C = Xq.dequantize(), Hq.dequantize(), Cq.dequantize()
+
+            for packed in (False, True):
+                steps = lengths if packed else [seq_len] * num_batches
+                batch_sizes = [sum(1 for n in steps if n > t) for t in range(seq_len)]
+                data = torch.cat([X[t, :batch_sizes[t]] for t in range(seq_len)])
+                igates = torch.ops.quantized.linear_dynamic(data, packed_ih, True)
+                h, c = H[0].clone(), C[0].clone()
+                outputs = []
+                offset = 0
+                for b in batch_sizes:
+                    ig = igates[offset:offset + b]
+                    offset += b
+                    hg = torch.ops.quantized.linear_dynamic(h[:b], packed_hh, True)
+                    if rnn_type == 'LSTM':
+                        i, f, g, o = (ig + hg).chunk(4, 1)
+                        c[:b] = f.sigmoid() * c[:b] + i.sigmoid() * g.tanh()
+                        h[:b] = o.sigmoid() * c[:b].tanh()
+                    else:
+                        ir, iz, in_ = ig.chunk(3, 1)
+                        hr, hz, hn = hg.chunk(3, 1)
+                        n = (in_ + (ir + hr).sigmoid() * hn).tanh()
+                        h[:b] = n + (iz + hz).sigmoid() * (h[:b] - n)
+                    outputs.append(h[:b].clone())
+                output_ref = torch.cat(outputs)
+
+                if rnn_type == 'LSTM':
+                    if packed:
+                        result = torch.quantized_lstm(data, torch.tensor(batch_sizes), (H, C), [cell_params], True,
+                                                      1, 0, False, False, dtype=torch.qint8, use_dynamic=True)
+                    else:
+                        result = torch.quantized_lstm(X, (H, C), [cell_params], True, 1, 0, False, False, False,
+                                                      dtype=torch.qint8, use_dynamic=True)
+                    self.assertEqual(result[2][0], c, atol=1e-4, rtol=0)
+                else:
+                    if packed:
+                        result = torch.quantized_gru(data, torch.tensor(batch_sizes), H, [cell_params], True,
+                                                     1, 0, False, False)
+                    else:
+                        result = torch.quantized_gru(X, H, [cell_params], True, 1, 0, False, False, False)
+                self.assertEqual(result[0].reshape(-1, hidden_size), output_ref, atol=1e-4, rtol=0)
+                self.assertEqual(result[1][0], h, atol=1e-4, rtol=0)
+
     @skipIfNoFBGEMM
     @given(
         batch_size=st.integers(1, 4),
@@ -51,6 +51,7 @@ TESTS = [
     'test_vulkan',
     'test_quantization',
     'test_sparse',
+    'test_sparse_csr',
     'test_serialization',
     'test_show_pickle',
     'test_torch',
@@ -4141,6 +4141,116 @@ class TestNN(NNTestCase):
                          torch.cat([m1.bias.grad.data, m2.bias.grad.data], 0),
                          atol=dtype2prec_DONTUSE[torch.float], rtol=0)
 
+    def test_conv_direct_cpu(self):
+        # Without grad, CPU convolutions that MKL-DNN and NNPACK don't take run
+        # without unfolding the input; compare with the unfold + GEMM path,
+        # which runs when grad is needed.
+        configs = [
+            # dim, in_channels, out_channels, kernel_size, stride, padding, dilation, groups, input size
+            (1, 3, 5, 3, 1, 1, 1, 1, (2, 3, 17)),
+            (2, 4, 6, 3, 1, 0, 1, 1, (2, 4, 9, 11)),
+            (2, 4, 12, (3, 2), (2, 1), (1, 2), (2, 3), 2, (1, 4, 13, 14)),
+            (2, 6, 6, 3, 1, 1, 1, 6, (1, 6, 10, 10)),
+            (2, 3, 17, 1, 1, 0, 1, 1, (3, 3, 5, 19)),
+            (3, 4, 8, 3, 1, 1, 1, 2, (2, 4, 5, 6, 7)),
+            (3, 2, 9, (2, 3, 1), (1, 2, 1), (0, 1, 1), (2, 1, 1), 1, (1, 2, 6, 9, 10)),
+        ]
+        modules = {1: nn.Conv1d, 2: nn.Conv2d, 3: nn.Conv3d}
+        with torch.backends.mkldnn.flags(enabled=False):
+            for config, bias, dtype in product(configs, (True, False), (torch.float, torch.double)):
+                dim, in_channels, out_channels, kernel_size, stride, padding, dilation, groups, size = config
+                m = modules[dim](in_channels, out_channels, kernel_size, stride=stride, padding=padding,
+                                 dilation=dilation, groups=groups, bias=bias).to(dtype)
+                input = torch.randn(size, dtype=dtype)
+                expected = m(input)
+                with torch.no_grad():
+                    output = m(input)
+                self.assertEqual(output, expected)
+
+            # a non-contiguous bias
+            weight = torch.randn(6, 2, 3, 3)
+            bias = torch.randn(12)[::2]
+            input = torch.randn(1, 4, 8, 8)
+            expected = F.conv2d(input, weight.requires_grad_(), bias, groups=2)
+            with torch.no_grad():
+                self.assertEqual(F.conv2d(input, weight, bias, groups=2), expected)
+
+    def test_bfloat16_accumulate_in_float_cpu(self):
+        # bfloat16 kernels accumulate in float, so they match the float ops on
+        # the same (bfloat16) values up to the final rounding, even for long
+        # reductions where bfloat16 partial sums would lose every increment
+        def check(fn, *inputs):
+            inputs_bf16 = [i.detach().bfloat16().requires_grad_(i.requires_grad) for i in inputs]
+            inputs_float = [i.float().detach().requires_grad_(i.requires_grad) for i in inputs_bf16]
+            out_bf16 = fn(*inputs_bf16)
+            out_float = fn(*inputs_float)
+            self.assertEqual(out_bf16.dtype, torch.bfloat16)
+            self.assertEqual(out_bf16.float(), out_float, atol=1e-2, rtol=1e-2)
+            if out_bf16.requires_grad:
+                grad = torch.randn_like(out_float).bfloat16()
+                out_bf16.backward(grad)
+                out_float.backward(grad.float())
+                for i_bf16, i_float in zip(inputs_bf16, inputs_float):
+                    if i_bf16.requires_grad:
+                        self.assertEqual(i_bf16.grad.float(), i_float.grad, atol=2e-2, rtol=2e-2)
+
+        self.assertEqual(torch.ones(10000, dtype=torch.bfloat16).sum().float(),
+                         torch.tensor(10000.).bfloat16().float())
+        check(lambda x: x.sum(1), torch.randn(7, 3000))
+        check(lambda x: x.sum(0), torch.randn(3000, 7))
+        check(lambda x: x.mean(), torch.randn(5000))
+
+        for dim_size in (1, 20, 300):
+            x = torch.randn(6, dim_size, requires_grad=True)
+            check(lambda x: F.softmax(x, -1), x)
+            check(lambda x: F.log_softmax(x, -1), x)
+            check(lambda x: F.softmax(x, 0), x)
+
+        x = torch.randn(4, 9, 70, requires_grad=True)
+        weight = torch.randn(70, requires_grad=True)
+        bias = torch.randn(70, requires_grad=True)
+        check(lambda x, w, b: F.layer_norm(x, (70,), w, b), x, weight, bias)
+        check(lambda x: F.layer_norm(x, (9, 70)), x)
+        _, mean, rstd = torch.native_layer_norm(x.bfloat16(), None, None, 36, 70, 1e-5)
+        self.assertEqual(mean.dtype, torch.float)
+        self.assertEqual(rstd.dtype, torch.float)
+
+        a, b = torch.randn(5, 1000), torch.randn(1000, 6)
+        check(torch.mm, a, b)
+        check(lambda c, a, b: torch.addmm(c, a, b), torch.randn(5, 6), a, b)
+        check(torch.mv, a, torch.randn(1000))
+        check(torch.bmm, torch.randn(3, 4, 500), torch.randn(3, 500, 2))
+
+    def test_linear_packed_weight_cpu(self):
+        # linear with a prepacked weight matches the BLAS path, and repacks
+        # the weight after it is modified in place
+        # input size, out_features
+        configs = [((1, 7), 5), ((3, 16), 16), ((5, 33), 40), ((2, 4, 9), 17), ((6,), 3), ((0, 4), 8)]
+        for (size, out_features), bias, dtype in product(configs, (True, False), (torch.float, torch.bfloat16)):
+            m = nn.Linear(size[-1], out_features, bias=bias).to(dtype)
+            input = torch.randn(size, dtype=dtype)
+            with torch.no_grad():
+                expected = m(input)
+                with torch.backends.packed_linear.flags(enabled=True):
+                    output = m(input)
+                    self.assertEqual(output.dtype, dtype)
+                    self.assertEqual(output, expected, atol=0.05 if dtype == torch.bfloat16 else 1e-5, rtol=0.02)
+
+                    m.weight.mul_(2)
+                    expected = F.linear(input.float(), m.weight.float(),
+                                        m.bias.float() if bias else None).to(dtype)
+                    self.assertEqual(m(input), expected, atol=0.1 if dtype == torch.bfloat16 else 1e-5, rtol=0.02)
+
+            # the packed path is for inference only
+            with torch.backends.packed_linear.flags(enabled=True):
+                output = m(input.float().requires_grad_().to(dtype))
+                self.assertTrue(output.requires_grad)
+
+        # no input features
+        input, weight, bias = torch.randn(3, 0), torch.randn(4, 0), torch.randn(4)
+        with torch.no_grad(), torch.backends.packed_linear.flags(enabled=True):
+            self.assertEqual(F.linear(input, weight, bias), bias.expand(3, 4))
+
     # Very similar to test_Conv2d_naive_groups but with special care to handle
     # the number of groups == number of input channels
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
@@ -5513,6 +5623,37 @@ class TestNN(NNTestCase):
             self.assertEqual(output1, output2)
             self.assertEqual(hidden1, hidden2)
 
+    def test_rnn_fused_cpu(self):
+        # Without grad, LSTM and GRU run in a fused engine on CPU; compare it
+        # against the per-step cells, which run when grad is needed.
+        input_size = 5
+        hidden_size = 7
+        seq_length = 6
+        batch = 4
+        lengths = [6, 5, 5, 2]
+        for module, bias, num_layers, bidirectional, batch_first, dtype in product(
+                (nn.LSTM, nn.GRU), (True, False), (1, 2), (False, True), (False, True),
+                (torch.float, torch.double)):
+            rnn = module(input_size, hidden_size, num_layers, bias=bias, bidirectional=bidirectional,
+                         batch_first=batch_first).to(dtype)
+            num_directions = 2 if bidirectional else 1
+            input = torch.randn(seq_length, batch, input_size, dtype=dtype)
+            if batch_first:
+                input = input.transpose(0, 1).contiguous()
+            hx = torch.randn(num_layers * num_directions, batch, hidden_size, dtype=dtype)
+            if module is nn.LSTM:
+                hx = (hx, torch.randn_like(hx))
+            packed = rnn_utils.pack_padded_sequence(input, lengths, batch_first=batch_first)
+
+            for inp in (input, packed):
+                expected_output, expected_hy = rnn(inp, hx)
+                with torch.no_grad():
+                    output, hy = rnn(inp, hx)
+                if isinstance(inp, rnn_utils.PackedSequence):
+                    expected_output, output = expected_output.data, output.data
+                self.assertEqual(output, expected_output)
+                self.assertEqual(hy, expected_hy)
+
     def _test_RNN_cpu_vs_cudnn(self, dropout, dtype=torch.double):
 
         def forward_backward(cuda, rnn, input_val, hx_val, grad_output, grad_hy, weights_val):
@@ -10859,6 +11000,22 @@ class TestNNDeviceType(NNTestCase):
             with torch.backends.cudnn.flags(enabled=False):
                 self._test_batchnorm_simple_average(device, dtype)
 
+    @dtypes(torch.float, torch.double)
+    def test_batchnorm_stats_layouts(self, device, dtype):
+        # The batch statistics are computed in a single pass over the input,
+        # check them against var_mean for inputs far from zero mean and in
+        # both memory formats.
+        x = torch.randn(4, 5, 37, 29, device=device, dtype=dtype) * 3 + 1000
+        for input in (x, x.contiguous(memory_format=torch.channels_last)):
+            running_mean = torch.zeros(5, device=device, dtype=dtype)
+            running_var = torch.ones(5, device=device, dtype=dtype)
+            output = F.batch_norm(input, running_mean, running_var, training=True, momentum=1.0)
+            var, mean = torch.var_mean(x.transpose(0, 1).reshape(5, -1), 1, unbiased=False)
+            self.assertEqual(running_mean, mean)
+            self.assertEqual(running_var, var * x[:, 0].numel() / (x[:, 0].numel() - 1))
+            expected = (x - mean.view(1, 5, 1, 1)) / (var.view(1, 5, 1, 1) + 1e-5).sqrt()
+            self.assertEqual(output, expected, atol=1e-3, rtol=0)
+
     def _test_maxpool_indices(self, num_dim, adaptive=False, device="cpu", dtype=torch.float):
         def expected_indices(dim):
             if dim == 1:
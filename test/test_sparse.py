@@ -199,6 +199,35 @@ class TestSparse(TestCase):
             t, _, _ = self._gen_sparse(len(sparse_size), nnz, sparse_size + dense_size)
             self.safeCoalesce(t)  # this tests correctness
 
+    def test_coalesce_large(self):
+        def check(t):
+            c = t.coalesce()
+            self.assertTrue(c.is_coalesced())
+            # expected: the values of every distinct index summed up
+            keys = t._indices()[0] * t.size(1) + t._indices()[1]
+            unique_keys, inverse = torch.unique(keys, sorted=True, return_inverse=True)
+            expected_values = torch.zeros((unique_keys.numel(),) + t._values().shape[1:],
+                                          dtype=t.dtype, device=self.device)
+            expected_values.index_add_(0, inverse, t._values())
+            self.assertEqual(c._indices()[0] * c.size(1) + c._indices()[1], unique_keys)
+            self.assertEqual(c._values(), expected_values)
+
+        # enough elements to take the parallel paths, with indices that span
+        # few bits (radix sort) and many bits (hash aggregation)
+        nnz = 100000
+        for size, dense_size in itertools.product([[30, 40], [1 << 20, 1 << 20]], [[], [3]]):
+            i = torch.stack([torch.randint(s, (nnz,), device=self.device) for s in size])
+            v = torch.randn([nnz] + dense_size, dtype=self.value_dtype, device=self.device)
+            check(self.sparse_tensor(i, v, size + dense_size))
+
+            # sorted indices with duplicates
+            keys, _ = (i[0] * size[1] + i[1]).sort()
+            sorted_i = torch.stack([keys // size[1], keys % size[1]])
+            t = self.sparse_tensor(sorted_i, v, size + dense_size)
+            check(t)
+            # adding two such tensors keeps the indices sorted
+            check(t + t)
+
     def test_ctor_size_checks(self):
         indices = self.index_tensor([
             [0, 0, 0],
@@ -923,6 +952,37 @@ class TestSparse(TestCase):
         test_shape(10, 100, 0, 0)
         test_shape(10, 100, 0, 20)
 
+    @cpu_only
+    def test_sparse_sparse_mm(self):
+        def test_shape(di, dj, dk, nnz1, nnz2):
+            x, _, _ = self._gen_sparse(2, nnz1, [di, dj])
+            y, _, _ = self._gen_sparse(2, nnz2, [dj, dk])
+            expected = torch.mm(self.safeToDense(x), self.safeToDense(y))
+
+            res = torch.mm(x, y)
+            self.assertTrue(res.is_sparse)
+            self.assertTrue(res.is_coalesced())
+            self.assertEqual(res.to_dense(), expected)
+            self.assertEqual(torch.sparse.mm(x, y).to_dense(), expected)
+
+            out = self.sparse_empty(0)
+            torch.mm(x, y, out=out)
+            self.assertEqual(out.to_dense(), expected)
+
+        test_shape(10, 20, 30, 20, 40)
+        test_shape(100, 1000, 200, 300, 300)
+        # many columns, accumulated in hash maps
+        test_shape(50, 100, 100000, 300, 3000)
+        # enough work to be split among threads
+        test_shape(300, 300, 300, 5000, 5000)
+        test_shape(0, 100, 100, 0, 20)
+        test_shape(10, 0, 100, 0, 0)
+        test_shape(10, 100, 0, 20, 0)
+
+        x, _, _ = self._gen_sparse(2, 20, [10, 20])
+        with self.assertRaisesRegex(RuntimeError, "Expected dim 0 size"):
+            torch.mm(x, x)
+
     @unittest.skipIf(
         IS_WINDOWS and TEST_CUDA,
         "bmm sparse-dense CUDA is not yet supported in Windows, at least up to CUDA 10.1"
@@ -1703,6 +1763,23 @@ class TestSparse(TestCase):
             y, _, _ = self._gen_sparse(2, 20, [10, 100])
             res = x.mv(y)
 
+    def test_sparse_add_mul_large(self):
+        # enough elements for the merge of the indices to be split among threads
+        nnz = 100000
+        size = [1000, 1000]
+        for dense_size in [[], [3]]:
+            def gen():
+                i = torch.stack([torch.randint(d, (nnz,), device=self.device) for d in size])
+                v = torch.randn([nnz] + dense_size, dtype=self.value_dtype, device=self.device)
+                return self.sparse_tensor(i, v, size + dense_size)
+            x, y = gen(), gen()
+            dense_x, dense_y = x.to_dense(), y.to_dense()
+            for a, b in [(x, y), (x.coalesce(), y.coalesce())]:
+                self.assertEqual((a + b).to_dense(), dense_x + dense_y)
+                self.assertEqual(a.add(b, alpha=2).to_dense(), dense_x + 2 * dense_y)
+                self.assertEqual((a * b).to_dense(), dense_x * dense_y)
+            self.assertTrue((x.coalesce() + y.coalesce()).is_coalesced())
+
     def test_sparse_add_coalesce(self):
         i = self.index_tensor([[1, 2, 1]])
         v = self.value_tensor([3, 4, 5])
@@ -0,0 +1,195 @@
+import torch
+
+import itertools
+from torch.testing._internal.common_utils import TestCase, run_tests, load_tests
+
+# load_tests from torch.testing._internal.common_utils is used to automatically filter tests for
+# sharding on sandcastle. This line silences flake warnings
+load_tests = load_tests
+
+
+class TestSparseCSR(TestCase):
+
+    def _random_dense(self, rows, cols, density, dtype=torch.double):
+        dense = torch.randn(rows, cols).to(dtype)
+        return dense * (torch.rand(rows, cols) < density).to(dtype)
+
+    def test_csr_layout(self):
+        self.assertEqual(str(torch.sparse_csr), 'torch.sparse_csr')
+        self.assertEqual(type(torch.sparse_csr), torch.layout)
+
+    def test_sparse_csr_constructor(self):
+        crow_indices = [0, 1, 3]
+        col_indices = [2, 0, 2]
+        values = [3., 4., 5.]
+        for size in [(2, 4), None]:
+            if size is None:
+                x = torch.sparse_csr_tensor(crow_indices, col_indices, values)
+                expected_size = (2, 3)
+            else:
+                x = torch.sparse_csr_tensor(crow_indices, col_indices, values, size)
+                expected_size = size
+            self.assertTrue(x.is_sparse_csr)
+            self.assertFalse(x.is_sparse)
+            self.assertEqual(x.layout, torch.sparse_csr)
+            self.assertEqual(x.shape, expected_size)
+            self.assertEqual(x._nnz(), 3)
+            self.assertEqual(x.dtype, torch.get_default_dtype())
+            self.assertEqual(x.crow_indices(), torch.tensor(crow_indices))
+            self.assertEqual(x.col_indices(), torch.tensor(col_indices))
+            self.assertEqual(x.values(), torch.tensor(values))
+
+        x = torch.sparse_csr_tensor(crow_indices, col_indices, values, (2, 3), dtype=torch.int32)
+        self.assertEqual(x.dtype, torch.int32)
+        self.assertEqual(x.values().dtype, torch.int32)
+        self.assertEqual(x.to_dense(), torch.tensor([[0, 0, 3], [4, 0, 5]], dtype=torch.int32))
+
+    def test_sparse_csr_constructor_errors(self):
+        # wrong number of row offsets
+        with self.assertRaisesRegex(RuntimeError, "crow_indices must have"):
+            torch.sparse_csr_tensor([0, 1, 3], [2, 0, 2], [3., 4., 5.], (3, 3))
+        # offsets must end with nnz
+        with self.assertRaisesRegex(RuntimeError, "must be nnz"):
+            torch.sparse_csr_tensor([0, 1, 2], [2, 0, 2], [3., 4., 5.], (2, 3))
+        # offsets must be non-decreasing
+        with self.assertRaisesRegex(RuntimeError, "non-decreasing"):
+            torch.sparse_csr_tensor([0, 2, 1, 3], [2, 0, 2], [3., 4., 5.], (3, 3))
+        # column out of bounds
+        with self.assertRaisesRegex(RuntimeError, "inconsistent with col_indices"):
+            torch.sparse_csr_tensor([0, 1, 3], [2, 0, 3], [3., 4., 5.], (2, 3))
+        with self.assertRaisesRegex(RuntimeError, "negative column index"):
+            torch.sparse_csr_tensor([0, 1, 3], [2, -1, 2], [3., 4., 5.], (2, 3))
+        with self.assertRaisesRegex(RuntimeError, "same nnz"):
+            torch.sparse_csr_tensor([0, 1, 3], [2, 0], [3., 4., 5.], (2, 3))
+
+    def test_conversions(self):
+        for rows, cols, density in [(0, 0, 0.5), (5, 0, 0.5), (1, 7, 0.5), (10, 20, 0.0),
+                                    (10, 20, 0.3), (50, 30, 1.0)]:
+            dense = self._random_dense(rows, cols, density)
+            csr = dense.to_sparse_csr()
+            self.assertTrue(csr.is_sparse_csr)
+            self.assertEqual(csr.shape, dense.shape)
+            self.assertEqual(csr._nnz(), int((dense != 0).sum()))
+            self.assertEqual(csr.to_dense(), dense)
+
+            coo = dense.to_sparse()
+            self.assertEqual(coo.to_sparse_csr().to_dense(), dense)
+            self.assertEqual(csr.to_sparse().to_dense(), dense)
+            self.assertEqual(csr.to_sparse_csr().to_dense(), dense)
+
+        # an uncoalesced COO matrix is coalesced first
+        coo = torch.sparse_coo_tensor([[1, 0, 1], [2, 1, 2]], [1., 2., 3.], (2, 3))
+        self.assertEqual(coo.to_sparse_csr().to_dense(), coo.to_dense())
+
+    def test_repr(self):
+        x = torch.sparse_csr_tensor([0, 1, 3], [2, 0, 2], [3., 4., 5.], (2, 3))
+        self.assertExpectedInline(str(x), '''\
+tensor(crow_indices=tensor([0, 1, 3]),
+       col_indices=tensor([2, 0, 2]),
+       values=tensor([3., 4., 5.]),
+       size=(2, 3), nnz=3, layout=torch.sparse_csr)''')
+
+    def test_mm(self):
+        for (rows, inner, cols), density, dtype in itertools.product(
+                [(0, 5, 3), (5, 0, 3), (7, 9, 0), (10, 20, 3), (33, 17, 65)],
+                [0.0, 0.2, 1.0],
+                [torch.float, torch.double, torch.long]):
+            dense_a = self._random_dense(rows, inner, density, dtype)
+            b = torch.randn(inner, cols).to(dtype)
+            a = dense_a.to_sparse_csr()
+            self.assertEqual(torch.mm(a, b), torch.mm(dense_a, b))
+            self.assertEqual(a.mm(b), torch.mm(dense_a, b))
+            # a non-contiguous dense operand
+            b_t = torch.randn(cols, inner).to(dtype).t()
+            self.assertEqual(torch.mm(a, b_t), torch.mm(dense_a, b_t))
+
+            out = torch.empty(0, dtype=dtype)
+            torch.mm(a, b, out=out)
+            self.assertEqual(out, torch.mm(dense_a, b))
+
+    def test_addmm(self):
+        dense_a = self._random_dense(30, 40, 0.1)
+        a = dense_a.to_sparse_csr()
+        b = torch.randn(40, 25)
+        c = torch.randn(30, 25)
+        for beta, alpha in [(1, 1), (0, 1), (0.5, 2), (2, 0)]:
+            expected = torch.addmm(c, dense_a, b, beta=beta, alpha=alpha)
+            self.assertEqual(torch.addmm(c, a, b, beta=beta, alpha=alpha), expected)
+            out = torch.empty(0)
+            torch.addmm(c, a, b, beta=beta, alpha=alpha, out=out)
+            self.assertEqual(out, expected)
+            # non-contiguous out
+            out = torch.empty(25, 30).t()
+            torch.addmm(c, a, b, beta=beta, alpha=alpha, out=out)
+            self.assertEqual(out, expected)
+
+        # self broadcasts
+        bias = torch.randn(25)
+        self.assertEqual(torch.addmm(bias, a, b), torch.addmm(bias, dense_a, b))
+
+        # matches the COO path
+        self.assertEqual(torch.addmm(c, a, b), torch.addmm(c, dense_a.to_sparse(), b))
+
+        with self.assertRaisesRegex(RuntimeError, "Expected dim 0 size"):
+            torch.addmm(c, a, torch.randn(30, 25))
+
+    def test_sparse_sparse_mm(self):
+        for (rows, inner, cols), density in itertools.product(
+                [(0, 5, 3), (5, 0, 3), (7, 9, 0), (10, 20, 30), (200, 100, 300)],
+                [0.0, 0.05, 1.0]):
+            for dtype in [torch.float, torch.double, torch.long]:
+                dense_a = self._random_dense(rows, inner, density, dtype)
+                dense_b = self._random_dense(inner, cols, density, dtype)
+                a = dense_a.to_sparse_csr()
+                b = dense_b.to_sparse_csr()
+                res = torch.mm(a, b)
+                self.assertTrue(res.is_sparse_csr)
+                self.assertEqual(res.to_dense(), torch.mm(dense_a, dense_b))
+                # the column indices are sorted in every row
+                self.assertEqual(res.to_sparse().coalesce().indices()[1], res.col_indices())
+
+                out = torch.sparse_csr_tensor([0], [], [], (0, 0), dtype=dtype)
+                torch.mm(a, b, out=out)
+                self.assertEqual(out.to_dense(), torch.mm(dense_a, dense_b))
+
+        with self.assertRaisesRegex(RuntimeError, "Expected dim 0 size"):
+            torch.mm(torch.eye(3).to_sparse_csr(), torch.eye(4).to_sparse_csr())
+
+    def test_mv(self):
+        for rows, cols, density in [(0, 5, 0.5), (5, 0, 0.5), (10, 20, 0.0), (10, 20, 0.3), (64, 33, 1.0)]:
+            for dtype in [torch.float, torch.double, torch.long]:
+                dense_a = self._random_dense(rows, cols, density, dtype)
+                v = torch.randn(cols).to(dtype)
+                a = dense_a.to_sparse_csr()
+                self.assertEqual(torch.mv(a, v), torch.mv(dense_a, v))
+                self.assertEqual(a.mv(v), torch.mv(dense_a, v))
+
+        with self.assertRaisesRegex(RuntimeError, "mv: expected self.size"):
+            torch.mv(torch.eye(3).to_sparse_csr(), torch.randn(4))
+
+    def test_unchecked_col_indices(self):
+        # the unsafe constructor skips the index checks, so the kernels check
+        # the column indices before using them
+        crow_indices = torch.tensor([0, 1, 3])
+        values = torch.tensor([3., 4., 5.])
+        for col_indices in [torch.tensor([2, 0, 3]), torch.tensor([2, -1, 2])]:
+            a = torch._sparse_csr_tensor_unsafe(crow_indices, col_indices, values, (2, 3))
+            with self.assertRaisesRegex(RuntimeError, "index out of column bound"):
+                torch.mv(a, torch.randn(3))
+            with self.assertRaisesRegex(RuntimeError, "index out of column bound"):
+                torch.mm(a, torch.randn(3, 4))
+            with self.assertRaisesRegex(RuntimeError, "index out of column bound"):
+                torch.mm(a, torch.eye(3).to_sparse_csr())
+
+    def test_large_parallel(self):
+        # enough rows to be split among threads
+        dense_a = self._random_dense(2000, 300, 0.05, torch.float)
+        a = dense_a.to_sparse_csr()
+        b = torch.randn(300, 64)
+        v = torch.randn(300)
+        self.assertEqual(torch.mm(a, b), torch.mm(dense_a, b), atol=1e-4, rtol=1e-5)
+        self.assertEqual(torch.mv(a, v), torch.mv(dense_a, v), atol=1e-4, rtol=1e-5)
+
+
+if __name__ == '__main__':
+    run_tests()
@@ -2450,6 +2450,36 @@ class AbstractTestCases:
                         dest2[idx[i]] += src[i]
                     self.assertEqual(dest, dest2)
 
+        def test_index_accumulate_parallel_deterministic(self):
+            # index_put_ with accumulate=True and index_add_ are parallel on
+            # large inputs, and should give the same result as with one thread.
+            num_threads = torch.get_num_threads()
+            for dtype in (torch.float, torch.double, torch.long, torch.half, torch.bool):
+                for num_dest in (1, 7, 1000):
+                    idx = torch.randint(num_dest, (100000,))
+                    if dtype.is_floating_point:
+                        src = torch.randn(100000).to(dtype)
+                    else:
+                        src = torch.randint(0, 3, (100000,)).to(dtype)
+                    src2d = torch.randn(100000, 3)
+
+                    def run():
+                        put = torch.zeros(num_dest, dtype=dtype).index_put_((idx,), src, accumulate=True)
+                        added = torch.zeros(num_dest, 3).index_add_(0, idx, src2d)
+                        if dtype in (torch.half, torch.bool):
+                            return put, added
+                        return put, added, torch.zeros(num_dest, dtype=dtype).index_add_(0, idx, src)
+
+                    try:
+                        torch.set_num_threads(1)
+                        expected = run()
+                    finally:
+                        torch.set_num_threads(num_threads)
+                    for _ in range(3):
+                        actual = run()
+                        for a, e in zip(actual, expected):
+                            self.assertTrue(torch.equal(a, e))
+
         # add coverage for issue with atomic add that appeared only for
         # specific dtypes on cuda:
         # https://github.com/pytorch/pytorch/issues/29153
@@ -2765,6 +2795,78 @@ class AbstractTestCases:
         def test_scatterFill(self):
             self._test_scatter_base(self, lambda t: t, 'scatter_', True)
 
+        def test_scatter_reduce(self):
+            def reference(base, index, src, reduce):
+                # Reduces along dim 0, one column at a time.
+                result = base.clone()
+                for j in range(index.size(1)):
+                    for d in index[:, j].unique().tolist():
+                        vals = src[:index.size(0), j][index[:, j] == d]
+                        if reduce == "sum":
+                            result[d, j] += vals.sum()
+                        elif reduce == "prod":
+                            result[d, j] *= vals.prod()
+                        elif reduce == "max":
+                            result[d, j] = torch.max(result[d, j], vals.max())
+                        elif reduce == "min":
+                            result[d, j] = torch.min(result[d, j], vals.min())
+                        else:
+                            total = result[d, j] + vals.sum()
+                            if base.dtype.is_floating_point:
+                                result[d, j] = total / (vals.numel() + 1)
+                            else:
+                                result[d, j] = total // (vals.numel() + 1)
+                return result
+
+            def make(size, dtype):
+                if dtype.is_floating_point:
+                    return torch.rand(size, dtype=dtype) + 0.5
+                # +-1, so that products do not overflow
+                return torch.randint(0, 2, size, dtype=dtype) * 2 - 1
+
+            num_threads = torch.get_num_threads()
+            for dtype in (torch.float, torch.double, torch.int, torch.long):
+                # (num_dest, index) pairs: a small random index, an index that is
+                # expanded over the features as in graph networks, and a large
+                # 1-D index; the last two take the vectorized, parallel path.
+                cases = [(5, torch.randint(5, (12, 3))),
+                         (50, torch.randint(50, (20000, 1)).expand(20000, 8)),
+                         (100, torch.randint(100, (100000, 1)))]
+                for (num_dest, index), reduce in product(cases, ("sum", "prod", "mean", "max", "min")):
+                    base = make((num_dest, index.size(1)), dtype)
+                    src = make((index.size(0) + 1, index.size(1)), dtype)
+                    expected = reference(base, index, src, reduce)
+                    # float sums of many values depend on the order of the additions
+                    tol = dict(atol=1e-3, rtol=1e-3) if dtype == torch.float else {}
+                    if index.size(1) == 1:
+                        actual = base.view(-1).scatter_reduce(0, index.view(-1), src.view(-1), reduce).view(-1, 1)
+                    else:
+                        actual = base.scatter_reduce(0, index, src, reduce)
+                    self.assertEqual(actual, expected, **tol)
+                    self.assertEqual(torch.scatter_reduce(base.t().contiguous(), 1, index.t(), src.t(), reduce),
+                                     expected.t(), **tol)
+                    if reduce == "sum":
+                        self.assertEqual(base.scatter_add(0, index, src), expected, **tol)
+
+                    try:
+                        torch.set_num_threads(1)
+                        serial = base.scatter_reduce(0, index, src, reduce)
+                    finally:
+                        torch.set_num_threads(num_threads)
+                    self.assertTrue(torch.equal(base.scatter_reduce(0, index, src, reduce), serial))
+
+            nan = torch.tensor([0., float('nan'), 2.])
+            for reduce in ("max", "min"):
+                result = torch.zeros(1).scatter_reduce_(0, torch.zeros(3, dtype=torch.long), nan, reduce)
+                self.assertTrue(result.isnan().all())
+            with self.assertRaisesRegex(RuntimeError, "reduce argument must be one of"):
+                torch.zeros(3).scatter_reduce_(0, torch.zeros(3, dtype=torch.long), torch.ones(3), "median")
+            with self.assertRaisesRegex(RuntimeError, "out of bounds"):
+                torch.zeros(3).scatter_reduce_(0, torch.tensor([0, 3]), torch.ones(2), "max")
+            with self.assertRaisesRegex(RuntimeError, "not supported for complex"):
+                torch.zeros(3, dtype=torch.cfloat).scatter_reduce_(0, torch.zeros(3, dtype=torch.long),
+                                                                   torch.ones(3, dtype=torch.cfloat), "max")
+
         def test_masked_scatter(self):
             with warnings.catch_warnings(record=True) as w:
                 warnings.simplefilter("always")
@@ -7970,6 +8072,55 @@ class TestTorchDeviceType(TestCase):
         for upper, batchsize in product([True, False], [(3,), (3, 4), (2, 3, 4)]):
             cholesky_test_helper(3, batchsize, upper)
 
+    @skipCUDAIfNoMagma
+    @skipCPUIfNoLapack
+    @dtypes(torch.float, torch.double)
+    def test_linalg_small_matrices_batched(self, device, dtype):
+        # sizes around the threshold of the unrolled CPU kernels, in batches
+        # large enough to be split among threads
+        from torch.testing._internal.common_utils import \
+            (random_fullrank_matrix_distinct_singular_value, random_symmetric_pd_matrix)
+
+        atol = 1e-4 if dtype == torch.float else 1e-10
+        for n in range(1, 11):
+            batch = 257
+            eye = torch.eye(n, dtype=dtype, device=device).expand(batch, n, n)
+            A = random_fullrank_matrix_distinct_singular_value(n, batch, dtype=dtype).to(device)
+            b = torch.randn(batch, n, 3, dtype=dtype, device=device)
+
+            A_inverse = torch.inverse(A)
+            self.assertEqual(torch.matmul(A, A_inverse), eye, atol=atol, rtol=0)
+
+            x = torch.solve(b, A)[0]
+            self.assertEqual(torch.matmul(A, x), b, atol=atol, rtol=0)
+
+            LU_data, LU_pivots = torch.lu(A)
+            P, L, U = torch.lu_unpack(LU_data, LU_pivots)
+            self.assertEqual(torch.matmul(P, torch.matmul(L, U)), A, atol=atol, rtol=0)
+            self.assertEqual(torch.lu_solve(b, LU_data, LU_pivots), x, atol=atol, rtol=0)
+
+            self.assertEqual(torch.det(A), torch.stack([m.det() for m in A]), atol=atol, rtol=1e-5)
+
+            S = random_symmetric_pd_matrix(n, batch, dtype=dtype, device=device)
+            for upper in [True, False]:
+                C = torch.cholesky(S, upper=upper)
+                C_exp = torch.stack([m.cholesky(upper=upper) for m in S])
+                self.assertEqual(C, C_exp, atol=atol, rtol=0)
+
+            # a singular matrix in the middle of the batch is still reported
+            A_singular = A.clone()
+            A_singular[100].zero_()
+            with self.assertRaisesRegex(RuntimeError, r'For batch 100: U\(1,1\) is zero'):
+                torch.inverse(A_singular)
+
+        # empty systems don't reach the unrolled kernels
+        for batch in [(), (4,)]:
+            A = torch.randn(*batch, 0, 0, dtype=dtype, device=device)
+            b = torch.randn(*batch, 0, 2, dtype=dtype, device=device)
+            x, LU = torch.solve(b, A)
+            self.assertEqual(x.shape, b.shape)
+            self.assertEqual(LU.shape, A.shape)
+
     @skipCUDAIfNoMagma
     @skipCPUIfNoLapack
     @dtypes(torch.double)
@@ -11846,6 +11997,72 @@ class TestTorchDeviceType(TestCase):
                 'expected scalar_type Double but found Float'):
             torch.logcumsumexp(b, axis, out=inplace_out)
 
+    @onlyCPU
+    def test_cumulative_ops_layouts(self, device):
+        # Long rows are scanned in blocks by several threads, and scans along an
+        # outer dimension are vectorized over the adjacent rows. Compare both
+        # with scans of contiguous rows on a single thread.
+        def serial(op, x, dim):
+            num_threads = torch.get_num_threads()
+            try:
+                torch.set_num_threads(1)
+                result = op(x.transpose(dim, -1).contiguous(), -1)
+            finally:
+                torch.set_num_threads(num_threads)
+            if isinstance(result, tuple):
+                return tuple(r.transpose(dim, -1) for r in result)
+            return result.transpose(dim, -1)
+
+        inputs = [
+            (torch.randn(2 * 32768 * 3 + 5), 0),
+            (torch.randn(3, 2 * 32768 + 1), 1),
+            (torch.randn(70, 3, 130), 0),
+            (torch.randn(70, 3, 130), 1),
+            (torch.randn(130, 70).t(), 1),
+        ]
+        for x, dim in inputs:
+            for dtype in (torch.float, torch.double):
+                t = x.to(dtype)
+                tol = dict(atol=1e-2, rtol=1e-3) if dtype == torch.float else {}
+                self.assertEqual(t.cumsum(dim), serial(torch.cumsum, t, dim), **tol)
+                self.assertEqual(t.logcumsumexp(dim), serial(torch.logcumsumexp, t, dim), **tol)
+                p = 1 + t / 1000
+                self.assertEqual(p.cumprod(dim), serial(torch.cumprod, p, dim), **tol)
+
+            # Few distinct values, so that there are ties, and some NaNs.
+            t = (x * 2).round()
+            t[t == 3] = nan
+            for op in (torch.cummax, torch.cummin):
+                values, indices = op(t, dim)
+                expected_values, expected_indices = serial(op, t, dim)
+                self.assertEqual(values, expected_values)
+                self.assertTrue(torch.equal(indices, expected_indices))
+            i = x.mul(3).long()
+            self.assertTrue(torch.equal(i.cumsum(dim), serial(torch.cumsum, i, dim)))
+            self.assertTrue(torch.equal(i.cummax(dim)[1], serial(torch.cummax, i, dim)[1]))
+
+        x = torch.tensor([-inf, -inf, 0., inf, inf, nan, 1.])
+        self.assertEqual(x.logcumsumexp(0), torch.tensor([-inf, -inf, 0., inf, inf, nan, nan]))
+        self.assertEqual(x.view(-1, 1).expand(7, 20).logcumsumexp(0),
+                         torch.tensor([-inf, -inf, 0., inf, inf, nan, nan]).view(-1, 1).expand(7, 20))
+
+    @onlyCPU
+    def test_cumsum_long_rows_thread_count(self, device):
+        # Long rows are scanned in blocks of a fixed size whatever the number
+        # of threads, and the prefix sums of nonnegative values stay monotone
+        # across the blocks.
+        x = torch.rand(4 * 32768 + 7, dtype=torch.double)
+        x[::1000] *= 1e6
+        num_threads = torch.get_num_threads()
+        try:
+            torch.set_num_threads(1)
+            expected = x.cumsum(0)
+        finally:
+            torch.set_num_threads(num_threads)
+        result = x.cumsum(0)
+        self.assertTrue(torch.equal(result, expected))
+        self.assertTrue((result[1:] >= result[:-1]).all())
+
     def test_std_mean(self, device):
         x = torch.rand(100, 50, 20, device=device)
         for dim in range(x.dim()):
@@ -11901,6 +12118,73 @@ class TestTorchDeviceType(TestCase):
                         self.assertEqual(std1, std2)
                         self.assertEqual(mean1, mean2)
 
+    @onlyCPU
+    def test_var_mean_layouts(self, device):
+        # Long reductions are split into blocks combined in a fixed order, and
+        # contiguous inputs are reduced with vector accumulators. Compare with
+        # double precision, and the results on one and several threads.
+        def single_thread(op, *args, **kwargs):
+            num_threads = torch.get_num_threads()
+            try:
+                torch.set_num_threads(1)
+                return op(*args, **kwargs)
+            finally:
+                torch.set_num_threads(num_threads)
+
+        inputs = [
+            (torch.randn(2 * 32768 * 3 + 5) + 1000, None),
+            (torch.randn(3, 2 * 32768 + 1), 1),
+            (torch.randn(70, 3, 130), 2),
+            (torch.randn(70, 3, 130), 0),
+            (torch.randn(130, 70).t(), 1),
+        ]
+        for x, dim in inputs:
+            for dtype in (torch.half, torch.float, torch.double):
+                t = x.to(dtype)
+                dims = {} if dim is None else dict(dim=dim)
+                expected_var, expected_mean = torch.var_mean(t.double(), **dims)
+                var, mean = torch.var_mean(t, **dims)
+                tol = dict(atol=1e-2, rtol=1e-2) if dtype == torch.half else {}
+                self.assertEqual(var, expected_var.to(dtype), **tol)
+                self.assertEqual(mean, expected_mean.to(dtype), **tol)
+                self.assertEqual(t.std(**dims), expected_var.sqrt().to(dtype), **tol)
+                serial_var, serial_mean = single_thread(torch.var_mean, t, **dims)
+                self.assertTrue(torch.equal(var, serial_var))
+                self.assertTrue(torch.equal(mean, serial_mean))
+
+    @onlyCPU
+    @dtypes(torch.uint8, torch.int8, torch.int32, torch.int64, torch.float, torch.double)
+    def test_aminmax(self, device, dtype):
+        def make(*sizes):
+            t = torch.randint(0, 120, sizes, device=device).to(dtype)
+            if dtype.is_floating_point:
+                t = t - 60 + torch.randn(sizes, device=device, dtype=dtype)
+            return t
+
+        x = make(2 * 32768 + 7)
+        min, max = torch._aminmax(x)
+        self.assertEqual(min, x.min())
+        self.assertEqual(max, x.max())
+
+        x = make(70, 3, 130)
+        for t in (x, x.transpose(0, 2)):
+            for dim in range(t.dim()):
+                for keepdim in (False, True):
+                    min, max = torch._aminmax(t, dim, keepdim)
+                    self.assertEqual(min, t.min(dim, keepdim)[0])
+                    self.assertEqual(max, t.max(dim, keepdim)[0])
+
+        if dtype.is_floating_point:
+            x[1, 2, 100] = nan
+            min, max = torch._aminmax(x, 2)
+            self.assertTrue(min[1, 2].isnan() and max[1, 2].isnan())
+            self.assertEqual(min[0], x[0].min(1)[0])
+            min, max = torch._aminmax(x)
+            self.assertTrue(min.isnan() and max.isnan())
+
+        with self.assertRaisesRegex(RuntimeError, 'no elements'):
+            torch._aminmax(torch.empty(0, device=device, dtype=dtype))
+
     def test_zeros_like(self, device):
         expected = torch.zeros((100, 100,), device=device)
 
@@ -362,6 +362,28 @@ ${assign_return_values}c10::Dispatcher::singleton().redispatch<${ret_and_arg_typ
 """)
 
 
+# InplaceOrViewType templates
+INPLACE_OR_VIEW_DISPATCH_WITH_TMP_RETURN_VALUES = CodeTemplate("""\
+static auto op = c10::Dispatcher::singleton()
+    .findSchemaOrThrow("aten::${operator_name}", "${overload_name}")
+    .typed<${return_type} (${arg_types})>();
+auto tmp = ([&]() {
+  c10::impl::ExcludeDispatchKeyGuard guard(c10::DispatchKey::InplaceOrView);
+  return c10::Dispatcher::singleton().redispatch<${ret_and_arg_types}>(${inplace_or_view_dispatch_args});
+})();
+""")
+
+INPLACE_OR_VIEW_DISPATCH_WITHOUT_RETURN_VALUES = CodeTemplate("""\
+static auto op = c10::Dispatcher::singleton()
+    .findSchemaOrThrow("aten::${operator_name}", "${overload_name}")
+    .typed<${return_type} (${arg_types})>();
+{
+  c10::impl::ExcludeDispatchKeyGuard guard(c10::DispatchKey::InplaceOrView);
+  c10::Dispatcher::singleton().redispatch<${ret_and_arg_types}>(${inplace_or_view_dispatch_args});
+}
+""")
+
+
 FACTORY_FUNCTION_NAMES = None
 
 
@@ -614,6 +636,7 @@ def gen_variable_type_shard(out, aten_declarations, template_path, suffix, heade
     VARIABLE_TYPE_CPP = CodeTemplate.from_file(template_path + '/VariableType.cpp')
     PROFILED_TYPE_CPP = CodeTemplate.from_file(template_path + '/ProfiledType.cpp')
     TRACE_TYPE_CPP = CodeTemplate.from_file(template_path + '/TraceType.cpp')
+    INPLACE_OR_VIEW_TYPE_CPP = CodeTemplate.from_file(template_path + '/InplaceOrViewType.cpp')
 
     type_declarations = []
     type_definitions = []
@@ -622,6 +645,8 @@ def gen_variable_type_shard(out, aten_declarations, template_path, suffix, heade
     profiled_wrapper_registrations = []
     trace_method_definitions = []
     trace_wrapper_registrations = []
+    inplace_or_view_method_definitions = []
+    inplace_or_view_wrapper_registrations = []
 
     for declaration in aten_declarations:
         formal_types = [arg['type'] for arg in declaration['arguments']]
@@ -663,6 +688,20 @@ def gen_variable_type_shard(out, aten_declarations, template_path, suffix, heade
                 trace_wrapper_registrations.append(UNBOXEDONLY_WRAPPER_REGISTRATION.substitute(
                     declaration, class_type='TraceType'))
 
+        # Emit InplaceOrViewType code
+        if not declaration['manual_kernel_registration']:
+            inplace_or_view_body = emit_inplace_or_view_body(declaration)
+            if inplace_or_view_body is not None:
+                inplace_or_view_method_definitions.append(METHOD_DEFINITION.substitute(
+                    declaration, type_definition_body=inplace_or_view_body))
+
+                if declaration['use_c10_dispatcher'] == 'full':
+                    inplace_or_view_wrapper_registrations.append(WRAPPER_REGISTRATION.substitute(
+                        declaration, class_type='InplaceOrViewType'))
+                else:
+                    inplace_or_view_wrapper_registrations.append(UNBOXEDONLY_WRAPPER_REGISTRATION.substitute(
+                        declaration, class_type='InplaceOrViewType'))
+
     env = {
         'type_derived_method_declarations': type_declarations,
         'type_derived_method_definitions': type_definitions,
@@ -671,6 +710,8 @@ def gen_variable_type_shard(out, aten_declarations, template_path, suffix, heade
         'profiled_wrapper_registrations': profiled_wrapper_registrations,
         'trace_method_definitions': trace_method_definitions,
         'trace_wrapper_registrations': trace_wrapper_registrations,
+        'inplace_or_view_method_definitions': inplace_or_view_method_definitions,
+        'inplace_or_view_wrapper_registrations': inplace_or_view_wrapper_registrations,
     }
     if header:
         write(out, 'VariableType.h', VARIABLE_TYPE_H, env)
@@ -678,6 +719,7 @@ def gen_variable_type_shard(out, aten_declarations, template_path, suffix, heade
         write(out, 'VariableType%s.cpp' % suffix, VARIABLE_TYPE_CPP, env)
         write(out, 'ProfiledType%s.cpp' % suffix, PROFILED_TYPE_CPP, env)
         write(out, 'TraceType%s.cpp' % suffix, TRACE_TYPE_CPP, env)
+        write(out, 'InplaceOrViewType%s.cpp' % suffix, INPLACE_OR_VIEW_TYPE_CPP, env)
 
 
 def emit_profiled_body(declaration):
@@ -754,6 +796,59 @@ def emit_trace_body(declaration):
     return trace_body
 
 
+def emit_inplace_or_view_body(declaration):
+    """The InplaceOrView kernel of an op, or None if it doesn't need one.
+
+    In InferenceMode these run instead of the Autograd kernels, and only do
+    their version counter bookkeeping: in-place and out= ops bump the version
+    of the tensors they modify, and views share the version counter of their
+    base.  See c10/core/InferenceMode.h.
+    """
+    name = declaration['name']
+    arguments = declaration['arguments']
+    inplace = declaration['inplace']
+    is_out_fn = name.endswith('_out')
+    modifies_arguments = inplace or is_out_fn
+    returns_void = len(declaration['returns']) == 0
+
+    base_name = name[:-1] if inplace else name[:-4] if is_out_fn else name
+    view_info = VIEW_FUNCTIONS.get(base_name, None)
+
+    if modifies_arguments:
+        # Like VariableType, only bump the version of modified Tensors, not
+        # that of the elements of modified TensorLists
+        modified = [arg['name'] for arg in arguments if arg['type'] == 'Tensor &' and
+                    (arg['name'] == 'self' if inplace else arg.get('output', False))]
+        if not modified:
+            return None
+    elif view_info is None or len(declaration['returns']) != 1 or 'Tensor' not in declaration['return_type']:
+        return None
+
+    _, _, get_return_value = format_return_variables(declaration)
+
+    arg_types = ', '.join([a['type'] for a in arguments])
+    ret_and_arg_types = ', '.join([declaration['return_type']] + [a['type'] for a in arguments])
+    inplace_or_view_dispatch_args = ['op', 'c10::DispatchKey::InplaceOrView'] + declaration['args']
+
+    if modifies_arguments:
+        template = INPLACE_OR_VIEW_DISPATCH_WITHOUT_RETURN_VALUES
+    else:
+        template = INPLACE_OR_VIEW_DISPATCH_WITH_TMP_RETURN_VALUES
+    body = [template.substitute(
+        declaration,
+        arg_types=arg_types,
+        ret_and_arg_types=ret_and_arg_types,
+        inplace_or_view_dispatch_args=inplace_or_view_dispatch_args,
+    )]
+    if modifies_arguments:
+        body.extend('increment_version_if_tracked({});'.format(arg) for arg in modified)
+        if not returns_void:
+            body.append('return {};'.format(get_return_value))
+    else:
+        body.append('return share_version_counter({}, std::move(tmp));'.format(view_info))
+    return body
+
+
 def emit_body(declaration):
     strategy = dispatch_strategy(declaration)
 
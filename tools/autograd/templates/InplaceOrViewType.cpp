@@ -0,0 +1,30 @@
+#include "torch/csrc/autograd/VariableTypeUtils.h"
+
+#include <torch/library.h>
+
+// ${generated_comment}
+
+// See the InplaceOrView dispatch key in c10/core/DispatchKey.h.
+// NOTE See [Sharded File] comment in VariableType
+
+using namespace at;
+using namespace torch::autograd;
+
+namespace torch {
+
+namespace InplaceOrViewType {
+
+namespace {
+${inplace_or_view_method_definitions}
+}  // namespace
+}  // namespace InplaceOrViewType
+
+namespace {
+
+TORCH_LIBRARY_IMPL(aten, InplaceOrView, m) {
+  ${inplace_or_view_wrapper_registrations};
+}
+
+}  // namespace
+
+} // namespace torch
@@ -20,6 +20,11 @@ GENERATED_CPP = [
     "autograd/generated/TraceType_2.cpp",
     "autograd/generated/TraceType_3.cpp",
     "autograd/generated/TraceType_4.cpp",
+    "autograd/generated/InplaceOrViewType_0.cpp",
+    "autograd/generated/InplaceOrViewType_1.cpp",
+    "autograd/generated/InplaceOrViewType_2.cpp",
+    "autograd/generated/InplaceOrViewType_3.cpp",
+    "autograd/generated/InplaceOrViewType_4.cpp",
     "autograd/generated/python_functions.cpp",
     "autograd/generated/python_nn_functions.cpp",
     "autograd/generated/python_torch_functions.cpp",
@@ -46,6 +51,11 @@ libtorch_generated_sources = [
     ":generate-code[autograd/generated/TraceType_2.cpp]",
     ":generate-code[autograd/generated/TraceType_3.cpp]",
     ":generate-code[autograd/generated/TraceType_4.cpp]",
+    ":generate-code[autograd/generated/InplaceOrViewType_0.cpp]",
+    ":generate-code[autograd/generated/InplaceOrViewType_1.cpp]",
+    ":generate-code[autograd/generated/InplaceOrViewType_2.cpp]",
+    ":generate-code[autograd/generated/InplaceOrViewType_3.cpp]",
+    ":generate-code[autograd/generated/InplaceOrViewType_4.cpp]",
     "torch/csrc/autograd/VariableTypeManual.cpp",
 ]
 
@@ -99,12 +109,15 @@ libtorch_core_sources = [
     "torch/csrc/jit/api/module.cpp",
     "torch/csrc/jit/api/object.cpp",
     "torch/csrc/jit/backends/backend_interface.cpp",
+    "torch/csrc/jit/codegen/aot/aot_compiler.cpp",
+    "torch/csrc/jit/codegen/aot/aot_module.cpp",
     "torch/csrc/jit/codegen/fuser/codegen.cpp",
     "torch/csrc/jit/codegen/fuser/compiler.cpp",
     "torch/csrc/jit/codegen/fuser/executor.cpp",
     "torch/csrc/jit/codegen/fuser/fallback.cpp",
     "torch/csrc/jit/codegen/fuser/interface.cpp",
     "torch/csrc/jit/codegen/fuser/kernel_cache.cpp",
+    "torch/csrc/jit/codegen/kernel_disk_cache.cpp",
     "torch/csrc/jit/frontend/builtin_functions.cpp",
     "torch/csrc/jit/frontend/versioned_symbols.cpp",
     "torch/csrc/jit/frontend/canonicalize_modified_loop.cpp",
@@ -160,7 +173,9 @@ libtorch_core_sources = [
     "torch/csrc/jit/passes/loop_unrolling.cpp",
     "torch/csrc/jit/passes/lower_grad_of.cpp",
     "torch/csrc/jit/passes/lower_tuples.cpp",
+    "torch/csrc/jit/passes/memory_format_propagation.cpp",
     "torch/csrc/jit/passes/normalize_ops.cpp",
+    "torch/csrc/jit/passes/parallelize_branches.cpp",
     "torch/csrc/jit/passes/peephole_list_idioms.cpp",
     "torch/csrc/jit/passes/pass_manager.cpp",
     "torch/csrc/jit/passes/peephole.cpp",
@@ -193,6 +208,7 @@ libtorch_core_sources = [
     "torch/csrc/jit/runtime/interpreter.cpp",
     "torch/csrc/jit/runtime/jit_exception.cpp",
     "torch/csrc/jit/runtime/logging.cpp",
+    "torch/csrc/jit/runtime/op_timings.cpp",
     "torch/csrc/jit/runtime/operator.cpp",
     "torch/csrc/jit/runtime/print_handler.cpp",
     "torch/csrc/jit/runtime/profiling_graph_executor_impl.cpp",
@@ -525,6 +541,7 @@ def glob_libtorch_python_sources():
         "test/cpp/jit/torch_python_test.cpp",
         "test/cpp/tensorexpr/padded_buffer.cpp",
         "test/cpp/jit/test_alias_analysis.cpp",
+        "test/cpp/jit/test_aot.cpp",
         "test/cpp/jit/test_argument_spec.cpp",
         "test/cpp/jit/test_autodiff.cpp",
         "test/cpp/jit/test_base.cpp",
@@ -546,10 +563,13 @@ def glob_libtorch_python_sources():
         "test/cpp/jit/test_ir.cpp",
         "test/cpp/jit/test_irparser.cpp",
         "test/cpp/jit/test_jit_type.cpp",
+        "test/cpp/jit/test_kernel_disk_cache.cpp",
         "test/cpp/jit/test_lite_interpreter.cpp",
+        "test/cpp/jit/test_memory_format_propagation.cpp",
         "test/cpp/jit/test_misc.cpp",
         "test/cpp/jit/test_mobile_type_parser.cpp",
         "test/cpp/jit/test_module_api.cpp",
+        "test/cpp/jit/test_parallelize_branches.cpp",
         "test/cpp/jit/test_peephole_optimize.cpp",
         "test/cpp/jit/test_qualified_name.cpp",
         "test/cpp/jit/test_save_load.cpp",
@@ -444,6 +444,9 @@ def gen_pyi(declarations_path, out):
         'sparse_coo_tensor': ['def sparse_coo_tensor(indices: Tensor, values: Union[Tensor,List],'
                               ' size: Optional[_size]=None, *, dtype: Optional[_dtype]=None,'
                               ' device: Union[_device, str, None]=None, requires_grad:_bool=False) -> Tensor: ...'],
+        'sparse_csr_tensor': ['def sparse_csr_tensor(crow_indices: Union[Tensor,List], col_indices: Union[Tensor,List],'
+                              ' values: Union[Tensor,List], size: Optional[_size]=None, *, dtype: Optional[_dtype]=None,'
+                              ' device: Union[_device, str, None]=None, requires_grad:_bool=False) -> Tensor: ...'],
         'range': ['def range(start: Number, end: Number,'
                   ' step: Number=1, *, out: Optional[Tensor]=None, {}) -> Tensor: ...'
                   .format(FACTORY_PARAMS)],
@@ -553,6 +556,7 @@ def gen_pyi(declarations_path, out):
         'is_cuda': ['is_cuda: _bool'],
         'is_leaf': ['is_leaf: _bool'],
         'is_sparse': ['is_sparse: _bool'],
+        'is_sparse_csr': ['is_sparse_csr: _bool'],
         'is_quantized': ['is_quantized: _bool'],
         'is_meta': ['is_meta: _bool'],
         'is_mkldnn': ['is_mkldnn: _bool'],
@@ -490,6 +490,7 @@ import torch.backends.cuda
 import torch.backends.mkl
 import torch.backends.mkldnn
 import torch.backends.openmp
+import torch.backends.packed_linear
 import torch.backends.quantized
 import torch.quantization
 import torch.utils.data
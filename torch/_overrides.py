@@ -122,6 +122,7 @@ def get_ignored_functions():
         torch.randperm,
         torch.range,
         torch.sparse_coo_tensor,
+        torch.sparse_csr_tensor,
         torch.vander,
         torch.zeros,
         torch.nn.functional.assert_int_or_pair,
@@ -606,6 +607,7 @@ def get_testing_overrides():
         torch.scalar_tensor: lambda s, dtype=None, layour=None, device=None, pin_memory=None: -1,
         torch.scatter: lambda input, dim, index, src: -1,
         torch.scatter_add: lambda input, dim, index, src: -1,
+        torch.scatter_reduce: lambda input, dim, index, src, reduce: -1,
         torch.searchsorted: lambda sorted_sequence, input, out_int32=False, right=False, out=None: -1,
         torch.select: lambda input, dim, index: -1,
         torch.selu: lambda input, inplace=False: -1,
@@ -890,6 +890,28 @@ cross(other, dim=-1) -> Tensor
 See :func:`torch.cross`
 """)
 
+add_docstr_all('crow_indices',
+               r"""
+crow_indices() -> Tensor
+
+If :attr:`self` is a sparse CSR matrix (i.e., with ``torch.sparse_csr``
+layout), this returns a view of the contained row offsets tensor, of size
+``self.size(0) + 1``. Otherwise, this throws an error.
+
+See also :meth:`Tensor.col_indices` and :meth:`Tensor.values`.
+""")
+
+add_docstr_all('col_indices',
+               r"""
+col_indices() -> Tensor
+
+If :attr:`self` is a sparse CSR matrix (i.e., with ``torch.sparse_csr``
+layout), this returns a view of the contained column indices tensor.
+Otherwise, this throws an error.
+
+See also :meth:`Tensor.crow_indices` and :meth:`Tensor.values`.
+""")
+
 add_docstr_all('cuda',
                r"""
 cuda(device=None, non_blocking=False, memory_format=torch.preserve_format) -> Tensor
@@ -1387,15 +1409,15 @@ add_docstr_all('values',
                r"""
 values() -> Tensor
 
-If :attr:`self` is a sparse COO tensor (i.e., with ``torch.sparse_coo`` layout),
-this returns a view of the contained values tensor. Otherwise, this throws an
-error.
+If :attr:`self` is a sparse COO tensor (i.e., with ``torch.sparse_coo`` layout)
+or a sparse CSR matrix (i.e., with ``torch.sparse_csr`` layout), this returns a
+view of the contained values tensor. Otherwise, this throws an error.
 
 See also :meth:`Tensor.indices`.
 
 .. note::
-  This method can only be called on a coalesced sparse tensor. See
-  :meth:`Tensor.coalesce` for details.
+  For COO tensors, this method can only be called on a coalesced sparse tensor.
+  See :meth:`Tensor.coalesce` for details.
 """)
 
 add_docstr_all('gt',
@@ -2669,6 +2691,55 @@ Example::
 
 """)
 
+add_docstr_all('scatter_reduce_',
+               r"""
+scatter_reduce_(dim, index, src, reduce) -> Tensor
+
+Reduces all values from the tensor :attr:`src` into :attr:`self` at the indices
+specified in the :attr:`index` tensor, in the same fashion as
+:meth:`~torch.Tensor.scatter_add_`, with the reduction given by the
+:attr:`reduce` argument. For a 3-D tensor with ``reduce="prod"``, :attr:`self`
+is updated as::
+
+    self[index[i][j][k]][j][k] *= src[i][j][k]  # if dim == 0
+    self[i][index[i][j][k]][k] *= src[i][j][k]  # if dim == 1
+    self[i][j][index[i][j][k]] *= src[i][j][k]  # if dim == 2
+
+The values of :attr:`self` take part in the reduction; an element of
+:attr:`self` that no index refers to is left unchanged. ``reduce="mean"``
+averages every element of :attr:`self` with the values scattered to it,
+rounding down for integer tensors. ``"max"`` and ``"min"`` propagate NaN.
+
+On CPU, the values scattered to each element are reduced in the order of
+:attr:`index`, so that the result does not depend on the number of threads.
+
+:attr:`self`, :attr:`index` and :attr:`src` should have the same number of
+dimensions, with the size requirements of :meth:`~torch.Tensor.scatter_add_`.
+
+.. warning::
+    Only ``reduce="sum"`` is differentiable, and ``"max"`` and ``"min"`` are
+    not supported for complex tensors.
+
+Args:
+    dim (int): the axis along which to index
+    index (LongTensor): the indices of elements to scatter and reduce
+    src (Tensor): the source elements to scatter and reduce
+    reduce (str): the reduction to apply: ``"sum"``, ``"prod"``, ``"mean"``,
+      ``"max"`` or ``"min"``
+
+Example::
+
+    >>> src = torch.tensor([1., 2., 3., 4., 5., 6.])
+    >>> index = torch.tensor([0, 1, 0, 1, 2, 1])
+    >>> torch.zeros(3).scatter_reduce_(0, index, src, "max")
+    tensor([3., 6., 5.])
+    >>> torch.ones(3).scatter_reduce_(0, index, src, "prod")
+    tensor([ 3., 48.,  5.])
+    >>> torch.zeros(3).scatter_reduce_(0, index, src, "mean")
+    tensor([1.3333, 3.0000, 2.5000])
+
+""")
+
 add_docstr_all('select',
                r"""
 select(dim, index) -> Tensor
@@ -3234,6 +3305,23 @@ Example::
            size=(3, 3), nnz=1, layout=torch.sparse_coo)
 """)
 
+add_docstr_all('to_sparse_csr',
+               r"""
+to_sparse_csr() -> Tensor
+Returns a copy of the matrix in :ref:`compressed sparse row format <sparse-docs>`.
+:attr:`self` must be a 2-dimensional dense or sparse COO tensor; a sparse CSR
+matrix is returned as is.
+
+Example::
+
+    >>> d = torch.tensor([[0, 0, 0], [9, 0, 10], [0, 0, 0]])
+    >>> d.to_sparse_csr()
+    tensor(crow_indices=tensor([0, 0, 2, 2]),
+           col_indices=tensor([0, 2]),
+           values=tensor([ 9, 10]),
+           size=(3, 3), nnz=2, layout=torch.sparse_csr)
+""")
+
 add_docstr_all('to_mkldnn',
                r"""
 to_mkldnn() -> Tensor
@@ -3717,6 +3805,13 @@ scatter_add(dim, index, src) -> Tensor
 Out-of-place version of :meth:`torch.Tensor.scatter_add_`
 """)
 
+add_docstr_all('scatter_reduce',
+               r"""
+scatter_reduce(dim, index, src, reduce) -> Tensor
+
+Out-of-place version of :meth:`torch.Tensor.scatter_reduce_`
+""")
+
 add_docstr_all('masked_scatter',
                r"""
 masked_scatter(mask, tensor) -> Tensor
@@ -3816,6 +3911,11 @@ Is ``True`` if the Tensor is a meta tensor, ``False`` otherwise.  Meta tensors
 are like normal tensors, but they carry no data.
 """)
 
+add_docstr_all('is_sparse_csr',
+               r"""
+Is ``True`` if the Tensor is a sparse CSR matrix, ``False`` otherwise.
+""")
+
 add_docstr_all('device',
                r"""
 Is the :class:`torch.device` where this Tensor is.
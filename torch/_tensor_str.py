@@ -309,6 +309,22 @@ def _str_intern(self):
         if values.numel() == 0:
             values_str += ', size=' + str(tuple(values.shape))
         tensor_str = indices_prefix + indices_str + '),\n' + ' ' * indent + values_prefix + values_str + ')'
+    elif self.is_sparse_csr:
+        suffixes.append('size=' + str(tuple(self.shape)))
+        suffixes.append('nnz=' + str(self._nnz()))
+        if not has_default_dtype:
+            suffixes.append('dtype=' + str(self.dtype))
+        member_strs = []
+        for name, member in (('crow_indices', self.crow_indices()),
+                             ('col_indices', self.col_indices()),
+                             ('values', self.values())):
+            member_prefix = name + '=tensor('
+            member = member.detach()
+            member_str = _tensor_str(member, indent + len(member_prefix))
+            if member.numel() == 0:
+                member_str += ', size=' + str(tuple(member.shape))
+            member_strs.append(member_prefix + member_str + ')')
+        tensor_str = (',\n' + ' ' * indent).join(member_strs)
     elif self.is_quantized:
         suffixes.append('size=' + str(tuple(self.shape)))
         if not has_default_dtype:
@@ -364,7 +380,7 @@ def _str_intern(self):
     if self.has_names():
         suffixes.append('names={}'.format(self.names))
 
-    return _add_suffixes(prefix + tensor_str, suffixes, indent, force_newline=self.is_sparse)
+    return _add_suffixes(prefix + tensor_str, suffixes, indent, force_newline=self.is_sparse or self.is_sparse_csr)
 
 def _str(self):
     with torch.no_grad():
@@ -5639,6 +5639,54 @@ Example::
 .. _torch.sparse: https://pytorch.org/docs/stable/sparse.html
 """.format(**factory_common_args))
 
+add_docstr(torch.sparse_csr_tensor,
+           r"""
+sparse_csr_tensor(crow_indices, col_indices, values, size=None, dtype=None, device=None, requires_grad=False) -> Tensor
+
+Constructs a sparse matrix in compressed sparse row (CSR) format with the given
+:attr:`values` at the given columns of each row. The elements of row ``i`` are
+``values[crow_indices[i]:crow_indices[i + 1]]`` in columns
+``col_indices[crow_indices[i]:crow_indices[i + 1]]``. See `torch.sparse`_.
+Only CPU is supported, and autograd is not supported through the result.
+
+Args:
+    crow_indices (array_like): the offset of the first element of each row,
+        followed by the number of elements. Will be cast to a :class:`torch.LongTensor`
+        internally. Must start with 0 and be non-decreasing.
+    col_indices (array_like): the column of each element. Will be cast to a
+        :class:`torch.LongTensor` internally.
+    values (array_like): Initial values for the tensor. Can be a list, tuple,
+        NumPy ``ndarray``, scalar, and other types.
+    size (list, tuple, or :class:`torch.Size`, optional): Size of the matrix. If not
+        provided, the number of rows is ``len(crow_indices) - 1`` and the number of
+        columns is the minimum that holds all elements.
+    dtype (:class:`torch.dtype`, optional): the desired data type of returned tensor.
+        Default: if None, infers data type from :attr:`values`.
+    device (:class:`torch.device`, optional): the desired device of returned tensor.
+        Default: if None, uses the current device for the default tensor type
+        (see :func:`torch.set_default_tensor_type`).
+    {requires_grad}
+
+Example::
+
+    >>> crow = torch.tensor([0, 1, 3])
+    >>> col = torch.tensor([2, 0, 2])
+    >>> v = torch.tensor([3, 4, 5], dtype=torch.float32)
+    >>> torch.sparse_csr_tensor(crow, col, v, [2, 4])
+    tensor(crow_indices=tensor([0, 1, 3]),
+           col_indices=tensor([2, 0, 2]),
+           values=tensor([3., 4., 5.]),
+           size=(2, 4), nnz=3, layout=torch.sparse_csr)
+
+    >>> torch.sparse_csr_tensor(crow, col, v)  # Shape inference
+    tensor(crow_indices=tensor([0, 1, 3]),
+           col_indices=tensor([2, 0, 2]),
+           values=tensor([3., 4., 5.]),
+           size=(2, 3), nnz=3, layout=torch.sparse_csr)
+
+.. _torch.sparse: https://pytorch.org/docs/stable/sparse.html
+""".format(**factory_common_args))
+
 add_docstr(torch.sqrt,
            r"""
 sqrt(input, out=None) -> Tensor
@@ -0,0 +1,38 @@
+import sys
+import torch
+from contextlib import contextmanager
+from torch.backends import ContextProp, PropModule, __allow_nonbracketed_mutation
+
+def set_flags(_enabled):
+    orig_flags = (torch._C._get_packed_linear_enabled(),)
+    torch._C._set_packed_linear_enabled(_enabled)
+    return orig_flags
+
+@contextmanager
+def flags(enabled=False):
+    with __allow_nonbracketed_mutation():
+        orig_flags = set_flags(enabled)
+    try:
+        yield
+    finally:
+        with __allow_nonbracketed_mutation():
+            set_flags(orig_flags[0])
+
+def clear_cache():
+    r"""Frees the packed copies of the weights cached by linear."""
+    torch._C._packed_linear_clear_cache()
+
+class PackedLinearModule(PropModule):
+    r"""When enabled, eager-mode CPU linear on float and bfloat16 tensors packs
+    its weight once and caches the packed copy for later calls, as long as no
+    gradient is required. A cached copy is dropped when its weight is freed,
+    and repacked after the weight is modified in place (writes through
+    ``.data`` are not tracked). Disabling it clears the cache."""
+    def __init__(self, m, name):
+        super(PackedLinearModule, self).__init__(m, name)
+
+    enabled = ContextProp(torch._C._get_packed_linear_enabled, torch._C._set_packed_linear_enabled)
+
+# Cool stuff from torch/backends/cudnn/__init__.py and
+# https://stackoverflow.com/questions/2447353/getattr-on-a-module/7668273#7668273
+sys.modules[__name__] = PackedLinearModule(sys.modules[__name__], __name__)
@@ -16,6 +16,7 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Parallel.h>
 #include <ATen/Utils.h>
+#include <ATen/native/PackedLinear.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -412,6 +413,29 @@ PyObject *THPModule_userEnabledMkldnn(PyObject *_unused, PyObject *noargs)
   else Py_RETURN_FALSE;
 }
 
+PyObject *THPModule_setUserEnabledPackedLinear(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_enabled_packed_linear expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setUserEnabledPackedLinear(arg == Py_True);
+  if (arg != Py_True) {
+    at::native::packed_linear_clear_cache();
+  }
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_userEnabledPackedLinear(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().userEnabledPackedLinear()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+PyObject *THPModule_clearPackedLinearCache(PyObject *_unused, PyObject *noargs)
+{
+  at::native::packed_linear_clear_cache();
+  Py_RETURN_NONE;
+}
+
 PyObject *THPModule_setDeterministicCuDNN(PyObject *_unused, PyObject *arg)
 {
   THPUtils_assert(PyBool_Check(arg), "set_deterministic_cudnn expects a bool, "
@@ -547,6 +571,9 @@ static PyMethodDef TorchMethods[] = {
   {"_set_cudnn_enabled", (PyCFunction)THPModule_setUserEnabledCuDNN, METH_O,  nullptr},
   {"_get_mkldnn_enabled", (PyCFunction)THPModule_userEnabledMkldnn, METH_NOARGS,     nullptr},
   {"_set_mkldnn_enabled", (PyCFunction)THPModule_setUserEnabledMkldnn, METH_O,  nullptr},
+  {"_get_packed_linear_enabled", (PyCFunction)THPModule_userEnabledPackedLinear, METH_NOARGS,     nullptr},
+  {"_set_packed_linear_enabled", (PyCFunction)THPModule_setUserEnabledPackedLinear, METH_O,  nullptr},
+  {"_packed_linear_clear_cache", (PyCFunction)THPModule_clearPackedLinearCache, METH_NOARGS,     nullptr},
   {"_get_cudnn_benchmark", (PyCFunction)THPModule_benchmarkCuDNN, METH_NOARGS,     nullptr},
   {"_set_cudnn_benchmark", (PyCFunction)THPModule_setBenchmarkCuDNN, METH_O,  nullptr},
   {"_get_cudnn_deterministic", (PyCFunction)THPModule_deterministicCuDNN, METH_NOARGS,     nullptr},
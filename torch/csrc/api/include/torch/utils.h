@@ -4,6 +4,7 @@
 #include <ATen/record_function.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/api/include/torch/types.h>
+#include <c10/core/InferenceMode.h>
 #include <cstdint>
 
 namespace torch {
@@ -66,6 +67,32 @@ using NoGradGuard = at::NoGradGuard;
 /// @endcode
 using AutoGradMode = at::AutoGradMode;
 
+/// A RAII, thread-local guard that runs operations without any autograd
+/// bookkeeping.
+///
+/// Unlike `NoGradGuard`, which still runs the autograd layer of every op,
+/// `InferenceMode` skips it entirely, and tensors created in this mode don't
+/// carry a version counter.  This lowers the per-op overhead when serving a
+/// model from C++.  The price is that tensors created in this mode can't be
+/// used with autograd afterwards: they can't require grad, be saved for
+/// backward, or be modified in-place outside `InferenceMode`.  See
+/// `c10/core/InferenceMode.h` for details.
+///
+/// This context manager is thread-local; it will not affect computation
+/// in other threads.
+///
+/// Example:
+/// @code
+/// torch::Tensor y;
+/// {
+///   torch::InferenceMode guard;
+///   y = model->forward(x);
+/// }
+/// std::cout << y.is_inference() << std::endl; // prints `true`
+/// auto z = y.clone(); // a normal tensor that can be used in autograd
+/// @endcode
+using InferenceMode = c10::InferenceMode;
+
 /// Sets the global random seed for all newly created CPU and CUDA tensors.
 using at::manual_seed;
 
@@ -6,6 +6,7 @@
 #include <torch/csrc/autograd/autograd.h>
 #include <ATen/TracerMode.h>
 #include <ATen/core/op_registration/op_registration.h>
+#include <torch/library.h>
 
 using namespace at;
 using namespace torch::autograd::generated;
@@ -348,6 +349,22 @@ Tensor & detach_(Tensor & self) {
   return self;
 }
 
+// copy_ is the only manually registered op that needs an InplaceOrView kernel
+// (see InplaceOrViewType.cpp): the native detach() returns self, and resizing
+// doesn't bump the version.
+Tensor & copy__inplace_or_view(Tensor & self, const Tensor & src, bool non_blocking) {
+  {
+    c10::impl::ExcludeDispatchKeyGuard guard(c10::DispatchKey::InplaceOrView);
+    self.copy_(src, non_blocking);
+  }
+  increment_version_if_tracked(self);
+  return self;
+}
+
+TORCH_LIBRARY_IMPL(aten, InplaceOrView, m) {
+  m.impl_UNBOXED("copy_", &copy__inplace_or_view);
+}
+
 // Some ops in the following registration list are registered as catch-all kernels,
 // some as catch-all kernels and additionally as backend kernels for Autograd.
 // The reason for this is that ops that also use dispatch (e.g. register CPU/CUDA/QuantizedCPU
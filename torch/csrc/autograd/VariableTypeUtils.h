@@ -41,6 +41,11 @@ namespace torch { namespace autograd {
 
 inline void check_inplace(const Tensor& tensor) {
   auto& var = static_cast<const Variable&>(tensor);
+  // Checked here rather than only when bumping the version, so that the
+  // inference tensor is not modified before we error out.
+  TORCH_CHECK(!var.is_inference(),
+    "Inplace update to an inference tensor outside InferenceMode is not allowed. "
+    "You can make a clone to get a normal tensor before doing inplace update.");
   if (var.requires_grad() && GradMode::is_enabled()) {
     if (var.is_view()) {
       // NB: is_view() ==> get_autograd_meta()
@@ -88,6 +93,29 @@ inline void increment_version(Tensor & t) {
   impl::bump_version(t);
 }
 
+// The InplaceOrView kernels (see InferenceMode.h) run in place of the Autograd
+// ones, and may see inference tensors, which have no version to bump.
+inline void increment_version_if_tracked(Tensor & t) {
+  if (!t.is_inference()) {
+    impl::bump_version(t);
+  }
+}
+
+// Views made in InferenceMode share the version counter of their base without
+// tracking history; the views of an inference tensor thus stay inference
+// tensors, and those of a normal tensor don't become one.
+inline Tensor share_version_counter(const Tensor & base, Tensor tensor) {
+  impl::set_version_counter(tensor, impl::version_counter(base));
+  return tensor;
+}
+
+inline std::vector<Tensor> share_version_counter(const Tensor & base, std::vector<Tensor> tensors) {
+  for (Tensor& tensor : tensors) {
+    impl::set_version_counter(tensor, impl::version_counter(base));
+  }
+  return tensors;
+}
+
 struct Flatten : IterArgs<Flatten> {
   Flatten(variable_list& out) : out(out) {}
   variable_list& out;
@@ -109,6 +137,11 @@ inline Tensor as_view(const Tensor & base, Tensor tensor, bool is_differentiable
         c10::optional<std::function<Tensor(const Tensor&)>> view_func=c10::nullopt,
         CreationMeta creation_meta=CreationMeta::DEFAULT) {
   auto base_var = Variable(base);
+  // Views of an inference tensor are inference tensors too: they share its
+  // disabled version counter and don't track history.
+  if (base_var.is_inference()) {
+    return make_variable_non_differentiable_view(std::move(base_var), std::move(tensor));
+  }
   if (base_var.is_view()) {
     // Set `view_func` using the root base as input.
     // `view_func` is used to recover views in backward when either as_strided is not supported
@@ -181,7 +214,9 @@ inline std::vector<Tensor> as_view(const Tensor & base, std::vector<Tensor> tens
     base_var = base_var._base();
   }
   for(Tensor &tensor : tensors) {
-    if (is_differentiable) {
+    if (base_var.is_inference()) {
+      tensor = make_variable_non_differentiable_view(base_var, std::move(tensor));
+    } else if (is_differentiable) {
       tensor = make_variable_differentiable_view(base_var, std::move(tensor), creation_meta);
     } else {
       TORCH_CHECK(creation_meta == CreationMeta::DEFAULT,
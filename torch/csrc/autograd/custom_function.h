@@ -3,6 +3,7 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/variable.h>
 #include <ATen/core/ivalue.h>
+#include <c10/core/InferenceMode.h>
 #include <c10/util/flat_hash_map.h>
 #include <vector>
 
@@ -207,7 +208,8 @@ auto Function<T>::apply(Args&&... args) -> std::enable_if_t<std::is_same<X,T>::v
   // TODO Add tracing here
   extract_vars(node->is_variable_input_, input_vars, args...);
 
-  bool is_executable =  GradMode::is_enabled() && any_variable_requires_grad(input_vars);
+  bool is_executable =  GradMode::is_enabled() && !c10::InferenceMode::is_enabled() &&
+      any_variable_requires_grad(input_vars);
   auto next_edges = collect_next_edges(input_vars);
   node->set_ctx_grad_fn(node);
   node->set_next_edges(std::move(next_edges));
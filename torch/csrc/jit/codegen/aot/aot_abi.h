@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// C ABI of the shared objects produced by the TorchScript ahead-of-time
+// compiler (aot_compiler.h) and consumed by AotModule (aot_module.h).
+//
+// Tensors cross the boundary as opaque handles, each pointing to an
+// at::Tensor owned by the caller. Output handles must point to tensors that
+// the library can assign to. All entry points are thread-safe; run() reports
+// failures through its return value and torch_aot_last_error(), which is
+// thread-local.
+
+#define TORCH_AOT_ABI_VERSION 1
+
+#ifdef _WIN32
+#define TORCH_AOT_EXPORT __declspec(dllexport)
+#else
+#define TORCH_AOT_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns TORCH_AOT_ABI_VERSION of the compiler that produced the library.
+typedef int32_t (*torch_aot_abi_version_fn)(void);
+// Number of tensors expected in each of the arrays passed to run().
+typedef int32_t (*torch_aot_num_constants_fn)(void);
+typedef int32_t (*torch_aot_num_inputs_fn)(void);
+typedef int32_t (*torch_aot_num_outputs_fn)(void);
+// Runs the graph. Returns 0 on success.
+typedef int32_t (*torch_aot_run_fn)(
+    void* const* constants,
+    void* const* inputs,
+    void** outputs);
+// Message describing the last failed run() on the calling thread.
+typedef const char* (*torch_aot_last_error_fn)(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#define TORCH_AOT_ABI_VERSION_SYMBOL "torch_aot_abi_version"
+#define TORCH_AOT_NUM_CONSTANTS_SYMBOL "torch_aot_num_constants"
+#define TORCH_AOT_NUM_INPUTS_SYMBOL "torch_aot_num_inputs"
+#define TORCH_AOT_NUM_OUTPUTS_SYMBOL "torch_aot_num_outputs"
+#define TORCH_AOT_RUN_SYMBOL "torch_aot_run"
+#define TORCH_AOT_LAST_ERROR_SYMBOL "torch_aot_last_error"
@@ -0,0 +1,984 @@
+#include <torch/csrc/jit/codegen/aot/aot_compiler.h>
+
+#include <ATen/core/dispatch/Dispatcher.h>
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/codegen/aot/aot_abi.h>
+#include <torch/csrc/jit/frontend/code_template.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/tensorexpr_fuser.h>
+#include <torch/csrc/jit/passes/utils/subgraph_utils.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+#include <torch/csrc/jit/tensorexpr/kernel.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+namespace aot {
+
+namespace {
+
+// ATen ops that only exist as Tensor methods (`variants: method` in
+// native_functions.yaml). In-place ops are called as methods as well.
+const std::unordered_set<std::string>& methodOnlyOps() {
+  static const std::unordered_set<std::string> ops = {
+      "align_as",    "align_to",     "coalesce",    "contiguous",
+      "data",        "dense_dim",    "expand",      "expand_as",
+      "indices",     "is_coalesced", "is_leaf",     "is_pinned",
+      "is_set_to",   "item",         "narrow_copy", "new_empty",
+      "new_full",    "new_zeros",    "output_nr",   "permute",
+      "pin_memory",  "qscheme",      "refine_names", "rename",
+      "repeat",      "reshape_as",   "sparse_dim",  "sparse_mask",
+      "sum_to_size", "to",           "to_dense",    "to_mkldnn",
+      "to_sparse",   "type_as",      "unflatten",   "unfold",
+      "values",      "view",         "view_as",
+  };
+  return ops;
+}
+
+bool isInplace(const std::string& name) {
+  return name.size() > 1 && name.back() == '_' && name.front() != '_' &&
+      name.compare(0, 2, "__") != 0;
+}
+
+class AotSourceGenerator {
+ public:
+  explicit AotSourceGenerator(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  AotCompilationUnit run() {
+    AotCompilationUnit unit;
+    for (size_t i = 0; i < graph_->inputs().size(); ++i) {
+      Value* input = graph_->inputs()[i];
+      checkTensor(input, "input");
+      body_ << "  const at::Tensor& " << name(input)
+            << " = *static_cast<const at::Tensor*>(inputs[" << i << "]);\n";
+    }
+    insertFallbacks();
+    for (Node* n : graph_->nodes()) {
+      if (!fallback_nodes_.count(n)) {
+        emitNode(n);
+      }
+    }
+    for (size_t i = 0; i < graph_->outputs().size(); ++i) {
+      Value* output = graph_->outputs()[i];
+      checkTensor(output, "output");
+      body_ << "  *static_cast<at::Tensor*>(outputs[" << i
+            << "]) = " << name(output) << ";\n";
+    }
+
+    TemplateEnv env;
+    env.s("kernel_decls", kernel_decls_.str());
+    env.s("body", body_.str());
+    env.d("num_constants", constants_.size());
+    env.d("num_inputs", graph_->inputs().size());
+    env.d("num_outputs", graph_->outputs().size());
+    unit.source = source_template.format(env);
+    unit.constants = std::move(constants_);
+    unit.kernel_objects = std::move(kernel_objects_);
+    unit.num_inputs = graph_->inputs().size();
+    unit.num_outputs = graph_->outputs().size();
+    return unit;
+  }
+
+ private:
+  static const CodeTemplate source_template;
+
+  // The ATen ops of a TensorExpr group, run when its inputs do not match
+  // the shapes the group was compiled for
+  struct Fallback {
+    std::vector<Node*> nodes;
+    std::vector<Value*> outputs;
+  };
+
+  static std::string name(const Value* v) {
+    return "v" + std::to_string(v->unique());
+  }
+
+  static void checkTensor(const Value* v, const char* what) {
+    TORCH_CHECK(
+        v->type()->isSubtypeOf(TensorType::get()),
+        "Ahead-of-time compilation requires tensor graph ",
+        what,
+        "s, but %",
+        v->debugName(),
+        " has type ",
+        v->type()->annotation_str(),
+        ". Freeze the module before compiling it.");
+  }
+
+  [[noreturn]] static void unsupported(const Node* n, const std::string& why) {
+    std::stringstream ss;
+    ss << *n;
+    TORCH_CHECK(
+        false,
+        "Ahead-of-time compilation does not support ",
+        why,
+        " in node:\n",
+        ss.str());
+  }
+
+  static bool isNone(const Value* v) {
+    return v->type()->kind() == TypeKind::NoneType;
+  }
+
+  static std::string doubleLiteral(double d) {
+    if (std::isnan(d)) {
+      return "std::numeric_limits<double>::quiet_NaN()";
+    }
+    if (std::isinf(d)) {
+      return d > 0 ? "std::numeric_limits<double>::infinity()"
+                   : "-std::numeric_limits<double>::infinity()";
+    }
+    std::stringstream ss;
+    ss << std::setprecision(std::numeric_limits<double>::max_digits10) << d;
+    std::string s = ss.str();
+    if (s.find_first_of(".e") == std::string::npos) {
+      s += ".";
+    }
+    return s;
+  }
+
+  static std::string intLiteral(int64_t i) {
+    if (i == std::numeric_limits<int64_t>::min()) {
+      return "std::numeric_limits<int64_t>::min()";
+    }
+    return "INT64_C(" + std::to_string(i) + ")";
+  }
+
+  static std::string stringLiteral(const std::string& s) {
+    std::stringstream ss;
+    ss << "std::string(\"";
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        ss << '\\' << c;
+      } else if (std::isprint(static_cast<unsigned char>(c))) {
+        ss << c;
+      } else {
+        ss << "\\" << std::oct << std::setw(3) << std::setfill('0')
+           << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
+      }
+    }
+    ss << "\", " << s.size() << ")";
+    return ss.str();
+  }
+
+  void emitConstant(Node* n) {
+    Value* out = n->output();
+    if (isNone(out)) {
+      // None arguments are emitted at their uses
+      return;
+    }
+    auto ival = toIValue(out);
+    TORCH_INTERNAL_ASSERT(ival);
+    const std::string v = name(out);
+    if (ival->isTensor()) {
+      body_ << "  const at::Tensor& " << v
+            << " = *static_cast<const at::Tensor*>(constants["
+            << constants_.size() << "]);\n";
+      constants_.push_back(ival->toTensor());
+    } else if (ival->isInt()) {
+      body_ << "  const int64_t " << v << " = " << intLiteral(ival->toInt())
+            << ";\n";
+    } else if (ival->isDouble()) {
+      body_ << "  const double " << v << " = "
+            << doubleLiteral(ival->toDouble()) << ";\n";
+    } else if (ival->isBool()) {
+      body_ << "  const bool " << v << " = "
+            << (ival->toBool() ? "true" : "false") << ";\n";
+    } else if (ival->isString()) {
+      body_ << "  const std::string " << v << " = "
+            << stringLiteral(ival->toStringRef()) << ";\n";
+    } else if (ival->isDevice()) {
+      body_ << "  const at::Device " << v << "("
+            << stringLiteral(ival->toDevice().str()) << ");\n";
+    } else if (ival->isIntList()) {
+      body_ << "  const std::vector<int64_t> " << v << " = {";
+      bool first = true;
+      for (int64_t i : ival->toIntList()) {
+        body_ << (first ? "" : ", ") << intLiteral(i);
+        first = false;
+      }
+      body_ << "};\n";
+    } else if (ival->isDoubleList()) {
+      body_ << "  const std::vector<double> " << v << " = {";
+      bool first = true;
+      for (double d : ival->toDoubleList()) {
+        body_ << (first ? "" : ", ") << doubleLiteral(d);
+        first = false;
+      }
+      body_ << "};\n";
+    } else {
+      unsupported(n, "constants of type " + out->type()->annotation_str());
+    }
+  }
+
+  // The C++ type of a schema argument of type `type` named `arg_name`.
+  // ScalarType, Layout and MemoryFormat are ints in schemas, so they are
+  // recognized by their conventional argument names.
+  static std::string cppType(
+      const Node* n,
+      const TypePtr& type,
+      const std::string& arg_name) {
+    switch (type->kind()) {
+      case TypeKind::IntType:
+        if (arg_name == "dtype") {
+          return "at::ScalarType";
+        } else if (arg_name == "layout") {
+          return "at::Layout";
+        } else if (arg_name == "memory_format") {
+          return "at::MemoryFormat";
+        }
+        return "int64_t";
+      case TypeKind::FloatType:
+        return "double";
+      case TypeKind::BoolType:
+        return "bool";
+      case TypeKind::NumberType:
+        return "at::Scalar";
+      case TypeKind::StringType:
+        return "std::string";
+      case TypeKind::DeviceObjType:
+        return "at::Device";
+      case TypeKind::ListType: {
+        auto elem = type->expect<ListType>()->getElementType();
+        if (elem->kind() == TypeKind::IntType) {
+          return "at::IntArrayRef";
+        } else if (elem->kind() == TypeKind::FloatType) {
+          return "at::ArrayRef<double>";
+        }
+        break;
+      }
+      default:
+        break;
+    }
+    unsupported(n, "arguments of type " + type->annotation_str());
+  }
+
+  static std::string argExpr(
+      const Node* n,
+      const Argument& arg,
+      const Value* v) {
+    TypePtr formal = arg.type();
+    if (auto opt = formal->cast<OptionalType>()) {
+      TypePtr elem = opt->getElementType();
+      // Tensor? is passed as a possibly undefined Tensor
+      if (elem->kind() == TypeKind::TensorType) {
+        return isNone(v) ? "at::Tensor()" : name(v);
+      }
+      if (isNone(v)) {
+        return "c10::nullopt";
+      }
+      return "c10::optional<" + cppType(n, elem, arg.name()) + ">(" +
+          plainArgExpr(n, elem, arg, v) + ")";
+    }
+    if (isNone(v)) {
+      unsupported(n, "None for non-optional argument " + arg.name());
+    }
+    return plainArgExpr(n, formal, arg, v);
+  }
+
+  static std::string plainArgExpr(
+      const Node* n,
+      const TypePtr& formal,
+      const Argument& arg,
+      const Value* v) {
+    switch (formal->kind()) {
+      case TypeKind::TensorType:
+        return name(v);
+      case TypeKind::IntType: {
+        const std::string type = cppType(n, formal, arg.name());
+        if (type != "int64_t") {
+          return "static_cast<" + type + ">(" + name(v) + ")";
+        }
+        return name(v);
+      }
+      case TypeKind::ListType: {
+        auto elem = formal->expect<ListType>()->getElementType();
+        if (elem->kind() == TypeKind::TensorType) {
+          return name(v);
+        }
+        // A single int is broadcast to fixed size int lists, e.g. int[2]
+        if (v->type()->kind() == TypeKind::IntType && arg.N()) {
+          return "std::vector<int64_t>(" + std::to_string(*arg.N()) + ", " +
+              name(v) + ")";
+        }
+        cppType(n, formal, arg.name());
+        return name(v);
+      }
+      case TypeKind::FloatType:
+      case TypeKind::BoolType:
+      case TypeKind::NumberType:
+      case TypeKind::StringType:
+      case TypeKind::DeviceObjType:
+        return name(v);
+      default:
+        unsupported(n, "arguments of type " + formal->annotation_str());
+    }
+  }
+
+  // The ATen C++ API folds (dtype, layout, device, pin_memory) into a single
+  // TensorOptions argument. Returns the index of the first of the four, if
+  // the schema has them.
+  static c10::optional<size_t> tensorOptionsIndex(
+      const FunctionSchema& schema) {
+    static const char* names[] = {"dtype", "layout", "device", "pin_memory"};
+    const auto& args = schema.arguments();
+    for (size_t i = 0; i + 4 <= args.size(); ++i) {
+      bool match = true;
+      for (size_t j = 0; j < 4 && match; ++j) {
+        match = args[i + j].name() == names[j];
+      }
+      if (match) {
+        return i;
+      }
+    }
+    return c10::nullopt;
+  }
+
+  static std::string tensorOptionsExpr(const Node* n, size_t first) {
+    std::string expr = "at::TensorOptions()";
+    const Value* dtype = n->input(first);
+    const Value* layout = n->input(first + 1);
+    const Value* device = n->input(first + 2);
+    const Value* pin_memory = n->input(first + 3);
+    if (!isNone(dtype)) {
+      expr += ".dtype(static_cast<at::ScalarType>(" + name(dtype) + "))";
+    }
+    if (!isNone(layout)) {
+      expr += ".layout(static_cast<at::Layout>(" + name(layout) + "))";
+    }
+    if (!isNone(device)) {
+      expr += ".device(" + name(device) + ")";
+    }
+    if (!isNone(pin_memory)) {
+      expr += ".pinned_memory(" + name(pin_memory) + ")";
+    }
+    return expr;
+  }
+
+  void bindOutputs(const Node* n, const std::string& call) {
+    if (n->outputs().size() == 1) {
+      body_ << "  auto " << name(n->output()) << " = " << call << ";\n";
+      return;
+    }
+    const std::string tuple = "t" + std::to_string(n->output(0)->unique());
+    body_ << "  auto " << tuple << " = " << call << ";\n";
+    for (size_t i = 0; i < n->outputs().size(); ++i) {
+      body_ << "  auto " << name(n->output(i)) << " = std::get<" << i << ">("
+            << tuple << ");\n";
+    }
+  }
+
+  static bool isNumber(const Value* v) {
+    auto kind = v->type()->kind();
+    return kind == TypeKind::IntType || kind == TypeKind::FloatType;
+  }
+
+  // Arithmetic and comparisons on ints and floats, e.g. from shape math
+  bool tryEmitScalarOp(Node* n) {
+    static const std::unordered_map<std::string, std::string> binary_ops = {
+        {"add", "+"},
+        {"sub", "-"},
+        {"mul", "*"},
+        {"eq", "=="},
+        {"ne", "!="},
+        {"lt", "<"},
+        {"le", "<="},
+        {"gt", ">"},
+        {"ge", ">="},
+    };
+    const std::string op = n->kind().toUnqualString();
+    if (n->inputs().size() == 2 && isNumber(n->input(0)) &&
+        isNumber(n->input(1))) {
+      auto it = binary_ops.find(op);
+      if (it != binary_ops.end()) {
+        bindOutputs(
+            n,
+            "(" + name(n->input(0)) + " " + it->second + " " +
+                name(n->input(1)) + ")");
+        return true;
+      }
+      if (op == "div") {
+        bindOutputs(
+            n,
+            "(static_cast<double>(" + name(n->input(0)) + ") / " +
+                name(n->input(1)) + ")");
+        return true;
+      }
+      if (op == "floordiv") {
+        bindOutputs(
+            n,
+            "aot_floordiv(" + name(n->input(0)) + ", " + name(n->input(1)) +
+                ")");
+        return true;
+      }
+    }
+    if (op == "neg" && n->inputs().size() == 1 && isNumber(n->input(0))) {
+      bindOutputs(n, "(-" + name(n->input(0)) + ")");
+      return true;
+    }
+    return false;
+  }
+
+  // Ops registered by the JIT rather than ATen, and list/tuple plumbing
+  bool tryEmitSpecialOp(Node* n) {
+    switch (n->kind()) {
+      case prim::Constant:
+        emitConstant(n);
+        return true;
+      case prim::ListConstruct: {
+        auto elem = n->output()->type()->expect<ListType>()->getElementType();
+        std::string type;
+        if (elem->kind() == TypeKind::TensorType) {
+          type = "std::vector<at::Tensor>";
+        } else if (elem->kind() == TypeKind::IntType) {
+          type = "std::vector<int64_t>";
+        } else if (elem->kind() == TypeKind::FloatType) {
+          type = "std::vector<double>";
+        } else {
+          unsupported(n, "lists of " + elem->annotation_str());
+        }
+        body_ << "  const " << type << " " << name(n->output()) << " = {";
+        for (size_t i = 0; i < n->inputs().size(); ++i) {
+          body_ << (i ? ", " : "") << name(n->input(i));
+        }
+        body_ << "};\n";
+        return true;
+      }
+      case prim::ListUnpack:
+        for (size_t i = 0; i < n->outputs().size(); ++i) {
+          body_ << "  auto " << name(n->output(i)) << " = "
+                << name(n->input()) << "[" << i << "];\n";
+        }
+        return true;
+      case prim::NumToTensor:
+        bindOutputs(
+            n, "at::scalar_to_tensor(at::Scalar(" + name(n->input()) + "))");
+        return true;
+      case aten::size:
+        if (n->inputs().size() == 1) {
+          bindOutputs(n, name(n->input()) + ".sizes().vec()");
+        } else {
+          bindOutputs(
+              n,
+              name(n->input(0)) + ".size(" + name(n->input(1)) + ")");
+        }
+        return true;
+      case aten::dim:
+        bindOutputs(n, name(n->input()) + ".dim()");
+        return true;
+      case aten::len:
+        bindOutputs(
+            n, "static_cast<int64_t>(" + name(n->input()) + ".size())");
+        return true;
+      case aten::__getitem__:
+        bindOutputs(
+            n,
+            "aot_getitem(" + name(n->input(0)) + ", " + name(n->input(1)) +
+                ")");
+        return true;
+      case aten::Int:
+      case aten::Float:
+      case aten::Bool:
+        if (n->input()->type()->isSubtypeOf(TensorType::get())) {
+          const char* type = n->kind() == aten::Int
+              ? "int64_t"
+              : (n->kind() == aten::Float ? "double" : "bool");
+          bindOutputs(
+              n, name(n->input()) + ".item<" + std::string(type) + ">()");
+          return true;
+        }
+        return false;
+      default:
+        break;
+    }
+    return n->kind().is_aten() && tryEmitScalarOp(n);
+  }
+
+  // Copies the subgraph of every TensorExpr group in front of it. The copies
+  // are not emitted in order, but as the fallback of their group.
+  void insertFallbacks() {
+    for (Node* n : graph_->nodes()) {
+      if (n->kind() != getTensorExprSymbol()) {
+        continue;
+      }
+      WithInsertPoint guard(n);
+      Node* prev = n->prev();
+      Fallback& fallback = fallbacks_[n];
+      fallback.outputs =
+          insertGraph(*graph_, *n->g(attr::Subgraph), n->inputs());
+      for (Node* f = prev->next(); f != n; f = f->next()) {
+        fallback.nodes.push_back(f);
+        fallback_nodes_.insert(f);
+      }
+    }
+  }
+
+  static std::string scalarTypeExpr(at::ScalarType type) {
+    return std::string("at::ScalarType::") + c10::toString(type);
+  }
+
+  static std::string intListExpr(const std::vector<int64_t>& list) {
+    std::string expr = "{";
+    for (size_t i = 0; i < list.size(); ++i) {
+      expr += (i ? ", " : "") + intLiteral(list[i]);
+    }
+    return expr + "}";
+  }
+
+  // The LLVM kernel of a TensorExpr group only handles the shapes, strides
+  // and dtypes it was specialized for, so every input and output type must
+  // be complete.
+  static bool canLower(Node* n) {
+    const auto& subgraph = n->g(attr::Subgraph);
+    for (Value* input : subgraph->inputs()) {
+      auto kind = input->type()->kind();
+      if (kind == TypeKind::TensorType) {
+        if (!input->isCompleteTensor()) {
+          return false;
+        }
+      } else if (
+          kind != TypeKind::IntType && kind != TypeKind::FloatType &&
+          kind != TypeKind::BoolType) {
+        return false;
+      }
+    }
+    for (Value* output : subgraph->outputs()) {
+      if (!output->isCompleteTensor()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  c10::optional<std::string> compileTensorExprGroup(
+      Node* n,
+      const std::string& kernel) {
+    if (!canLower(n)) {
+      return c10::nullopt;
+    }
+    try {
+      tensorexpr::TensorExprKernel k(n->g(attr::Subgraph));
+      return k.compileToObject(kernel);
+    } catch (const std::exception& e) {
+      GRAPH_DEBUG("Could not compile ", kernel, ": ", e.what());
+      return c10::nullopt;
+    }
+  }
+
+  // Calls the LLVM kernel of the group when the inputs match the types it
+  // was compiled for, and its ATen ops otherwise.
+  void emitTensorExprGroup(Node* n) {
+    const Fallback& fallback = fallbacks_.at(n);
+    for (Value* output : n->outputs()) {
+      body_ << "  at::Tensor " << name(output) << ";\n";
+    }
+    const std::string kernel =
+        "aot_kernel_" + std::to_string(kernel_objects_.size());
+    auto object = compileTensorExprGroup(n, kernel);
+    if (object) {
+      kernel_objects_.push_back(std::move(*object));
+      kernel_decls_ << "extern \"C\" int32_t " << kernel << "(void** args);\n";
+
+      const auto& subgraph = n->g(attr::Subgraph);
+      const std::string args = "a" + std::to_string(n->output(0)->unique());
+      std::vector<std::string> guards;
+      std::vector<std::string> arg_exprs;
+      std::stringstream scalars;
+      for (size_t i = 0; i < n->inputs().size(); ++i) {
+        Value* input = n->input(i);
+        auto type = subgraph->inputs()[i]->type();
+        if (auto tt = type->cast<TensorType>()) {
+          guards.push_back(
+              "aot_matches(" + name(input) + ", " +
+              intListExpr(*tt->sizes().concrete_sizes()) + ", " +
+              intListExpr(*tt->strides().concrete_sizes()) + ", " +
+              scalarTypeExpr(*tt->scalarType()) + ")");
+          arg_exprs.push_back(name(input) + ".data_ptr()");
+          continue;
+        }
+        // Scalars are passed by address, as the kernel's int, float or
+        // bool variables.
+        const char* cpp_type = type->kind() == TypeKind::IntType
+            ? "int32_t"
+            : (type->kind() == TypeKind::FloatType ? "float" : "bool");
+        const std::string scalar = args + "_" + std::to_string(i);
+        scalars << "    " << cpp_type << " " << scalar << " = static_cast<"
+                << cpp_type << ">(" << name(input) << ");\n";
+        arg_exprs.push_back("&" + scalar);
+      }
+      body_ << "  if (";
+      for (size_t i = 0; i < guards.size(); ++i) {
+        body_ << (i ? " &&\n      " : "") << guards[i];
+      }
+      body_ << (guards.empty() ? "true" : "") << ") {\n";
+      for (size_t i = 0; i < n->outputs().size(); ++i) {
+        auto tt = subgraph->outputs()[i]->type()->expect<TensorType>();
+        body_ << "    " << name(n->output(i)) << " = at::empty("
+              << intListExpr(*tt->sizes().concrete_sizes())
+              << ", at::TensorOptions().dtype("
+              << scalarTypeExpr(*tt->scalarType()) << "));\n";
+        arg_exprs.push_back(name(n->output(i)) + ".data_ptr()");
+      }
+      body_ << scalars.str() << "    void* " << args << "[] = {";
+      for (size_t i = 0; i < arg_exprs.size(); ++i) {
+        body_ << (i ? ", " : "") << arg_exprs[i];
+      }
+      body_ << "};\n";
+      body_ << "    " << kernel << "(" << args << ");\n";
+      body_ << "  } else {\n";
+    } else {
+      body_ << "  {\n";
+    }
+    for (Node* f : fallback.nodes) {
+      emitNode(f);
+    }
+    for (size_t i = 0; i < n->outputs().size(); ++i) {
+      body_ << "  " << name(n->output(i)) << " = "
+            << name(fallback.outputs[i]) << ";\n";
+    }
+    body_ << "  }\n";
+  }
+
+  void emitNode(Node* n) {
+    if (n->kind() == getTensorExprSymbol()) {
+      emitTensorExprGroup(n);
+      return;
+    }
+    if (tryEmitSpecialOp(n)) {
+      return;
+    }
+    if (!n->blocks().empty()) {
+      unsupported(n, "control flow");
+    }
+    if (!n->kind().is_aten()) {
+      unsupported(n, "this operator");
+    }
+    const FunctionSchema* schema = n->maybeSchema();
+    if (!schema ||
+        !c10::Dispatcher::singleton().findSchema(schema->operator_name())) {
+      unsupported(n, "operators without an ATen kernel");
+    }
+    for (const Argument& ret : schema->returns()) {
+      auto kind = ret.type()->kind();
+      if (kind != TypeKind::TensorType && kind != TypeKind::IntType &&
+          kind != TypeKind::FloatType && kind != TypeKind::BoolType &&
+          !ret.type()->isSubtypeOf(ListType::ofTensors())) {
+        unsupported(n, "returns of type " + ret.type()->annotation_str());
+      }
+    }
+
+    std::vector<std::string> args;
+    auto options_index = tensorOptionsIndex(*schema);
+    const auto& formals = schema->arguments();
+    for (size_t i = 0; i < formals.size(); ++i) {
+      if (options_index && i == *options_index) {
+        args.push_back(tensorOptionsExpr(n, i));
+        i += 3;
+        continue;
+      }
+      args.push_back(argExpr(n, formals[i], n->input(i)));
+    }
+
+    const std::string op = n->kind().toUnqualString();
+    const bool as_method = !formals.empty() &&
+        formals[0].type()->kind() == TypeKind::TensorType &&
+        (methodOnlyOps().count(op) ||
+         (isInplace(op) && formals[0].name() == "self"));
+    std::stringstream call;
+    size_t first_arg = 0;
+    if (as_method) {
+      call << args[0] << "." << op << "(";
+      first_arg = 1;
+    } else {
+      call << "at::" << op << "(";
+    }
+    for (size_t i = first_arg; i < args.size(); ++i) {
+      call << (i > first_arg ? ", " : "") << args[i];
+    }
+    call << ")";
+    bindOutputs(n, call.str());
+  }
+
+  std::shared_ptr<Graph> graph_;
+  std::stringstream body_;
+  std::stringstream kernel_decls_;
+  std::vector<at::Tensor> constants_;
+  std::vector<std::string> kernel_objects_;
+  std::unordered_map<Node*, Fallback> fallbacks_;
+  std::unordered_set<Node*> fallback_nodes_;
+};
+
+const CodeTemplate AotSourceGenerator::source_template(R"(
+// Generated by the TorchScript ahead-of-time compiler. Do not edit.
+#include <ATen/ATen.h>
+#include <ATen/ScalarOps.h>
+#include <torch/csrc/jit/codegen/aot/aot_abi.h>
+
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+
+${kernel_decls}
+namespace {
+
+thread_local std::string last_error;
+
+inline bool aot_matches(
+    const at::Tensor& t,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    at::ScalarType dtype) {
+  return t.defined() && t.device().is_cpu() && t.scalar_type() == dtype &&
+      t.sizes() == sizes && t.strides() == strides;
+}
+
+template <typename T>
+T aot_getitem(const std::vector<T>& list, int64_t idx) {
+  const int64_t size = list.size();
+  if (idx < 0) {
+    idx += size;
+  }
+  TORCH_CHECK(idx >= 0 && idx < size, "list index out of range");
+  return list[idx];
+}
+
+inline int64_t aot_floordiv(int64_t a, int64_t b) {
+  TORCH_CHECK(b != 0, "ZeroDivisionError: integer division by zero");
+  int64_t q = a / b;
+  return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+inline double aot_floordiv(double a, double b) {
+  return std::floor(a / b);
+}
+
+void forward(void* const* constants, void* const* inputs, void** outputs) {
+${body}
+}
+
+} // namespace
+
+extern "C" {
+
+TORCH_AOT_EXPORT int32_t torch_aot_abi_version() {
+  return TORCH_AOT_ABI_VERSION;
+}
+
+TORCH_AOT_EXPORT int32_t torch_aot_num_constants() {
+  return ${num_constants};
+}
+
+TORCH_AOT_EXPORT int32_t torch_aot_num_inputs() {
+  return ${num_inputs};
+}
+
+TORCH_AOT_EXPORT int32_t torch_aot_num_outputs() {
+  return ${num_outputs};
+}
+
+TORCH_AOT_EXPORT int32_t torch_aot_run(
+    void* const* constants,
+    void* const* inputs,
+    void** outputs) {
+  try {
+    at::AutoGradMode no_grad(false);
+    forward(constants, inputs, outputs);
+    return 0;
+  } catch (const std::exception& e) {
+    last_error = e.what();
+    return 1;
+  }
+}
+
+TORCH_AOT_EXPORT const char* torch_aot_last_error() {
+  return last_error.c_str();
+}
+
+} // extern "C"
+)");
+
+// Moves the contents of fusion groups other than TensorExpr groups back into
+// the graph so that every node maps to an ATen call. TensorExpr groups are
+// compiled with LLVM by the generator.
+void inlineSubgraphs(Block* block) {
+  bool changed = true;
+  while (changed) {
+    // Inlined groups may themselves contain groups, so repeat until none
+    // are left.
+    changed = false;
+    for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+      Node* n = *it++;
+      for (Block* b : n->blocks()) {
+        inlineSubgraphs(b);
+      }
+      if (n->hasAttribute(attr::Subgraph) &&
+          n->kind() != getTensorExprSymbol()) {
+        SubgraphUtils::unmergeSubgraph(n);
+        changed = true;
+      }
+    }
+  }
+}
+
+#ifdef _MSC_VER
+static const std::string compile_string =
+    "${cxx} /nologo /MD /O2 /LD /EHsc /std:c++14 ${include_flags} "
+    "${cpp_file} ${object_files} /link /out:${so_file} ${library_flags}";
+static const std::string object_suffix = ".obj";
+#else
+static const std::string compile_string =
+    "${cxx} -O3 -std=c++14 -fPIC -shared ${include_flags} "
+    "${cpp_file} ${object_files} -o ${so_file} ${library_flags}";
+static const std::string object_suffix = ".o";
+#endif
+
+// Quotes `arg` so that the shell run by std::system passes it to the
+// compiler as a single argument.
+std::string shellQuote(const std::string& arg) {
+#ifdef _MSC_VER
+  TORCH_CHECK(
+      arg.find('"') == std::string::npos,
+      "Ahead-of-time compiler arguments may not contain quotes: ",
+      arg);
+  return "\"" + arg + "\"";
+#else
+  std::string quoted = "'";
+  for (char c : arg) {
+    if (c == '\'') {
+      quoted += "'\\''";
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "'";
+#endif
+}
+
+std::string compileCommand(
+    const AotCompileOptions& options,
+    const std::string& cpp_file,
+    const std::vector<std::string>& object_files,
+    const std::string& so_file) {
+  std::string cxx = options.cxx;
+  if (cxx.empty()) {
+    const char* cxx_env = std::getenv("CXX");
+#ifdef _MSC_VER
+    cxx = cxx_env ? cxx_env : "cl";
+#else
+    cxx = cxx_env ? cxx_env : "g++";
+#endif
+  }
+  std::string include_flags;
+  for (const auto& dir : options.include_dirs) {
+#ifdef _MSC_VER
+    include_flags += shellQuote("/I" + dir) + " ";
+#else
+    include_flags += shellQuote("-I" + dir) + " ";
+#endif
+  }
+  std::string object_flags;
+  for (const auto& object_file : object_files) {
+    object_flags += shellQuote(object_file) + " ";
+  }
+  std::string library_flags;
+  for (const auto& dir : options.library_dirs) {
+#ifdef _MSC_VER
+    library_flags += shellQuote("/LIBPATH:" + dir) + " ";
+#else
+    library_flags += shellQuote("-L" + dir) + " " +
+        shellQuote("-Wl,-rpath," + dir) + " ";
+#endif
+  }
+  for (const auto& lib : options.libraries) {
+#ifdef _MSC_VER
+    library_flags += shellQuote(lib + ".lib") + " ";
+#else
+    library_flags += shellQuote("-l" + lib) + " ";
+#endif
+  }
+  TemplateEnv env;
+  env.s("cxx", shellQuote(cxx));
+  env.s("include_flags", include_flags);
+  env.s("object_files", object_flags);
+  env.s("library_flags", library_flags);
+  env.s("cpp_file", shellQuote(cpp_file));
+  env.s("so_file", shellQuote(so_file));
+  std::string cmd = format(compile_string, env);
+#ifdef _MSC_VER
+  // cmd.exe drops the first and last quote of the command line
+  cmd = "\"" + cmd + "\"";
+#endif
+  return cmd;
+}
+
+} // namespace
+
+AotCompilationUnit generateAotSource(const std::shared_ptr<Graph>& graph) {
+  auto g = graph->copy();
+  inlineSubgraphs(g->block());
+  LowerAllTuples(g);
+  EliminateDeadCode(g);
+  GRAPH_DUMP("Graph for ahead-of-time compilation:", g);
+  return AotSourceGenerator(g).run();
+}
+
+void compileAotModule(
+    const std::shared_ptr<Graph>& graph,
+    const std::string& so_path,
+    const AotCompileOptions& options) {
+  AotCompilationUnit unit = generateAotSource(graph);
+
+  const std::string cpp_path = so_path + ".cpp";
+  {
+    std::ofstream cpp(cpp_path, std::ios::out | std::ios::trunc);
+    TORCH_CHECK(cpp, "Could not write ", cpp_path);
+    cpp << unit.source;
+  }
+  {
+    const std::string constants_path = so_path + ".constants";
+    std::vector<char> data =
+        pickle_save(c10::List<at::Tensor>(unit.constants));
+    std::ofstream out(
+        constants_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    TORCH_CHECK(out, "Could not write ", constants_path);
+    out.write(data.data(), data.size());
+  }
+  std::vector<std::string> object_paths;
+  for (size_t i = 0; i < unit.kernel_objects.size(); ++i) {
+    object_paths.push_back(
+        so_path + ".kernel" + std::to_string(i) + object_suffix);
+    std::ofstream out(
+        object_paths.back(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    TORCH_CHECK(out, "Could not write ", object_paths.back());
+    out.write(
+        unit.kernel_objects[i].data(), unit.kernel_objects[i].size());
+  }
+
+  const std::string cmd =
+      compileCommand(options, cpp_path, object_paths, so_path);
+  GRAPH_DEBUG("Compiling ahead-of-time module: ", cmd);
+  int r = std::system(cmd.c_str());
+  TORCH_CHECK(
+      r == 0, "Failed to compile ahead-of-time module with: ", cmd);
+}
+
+} // namespace aot
+} // namespace jit
+} // namespace torch
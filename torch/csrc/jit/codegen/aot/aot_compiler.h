@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Ahead-of-time compilation of TorchScript graphs into native shared objects.
+//
+// The input is a frozen graph (see freeze_module.h): tensor inputs and
+// outputs, no module attributes and no control flow left after constant
+// propagation and loop unrolling. Every node is translated into a direct call
+// to the unboxed ATen API, so running the result has no interpreter dispatch,
+// IValue boxing or stack traffic. TensorExpr groups whose types are complete
+// are compiled with LLVM for the host CPU and called when the inputs match
+// those types, falling back to their ATen ops otherwise. Other fusion groups
+// are inlined back into their ATen ops.
+//
+// The resulting library exposes the C ABI in aot_abi.h and is loaded with
+// AotModule (aot_module.h).
+
+namespace torch {
+namespace jit {
+namespace aot {
+
+struct TORCH_API AotCompileOptions {
+  // Compiler used to build the generated source; defaults to $CXX or g++
+  std::string cxx;
+  // Directories holding the ATen/torch headers and libraries
+  std::vector<std::string> include_dirs;
+  std::vector<std::string> library_dirs;
+  std::vector<std::string> libraries = {"c10", "torch_cpu"};
+};
+
+struct TORCH_API AotCompilationUnit {
+  // C++ source implementing the aot_abi.h entry points
+  std::string source;
+  // Tensor constants of the graph, passed to the library at run time
+  std::vector<at::Tensor> constants;
+  // Object code of the TensorExpr groups, linked into the library
+  std::vector<std::string> kernel_objects;
+  size_t num_inputs = 0;
+  size_t num_outputs = 0;
+};
+
+// Translates `graph` into C++ source. Throws if the graph uses constructs
+// that have no unboxed equivalent. `graph` is not modified.
+TORCH_API AotCompilationUnit
+generateAotSource(const std::shared_ptr<Graph>& graph);
+
+// Generates and builds `so_path`. The generated source is kept next to it as
+// `<so_path>.cpp`, the kernel objects as `<so_path>.kernel<i>.o` and the
+// constants are saved as `<so_path>.constants`.
+TORCH_API void compileAotModule(
+    const std::shared_ptr<Graph>& graph,
+    const std::string& so_path,
+    const AotCompileOptions& options = AotCompileOptions());
+
+} // namespace aot
+} // namespace jit
+} // namespace torch
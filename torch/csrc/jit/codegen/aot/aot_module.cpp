@@ -0,0 +1,98 @@
+#include <torch/csrc/jit/codegen/aot/aot_module.h>
+
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace torch {
+namespace jit {
+namespace aot {
+
+namespace {
+
+template <typename Fn>
+Fn lookup(at::DynamicLibrary& lib, const char* name) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+  return reinterpret_cast<Fn>(lib.sym(name));
+#pragma GCC diagnostic pop
+}
+
+std::vector<at::Tensor> loadConstants(const std::string& path) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  TORCH_CHECK(in, "Could not open ahead-of-time module constants ", path);
+  std::vector<char> data(
+      (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return pickle_load(data).toTensorVector();
+}
+
+} // namespace
+
+AotModule::AotModule(const std::string& so_path)
+    : lib_(std::make_unique<at::DynamicLibrary>(so_path.c_str())) {
+  auto abi_version =
+      lookup<torch_aot_abi_version_fn>(*lib_, TORCH_AOT_ABI_VERSION_SYMBOL)();
+  TORCH_CHECK(
+      abi_version == TORCH_AOT_ABI_VERSION,
+      so_path,
+      " was compiled for ahead-of-time ABI version ",
+      abi_version,
+      " but this runtime supports version ",
+      TORCH_AOT_ABI_VERSION);
+
+  num_inputs_ =
+      lookup<torch_aot_num_inputs_fn>(*lib_, TORCH_AOT_NUM_INPUTS_SYMBOL)();
+  num_outputs_ =
+      lookup<torch_aot_num_outputs_fn>(*lib_, TORCH_AOT_NUM_OUTPUTS_SYMBOL)();
+  run_ = lookup<torch_aot_run_fn>(*lib_, TORCH_AOT_RUN_SYMBOL);
+  last_error_ =
+      lookup<torch_aot_last_error_fn>(*lib_, TORCH_AOT_LAST_ERROR_SYMBOL);
+
+  const size_t num_constants = lookup<torch_aot_num_constants_fn>(
+      *lib_, TORCH_AOT_NUM_CONSTANTS_SYMBOL)();
+  if (num_constants > 0) {
+    constants_ = loadConstants(so_path + ".constants");
+  }
+  TORCH_CHECK(
+      constants_.size() == num_constants,
+      "Expected ",
+      num_constants,
+      " constants for ",
+      so_path,
+      " but found ",
+      constants_.size());
+  for (auto& c : constants_) {
+    constant_handles_.push_back(&c);
+  }
+}
+
+std::vector<at::Tensor> AotModule::run(
+    const std::vector<at::Tensor>& inputs) const {
+  TORCH_CHECK(
+      inputs.size() == num_inputs_,
+      "Expected ",
+      num_inputs_,
+      " inputs but got ",
+      inputs.size());
+  std::vector<void*> input_handles;
+  input_handles.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    input_handles.push_back(const_cast<at::Tensor*>(&input));
+  }
+  std::vector<at::Tensor> outputs(num_outputs_);
+  std::vector<void*> output_handles;
+  output_handles.reserve(outputs.size());
+  for (auto& output : outputs) {
+    output_handles.push_back(&output);
+  }
+  int32_t r = run_(
+      constant_handles_.data(), input_handles.data(), output_handles.data());
+  TORCH_CHECK(r == 0, last_error_());
+  return outputs;
+}
+
+} // namespace aot
+} // namespace jit
+} // namespace torch
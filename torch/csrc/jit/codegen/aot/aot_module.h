@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/DynamicLibrary.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/codegen/aot/aot_abi.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace aot {
+
+// A graph compiled ahead of time by compileAotModule(), loaded from its
+// shared object and constants file. run() may be called concurrently.
+class TORCH_API AotModule {
+ public:
+  explicit AotModule(const std::string& so_path);
+
+  std::vector<at::Tensor> run(const std::vector<at::Tensor>& inputs) const;
+
+  size_t num_inputs() const {
+    return num_inputs_;
+  }
+
+  size_t num_outputs() const {
+    return num_outputs_;
+  }
+
+ private:
+  std::unique_ptr<at::DynamicLibrary> lib_;
+  std::vector<at::Tensor> constants_;
+  std::vector<void*> constant_handles_;
+  size_t num_inputs_ = 0;
+  size_t num_outputs_ = 0;
+  torch_aot_run_fn run_ = nullptr;
+  torch_aot_last_error_fn last_error_ = nullptr;
+};
+
+} // namespace aot
+} // namespace jit
+} // namespace torch
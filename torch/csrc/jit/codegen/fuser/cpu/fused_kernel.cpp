@@ -3,10 +3,13 @@
 #include <c10/util/Optional.h>
 #include <torch/csrc/jit/codegen/fuser/compiler.h>
 #include <torch/csrc/jit/codegen/fuser/cpu/temp_file.h>
+#include <torch/csrc/jit/codegen/kernel_disk_cache.h>
 #include <torch/csrc/jit/frontend/code_template.h>
 #include <torch/csrc/utils/memory.h>
 
+#include <array>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -37,12 +40,14 @@ static const std::string check_exists_string =
 static std::vector<std::string> env_list;
 constexpr int so_suffix_len = 4;
 constexpr int cpp_suffix_len = 4;
+static const std::string so_ext = "dll";
 #else
 static const std::string so_template = "/tmp/pytorch_fuserXXXXXX.so";
 static const std::string cpp_template = "/tmp/pytorch_fuserXXXXXX.cpp";
 static const std::string check_exists_string = "which '${program}' > /dev/null";
 constexpr int so_suffix_len = 3;
 constexpr int cpp_suffix_len = 4;
+static const std::string so_ext = "so";
 #endif
 
 static bool programExists(const std::string& program) {
@@ -164,6 +169,37 @@ intptr_t run(const std::string& cmd) {
 }
 #endif
 
+#ifdef _MSC_VER
+static const std::string version_string = "\"${cxx}\" 2>&1";
+#else
+static const std::string version_string = "\"${cxx}\" --version 2>&1";
+#endif
+static std::string compilerVersion(const std::string& cxx) {
+  if (cxx.empty()) {
+    return "";
+  }
+  TemplateEnv env;
+  env.s("cxx", cxx);
+  std::string cmd = format(version_string, env);
+#ifdef _MSC_VER
+  c10::optional<std::string> out = exec(cmd);
+  return out ? *out : "";
+#else
+  std::string result;
+  FILE* pipe = popen(cmd.c_str(), "r");
+  if (pipe == nullptr) {
+    return result;
+  }
+  std::array<char, 128> buffer;
+  while (fgets(buffer.data(), static_cast<int>(buffer.size()), pipe) !=
+         nullptr) {
+    result += buffer.data();
+  }
+  pclose(pipe);
+  return result;
+#endif
+}
+
 // A single compiler config is accessed through getConfig() (below)
 // Controls compilation options and may be updated based on the result
 // of compilation attempts.
@@ -183,6 +219,14 @@ struct CompilerConfig {
     }
   }
 
+  // Identifies the compiler for the on-disk kernel cache
+  const std::string& version() {
+    if (!version_) {
+      version_ = compilerVersion(cxx);
+    }
+    return *version_;
+  }
+
   ~CompilerConfig() = default;
 
 #ifdef _MSC_VER
@@ -193,6 +237,9 @@ struct CompilerConfig {
   const std::string openmp_flags = "-fopenmp";
 #endif
   bool openmp = true;
+
+ private:
+  c10::optional<std::string> version_;
 };
 
 static CompilerConfig& getConfig() {
@@ -269,6 +316,26 @@ static void runCompiler(
   TORCH_CHECK(r == 0, "Failed to compile a fused CPU kernel");
 }
 
+// Everything the compiled kernel depends on: its source, the compiler and
+// the exact command line used to build it.
+static std::string diskCacheKey(const std::string& code, bool openmp) {
+  auto& config = getConfig();
+  std::string key = "cpu_fuser\n";
+  key += config.version();
+  key += compile_string;
+  key += openmp ? config.openmp_flags : "";
+  key += "\n";
+  key += code;
+  return key;
+}
+
+static std::string readBinaryFile(const std::string& path) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
 #ifdef _MSC_VER
 static const std::string disas_string =
     "dumpbin /DISASM:NOBYTES \"${so_file}\"";
@@ -299,18 +366,42 @@ FusedKernelCPU::FusedKernelCPU(
           std::move(chunk_desc),
           std::move(concat_desc),
           has_random) {
-  TempFile so_file(so_template, so_suffix_len);
-  TempFile cpp_file(cpp_template, cpp_suffix_len);
-  cpp_file.write(code_);
-  cpp_file.sync();
+  auto& config = getConfig();
+  auto& disk_cache = KernelDiskCache::get();
+  c10::optional<std::string> cached;
+  if (disk_cache.enabled()) {
+    // Whether the compiler supports openmp is only known after a compile:
+    // when it does not, kernels are stored under the key without openmp,
+    // which a new process has to look up as well to hit.
+    std::vector<std::string> keys = {diskCacheKey(code_, config.openmp)};
+    if (config.openmp) {
+      keys.push_back(diskCacheKey(code_, false));
+    }
+    cached = disk_cache.lookup(keys, so_ext);
+  }
+  if (cached) {
+    so_lib = make_unique<at::DynamicLibrary>(cached->c_str());
+  } else {
+    TempFile so_file(so_template, so_suffix_len);
+    TempFile cpp_file(cpp_template, cpp_suffix_len);
+    cpp_file.write(code_);
+    cpp_file.sync();
 #ifdef _MSC_VER
-  so_file.close();
-  cpp_file.close();
+    so_file.close();
+    cpp_file.close();
 #endif
-  runCompiler(cpp_file.name(), so_file.name());
-  if (debugFuser() >= 2)
-    disas(so_file.name());
-  so_lib = make_unique<at::DynamicLibrary>(so_file.name().c_str());
+    runCompiler(cpp_file.name(), so_file.name());
+    if (debugFuser() >= 2)
+      disas(so_file.name());
+    if (disk_cache.enabled()) {
+      // The key is recomputed since a failed compile may have disabled openmp
+      disk_cache.store(
+          diskCacheKey(code_, config.openmp),
+          so_ext,
+          readBinaryFile(so_file.name()));
+    }
+    so_lib = make_unique<at::DynamicLibrary>(so_file.name().c_str());
+  }
 #pragma GCC diagnostic ignored "-Wpedantic"
   kernel =
       reinterpret_cast<void (*)(uint32_t, void**)>(so_lib->sym(name_.c_str()));
@@ -0,0 +1,350 @@
+#include <torch/csrc/jit/codegen/kernel_disk_cache.h>
+
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/jit_log.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+#ifdef _WIN32
+constexpr char kPathSeparator = '\\';
+#else
+constexpr char kPathSeparator = '/';
+#endif
+
+bool readFile(const std::string& path, std::string& out) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  out = ss.str();
+  return !in.bad();
+}
+
+bool fileExists(const std::string& path) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  return static_cast<bool>(in);
+}
+
+bool isPathSeparator(char c) {
+#ifdef _WIN32
+  return c == '\\' || c == '/';
+#else
+  return c == '/';
+#endif
+}
+
+// Creates dir and any missing parent directories, like `mkdir -p`.
+bool makeDirectory(const std::string& dir) {
+  for (size_t i = 1; i <= dir.size(); ++i) {
+    if (i < dir.size() && !isPathSeparator(dir[i])) {
+      continue;
+    }
+    // Skip the drive of a Windows path, e.g. `C:`
+    if (i == 2 && dir[1] == ':') {
+      continue;
+    }
+    const std::string prefix = dir.substr(0, i);
+#ifdef _WIN32
+    int r = _mkdir(prefix.c_str());
+#else
+    int r = mkdir(prefix.c_str(), 0755);
+#endif
+    if (r != 0 && errno != EEXIST) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int currentPid() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+// Writes `contents` next to `path` and renames it into place, so that
+// concurrent readers never observe a partially written entry.
+bool writeFileAtomic(const std::string& path, const std::string& contents) {
+  static std::atomic<int64_t> counter{0};
+  std::string tmp = path + ".tmp" + std::to_string(currentPid()) + "_" +
+      std::to_string(counter++);
+  {
+    std::ofstream out(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    out.write(contents.data(), contents.size());
+    if (!out) {
+      out.close();
+      std::remove(tmp.c_str());
+      return false;
+    }
+  }
+#ifdef _WIN32
+  // rename() does not replace existing files on Windows
+  if (!MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+#else
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+#endif
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+std::string kernelDiskCacheHash(const std::string& key) {
+  // Two independent 64-bit FNV-1a hashes; the stored key guards against
+  // the remaining collisions.
+  uint64_t h1 = 14695981039346656037ULL;
+  uint64_t h2 = 0x84222325cbf29ce4ULL;
+  for (unsigned char c : key) {
+    h1 = (h1 ^ c) * 1099511628211ULL;
+    h2 = (h2 ^ c) * 0x100000001b3ULL + 0x9e3779b97f4a7c15ULL;
+  }
+  char buf[33];
+  snprintf(
+      buf,
+      sizeof(buf),
+      "%016llx%016llx",
+      static_cast<unsigned long long>(h1),
+      static_cast<unsigned long long>(h2));
+  return std::string(buf);
+}
+
+KernelDiskCache& KernelDiskCache::get() {
+  static KernelDiskCache cache;
+  return cache;
+}
+
+KernelDiskCache::KernelDiskCache() {
+  const char* dir = std::getenv("PYTORCH_JIT_KERNEL_CACHE_DIR");
+  if (dir != nullptr) {
+    setDirectory(dir);
+  }
+}
+
+bool KernelDiskCache::enabled() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return !dir_.empty();
+}
+
+std::string KernelDiskCache::directory() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return dir_;
+}
+
+void KernelDiskCache::setDirectory(const std::string& dir) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  index_.clear();
+  loaded_ = 0;
+  dir_.clear();
+  if (dir.empty()) {
+    return;
+  }
+  if (!makeDirectory(dir)) {
+    TORCH_WARN(
+        "Could not create kernel cache directory ",
+        dir,
+        ", the kernel cache is disabled");
+    return;
+  }
+  dir_ = dir;
+  if (dir_.back() == kPathSeparator) {
+    dir_.pop_back();
+  }
+  loadIndex();
+}
+
+std::string KernelDiskCache::entryPath(
+    const std::string& hash,
+    const std::string& ext) const {
+  return dir_ + kPathSeparator + hash + "." + ext;
+}
+
+// Loads the keys of all complete entries in dir_. Called with mutex_ held.
+void KernelDiskCache::loadIndex() {
+  const std::string key_ext = ".key";
+  auto addEntry = [&](const std::string& name) {
+    if (name.size() <= key_ext.size() ||
+        name.compare(name.size() - key_ext.size(), key_ext.size(), key_ext) !=
+            0) {
+      return;
+    }
+    std::string hash = name.substr(0, name.size() - key_ext.size());
+    std::string key;
+    if (readFile(entryPath(hash, "key"), key)) {
+      index_.emplace(std::move(hash), std::move(key));
+    }
+  };
+#ifdef _WIN32
+  WIN32_FIND_DATAA data;
+  const std::string pattern = dir_ + kPathSeparator + "*" + key_ext;
+  HANDLE find = FindFirstFileA(pattern.c_str(), &data);
+  if (find == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  do {
+    addEntry(data.cFileName);
+  } while (FindNextFileA(find, &data));
+  FindClose(find);
+#else
+  DIR* d = opendir(dir_.c_str());
+  if (d == nullptr) {
+    return;
+  }
+  while (struct dirent* entry = readdir(d)) {
+    addEntry(entry->d_name);
+  }
+  closedir(d);
+#endif
+  loaded_ = index_.size();
+  GRAPH_DEBUG("Loaded ", index_.size(), " kernels from ", dir_);
+}
+
+c10::optional<std::string> KernelDiskCache::find(
+    const std::string& key,
+    const std::string& ext) {
+  const std::string hash = kernelDiskCacheHash(key);
+  std::string path;
+  std::string key_path;
+  bool known = false;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (dir_.empty()) {
+      return c10::nullopt;
+    }
+    auto it = index_.find(hash);
+    if (it != index_.end()) {
+      if (it->second != key) {
+        // A hash collision; treat it as a miss.
+        return c10::nullopt;
+      }
+      known = true;
+    }
+    path = entryPath(hash, ext);
+    key_path = entryPath(hash, "key");
+  }
+
+  if (!known) {
+    // The entry may have been written by another process since the index
+    // was loaded.
+    std::string stored_key;
+    if (!readFile(key_path, stored_key) || stored_key != key) {
+      return c10::nullopt;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    index_.emplace(hash, key);
+  }
+
+  // The key is published after the artifact, so this only fails if the
+  // artifact was stored with a different extension or removed externally.
+  if (!fileExists(path)) {
+    return c10::nullopt;
+  }
+  return path;
+}
+
+c10::optional<std::string> KernelDiskCache::lookup(
+    const std::string& key,
+    const std::string& ext) {
+  return lookup(std::vector<std::string>{key}, ext);
+}
+
+c10::optional<std::string> KernelDiskCache::lookup(
+    const std::vector<std::string>& keys,
+    const std::string& ext) {
+  if (!enabled()) {
+    return c10::nullopt;
+  }
+  for (const auto& key : keys) {
+    if (auto path = find(key, ext)) {
+      ++hits_;
+      return path;
+    }
+  }
+  ++misses_;
+  return c10::nullopt;
+}
+
+c10::optional<std::string> KernelDiskCache::store(
+    const std::string& key,
+    const std::string& ext,
+    const std::string& contents) {
+  const std::string hash = kernelDiskCacheHash(key);
+  std::string path;
+  std::string key_path;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (dir_.empty()) {
+      return c10::nullopt;
+    }
+    path = entryPath(hash, ext);
+    key_path = entryPath(hash, "key");
+  }
+
+  // Publish the artifact first so that a visible key always refers to a
+  // complete artifact.
+  if (!writeFileAtomic(path, contents) || !writeFileAtomic(key_path, key)) {
+    TORCH_WARN("Failed to write compiled kernel to the cache at ", path);
+    return c10::nullopt;
+  }
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    index_[hash] = key;
+  }
+  ++stores_;
+  GRAPH_DEBUG("Stored kernel ", path);
+  return path;
+}
+
+KernelDiskCacheStats KernelDiskCache::stats() const {
+  KernelDiskCacheStats s;
+  s.loaded = loaded_;
+  s.hits = hits_;
+  s.misses = misses_;
+  s.stores = stores_;
+  return s;
+}
+
+void KernelDiskCache::resetStats() {
+  hits_ = 0;
+  misses_ = 0;
+  stores_ = 0;
+}
+
+void setKernelDiskCacheDir(const std::string& dir) {
+  KernelDiskCache::get().setDirectory(dir);
+}
+
+KernelDiskCacheStats kernelDiskCacheStats() {
+  return KernelDiskCache::get().stats();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A content-addressed, on-disk cache for compiled kernels (shared objects
+// produced by the legacy CPU fuser and object code produced by the
+// TensorExpr LLVM backend). It is disabled unless a cache directory is set,
+// either through the `PYTORCH_JIT_KERNEL_CACHE_DIR` environment variable or
+// setKernelDiskCacheDir().
+//
+// Every entry is addressed by a hash of its key, which the caller builds from
+// everything the compiled code depends on: the kernel source or IR, the
+// compiler (or LLVM) version and the target CPU. The full key is stored next
+// to the entry and compared on lookup, so hash collisions degrade to misses.
+//
+// Layout of the cache directory:
+//   <hash>.key      the key the entry was stored under
+//   <hash>.<ext>    the compiled artifact (e.g. `so` or `o`)
+
+namespace torch {
+namespace jit {
+
+struct KernelDiskCacheStats {
+  // Entries found in the cache directory when it was opened
+  int64_t loaded = 0;
+  int64_t hits = 0;
+  int64_t misses = 0;
+  int64_t stores = 0;
+};
+
+class TORCH_API KernelDiskCache {
+ public:
+  // Returns the process-wide cache. On first use the cache directory is read
+  // from `PYTORCH_JIT_KERNEL_CACHE_DIR` and its keys are loaded.
+  static KernelDiskCache& get();
+
+  bool enabled() const;
+
+  // Switches the cache to `dir`, creating it and its parents if needed, and
+  // loads the keys of the entries it already holds. An empty string disables
+  // the cache.
+  void setDirectory(const std::string& dir);
+  std::string directory() const;
+
+  // Returns the path of the artifact stored under `key`, if any.
+  // Counts a hit or a miss.
+  c10::optional<std::string> lookup(
+      const std::string& key,
+      const std::string& ext);
+
+  // Like lookup(), for the first of `keys` that has an entry. Counts a
+  // single hit or miss.
+  c10::optional<std::string> lookup(
+      const std::vector<std::string>& keys,
+      const std::string& ext);
+
+  // Atomically publishes `contents` under `key`. Failures to write are
+  // reported as warnings; the cache is an optimization only.
+  // Returns the path of the stored artifact on success.
+  c10::optional<std::string> store(
+      const std::string& key,
+      const std::string& ext,
+      const std::string& contents);
+
+  KernelDiskCacheStats stats() const;
+  void resetStats();
+
+ private:
+  KernelDiskCache();
+
+  std::string entryPath(const std::string& hash, const std::string& ext)
+      const;
+  void loadIndex();
+  // lookup() without counting a hit or a miss
+  c10::optional<std::string> find(
+      const std::string& key,
+      const std::string& ext);
+
+  mutable std::mutex mutex_;
+  std::string dir_;
+  // hash -> key of the entries known to be present in dir_
+  std::unordered_map<std::string, std::string> index_;
+
+  std::atomic<int64_t> loaded_{0};
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+  std::atomic<int64_t> stores_{0};
+};
+
+// Returns a stable, filename-safe hash of `key`.
+TORCH_API std::string kernelDiskCacheHash(const std::string& key);
+
+TORCH_API void setKernelDiskCacheDir(const std::string& dir);
+TORCH_API KernelDiskCacheStats kernelDiskCacheStats();
+
+} // namespace jit
+} // namespace torch
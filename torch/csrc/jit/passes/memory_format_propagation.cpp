@@ -0,0 +1,367 @@
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
+
+#include <c10/core/MemoryFormat.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+enum class FormatBehavior {
+  // only has a channels-last kernel: copies NCHW input to channels-last and
+  // its channels-last result back
+  kChannelsLastOnly,
+  // has kernels for both layouts and keeps the layout of its input
+  kChannelsLastCapable,
+  // elementwise; the output takes the layout of the operands
+  kPointwise,
+  // elementwise and in place; the output is `self`
+  kInplacePointwise,
+  // only reads metadata, so the layout doesn't matter
+  kMetadata,
+  // anything else is assumed to want contiguous input
+  kContiguous,
+};
+
+FormatBehavior behaviorOf(const Node* n) {
+  static const Symbol conv2d_clamp_run =
+      Symbol::fromQualString("prepacked::conv2d_clamp_run");
+  static const std::unordered_set<Symbol> pointwise = {
+      Symbol::aten("relu"),
+      Symbol::aten("sigmoid"),
+      Symbol::aten("tanh"),
+      Symbol::aten("hardtanh"),
+      Symbol::aten("hardsigmoid"),
+      Symbol::aten("hardswish"),
+      Symbol::aten("leaky_relu"),
+      Symbol::aten("elu"),
+      Symbol::aten("clamp"),
+      Symbol::aten("add"),
+      Symbol::aten("sub"),
+      Symbol::aten("mul"),
+      Symbol::aten("div"),
+  };
+  static const std::unordered_set<Symbol> inplace_pointwise = {
+      Symbol::aten("relu_"),
+      Symbol::aten("sigmoid_"),
+      Symbol::aten("tanh_"),
+      Symbol::aten("hardtanh_"),
+      Symbol::aten("hardsigmoid_"),
+      Symbol::aten("hardswish_"),
+      Symbol::aten("leaky_relu_"),
+      Symbol::aten("elu_"),
+      Symbol::aten("clamp_"),
+      Symbol::aten("add_"),
+      Symbol::aten("sub_"),
+      Symbol::aten("mul_"),
+      Symbol::aten("div_"),
+  };
+
+  if (!n->blocks().empty()) {
+    return FormatBehavior::kContiguous;
+  }
+  if (n->kind() == conv2d_clamp_run) {
+    return FormatBehavior::kChannelsLastOnly;
+  }
+  switch (n->kind()) {
+    case aten::upsample_nearest2d:
+    case aten::upsample_bilinear2d:
+      return FormatBehavior::kChannelsLastCapable;
+    case aten::batch_norm: {
+      // only the inference kernel has a channels-last path
+      auto training = n->inputs().size() == 9
+          ? constant_as<bool>(n->input(5))
+          : c10::nullopt;
+      return training && !*training ? FormatBehavior::kChannelsLastCapable
+                                    : FormatBehavior::kContiguous;
+    }
+    case aten::size:
+    case aten::dim:
+    case aten::numel:
+    case aten::__is__:
+    case aten::__isnot__:
+    case prim::device:
+    case prim::dtype:
+      return FormatBehavior::kMetadata;
+    default:
+      break;
+  }
+  if (pointwise.count(n->kind())) {
+    return FormatBehavior::kPointwise;
+  }
+  if (inplace_pointwise.count(n->kind())) {
+    return FormatBehavior::kInplacePointwise;
+  }
+  return FormatBehavior::kContiguous;
+}
+
+bool isTensor(const Value* v) {
+  return v->type()->isSubtypeOf(TensorType::get());
+}
+
+c10::optional<size_t> dimOf(const Value* v) {
+  if (auto type = v->type()->cast<TensorType>()) {
+    if (auto dim = type->dim()) {
+      return dim;
+    }
+  }
+  if (auto t = constant_as<at::Tensor>(v)) {
+    return t->dim();
+  }
+  return c10::nullopt;
+}
+
+bool isFourDim(const Value* v) {
+  auto dim = dimOf(v);
+  return dim && *dim == 4;
+}
+
+TypePtr typeWithFormat(const TypePtr& type, c10::MemoryFormat format) {
+  auto tensor_type = type->cast<TensorType>();
+  if (!tensor_type) {
+    return type;
+  }
+  auto sizes = tensor_type->sizes().concrete_sizes();
+  if (!sizes) {
+    // whatever strides were recorded no longer hold
+    return tensor_type->dimensionedOnly();
+  }
+  if (format == c10::MemoryFormat::ChannelsLast) {
+    return tensor_type->withSizesStrides(
+        *sizes, c10::get_channels_last_strides_2d(*sizes));
+  }
+  return tensor_type->contiguous();
+}
+
+class ChannelsLastPropagator {
+ public:
+  explicit ChannelsLastPropagator(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)), aliasDb_(graph_) {}
+
+  bool run() {
+    plan();
+    size_t channels_last_cost = conversions_.size() + hidden_conversions_;
+    GRAPH_DEBUG(
+        "Channels-last needs ",
+        channels_last_cost,
+        " conversions, NCHW needs ",
+        contiguous_cost_);
+    if (channels_last_cost >= contiguous_cost_) {
+      return false;
+    }
+    apply();
+    return true;
+  }
+
+ private:
+  // An aten::contiguous to insert right after the definition of `value`,
+  // and the uses that should read its result instead of `value`.
+  struct Conversion {
+    Value* value;
+    c10::MemoryFormat format;
+    std::vector<Use> uses;
+  };
+
+  void plan() {
+    for (Node* n : graph_->nodes()) {
+      switch (behaviorOf(n)) {
+        case FormatBehavior::kChannelsLastOnly:
+          contiguous_cost_ += 2;
+          if (useChannelsLast(n, 0)) {
+            channels_last_.insert(n->output());
+          } else {
+            hidden_conversions_ += 2;
+          }
+          useContiguous(n, 1);
+          break;
+        case FormatBehavior::kChannelsLastCapable:
+          if (channels_last_.count(n->input(0))) {
+            channels_last_.insert(n->output());
+          }
+          useContiguous(n, 1);
+          break;
+        case FormatBehavior::kPointwise:
+          planPointwise(n);
+          break;
+        case FormatBehavior::kInplacePointwise:
+          if (channels_last_.count(n->input(0))) {
+            // the output is `self`, so it is channels-last whatever the
+            // layout of the other operands; converting them just avoids
+            // strided reads
+            for (size_t i = 1; i < n->inputs().size(); ++i) {
+              if (isTensor(n->input(i)) && isFourDim(n->input(i))) {
+                useChannelsLast(n, i);
+              }
+            }
+            channels_last_.insert(n->output());
+          }
+          break;
+        case FormatBehavior::kMetadata:
+          break;
+        case FormatBehavior::kContiguous:
+          useContiguous(n, 0);
+          for (Block* b : n->blocks()) {
+            useContiguousInBlock(b);
+          }
+          break;
+      }
+    }
+    useContiguous(graph_->return_node(), 0);
+  }
+
+  void planPointwise(Node* n) {
+    bool any_channels_last = false;
+    std::vector<size_t> to_convert;
+    for (size_t i = 0; i < n->inputs().size(); ++i) {
+      Value* v = n->input(i);
+      if (!isTensor(v)) {
+        continue;
+      }
+      if (channels_last_.count(v)) {
+        any_channels_last = true;
+        continue;
+      }
+      auto dim = dimOf(v);
+      if (!dim) {
+        // might be a full-size NCHW operand, which would leave the layout of
+        // the output up to TensorIterator
+        return;
+      }
+      // lower rank operands broadcast over the spatial dims
+      if (*dim == 4) {
+        if (!to_channels_last_.count(v) && aliasDb_.hasWriters(v)) {
+          return;
+        }
+        to_convert.push_back(i);
+      }
+    }
+    if (!any_channels_last) {
+      return;
+    }
+    for (size_t i : to_convert) {
+      useChannelsLast(n, i);
+    }
+    channels_last_.insert(n->output());
+  }
+
+  // Makes input `i` of `user` read a channels-last value, inserting a
+  // conversion if needed. Returns false if the value may not be converted.
+  bool useChannelsLast(Node* user, size_t i) {
+    Value* v = user->input(i);
+    if (channels_last_.count(v)) {
+      return true;
+    }
+    if (!to_channels_last_.count(v) && aliasDb_.hasWriters(v)) {
+      return false;
+    }
+    addUse(to_channels_last_, v, c10::MemoryFormat::ChannelsLast, user, i);
+    return true;
+  }
+
+  // Makes the inputs of `user` starting at `begin` read contiguous values.
+  void useContiguous(Node* user, size_t begin) {
+    for (size_t i = begin; i < user->inputs().size(); ++i) {
+      Value* v = user->input(i);
+      if (!channels_last_.count(v)) {
+        continue;
+      }
+      if (aliasDb_.hasWriters(v)) {
+        // the op copies it itself; graph outputs are left in channels-last
+        if (user != graph_->return_node()) {
+          hidden_conversions_++;
+        }
+        continue;
+      }
+      addUse(to_contiguous_, v, c10::MemoryFormat::Contiguous, user, i);
+    }
+  }
+
+  void useContiguousInBlock(Block* b) {
+    for (Node* n : b->nodes()) {
+      useContiguous(n, 0);
+      for (Block* sub : n->blocks()) {
+        useContiguousInBlock(sub);
+      }
+    }
+    useContiguous(b->return_node(), 0);
+  }
+
+  void addUse(
+      std::unordered_map<Value*, size_t>& index,
+      Value* v,
+      c10::MemoryFormat format,
+      Node* user,
+      size_t i) {
+    auto it = index.find(v);
+    if (it == index.end()) {
+      it = index.emplace(v, conversions_.size()).first;
+      conversions_.push_back({v, format, {}});
+    }
+    conversions_[it->second].uses.emplace_back(user, i);
+  }
+
+  void apply() {
+    Node* first = graph_->block()->nodes().front();
+    std::unordered_map<int64_t, Value*> format_constants;
+    auto formatConstant = [&](c10::MemoryFormat format) {
+      auto key = static_cast<int64_t>(format);
+      auto it = format_constants.find(key);
+      if (it == format_constants.end()) {
+        WithInsertPoint guard(first);
+        it = format_constants.emplace(key, graph_->insertConstant(format))
+                 .first;
+      }
+      return it->second;
+    };
+
+    for (Value* v : channels_last_) {
+      v->setType(typeWithFormat(v->type(), c10::MemoryFormat::ChannelsLast));
+    }
+    for (const Conversion& conversion : conversions_) {
+      Value* v = conversion.value;
+      Node* convert = graph_->create(
+          aten::contiguous, {v, formatConstant(conversion.format)});
+      if (v->node() == graph_->param_node()) {
+        convert->insertBefore(first);
+      } else {
+        convert->insertAfter(v->node());
+      }
+      convert->output()->setType(typeWithFormat(v->type(), conversion.format));
+      for (const Use& use : conversion.uses) {
+        use.user->replaceInput(use.offset, convert->output());
+      }
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  AliasDb aliasDb_;
+  // values produced in channels-last
+  std::unordered_set<Value*> channels_last_;
+  std::vector<Conversion> conversions_;
+  // index into conversions_ of the conversion of a value to each layout
+  std::unordered_map<Value*, size_t> to_channels_last_;
+  std::unordered_map<Value*, size_t> to_contiguous_;
+  // copies ops make internally under the channels-last plan
+  size_t hidden_conversions_ = 0;
+  // copies ops make internally if the graph stays NCHW
+  size_t contiguous_cost_ = 0;
+};
+
+} // namespace
+
+bool PropagateChannelsLast(const std::shared_ptr<Graph>& graph) {
+  bool changed = ChannelsLastPropagator(graph).run();
+  if (changed) {
+    GRAPH_DUMP("After PropagateChannelsLast: ", graph);
+  }
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch
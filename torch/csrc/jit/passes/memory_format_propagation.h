@@ -0,0 +1,35 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Chooses between NCHW and channels-last (NHWC) for the 4-d activations of a
+// frozen inference graph, and makes the choice explicit in the graph.
+//
+// Some CPU kernels only run in channels-last: XNNPACK convolutions
+// (prepacked::conv2d_clamp_run) copy an NCHW input into NHWC and copy their
+// result back, so a chain of them in an NCHW graph converts twice per
+// convolution. Under the channels-last plan, activations are converted once
+// where they enter a region of ops that handle channels-last natively (the
+// convolutions above, batch_norm in inference mode and the 2d upsampling ops)
+// or elementwise (relu, hardtanh, add, mul, ...), and converted back once
+// where they leave it, i.e. where they reach an op that expects contiguous
+// input, such as a view or a native convolution, or a graph output.
+// Elementwise ops run in channels-last because every full-size operand they
+// read is channels-last, and TensorIterator gives their output the same
+// layout; their output types are marked as channels-last when their sizes are
+// known.
+//
+// The pass counts the conversions each plan needs, including the copies ops
+// make internally, and only rewrites the graph if channels-last needs fewer.
+// Values that are written in place are never converted, so aliasing is
+// preserved. Only the top-level block is planned; uses in nested blocks are
+// treated as wanting contiguous input.
+//
+// Returns true if the graph was changed.
+TORCH_API bool PropagateChannelsLast(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
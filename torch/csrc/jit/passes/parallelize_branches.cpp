@@ -0,0 +1,287 @@
+#include <torch/csrc/jit/passes/parallelize_branches.h>
+
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/runtime/op_timings.h>
+#include <torch/csrc/utils/memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+std::atomic<bool> parallelize_branches_enabled{false};
+
+// Guesses for ops that have not been profiled: a fixed per-op overhead plus a
+// per-element cost when the output sizes are known.
+constexpr double kDefaultOpCostUs = 5.0;
+constexpr double kOpOverheadUs = 1.0;
+constexpr double kElementCostUs = 1e-3;
+
+struct Branch {
+  // produces the value the joining node consumes
+  Node* root;
+  // in topological order, ending with root
+  std::vector<Node*> nodes;
+  double cost_us = 0;
+};
+
+class BranchParallelizer {
+ public:
+  BranchParallelizer(std::shared_ptr<Graph> graph, double min_branch_cost_us)
+      : graph_(std::move(graph)), min_branch_cost_us_(min_branch_cost_us) {}
+
+  bool run() {
+    return processBlock(graph_->block());
+  }
+
+ private:
+  AliasDb& aliasDb() {
+    if (!aliasDb_) {
+      aliasDb_ = torch::make_unique<AliasDb>(graph_);
+    }
+    return *aliasDb_;
+  }
+
+  bool processBlock(Block* block) {
+    bool changed = false;
+    // forks and waits are inserted as we go, so iterate over a snapshot.
+    // Nodes moved into a fork always come before the join being processed,
+    // so nothing in the snapshot is destroyed before it is visited.
+    std::vector<Node*> joins(block->nodes().begin(), block->nodes().end());
+    joins.push_back(block->return_node());
+    for (Node* join : joins) {
+      for (Block* b : join->blocks()) {
+        changed |= processBlock(b);
+      }
+      changed |= parallelizeInputs(join);
+    }
+    return changed;
+  }
+
+  bool canFork(Node* n) {
+    switch (n->kind()) {
+      case prim::ListConstruct:
+      case prim::ListUnpack:
+      case prim::TupleConstruct:
+      case prim::TupleUnpack:
+      case prim::TupleIndex:
+      case prim::ConstantChunk:
+      case prim::FusionGroup:
+        break;
+      default:
+        if (!n->kind().is_aten() || n->kind() == aten::wait) {
+          return false;
+        }
+    }
+    return n->blocks().empty() && !n->hasSideEffects() &&
+        !n->isNondeterministic() && !aliasDb().hasWriters(n);
+  }
+
+  // Collects the nodes whose outputs only flow into `root`, walking backwards
+  // from it. `frontier` holds the producers of values the branch reads that
+  // have not been visited yet; once it is empty no earlier node can belong to
+  // the branch.
+  Branch collectBranch(Node* root) {
+    Block* block = root->owningBlock();
+    std::unordered_set<Node*> members{root};
+    std::unordered_set<Node*> frontier;
+    auto addMember = [&](Node* n) {
+      members.insert(n);
+      for (Value* input : n->inputs()) {
+        Node* producer = input->node();
+        if (producer->owningBlock() == block &&
+            producer != block->param_node() &&
+            producer->kind() != prim::Constant) {
+          frontier.insert(producer);
+        }
+      }
+    };
+    auto usesOnlyInBranch = [&](Node* n) {
+      bool used = false;
+      for (Value* output : n->outputs()) {
+        for (const Use& use : output->uses()) {
+          if (!members.count(use.user)) {
+            return false;
+          }
+          used = true;
+        }
+      }
+      return used;
+    };
+
+    Branch branch{root};
+    branch.nodes.push_back(root);
+    addMember(root);
+    for (Node* n = root->prev(); !frontier.empty(); n = n->prev()) {
+      if (!frontier.erase(n)) {
+        continue;
+      }
+      if (usesOnlyInBranch(n) && canFork(n)) {
+        branch.nodes.push_back(n);
+        addMember(n);
+      }
+    }
+    std::reverse(branch.nodes.begin(), branch.nodes.end());
+    for (Node* n : branch.nodes) {
+      branch.cost_us += estimateNodeCostUs(n);
+    }
+    return branch;
+  }
+
+  bool parallelizeInputs(Node* join) {
+    std::vector<Branch> branches;
+    std::unordered_set<Node*> roots;
+    for (Value* input : join->inputs()) {
+      Node* root = input->node();
+      if (root->owningBlock() != join->owningBlock() ||
+          root->outputs().size() != 1 || !roots.insert(root).second ||
+          !canFork(root)) {
+        continue;
+      }
+      bool only_used_by_join = std::all_of(
+          input->uses().begin(), input->uses().end(), [&](const Use& use) {
+            return use.user == join;
+          });
+      if (!only_used_by_join) {
+        continue;
+      }
+      Branch branch = collectBranch(root);
+      if (branch.cost_us >= min_branch_cost_us_) {
+        branches.push_back(std::move(branch));
+      }
+    }
+    if (branches.size() < 2) {
+      return false;
+    }
+
+    // the most expensive branch stays on the calling thread
+    std::sort(
+        branches.begin(), branches.end(), [](const Branch& a, const Branch& b) {
+          return a.cost_us > b.cost_us;
+        });
+    for (size_t i = 1; i < branches.size(); ++i) {
+      GRAPH_DEBUG(
+          "Forking branch of ",
+          branches[i].nodes.size(),
+          " nodes (",
+          branches[i].cost_us,
+          "us) ending in ",
+          *branches[i].root);
+      forkBranch(branches[i], join);
+    }
+    aliasDb_.reset();
+    return true;
+  }
+
+  void forkBranch(const Branch& branch, Node* join) {
+    Block* block = join->owningBlock();
+    auto subgraph = std::make_shared<Graph>();
+    std::unordered_map<Value*, Value*> env;
+    std::vector<Value*> fork_inputs;
+    // the last node in `block` producing a value the branch reads; the fork
+    // goes right after it so the branch starts as early as possible
+    Node* insert_point = nullptr;
+
+    auto valueFor = [&](Value* v) -> Value* {
+      auto it = env.find(v);
+      if (it != env.end()) {
+        return it->second;
+      }
+      Value* subgraph_value = nullptr;
+      if (v->node()->kind() == prim::Constant) {
+        subgraph_value =
+            subgraph->insertNode(subgraph->createClone(v->node(), {nullptr}))
+                ->output();
+      } else {
+        subgraph_value = subgraph->addInput()->copyMetadata(v);
+        fork_inputs.push_back(v);
+        Node* producer = v->node();
+        if (producer->owningBlock() == block &&
+            producer != block->param_node() &&
+            (!insert_point || producer->isAfter(insert_point))) {
+          insert_point = producer;
+        }
+      }
+      env[v] = subgraph_value;
+      return subgraph_value;
+    };
+    for (Node* n : branch.nodes) {
+      Node* clone = subgraph->insertNode(subgraph->createClone(n, valueFor));
+      for (size_t i = 0; i < n->outputs().size(); ++i) {
+        env[n->outputs()[i]] = clone->outputs()[i];
+      }
+    }
+    Value* result = branch.root->output();
+    subgraph->registerOutput(env.at(result));
+
+    Node* fork = graph_->create(prim::fork, fork_inputs, 1);
+    fork->g_(attr::Subgraph, subgraph);
+    fork->output()->setType(FutureType::create(result->type()));
+    fork->setSourceRange(branch.root->sourceRange());
+    if (insert_point) {
+      fork->insertAfter(insert_point);
+    } else {
+      fork->insertBefore(block->nodes().front());
+    }
+
+    Node* wait = graph_->create(aten::wait, {fork->output()}, 1);
+    wait->setSourceRange(branch.root->sourceRange());
+    wait->insertBefore(join);
+    result->replaceAllUsesWith(wait->output());
+    wait->output()->copyMetadata(result);
+    for (auto it = branch.nodes.rbegin(); it != branch.nodes.rend(); ++it) {
+      (*it)->destroy();
+    }
+  }
+
+  std::shared_ptr<Graph> graph_;
+  double min_branch_cost_us_;
+  std::unique_ptr<AliasDb> aliasDb_;
+};
+
+} // namespace
+
+double estimateNodeCostUs(const Node* node) {
+  if (auto profiled = OpTimings::get().averageUs(node->kind().toQualString())) {
+    return *profiled;
+  }
+  double cost = kOpOverheadUs;
+  for (const Value* output : node->outputs()) {
+    auto type = output->type()->cast<TensorType>();
+    if (!type) {
+      continue;
+    }
+    auto numel = type->numel();
+    if (!numel) {
+      return kDefaultOpCostUs;
+    }
+    cost += *numel * kElementCostUs;
+  }
+  return cost;
+}
+
+bool ParallelizeBranches(
+    const std::shared_ptr<Graph>& graph,
+    double min_branch_cost_us) {
+  bool changed = BranchParallelizer(graph, min_branch_cost_us).run();
+  if (changed) {
+    GRAPH_DUMP("After ParallelizeBranches: ", graph);
+  }
+  return changed;
+}
+
+void setParallelizeBranchesEnabled(bool enabled) {
+  parallelize_branches_enabled = enabled;
+}
+
+bool parallelizeBranchesEnabled() {
+  return parallelize_branches_enabled;
+}
+
+} // namespace jit
+} // namespace torch
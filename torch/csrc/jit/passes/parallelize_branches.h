@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Finds independent branches of a graph that are expensive enough to be worth
+// running concurrently, e.g. the towers of a multi-tower model or the heads of
+// an ensemble, and moves all but the most expensive one into prim::fork
+// subgraphs. The interpreter runs forked subgraphs on the inter-op thread pool
+// (at::launch), and an aten::wait is inserted right before the node that joins
+// the branches.
+//
+// A branch is the set of nodes whose results only flow into one input of the
+// joining node. Every node in it must be free of side effects and
+// nondeterminism, and nothing in the graph may write to the values it reads or
+// produces (according to AliasDb), so running it early on another thread
+// cannot be observed.
+//
+// Branch costs come from OpTimings when the ops have been profiled and from a
+// size-based guess otherwise. A branch is forked only if its estimated cost is
+// at least `min_branch_cost_us` microseconds, which should comfortably exceed
+// the cost of a fork (a few microseconds).
+//
+// Returns true if the graph was changed.
+TORCH_API bool ParallelizeBranches(
+    const std::shared_ptr<Graph>& graph,
+    double min_branch_cost_us = 50.0);
+
+// Estimated cost of running `node` in microseconds.
+TORCH_API double estimateNodeCostUs(const Node* node);
+
+// Whether the graph executor runs ParallelizeBranches on graphs that don't
+// need gradients. Off by default.
+TORCH_API void setParallelizeBranchesEnabled(bool enabled);
+TORCH_API bool parallelizeBranchesEnabled();
+
+} // namespace jit
+} // namespace torch
@@ -24,6 +24,7 @@ std::vector<std::string> _static_quantizable_call_funcs = {
     "layer_norm",
     "group_norm",
     "instance_norm",
+    "softmax",
 };
 
 std::vector<std::string> _static_quantizable_aten_funcs = {
@@ -39,6 +40,9 @@ std::vector<std::string> _static_quantizable_aten_funcs = {
     "layer_norm",
     "group_norm",
     "instance_norm",
+    "softmax",
+    "gelu",
+    "matmul",
 };
 
 std::vector<std::string> _dynamic_quantizable_call_funcs = {
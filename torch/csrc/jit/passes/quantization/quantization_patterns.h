@@ -233,6 +233,15 @@ bool input_b_is_scalar(
   return isScalar(b_scalar);
 }
 
+// filter that checks %dtype is None, i.e. the op computes in the input dtype
+bool dtype_is_none(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap) {
+  const auto& match_vmap = match.values_map;
+  auto dtype = toIValue(match_vmap.at(vmap.at("dtype")));
+  return dtype && dtype->isNone();
+}
+
 // Patterns for ops that require observation for output quantization parameters
 // Example:
 //
@@ -253,7 +262,8 @@ QuantFusionInfo getObservedQParamOpFusionInfo(
     const std::string& fp_op_name,
     const std::string& q_op_name,
     const std::vector<std::string>& fp_extra_args,
-    const std::vector<std::string>& q_extra_args) {
+    const std::vector<std::string>& q_extra_args,
+    const std::vector<MatchFilter>& filters = {}) {
   const auto& fp_extra_arg_list = getExtraArgList(fp_extra_args);
   const auto& q_extra_arg_list = getExtraArgList(q_extra_args);
 
@@ -272,7 +282,7 @@ QuantFusionInfo getObservedQParamOpFusionInfo(
       ", %r_scale, %r_zero_point)" + R"(
           return (%r_quant) )";
 
-  return {q_op_name, op_pattern, aten_op_pattern};
+  return {q_op_name, op_pattern, aten_op_pattern, filters};
 }
 
 } // namespace
@@ -732,6 +742,21 @@ graph(%a_quant, %b_scalar):
          %r = quantized::mul_scalar_relu_out(%a_quant, %b_scalar, %a_quant)
          return (%r) )";
 
+  // aten::matmul
+  std::string matmul = R"(
+graph(%a_quant, %b_quant, %scale, %zero_point, %dtype):
+         %a_dequant = aten::dequantize(%a_quant)
+         %b_dequant = aten::dequantize(%b_quant)
+         %r_matmul = aten::matmul(%a_dequant, %b_dequant)
+         %r = aten::quantize_per_tensor(%r_matmul, %scale, %zero_point, %dtype)
+         return (%r) )";
+
+  // quantized::matmul
+  std::string quantized_matmul = R"(
+graph(%a_quant, %b_quant, %scale, %zero_point, %dtype):
+         %r = quantized::matmul(%a_quant, %b_quant, %scale, %zero_point)
+         return (%r) )";
+
   // quantized::elu
   std::string elu = R"(
 graph(%a_quant, %alpha, %scale, %input_scale, %r_scale, %r_zero_point, %r_dtype):
@@ -860,6 +885,18 @@ graph(%a_quant, %alpha, %scale, %input_scale, %r_scale, %r_zero_point, %r_dtype)
       {"%normalized_shape", "%weight", "%bias", "%eps", "%cudnn_enabled"},
       {"%normalized_shape", "%weight", "%bias", "%eps"});
 
+  // quantized::softmax computes in the input dtype, so only softmax without
+  // an explicit %dtype is fused
+  auto softmax = getObservedQParamOpFusionInfo(
+      "aten::softmax",
+      "quantized::softmax",
+      {"%dim", "%dtype"},
+      {"%dim"},
+      {dtype_is_none});
+
+  auto gelu =
+      getObservedQParamOpFusionInfo("aten::gelu", "quantized::gelu", {}, {});
+
   auto group_norm = getObservedQParamOpFusionInfo(
       "aten::group_norm",
       "quantized::group_norm",
@@ -956,9 +993,12 @@ graph(%a_quant, %alpha, %scale, %input_scale, %r_scale, %r_zero_point, %r_dtype)
       {"quantized::mul_relu", inplace_mul_inplace_relu, quantized_mul_relu},
       {"quantized::mul", mul, quantized_mul},
       {"quantized::mul", inplace_mul, quantized_mul},
+      {"quantized::matmul", matmul, quantized_matmul},
       hardswish,
       hardswish_,
       layer_norm,
+      softmax,
+      gelu,
       group_norm,
       instance_norm,
       {"quantized::elu", elu, quantized_elu},
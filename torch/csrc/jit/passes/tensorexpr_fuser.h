@@ -15,6 +15,9 @@ TORCH_API void FuseTensorExprs(std::shared_ptr<Graph>& graph);
 TORCH_API void setTensorExprFuserEnabled(bool val);
 TORCH_API bool tensorExprFuserEnabled();
 
+// Kind of the fusion group nodes created by FuseTensorExprs
+TORCH_API const Symbol& getTensorExprSymbol();
+
 namespace tensorexpr {
 TORCH_API bool isSupported(Node* node);
 }
@@ -8,6 +8,7 @@
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
 #include <torch/csrc/jit/passes/graph_rewrite_helper.h>
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
 #include <torch/csrc/jit/passes/prepack_folding.h>
 #include <torch/csrc/jit/passes/remove_dropout.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
@@ -276,7 +277,8 @@ void FoldPrePackingOps(script::Module& m) {
 
 script::Module optimizeForMobile(
     const script::Module& m,
-    const std::set<MobileOptimizerType>& optimization_blacklist) {
+    const std::set<MobileOptimizerType>& optimization_blacklist,
+    bool propagate_channels_last) {
   auto cloned_module = m.clone();
   cloned_module.eval();
 
@@ -301,6 +303,10 @@ script::Module optimizeForMobile(
     removeDropout(cloned_module);
   }
 
+  if (propagate_channels_last) {
+    PropagateChannelsLast(cloned_module.get_method("forward").graph());
+  }
+
   return cloned_module;
 }
 
@@ -328,7 +334,8 @@ void FoldPrePackingOps(script::Module& m) {
 
 script::Module optimizeForMobile(
     const script::Module& module,
-    const std::set<MobileOptimizerType>& blacklist) {
+    const std::set<MobileOptimizerType>& blacklist,
+    bool propagate_channels_last) {
   TORCH_INTERNAL_ASSERT(
       "Mobile optimizaiton only available with XNNPACK at the moment. "
       "XNNPACK is not enabled. Please build with USE_XNNPACK=1");
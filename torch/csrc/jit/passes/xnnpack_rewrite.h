@@ -16,8 +16,12 @@ TORCH_API void insertPrePackedOps(std::shared_ptr<Graph>& graph);
 TORCH_API void insertPrePackedOps(script::Module& module);
 TORCH_API void fusePrePackedLinearConvWithClamp(script::Module& module);
 TORCH_API void FoldPrePackingOps(script::Module& module);
+// Passes in `optimization_blacklist` are skipped. PropagateChannelsLast
+// (memory_format_propagation.h) changes the layout of activations, so it only
+// runs when `propagate_channels_last` is set.
 TORCH_API script::Module optimizeForMobile(
     const script::Module& module,
-    const std::set<MobileOptimizerType>& optimization_blacklist = {});
+    const std::set<MobileOptimizerType>& optimization_blacklist = {},
+    bool propagate_channels_last = false);
 } // namespace jit
 } // namespace torch
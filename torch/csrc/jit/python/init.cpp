@@ -2,8 +2,11 @@
 
 #include <torch/csrc/jit/api/module.h>
 #include <torch/csrc/jit/backends/backend_init.h>
+#include <torch/csrc/jit/codegen/aot/aot_compiler.h>
+#include <torch/csrc/jit/codegen/aot/aot_module.h>
 #include <torch/csrc/jit/codegen/fuser/interface.h>
 #include <torch/csrc/jit/codegen/fuser/kernel_cache.h>
+#include <torch/csrc/jit/codegen/kernel_disk_cache.h>
 #include <torch/csrc/jit/frontend/ir_emitter.h>
 #include <torch/csrc/jit/frontend/tracer.h>
 #include <torch/csrc/jit/ir/irparser.h>
@@ -27,6 +30,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_graph.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/memory_format_propagation.h>
 #include <torch/csrc/jit/passes/normalize_ops.h>
 #include <torch/csrc/jit/passes/onnx.h>
 #include <torch/csrc/jit/passes/onnx/cast_all_constant_to_floating.h>
@@ -39,6 +43,7 @@
 #include <torch/csrc/jit/passes/onnx/prepare_inplace_ops_for_onnx.h>
 #include <torch/csrc/jit/passes/onnx/scalar_type_analysis.h>
 #include <torch/csrc/jit/passes/onnx/unpack_quantized_weights.h>
+#include <torch/csrc/jit/passes/parallelize_branches.h>
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/quantization/dedup_module_uses.h>
 #include <torch/csrc/jit/passes/quantization/finalize.h>
@@ -66,7 +71,9 @@
 #include <torch/csrc/jit/runtime/argument_spec.h>
 #include <torch/csrc/jit/runtime/autodiff.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
+#include <torch/csrc/jit/runtime/interpreter.h>
 #include <torch/csrc/jit/runtime/jit_exception.h>
+#include <torch/csrc/jit/runtime/op_timings.h>
 #include <torch/csrc/jit/runtime/operator.h>
 #include <torch/csrc/jit/runtime/print_handler.h>
 #include <torch/csrc/jit/serialization/export.h>
@@ -331,6 +338,20 @@ void initJITBindings(PyObject* module) {
       .def("_jit_pass_remove_expands", RemoveExpands)
       .def("_jit_pass_erase_number_types", EraseNumberTypes)
       .def("_jit_pass_inline_fork_wait", InlineForkWait)
+      .def(
+          "_jit_pass_parallelize_branches",
+          [](std::shared_ptr<Graph>& g, double min_branch_cost_us) {
+            return ParallelizeBranches(g, min_branch_cost_us);
+          },
+          py::arg("graph"),
+          py::arg("min_branch_cost_us") = 50.0)
+      .def("_jit_set_parallelize_branches", &setParallelizeBranchesEnabled)
+      .def("_jit_parallelize_branches_enabled", &parallelizeBranchesEnabled)
+      .def(
+          "_jit_set_op_timings_enabled",
+          [](bool enabled) { OpTimings::get().setEnabled(enabled); })
+      .def("_jit_op_timings", []() { return OpTimings::get().averages(); })
+      .def("_jit_clear_op_timings", []() { OpTimings::get().clear(); })
       .def("_jit_pass_inline", Inline)
       .def("_jit_pass_prepare_division_for_onnx", PrepareDivisionForONNX)
       .def(
@@ -399,6 +420,34 @@ void initJITBindings(PyObject* module) {
       .def("_jit_override_can_fuse_on_gpu", &overrideCanFuseOnGPU)
       .def("_jit_can_fuse_on_cpu", &canFuseOnCPU)
       .def("_jit_can_fuse_on_gpu", &canFuseOnGPU)
+      .def("_jit_set_kernel_cache_dir", &setKernelDiskCacheDir)
+      .def(
+          "_jit_aot_generate_source",
+          [](std::shared_ptr<Graph>& g) {
+            return aot::generateAotSource(g).source;
+          })
+      .def(
+          "_jit_aot_compile",
+          [](std::shared_ptr<Graph>& g,
+             const std::string& so_path,
+             const std::vector<std::string>& include_dirs,
+             const std::vector<std::string>& library_dirs) {
+            aot::AotCompileOptions options;
+            options.include_dirs = include_dirs;
+            options.library_dirs = library_dirs;
+            aot::compileAotModule(g, so_path, options);
+          })
+      .def(
+          "_jit_kernel_cache_stats",
+          []() {
+            auto stats = kernelDiskCacheStats();
+            py::dict d;
+            d["loaded"] = stats.loaded;
+            d["hits"] = stats.hits;
+            d["misses"] = stats.misses;
+            d["stores"] = stats.stores;
+            return d;
+          })
       .def(
           "_jit_differentiate",
           [](Graph& g) {
@@ -432,6 +481,13 @@ void initJITBindings(PyObject* module) {
             getExecutorMode() = profiling_flag;
             return oldState;
           })
+      .def(
+          "_jit_set_interpreter_superinstructions",
+          [](bool enabled) {
+            bool oldState = getInterpreterSuperinstructions();
+            getInterpreterSuperinstructions() = enabled;
+            return oldState;
+          })
       .def(
           "_jit_set_num_profiled_runs",
           [](size_t num) {
@@ -539,9 +595,17 @@ void initJITBindings(PyObject* module) {
       .def(
           "_jit_pass_optimize_for_mobile",
           [](script::Module& module,
-             std::set<MobileOptimizerType>& optimization_blacklist) {
-            return optimizeForMobile(module, optimization_blacklist);
-          })
+             std::set<MobileOptimizerType>& optimization_blacklist,
+             bool propagate_channels_last) {
+            return optimizeForMobile(
+                module, optimization_blacklist, propagate_channels_last);
+          },
+          py::arg("module"),
+          py::arg("optimization_blacklist"),
+          py::arg("propagate_channels_last") = false)
+      .def(
+          "_jit_pass_propagate_channels_last",
+          [](std::shared_ptr<Graph>& g) { return PropagateChannelsLast(g); })
       .def(
           "_jit_pass_vulkan_insert_prepacked_ops",
           [](std::shared_ptr<Graph>& graph) {
@@ -669,6 +733,12 @@ void initJITBindings(PyObject* module) {
       .def_property_readonly(
           "fallback", [](GraphExecutorState& s) { return s.fallback; });
 
+  py::class_<aot::AotModule, std::shared_ptr<aot::AotModule>>(m, "_AotModule")
+      .def(py::init<std::string>())
+      .def("run", &aot::AotModule::run)
+      .def_property_readonly("num_inputs", &aot::AotModule::num_inputs)
+      .def_property_readonly("num_outputs", &aot::AotModule::num_outputs);
+
   py::class_<PyTorchStreamWriter>(m, "PyTorchFileWriter")
       .def(py::init<std::string>())
       .def(py::init([](const py::object& buffer) {
@@ -22,6 +22,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_grad_of.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/parallelize_branches.h>
 #include <torch/csrc/jit/passes/pass_manager.h>
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
@@ -636,6 +637,9 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
           autodiff_subgraph_inlining ? autodiffSubgraphInlineThreshold : 1);
     } else {
       runNondiffOptimization(opt_graph);
+      if (parallelizeBranchesEnabled()) {
+        ParallelizeBranches(opt_graph);
+      }
     }
     // Make sure there are no leftovers from any passes.
     EliminateDeadCode(opt_graph);
@@ -17,6 +17,10 @@ namespace jit {
 // T - index into the type table, used for guard instructions
 // S - index into object slots
 // C - index into code table
+//
+// The *_OP, OP_STORE and *_OP_STORE superinstructions are only ever produced
+// by the interpreter when it fuses adjacent instructions (see
+// fuseInstructions in interpreter.cpp); they are never serialized.
 
 #define FORALL_OPCODES(_)                                                   \
   _(OP, "O") /* invoke operator X */                                        \
@@ -53,7 +57,16 @@ namespace jit {
   _(FORK, "CN") /* launch a thread to run code entry x with N inputs  */    \
   _(WARN, "") /* emit a warning with line information */                    \
   _(ENTER, "EN") /* enter scope of a contextmanager */                      \
-  _(EXIT, "EX") /* exit the last entered contextmanager */
+  _(EXIT, "EX") /* exit the last entered contextmanager */                  \
+  _(OP_STORE, "OR") /* invoke operator X, store its output to register N */ \
+  _(LOAD_OP, "OR") /* push a value from register N, invoke operator X */    \
+  _(MOVE_OP, "OR") /* move a value from register N, invoke operator X */    \
+  _(LOADC_OP, "OC") /* push the constant N, invoke operator X */          \
+  /* the *_OP_STORE superinstructions pack operator X & 0xffff and the */   \
+  /* register X >> 16 the output is stored to into X */                     \
+  _(LOAD_OP_STORE, "OR") /* LOAD_OP, then store to a register */            \
+  _(MOVE_OP_STORE, "OR") /* MOVE_OP, then store to a register */            \
+  _(LOADC_OP_STORE, "OC") /* LOADC_OP, then store to a register */
 
 enum OpCode : uint8_t {
 #define DEFINE_OP(op, _) op,
@@ -30,6 +30,7 @@ using torch::distributed::autograd::DistAutogradContainer;
 
 #include <exception>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <ostream>
@@ -43,6 +44,12 @@ using torch::distributed::autograd::DistAutogradContainer;
 namespace torch {
 namespace jit {
 
+static std::atomic<bool> interpreter_superinstructions{false};
+
+std::atomic<bool>& getInterpreterSuperinstructions() {
+  return interpreter_superinstructions;
+}
+
 // Before we translate to intepreter instructions, we do
 // some preprocessing of the graph to turn it into a form that is closer
 // to what the instructions will look like.
@@ -420,6 +427,13 @@ struct CodeImpl {
   // instruction to be emitted?
   std::vector<Node*> instructions_source_;
 
+  // instructions_ and instructions_source_ hold what the interpreter runs,
+  // which may contain superinstructions (see fuseInstructions). These are the
+  // instructions as originally emitted, which is what Code::instructions()
+  // exposes, e.g. for the mobile bytecode export.
+  std::vector<Instruction> unfused_instructions_;
+  std::vector<Node*> unfused_instructions_source_;
+
   std::vector<IValue> constant_table_;
   std::vector<Operation> operator_table_;
   std::vector<Function*> function_table_;
@@ -483,6 +497,11 @@ struct CodeImpl {
     // we deferred the emission of bailout blocks so they appear at the end
     // emit them now and patch up the jumps
     insertBailoutBlocks();
+    unfused_instructions_ = instructions_;
+    unfused_instructions_source_ = instructions_source_;
+    if (getInterpreterSuperinstructions()) {
+      fuseInstructions();
+    }
   }
 
   const std::vector<c10::IValue>& constant_table() const {
@@ -490,31 +509,35 @@ struct CodeImpl {
   }
 
   void request_bailout(size_t index) {
-    auto count = index;
-    for (size_t instr_index = 0; instr_index < instructions_.size();
-         instr_index++) {
-      if (instructions_[instr_index].op == GUARD ||
-          instructions_[instr_index].op == FAIL_GUARD) {
-        if (count-- == 0) {
-          // patching GUARD to FAIL_GUARD
-          instructions_[instr_index].op = FAIL_GUARD;
-          GRAPH_DEBUG(
-              "Added a bailout request for ",
-              index,
-              " at instruction ",
-              instr_index);
-          break;
+    // guards are never fused, so both instruction lists have them in the
+    // same order
+    for (auto* instructions : {&instructions_, &unfused_instructions_}) {
+      auto count = index;
+      for (size_t instr_index = 0; instr_index < instructions->size();
+           instr_index++) {
+        Instruction& inst = (*instructions)[instr_index];
+        if (inst.op == GUARD || inst.op == FAIL_GUARD) {
+          if (count-- == 0) {
+            // patching GUARD to FAIL_GUARD
+            inst.op = FAIL_GUARD;
+            GRAPH_DEBUG(
+                "Added a bailout request for ",
+                index,
+                " at instruction ",
+                instr_index);
+            break;
+          }
         }
       }
     }
   }
 
   const std::vector<Instruction>& instructions() const {
-    return instructions_;
+    return unfused_instructions_;
   }
 
   const std::vector<Node*>& instructions_source() const {
-    return instructions_source_;
+    return unfused_instructions_source_;
   }
 
   void insertInstruction(OpCode op, int64_t X = 0, uint64_t N = 0) {
@@ -757,6 +780,102 @@ struct CodeImpl {
     insertInstruction(SET_ATTR, slot);
   }
 
+  static bool isJump(OpCode op) {
+    return op == JF || op == JMP || op == LOOP;
+  }
+
+  // Replaces common sequences of instructions with a single superinstruction
+  // so the interpreter loop dispatches once instead of two or three times:
+  //   LOAD r; OP o; STORE s   -> LOAD_OP_STORE (s << 16 | o) r
+  //   MOVE r; OP o; STORE s   -> MOVE_OP_STORE (s << 16 | o) r
+  //   LOADC c; OP o; STORE s  -> LOADC_OP_STORE (s << 16 | o) c
+  //   OP o; STORE r           -> OP_STORE o r
+  //   LOAD r; OP o            -> LOAD_OP o r
+  //   MOVE r; OP o            -> MOVE_OP o r
+  //   LOADC c; OP o           -> LOADC_OP o c
+  // An OP is fused with the instruction that pushes its last input and with
+  // the STORE of its output, when it has them. A sequence is left alone if
+  // anything jumps into it past its first instruction, or if its operands
+  // don't fit. Jump offsets are rewritten for the shorter instruction list.
+  void fuseInstructions() {
+    const size_t n = instructions_.size();
+    std::vector<bool> is_target(n + 1, false);
+    for (size_t i = 0; i < n; ++i) {
+      if (isJump(instructions_[i].op)) {
+        is_target[static_cast<int64_t>(i) + instructions_[i].X] = true;
+      }
+    }
+    auto fitsInN = [](int32_t v) {
+      return v >= 0 && v <= std::numeric_limits<uint16_t>::max();
+    };
+    // the store register goes in the upper 16 bits of X, which is signed
+    auto fitsInPackedStore = [](int32_t v) {
+      return v >= 0 && v <= std::numeric_limits<int16_t>::max();
+    };
+    auto fusesWithStore = [&](size_t op_index) {
+      size_t store_index = op_index + 1;
+      return store_index < n && instructions_[store_index].op == STORE &&
+          !is_target[store_index] && fitsInN(instructions_[store_index].X);
+    };
+
+    std::vector<Instruction> fused;
+    std::vector<Node*> fused_source;
+    fused.reserve(n);
+    fused_source.reserve(n);
+    // index of each original instruction in the fused list
+    std::vector<int64_t> new_index(n + 1);
+    for (size_t i = 0; i < n; ++i) {
+      new_index[i] = fused.size();
+      const Instruction& inst = instructions_[i];
+      const bool pushes_operand =
+          (inst.op == LOAD || inst.op == MOVE || inst.op == LOADC) &&
+          i + 1 < n && instructions_[i + 1].op == OP && !is_target[i + 1] &&
+          fitsInN(inst.X);
+      if (pushes_operand && fusesWithStore(i + 1) &&
+          fitsInN(instructions_[i + 1].X) &&
+          fitsInPackedStore(instructions_[i + 2].X)) {
+        OpCode op = inst.op == LOAD ? LOAD_OP_STORE
+            : inst.op == MOVE       ? MOVE_OP_STORE
+                                    : LOADC_OP_STORE;
+        fused.emplace_back(
+            op,
+            instructions_[i + 2].X << 16 | instructions_[i + 1].X,
+            inst.X);
+        fused_source.push_back(instructions_source_[i + 1]);
+        new_index[++i] = fused.size() - 1;
+        new_index[++i] = fused.size() - 1;
+        continue;
+      }
+      if (inst.op == OP && fusesWithStore(i)) {
+        fused.emplace_back(OP_STORE, inst.X, instructions_[i + 1].X);
+        fused_source.push_back(instructions_source_[i]);
+        new_index[++i] = fused.size() - 1;
+        continue;
+      }
+      if (pushes_operand && !fusesWithStore(i + 1)) {
+        OpCode op = inst.op == LOAD ? LOAD_OP
+            : inst.op == MOVE       ? MOVE_OP
+                                    : LOADC_OP;
+        fused.emplace_back(op, instructions_[i + 1].X, inst.X);
+        fused_source.push_back(instructions_source_[i + 1]);
+        new_index[++i] = fused.size() - 1;
+        continue;
+      }
+      fused.push_back(inst);
+      fused_source.push_back(instructions_source_[i]);
+    }
+    new_index[n] = fused.size();
+
+    for (size_t i = 0; i < n; ++i) {
+      if (isJump(instructions_[i].op)) {
+        int64_t target = static_cast<int64_t>(i) + instructions_[i].X;
+        fused[new_index[i]].X = new_index[target] - new_index[i];
+      }
+    }
+    instructions_ = std::move(fused);
+    instructions_source_ = std::move(fused_source);
+  }
+
   void insertBailoutBlocks() {
     for (const BailoutBlock& block : bailout_blocks_) {
       TORCH_INTERNAL_ASSERT(instructions_[block.jf_instruction_index].op == JF)
@@ -950,11 +1069,22 @@ struct CodeImpl {
 
   void dump(std::ostream& out, size_t i) const {
     out << i << " " << instructions_[i];
-    if (instructions_[i].op == OP || instructions_[i].op == CALL ||
-        instructions_[i].op == OPN) {
-      out << " # " << *instructions_source_[i];
-    } else {
-      out << "\n";
+    switch (instructions_[i].op) {
+      case OP:
+      case OPN:
+      case CALL:
+      case OP_STORE:
+      case LOAD_OP:
+      case MOVE_OP:
+      case LOADC_OP:
+      case LOAD_OP_STORE:
+      case MOVE_OP_STORE:
+      case LOADC_OP_STORE:
+        out << " # " << *instructions_source_[i];
+        break;
+      default:
+        out << "\n";
+        break;
     }
   }
 
@@ -1187,6 +1317,48 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             stack.emplace_back(af.constants[inst.X]);
             ++af.pc;
             break;
+          case OP_STORE:
+            af.operators[inst.X](stack);
+            reg(inst.N) = std::move(stack.back());
+            stack.pop_back();
+            ++af.pc;
+            break;
+          case LOAD_OP:
+            stack.emplace_back(reg(inst.N));
+            af.operators[inst.X](stack);
+            ++af.pc;
+            break;
+          case MOVE_OP:
+            stack.emplace_back(std::move(reg(inst.N)));
+            af.operators[inst.X](stack);
+            ++af.pc;
+            break;
+          case LOADC_OP:
+            stack.emplace_back(af.constants[inst.N]);
+            af.operators[inst.X](stack);
+            ++af.pc;
+            break;
+          case LOAD_OP_STORE:
+            stack.emplace_back(reg(inst.N));
+            af.operators[inst.X & 0xffff](stack);
+            reg(inst.X >> 16) = std::move(stack.back());
+            stack.pop_back();
+            ++af.pc;
+            break;
+          case MOVE_OP_STORE:
+            stack.emplace_back(std::move(reg(inst.N)));
+            af.operators[inst.X & 0xffff](stack);
+            reg(inst.X >> 16) = std::move(stack.back());
+            stack.pop_back();
+            ++af.pc;
+            break;
+          case LOADC_OP_STORE:
+            stack.emplace_back(af.constants[inst.N]);
+            af.operators[inst.X & 0xffff](stack);
+            reg(inst.X >> 16) = std::move(stack.back());
+            stack.pop_back();
+            ++af.pc;
+            break;
           case GET_ATTR: {
             auto userObj = pop(stack).toObject();
             auto value = userObj->getSlot(inst.X);
@@ -1,5 +1,6 @@
 #pragma once
 #include <c10/util/Optional.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -126,5 +127,10 @@ struct InterpreterContinuation {
 TORCH_API at::TensorTypePtr tensorTypeInCurrentExecutionContext(
     const at::Tensor& t);
 
+// Whether Code fuses common instruction sequences (e.g. an operator and the
+// STORE of its output) into single superinstructions. Off by default; only
+// affects Code objects created after the flag is changed.
+TORCH_API std::atomic<bool>& getInterpreterSuperinstructions();
+
 } // namespace jit
 } // namespace torch
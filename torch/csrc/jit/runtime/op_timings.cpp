@@ -0,0 +1,91 @@
+#include <torch/csrc/jit/runtime/op_timings.h>
+
+#include <chrono>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// start times of the RecordFunctions currently open on this thread; ops nest
+// properly on a thread so a stack is enough to pair starts with ends
+thread_local std::vector<Clock::time_point> start_times;
+
+void onStart(const at::RecordFunction&) {
+  start_times.push_back(Clock::now());
+}
+
+void onEnd(const at::RecordFunction& fn) {
+  // ends of async ops may run on a thread that never saw the start
+  if (start_times.empty()) {
+    return;
+  }
+  auto elapsed = Clock::now() - start_times.back();
+  start_times.pop_back();
+  OpTimings::get().record(
+      fn.name().str(),
+      std::chrono::duration<double, std::micro>(elapsed).count());
+}
+
+} // namespace
+
+OpTimings& OpTimings::get() {
+  static OpTimings timings;
+  return timings;
+}
+
+void OpTimings::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> guard(handle_mutex_);
+  if (enabled == handle_.has_value()) {
+    return;
+  }
+  if (enabled) {
+    handle_ = at::addGlobalCallback(
+        at::RecordFunctionCallback(onStart, onEnd)
+            .scopes({at::RecordScope::FUNCTION}));
+  } else {
+    at::removeCallback(*handle_);
+    handle_ = c10::nullopt;
+  }
+  enabled_ = enabled;
+}
+
+bool OpTimings::enabled() const {
+  return enabled_;
+}
+
+void OpTimings::record(const std::string& op, double us) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto& entry = timings_[op];
+  entry.total_us += us;
+  entry.count++;
+}
+
+c10::optional<double> OpTimings::averageUs(const std::string& op) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = timings_.find(op);
+  if (it == timings_.end()) {
+    return c10::nullopt;
+  }
+  return it->second.total_us / it->second.count;
+}
+
+std::unordered_map<std::string, double> OpTimings::averages() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::unordered_map<std::string, double> result;
+  for (const auto& kv : timings_) {
+    result[kv.first] = kv.second.total_us / kv.second.count;
+  }
+  return result;
+}
+
+void OpTimings::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  timings_.clear();
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <ATen/record_function.h>
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+// Average run time of operators, keyed by qualified name (e.g. "aten::conv2d")
+// and collected from RecordFunction events while enabled. Passes use it as a
+// cost model, e.g. to decide whether a branch is worth running on another
+// thread. Timings are inclusive: an op that calls other ops is charged for
+// them too.
+class TORCH_API OpTimings {
+ public:
+  static OpTimings& get();
+
+  // Installs or removes the global RecordFunction callback that records
+  // timings. Concurrent calls are serialized; enabled() may be read from
+  // any thread.
+  void setEnabled(bool enabled);
+  bool enabled() const;
+
+  void record(const std::string& op, double us);
+  c10::optional<double> averageUs(const std::string& op) const;
+  std::unordered_map<std::string, double> averages() const;
+  void clear();
+
+ private:
+  OpTimings() = default;
+
+  struct Entry {
+    double total_us = 0;
+    size_t count = 0;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> timings_;
+  // guards handle_, which is only touched by setEnabled()
+  std::mutex handle_mutex_;
+  c10::optional<at::CallbackHandle> handle_;
+  std::atomic<bool> enabled_{false};
+};
+
+} // namespace jit
+} // namespace torch
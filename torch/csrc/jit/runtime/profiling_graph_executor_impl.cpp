@@ -18,6 +18,7 @@
 #include <torch/csrc/jit/passes/loop_unrolling.h>
 #include <torch/csrc/jit/passes/lower_grad_of.h>
 #include <torch/csrc/jit/passes/lower_tuples.h>
+#include <torch/csrc/jit/passes/parallelize_branches.h>
 #include <torch/csrc/jit/passes/peephole.h>
 #include <torch/csrc/jit/passes/remove_expands.h>
 #include <torch/csrc/jit/passes/requires_grad_analysis.h>
@@ -117,6 +118,9 @@ void ProfilingGraphExecutorImpl::runProfilingOptimizations(
 
   } else {
     runNondiffOptimization(copy, true);
+    if (parallelizeBranchesEnabled()) {
+      ParallelizeBranches(copy);
+    }
   }
   EliminateDeadCode(copy);
   GRAPH_DUMP("Optimized Graph : ", copy);
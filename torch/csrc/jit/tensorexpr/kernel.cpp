@@ -5,6 +5,7 @@
 #include <torch/csrc/jit/tensorexpr/analysis.h>
 #include <torch/csrc/jit/tensorexpr/ir_printer.h>
 #include <torch/csrc/jit/tensorexpr/ir_simplifier.h>
+#include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
 
 using namespace torch::jit;
@@ -1485,6 +1486,26 @@ Stmt* TensorExprKernel::getCodeGenStmt() {
   return codegen_->stmt();
 }
 
+c10::optional<std::string> TensorExprKernel::compileToObject(
+    const std::string& name) {
+#ifdef TORCH_ENABLE_LLVM
+  if (fallback_ || !codegen_ || device_ != at::kCPU) {
+    return c10::nullopt;
+  }
+  // Sizes and strides are only passed for inputs of dynamic shape.
+  for (const auto& arg : kernelArgs_) {
+    if (!arg.sizes().empty() || !arg.strides().empty()) {
+      return c10::nullopt;
+    }
+  }
+  KernelScope kernelScope(&kernelArena_);
+  return LLVMCodeGen::compileToObject(
+      codegen_->stmt(), codegen_->buffer_args(), name);
+#else
+  return c10::nullopt;
+#endif
+}
+
 void TensorExprKernel::runKernel(Stack& stack) {
   KernelScope kernelScope(&kernelArena_);
 
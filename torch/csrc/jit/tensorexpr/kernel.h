@@ -54,6 +54,13 @@ class TORCH_API TensorExprKernel {
 
   Stmt* getCodeGenStmt();
 
+  // Compiles the kernel for ahead-of-time use, see
+  // LLVMCodeGen::compileToObject(). The object takes the inputs of the
+  // subgraph, then its outputs, allocated contiguous with the sizes and
+  // dtypes of the subgraph outputs. Returns nullopt if the kernel runs on
+  // the fallback interpreter or is not compiled with LLVM for the CPU.
+  c10::optional<std::string> compileToObject(const std::string& name);
+
  private:
   enum BackendType {
     kUninitialized,
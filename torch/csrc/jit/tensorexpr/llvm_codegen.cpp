@@ -4,17 +4,23 @@
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
 
 #include <memory>
+#include <sstream>
 
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 
+#include <torch/csrc/jit/codegen/kernel_disk_cache.h>
 #include <torch/csrc/jit/tensorexpr/buffer.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
 #include <torch/csrc/jit/tensorexpr/ir.h>
@@ -51,12 +57,24 @@ class LLVMCodeGenImpl : public IRVisitor {
   std::unordered_map<const Var*, int> varToArg_;
   std::unordered_map<const Var*, llvm::Value*> varToVal_;
 
+  // Vector math calls go to the Sleef functions that the JIT resolves in
+  // this process, or are scalarized into libm calls.
+  bool useSleef_{true};
+  std::string objectCode_;
+
  private:
   llvm::LLVMContext& getContext();
   llvm::Type* dtypeToLLVM(Dtype dtype);
   llvm::Type* dtypeToLLVMPtr(Dtype dtype);
-  void emitWrapper(const std::vector<llvm::Type*>& params);
+  std::vector<llvm::Type*> emitPrototype(
+      const std::vector<CodeGen::BufferArg>& args,
+      Dtype dtype,
+      llvm::orc::JITTargetMachineBuilder& JTMB);
+  void emitWrapper(
+      const std::vector<llvm::Type*>& params,
+      const std::string& name);
   void emitKernel(Stmt* stmt, const std::vector<llvm::Type*>& params);
+  std::unique_ptr<llvm::MemoryBuffer> emitObject();
 
  public:
   LLVMCodeGenImpl(
@@ -64,8 +82,17 @@ class LLVMCodeGenImpl : public IRVisitor {
       const std::vector<CodeGen::BufferArg>& args,
       at::Device device,
       Dtype dtype);
+  // Compiles the kernel into object code instead of loading it into the JIT,
+  // see LLVMCodeGen::compileToObject().
+  LLVMCodeGenImpl(
+      Stmt* stmt,
+      const std::vector<CodeGen::BufferArg>& args,
+      Dtype dtype,
+      const std::string& wrapperName);
   ~LLVMCodeGenImpl() = default;
 
+  const std::string& objectCode() const;
+
   llvm::JITTargetAddress getKernelAddress() const;
   void** getArgvAddress() const;
 
@@ -161,6 +188,14 @@ LLVMCodeGen::LLVMCodeGen(
     : CodeGen(stmt, args, device),
       impl_(std::make_unique<LLVMCodeGenImpl>(stmt, args, device, dtype)) {}
 
+std::string LLVMCodeGen::compileToObject(
+    Stmt* stmt,
+    const std::vector<BufferArg>& args,
+    const std::string& name,
+    Dtype dtype) {
+  return LLVMCodeGenImpl(stmt, args, dtype, name).objectCode();
+}
+
 static void* argToPtr(
     const CodeGen::BufferArg& bufferArg,
     const CodeGen::CallArg& callArg) {
@@ -211,12 +246,42 @@ void** LLVMCodeGenImpl::getArgvAddress() const {
   return argv_.get();
 }
 
-LLVMCodeGenImpl::LLVMCodeGenImpl(
+// Everything the object code for a kernel depends on: the LLVM version, the
+// target and its features, the kernel signature and the kernel IR.
+static std::string diskCacheKey(
     Stmt* stmt,
     const std::vector<CodeGen::BufferArg>& args,
-    at::Device device,
-    Dtype dtype)
-    : context_(std::make_unique<llvm::LLVMContext>()), irb_(getContext()) {
+    Dtype dtype,
+    const llvm::orc::JITTargetMachineBuilder& JTMB) {
+  std::ostringstream ss;
+  ss << "tensorexpr_llvm\n"
+     << LLVM_VERSION_STRING << "\n"
+     << JTMB.getTargetTriple().str() << "\n"
+     << llvm::sys::getHostCPUName().str() << "\n";
+  for (const auto& feature : JTMB.getFeatures().getFeatures()) {
+    ss << feature << ",";
+  }
+  ss << "\n";
+
+  // Print the arguments and the body with the same printer so that they
+  // agree on variable names.
+  IRPrinter printer(ss);
+  printer.os() << dtype << "(";
+  for (const auto& arg : args) {
+    arg.var()->accept(&printer);
+    printer.os() << ":" << arg.dtype() << (arg.isVar() ? "" : "*") << ",";
+  }
+  printer.os() << ")\n";
+  stmt->accept(&printer);
+  return ss.str();
+}
+
+// Sets up the module for `JTMB` and emits the prototype of the kernel.
+// Returns the LLVM types of its parameters.
+std::vector<llvm::Type*> LLVMCodeGenImpl::emitPrototype(
+    const std::vector<CodeGen::BufferArg>& args,
+    Dtype dtype,
+    llvm::orc::JITTargetMachineBuilder& JTMB) {
   // Manually map types to LLVM types.
   ByteTy_ = llvm::Type::getInt8Ty(getContext());
   CharTy_ = llvm::Type::getInt8Ty(getContext());
@@ -228,13 +293,8 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   DoubleTy_ = llvm::Type::getDoubleTy(getContext());
   BoolTy_ = ByteTy_;
 
-  llvm::InitializeNativeTarget();
-  llvm::InitializeNativeTargetAsmPrinter();
-
-  auto JTMB = makeTargetMachineBuilder();
   TM_ = llvm::cantFail(JTMB.createTargetMachine());
 
-  jit_ = std::make_unique<llvm::orc::PytorchLLVMJIT>();
   module_ = std::make_unique<llvm::Module>("pytorch", getContext());
   module_->setDataLayout(cantFail(JTMB.getDefaultDataLayoutForTarget()));
   module_->setTargetTriple(JTMB.getTargetTriple().str());
@@ -259,12 +319,50 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
       fn_->addParamAttr(i, llvm::Attribute::NoAlias);
     }
   }
+  return params;
+}
 
-  emitWrapper(params);
-  emitKernel(stmt, params);
+LLVMCodeGenImpl::LLVMCodeGenImpl(
+    Stmt* stmt,
+    const std::vector<CodeGen::BufferArg>& args,
+    at::Device device,
+    Dtype dtype)
+    : context_(std::make_unique<llvm::LLVMContext>()), irb_(getContext()) {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+
+  auto JTMB = makeTargetMachineBuilder();
+  jit_ = std::make_unique<llvm::orc::PytorchLLVMJIT>();
+  std::vector<llvm::Type*> params = emitPrototype(args, dtype, JTMB);
+
+  auto& diskCache = KernelDiskCache::get();
+  std::string cacheKey;
+  std::unique_ptr<llvm::MemoryBuffer> object;
+  if (diskCache.enabled()) {
+    cacheKey = diskCacheKey(stmt, args, dtype, JTMB);
+    if (auto cached = diskCache.lookup(cacheKey, "o")) {
+      auto buffer = llvm::MemoryBuffer::getFile(*cached);
+      if (buffer) {
+        object = std::move(*buffer);
+      }
+    }
+  }
+
+  if (!object) {
+    emitWrapper(params, "wrapper");
+    emitKernel(stmt, params);
+    if (diskCache.enabled()) {
+      object = emitObject();
+      diskCache.store(cacheKey, "o", object->getBuffer().str());
+    }
+  }
 
-  cantFail(jit_->addModule(
-      llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  if (object) {
+    cantFail(jit_->addObjectFile(std::move(object)));
+  } else {
+    cantFail(jit_->addModule(
+        llvm::orc::ThreadSafeModule(std::move(module_), context_)));
+  }
   auto sym = jit_->findSymbol("wrapper");
   kernelAddress_ = cantFail(sym.getAddress());
   argv_ = std::make_unique<void*[]>(params.size());
@@ -272,6 +370,30 @@ LLVMCodeGenImpl::LLVMCodeGenImpl(
   USE_TRIGGER(llvm_codegen_created);
 }
 
+LLVMCodeGenImpl::LLVMCodeGenImpl(
+    Stmt* stmt,
+    const std::vector<CodeGen::BufferArg>& args,
+    Dtype dtype,
+    const std::string& wrapperName)
+    : context_(std::make_unique<llvm::LLVMContext>()),
+      irb_(getContext()),
+      useSleef_(false) {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+
+  // The object is linked into a shared library.
+  auto JTMB = makeTargetMachineBuilder();
+  JTMB.setRelocationModel(llvm::Reloc::PIC_);
+  std::vector<llvm::Type*> params = emitPrototype(args, dtype, JTMB);
+  emitWrapper(params, wrapperName);
+  emitKernel(stmt, params);
+  objectCode_ = emitObject()->getBuffer().str();
+}
+
+const std::string& LLVMCodeGenImpl::objectCode() const {
+  return objectCode_;
+}
+
 llvm::LLVMContext& LLVMCodeGenImpl::getContext() {
   return *context_.getContext();
 }
@@ -295,13 +417,20 @@ llvm::Type* LLVMCodeGenImpl::dtypeToLLVMPtr(Dtype dtype) {
   return dtypeToLLVM(dtype)->getPointerTo();
 }
 
-void LLVMCodeGenImpl::emitWrapper(const std::vector<llvm::Type*>& params) {
+void LLVMCodeGenImpl::emitWrapper(
+    const std::vector<llvm::Type*>& params,
+    const std::string& name) {
   auto voidPtrPtrTy = llvm::Type::getInt8PtrTy(getContext())->getPointerTo();
   auto wrapper = llvm::Function::Create(
       llvm::FunctionType::get(IntTy_, {voidPtrPtrTy}, false),
       llvm::Function::ExternalLinkage,
-      "wrapper",
+      name,
       module_.get());
+  if (!jit_) {
+    // Ahead-of-time kernels are only called from the library they are
+    // linked into.
+    wrapper->setVisibility(llvm::GlobalValue::HiddenVisibility);
+  }
   auto wrapBB = llvm::BasicBlock::Create(getContext(), "wrapBB", wrapper);
   irb_.SetInsertPoint(wrapBB);
   llvm::SmallVector<llvm::Value*, 6> wrappedArgs;
@@ -455,6 +584,23 @@ void LLVMCodeGenImpl::emitKernel(
 #endif
 }
 
+std::unique_ptr<llvm::MemoryBuffer> LLVMCodeGenImpl::emitObject() {
+#if LLVM_VERSION_MAJOR >= 10
+  auto fileType = llvm::CodeGenFileType::CGFT_ObjectFile;
+#else
+  auto fileType = llvm::TargetMachine::CodeGenFileType::CGFT_ObjectFile;
+#endif
+  llvm::SmallVector<char, 0> objBuffer;
+  llvm::raw_svector_ostream objStream(objBuffer);
+  llvm::legacy::PassManager PM;
+  if (TM_->addPassesToEmitFile(PM, objStream, nullptr, fileType)) {
+    throw std::runtime_error("Target does not support object emission");
+  }
+  PM.run(*module_);
+  return llvm::MemoryBuffer::getMemBufferCopy(
+      llvm::StringRef(objBuffer.data(), objBuffer.size()), "pytorch");
+}
+
 // TODO: The binary ops are copypasta.
 
 void LLVMCodeGenImpl::visit(const Add* v) {
@@ -1213,13 +1359,13 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 8) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 8) {                              \
       fname = "Sleef_" + std::string(name) + "8";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
           fname, llvm::FunctionType::get(vecType, {vecType}, false), {});    \
       call_simd_sleef = true;                                                \
-    } else if (v->dtype().lanes() == 4) {                                    \
+    } else if (useSleef_ && v->dtype().lanes() == 4) {                       \
       fname = "Sleef_" + std::string(name) + "4";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1238,7 +1384,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 4) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 4) {                              \
       fname = "Sleef_" + std::string(name) + "4";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1283,7 +1429,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 8) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 8) {                              \
       fname = "Sleef_" + std::string(name) + "8";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1291,7 +1437,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
           llvm::FunctionType::get(vecType, {vecType, vecType}, false),       \
           {});                                                               \
       call_simd_sleef = true;                                                \
-    } else if (v->dtype().lanes() == 4) {                                    \
+    } else if (useSleef_ && v->dtype().lanes() == 4) {                       \
       fname = "Sleef_" + std::string(name) + "4";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1312,7 +1458,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 4) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 4) {                              \
       fname = "Sleef_" + std::string(name) + "4";                            \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1357,13 +1503,13 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 4) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 4) {                              \
       fname = "Sleef_" + std::string(name) + "d4";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
           fname, llvm::FunctionType::get(vecType, {vecType}, false), {});    \
       call_simd_sleef = true;                                                \
-    } else if (v->dtype().lanes() == 2) {                                    \
+    } else if (useSleef_ && v->dtype().lanes() == 2) {                       \
       fname = "Sleef_" + std::string(name) + "d2";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1382,7 +1528,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 2) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 2) {                              \
       fname = "Sleef_" + std::string(name) + "d2";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1438,7 +1584,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 4) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 4) {                              \
       fname = "Sleef_" + std::string(name) + "d4";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1446,7 +1592,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
           llvm::FunctionType::get(vecType, {vecType, vecType}, false),       \
           {});                                                               \
       call_simd_sleef = true;                                                \
-    } else if (v->dtype().lanes() == 2) {                                    \
+    } else if (useSleef_ && v->dtype().lanes() == 2) {                       \
       fname = "Sleef_" + std::string(name) + "d2";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
@@ -1467,7 +1613,7 @@ void LLVMCodeGenImpl::visit(const Intrinsics* v) {
   case enum: {                                                               \
     llvm::FunctionCallee callee;                                             \
     std::string fname;                                                       \
-    if (v->dtype().lanes() == 2) {                                           \
+    if (useSleef_ && v->dtype().lanes() == 2) {                              \
       fname = "Sleef_" + std::string(name) + "d2";                           \
       llvm::Type* vecType = llvm::VectorType::get(type, v->dtype().lanes()); \
       callee = module_->getOrInsertFunction(                                 \
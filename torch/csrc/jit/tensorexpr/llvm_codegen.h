@@ -7,6 +7,7 @@
 #include <torch/csrc/jit/tensorexpr/ir.h>
 #include <torch/csrc/jit/tensorexpr/ir_visitor.h>
 
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +31,17 @@ class TORCH_API LLVMCodeGen : public CodeGen {
 
   TORCH_API void call(const std::vector<CallArg>& args) override;
 
+  // Compiles `stmt` into position independent object code for the host CPU,
+  // to be linked into a shared library. The object defines a hidden
+  // `int32_t name(void** args)` taking the same arguments as the kernel
+  // called by call(): args[i] points to buffer i, or to the value of scalar
+  // argument i. Vector math is lowered to libm rather than Sleef calls.
+  static std::string compileToObject(
+      Stmt* stmt,
+      const std::vector<BufferArg>& args,
+      const std::string& name,
+      Dtype dtype = kInt);
+
   template <typename T>
   T value() {
     return value<T>(nullptr);
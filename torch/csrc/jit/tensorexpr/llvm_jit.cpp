@@ -425,6 +425,10 @@ class TORCH_API PytorchLLVMJITImpl {
     return Error::success();
   }
 
+  Error addObjectFile(std::unique_ptr<MemoryBuffer> Obj) {
+    return LLJ->addObjectFile(std::move(Obj));
+  }
+
   JITSymbol findSymbol(const std::string Name) {
     return cantFail(LLJ->lookup(Name));
   }
@@ -443,6 +447,10 @@ Error PytorchLLVMJIT::addModule(ThreadSafeModule M) {
   return impl_->addModule(std::move(M));
 }
 
+Error PytorchLLVMJIT::addObjectFile(std::unique_ptr<MemoryBuffer> Obj) {
+  return impl_->addObjectFile(std::move(Obj));
+}
+
 JITSymbol PytorchLLVMJIT::findSymbol(const std::string Name) {
   return impl_->findSymbol(std::move(Name));
 }
@@ -630,6 +630,30 @@ Tensor sparse_coo_tensor_ctor(c10::DispatchKey dispatch_key, at::ScalarType scal
   throw std::runtime_error("sparse_coo_tensor(): invalid arguments");
 }
 
+Tensor sparse_csr_tensor_ctor(c10::DispatchKey dispatch_key, at::ScalarType scalar_type, PyObject* args, PyObject* kwargs) {
+  static PythonArgParser parser({
+    "sparse_csr_tensor(PyObject* crow_indices, PyObject* col_indices, PyObject* values, *, ScalarType dtype=None, Device? device=None, bool requires_grad=False)",
+    "sparse_csr_tensor(PyObject* crow_indices, PyObject* col_indices, PyObject* values, IntArrayRef size, *, ScalarType dtype=None, Device? device=None, bool requires_grad=False)",
+  });
+
+  ParsedArgs<7> parsed_args;
+  auto r = parser.parse(args, kwargs, parsed_args);
+  // the size, if given, is the fourth argument, and shifts the keyword arguments
+  const int kwarg_begin = r.idx == 0 ? 3 : 4;
+  bool type_inference = r.isNone(kwarg_begin);
+  const auto inferred_dispatch_key = denseTypeIdWithDefault(r, kwarg_begin + 1, dispatch_key);
+  const auto inferred_scalar_type = r.scalartypeWithDefault(kwarg_begin, scalar_type);
+  at::OptionalDeviceGuard device_guard(r.deviceOptional(kwarg_begin + 1));
+  // if no dtype provided, infer type based on value type.
+  Tensor values = internal_new_from_data(inferred_dispatch_key, inferred_scalar_type, r.deviceOptional(kwarg_begin + 1), r.pyobject(2), false, true, type_inference);
+  Tensor crow_indices = internal_new_from_data(legacyExtractDispatchKey(values.key_set()), kLong, r.deviceOptional(kwarg_begin + 1), r.pyobject(0), false, true, false);
+  Tensor col_indices = internal_new_from_data(legacyExtractDispatchKey(values.key_set()), kLong, r.deviceOptional(kwarg_begin + 1), r.pyobject(1), false, true, false);
+  if (r.idx == 0) {
+    return at::sparse_csr_tensor(crow_indices, col_indices, values, values.options().layout(at::kSparseCsr)).set_requires_grad(r.toBool(kwarg_begin + 2));
+  }
+  return at::sparse_csr_tensor(crow_indices, col_indices, values, r.intlist(3), values.options().layout(at::kSparseCsr)).set_requires_grad(r.toBool(kwarg_begin + 2));
+}
+
 Tensor tensor_ctor(c10::DispatchKey dispatch_key, at::ScalarType scalar_type, PyObject* args, PyObject* kwargs) {
   static PythonArgParser parser({
     "tensor(PyObject* data, *, ScalarType dtype=None, Device? device=None, bool pin_memory=False, bool requires_grad=False, DimnameList? names=None)",
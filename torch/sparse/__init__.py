@@ -44,15 +44,16 @@ def addmm(mat, mat1, mat2, beta=1, alpha=1):
 def mm(mat1, mat2):
     r"""
     Performs a matrix multiplication of the sparse matrix :attr:`mat1`
-    and dense matrix :attr:`mat2`. Similar to :func:`torch.mm`, If :attr:`mat1` is a
+    and the sparse or dense matrix :attr:`mat2`. Similar to :func:`torch.mm`, If :attr:`mat1` is a
     :math:`(n \times m)` tensor, :attr:`mat2` is a :math:`(m \times p)` tensor, out will be a
-    :math:`(n \times p)` dense tensor. :attr:`mat1` need to have `sparse_dim = 2`.
-    This function also supports backward for both matrices. Note that the gradients of
-    :attr:`mat1` is a coalesced sparse tensor.
+    :math:`(n \times p)` tensor, which is a coalesced sparse tensor if :attr:`mat2` is sparse
+    and a dense tensor otherwise. :attr:`mat1` need to have `sparse_dim = 2`.
+    When :attr:`mat2` is dense, this function also supports backward for both matrices.
+    Note that the gradients of :attr:`mat1` is a coalesced sparse tensor.
 
     Args:
         mat1 (SparseTensor): the first sparse matrix to be multiplied
-        mat2 (Tensor): the second dense matrix to be multiplied
+        mat2 (Tensor): the second matrix to be multiplied, which could be sparse or dense
 
     Example::
 
@@ -13,13 +13,16 @@ class LintCode(Enum):
     DROPOUT = 3
     BATCHNORM = 4
 
-def optimize_for_mobile(script_module, optimization_blacklist: Set[MobileOptimizerType] = None):
+def optimize_for_mobile(script_module, optimization_blacklist: Set[MobileOptimizerType] = None,
+                        propagate_channels_last: bool = False):
     """
     Args:
         script_module: An instance of torch script module with type of ScriptModule.
         optimization_blacklist: A set with type of MobileOptimizerType. When set is not passed,
             optimization method will run all the optimizer pass; otherwise, optimizer
             method will run the optimization pass that is not included inside optimization_blacklist.
+        propagate_channels_last: Also convert 4-d activations to channels-last where that saves
+            layout conversions in XNNPACK convolutions. Off by default.
     Returns:
         A new optimized torch script module
     """
@@ -30,7 +33,8 @@ def optimize_for_mobile(script_module, optimization_blacklist: Set[MobileOptimiz
     if optimization_blacklist is None:
         optimization_blacklist = set()
 
-    optimized_cpp_module = torch._C._jit_pass_optimize_for_mobile(script_module._c, optimization_blacklist)
+    optimized_cpp_module = torch._C._jit_pass_optimize_for_mobile(
+        script_module._c, optimization_blacklist, propagate_channels_last)
     return torch.jit._recursive.wrap_cpp_module(optimized_cpp_module)
 
 